@@ -0,0 +1,125 @@
+// Compares strategies for accumulating Vector3 contributions from many threads into shared bodies:
+// a mutex per body, per-component CAS (atomicAdd) and the buffered two-pass BufferedScatterAdd.
+// Usage: accumulation_bench [threads] [contributions per thread]
+
+#include <lumina/concurrent/atomic_vector.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+// Deterministic per-thread index stream
+struct IndexStream
+{
+    std::uint64_t state;
+
+    std::uint32_t next(std::uint32_t bound)
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return std::uint32_t(((state >> 32) * bound) >> 32);
+    }
+};
+
+template <typename Fn>
+double runThreads(unsigned threads, Fn &&fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t)
+        workers.emplace_back([&fn, t]() { fn(t); });
+    for (std::thread &worker : workers)
+        worker.join();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Every strategy adds `count` copies of the same contribution, so each component's total must agree
+bool checkTotal(const std::vector<Vector3<float>> &bodies, const Vector3<float> &contribution, double count)
+{
+    double total[3] = {0, 0, 0};
+    for (const Vector3<float> &body : bodies)
+    {
+        total[0] += body.x;
+        total[1] += body.y;
+        total[2] += body.z;
+    }
+    for (int k = 0; k < 3; ++k)
+    {
+        double expected = count * contribution[k];
+        if (std::abs(total[k] - expected) > 1e-3 * std::abs(expected))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned threads = argc > 1 ? unsigned(std::atoi(argv[1])) : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t perThread = argc > 2 ? std::size_t(std::atoll(argv[2])) : std::size_t(1) << 20;
+    const Vector3<float> contribution(1.0f, 2.0f, 3.0f);
+    bool ok = true;
+
+    std::printf("%-10s %10s %8s %14s\n", "strategy", "bodies", "threads", "ns/contrib");
+    for (std::uint32_t bodyCount : {64u, 4096u, 1u << 20})
+    {
+        double contributions = double(threads) * double(perThread);
+
+        std::vector<Vector3<float>> bodies(bodyCount);
+        std::vector<std::mutex> locks(bodyCount);
+        double ns = runThreads(threads, [&](unsigned t)
+        {
+            IndexStream indices{t + 1};
+            for (std::size_t i = 0; i < perThread; ++i)
+            {
+                std::uint32_t index = indices.next(bodyCount);
+                std::lock_guard<std::mutex> lock(locks[index]);
+                bodies[index] += contribution;
+            }
+        });
+        ok &= checkTotal(bodies, contribution, contributions);
+        std::printf("%-10s %10u %8u %14.2f\n", "mutex", bodyCount, threads, ns / contributions);
+
+        bodies.assign(bodyCount, Vector3<float>());
+        ns = runThreads(threads, [&](unsigned t)
+        {
+            IndexStream indices{t + 1};
+            for (std::size_t i = 0; i < perThread; ++i)
+                atomicAdd(bodies[indices.next(bodyCount)], contribution);
+        });
+        ok &= checkTotal(bodies, contribution, contributions);
+        std::printf("%-10s %10u %8u %14.2f\n", "cas", bodyCount, threads, ns / contributions);
+
+        // Run twice so the timed pass reuses the buffer capacity, as a solver would from frame to frame
+        BufferedScatterAdd<float> scatter(bodyCount, threads);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            bodies.assign(bodyCount, Vector3<float>());
+            auto start = std::chrono::steady_clock::now();
+            runThreads(threads, [&](unsigned t)
+            {
+                IndexStream indices{t + 1};
+                for (std::size_t i = 0; i < perThread; ++i)
+                    scatter.add(t, indices.next(bodyCount), contribution);
+            });
+            scatter.merge(bodies.data(), threads);
+            ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        }
+        ok &= checkTotal(bodies, contribution, contributions);
+        std::printf("%-10s %10u %8u %14.2f\n", "buffered", bodyCount, threads, ns / contributions);
+    }
+
+    if (!ok)
+        std::fprintf(stderr, "accumulated totals disagree\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+// Compares regular and non-temporal (streaming) stores for batch outputs from cache-resident sizes up
+// to DRAM-sized buffers: Matrix4 * Vector4<float> transforms and Vector3<float> normalization.
+// Usage: streaming_bench [threads] [largest vector count]
+
+#include <lumina/batch/transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+const char *modeName(StoreMode mode)
+{
+    switch (mode)
+    {
+    case StoreMode::Auto:
+        return "auto";
+    case StoreMode::Regular:
+        return "regular";
+    case StoreMode::Streaming:
+        return "streaming";
+    }
+    return "?";
+}
+
+// Best of several runs after one warm-up, in nanoseconds
+template <typename Fn>
+double bestTime(int runs, Fn &&fn)
+{
+    fn();
+    double best = 0;
+    for (int r = 0; r < runs; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = r == 0 ? ns : std::min(best, ns);
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned threads = argc > 1 ? unsigned(std::atoi(argv[1])) : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t largest = argc > 2 ? std::size_t(std::atoll(argv[2])) : std::size_t(1) << 24;
+    const Matrix4<float> matrix =
+        Matrix4<float>::trs(Vector3<float>(1, 2, 3), Vector4<float>(0, 0.6f, 0, 0.8f), Vector3<float>(2));
+    bool ok = true;
+
+    std::printf("streaming threshold %zu bytes\n", streamingThreshold());
+    std::printf("%-10s %-10s %12s %8s %12s\n", "kernel", "mode", "output MiB", "threads", "GB/s");
+    for (std::size_t count = std::size_t(1) << 14; count <= largest; count *= 4)
+    {
+        int runs = count <= (std::size_t(1) << 20) ? 20 : 3;
+        std::vector<Vector4<float>> points(count, Vector4<float>(1, 2, 3, 1));
+        std::vector<Vector4<float>> transformed(count);
+        std::vector<Vector3<float>> normals(count, Vector3<float>(3, 0, 4));
+        std::vector<Vector3<float>> unit(count);
+
+        for (StoreMode mode : {StoreMode::Regular, StoreMode::Streaming, StoreMode::Auto})
+        {
+            // Bytes read plus bytes written
+            double ns = bestTime(runs, [&]()
+            {
+                transformBatch(matrix, points.data(), transformed.data(), count, mode, threads);
+            });
+            double bytes = 2.0 * double(count * sizeof(Vector4<float>));
+            std::printf("%-10s %-10s %12.1f %8u %12.2f\n", "transform", modeName(mode),
+                        double(count * sizeof(Vector4<float>)) / (1 << 20), threads, bytes / ns);
+            ok &= Vector4<float>::approxEqual(transformed[count - 1], matrix * points[count - 1], 1e-5f);
+
+            ns = bestTime(runs, [&]()
+            {
+                normalizeBatch(normals.data(), unit.data(), count, MathAccuracy::Precise, mode, threads);
+            });
+            bytes = 2.0 * double(count * sizeof(Vector3<float>));
+            std::printf("%-10s %-10s %12.1f %8u %12.2f\n", "normalize", modeName(mode),
+                        double(count * sizeof(Vector3<float>)) / (1 << 20), threads, bytes / ns);
+            ok &= Vector3<float>::approxEqual(unit[count - 1], Vector3<float>(0.6f, 0, 0.8f), 1e-6f);
+        }
+    }
+
+    if (!ok)
+        std::fprintf(stderr, "batch results disagree with the scalar operators\n");
+    return ok ? 0 : 1;
+}
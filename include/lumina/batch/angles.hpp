@@ -0,0 +1,73 @@
+#pragma once
+
+#include <lumina/batch/math.hpp>
+#include <lumina/batch/strided_view.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <cstddef>
+
+namespace lumina
+{
+
+    // Batch angle, rotation and polar kernels on the vectorized math layer.
+    // All angles are in radians.
+
+    // Angle between a[i] and b[i]. Like Vector2/3/4::angle a zero-length input gives pi/2.
+    // Computed as atan2(|a ^ b|, a . b) with the wedge terms (the 3D cross product, the 2D perp-dot)
+    // taken as compensated differences of products, so Precise results stay within a few ulp for random
+    // and near-parallel pairs alike. That holds while the component products stay in T's normal range;
+    // denormal components, or products that overflow, lose it.
+    template <typename T>
+    void angles(const Vector2<T> *a, const Vector2<T> *b, T *out, std::size_t count,
+                MathAccuracy accuracy = MathAccuracy::Precise);
+    template <typename T>
+    void angles(const Vector3<T> *a, const Vector3<T> *b, T *out, std::size_t count,
+                MathAccuracy accuracy = MathAccuracy::Precise);
+    template <typename T>
+    void angles(const Vector4<T> *a, const Vector4<T> *b, T *out, std::size_t count,
+                MathAccuracy accuracy = MathAccuracy::Precise);
+
+    // Counter-clockwise rotation of in[i] by angles[i]
+    template <typename T>
+    void rotate(const Vector2<T> *in, const T *angles, Vector2<T> *out, std::size_t count,
+                MathAccuracy accuracy = MathAccuracy::Precise);
+
+    // Rotation of in[i] by angles[i] around the unit axis axes[i] (Rodrigues' formula)
+    template <typename T>
+    void rotate(const Vector3<T> *in, const Vector3<T> *axes, const T *angles, Vector3<T> *out,
+                std::size_t count, MathAccuracy accuracy = MathAccuracy::Precise);
+
+    // Cartesian <-> polar; angles are in (-pi, pi]
+    template <typename T>
+    void toPolar(const Vector2<T> *in, T *radius, T *angle, std::size_t count,
+                 MathAccuracy accuracy = MathAccuracy::Precise);
+    template <typename T>
+    void fromPolar(const T *radius, const T *angle, Vector2<T> *out, std::size_t count,
+                   MathAccuracy accuracy = MathAccuracy::Precise);
+
+    // Strided overloads work in place on interleaved buffers; all views must have the same count.
+    // Rotating with `in` and `out` over the same elements is allowed.
+    template <typename T>
+    void angles(const StridedView<Vector2<T>> &a, const StridedView<Vector2<T>> &b, T *out,
+                MathAccuracy accuracy = MathAccuracy::Precise);
+    template <typename T>
+    void angles(const StridedView<Vector3<T>> &a, const StridedView<Vector3<T>> &b, T *out,
+                MathAccuracy accuracy = MathAccuracy::Precise);
+    template <typename T>
+    void angles(const StridedView<Vector4<T>> &a, const StridedView<Vector4<T>> &b, T *out,
+                MathAccuracy accuracy = MathAccuracy::Precise);
+    template <typename T>
+    void rotate(const StridedView<Vector2<T>> &in, const T *angles, const StridedRef<Vector2<T>> &out,
+                MathAccuracy accuracy = MathAccuracy::Precise);
+    template <typename T>
+    void rotate(const StridedView<Vector3<T>> &in, const StridedView<Vector3<T>> &axes, const T *angles,
+                const StridedRef<Vector3<T>> &out, MathAccuracy accuracy = MathAccuracy::Precise);
+    template <typename T>
+    void toPolar(const StridedView<Vector2<T>> &in, T *radius, T *angle,
+                 MathAccuracy accuracy = MathAccuracy::Precise);
+    template <typename T>
+    void fromPolar(const T *radius, const T *angle, const StridedRef<Vector2<T>> &out,
+                   MathAccuracy accuracy = MathAccuracy::Precise);
+
+} // namespace lumina
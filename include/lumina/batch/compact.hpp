@@ -0,0 +1,39 @@
+#pragma once
+
+#include <lumina/batch/predicates.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace lumina
+{
+
+    // Stream compaction over the bitmasks written by the batch predicates (see batch/predicates.hpp).
+    // Selected elements are written contiguously and in order to `out`, and their source indices
+    // to `indices` when it is non-null. Both outputs must have room for `count` entries, since the
+    // SIMD paths store whole packs past the last survivor. Returns the number of selected elements.
+
+    std::size_t countMask(const std::uint64_t *masks, std::size_t count);
+    std::size_t maskToIndices(const std::uint64_t *masks, std::size_t count, std::uint32_t *indices);
+
+    template <typename T>
+    std::size_t compact(const T *values, std::size_t count, const std::uint64_t *masks, T *out,
+                        std::uint32_t *indices = nullptr);
+    template <typename T>
+    std::size_t compact(const Vector2<T> *values, std::size_t count, const std::uint64_t *masks, Vector2<T> *out,
+                        std::uint32_t *indices = nullptr);
+    template <typename T>
+    std::size_t compact(const Vector3<T> *values, std::size_t count, const std::uint64_t *masks, Vector3<T> *out,
+                        std::uint32_t *indices = nullptr);
+    template <typename T>
+    std::size_t compact(const Vector4<T> *values, std::size_t count, const std::uint64_t *masks, Vector4<T> *out,
+                        std::uint32_t *indices = nullptr);
+    template <typename T>
+    std::size_t compact(const StridedView<Vector3<T>> &values, const std::uint64_t *masks, Vector3<T> *out,
+                        std::uint32_t *indices = nullptr);
+
+    // `out` must have the same count as `values`
+    template <typename T>
+    std::size_t compact(const Vector3SoAView<T> &values, const std::uint64_t *masks, const Vector3SoARef<T> &out,
+                        std::uint32_t *indices = nullptr);
+
+} // namespace lumina
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <lumina/batch/soa.hpp>
+#include <lumina/batch/strided_view.hpp>
+#include <lumina/geometry/frustum.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace lumina
+{
+
+    // Batch frustum culling.
+    // Indices of the elements that survive are written in ascending order to `survivors`,
+    // which must have room for `points.count` entries. Returns the number of survivors.
+    // Counts above 2^32 throw std::length_error, since the indices would not fit.
+
+    template <typename T>
+    std::size_t cullPoints(const Frustum<T> &frustum, const Vector3SoAView<T> &points, std::uint32_t *survivors);
+    template <typename T>
+    std::size_t cullPoints(const Frustum<T> &frustum, const StridedView<Vector3<T>> &points, std::uint32_t *survivors);
+
+    // A sphere survives unless it lies entirely behind one of the planes
+    template <typename T>
+    std::size_t cullSpheres(const Frustum<T> &frustum, const Vector3SoAView<T> &centers, const T *radii,
+                            std::uint32_t *survivors);
+    // Centers and radii read in place, e.g. from interleaved {center, radius} records; both views
+    // must have the same count
+    template <typename T>
+    std::size_t cullSpheres(const Frustum<T> &frustum, const StridedView<Vector3<T>> &centers,
+                            const StridedView<T> &radii, std::uint32_t *survivors);
+
+} // namespace lumina
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <lumina/numeric/fixed.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <cstddef>
+
+namespace lumina
+{
+
+    // Batch kernels for int and Q16.16 (Fixed16) vectors, vectorized with AVX2 epi32 lanes.
+    // V is Vector2, Vector3 or Vector4 of int or Fixed16. int arithmetic wraps around in two's
+    // complement; Fixed16 arithmetic saturates exactly like its scalar operators, so results are
+    // bit-identical to the scalar Vector code and across instruction sets. Outputs may alias inputs.
+
+    // Component-wise out[i] = a[i] op b[i]
+    template <typename V>
+    void addBatch(const V *a, const V *b, V *out, std::size_t count);
+    template <typename V>
+    void subBatch(const V *a, const V *b, V *out, std::size_t count);
+    template <typename V>
+    void mulBatch(const V *a, const V *b, V *out, std::size_t count);
+    template <typename V>
+    void minBatch(const V *a, const V *b, V *out, std::size_t count);
+    template <typename V>
+    void maxBatch(const V *a, const V *b, V *out, std::size_t count);
+
+    // out[i] = V::dot(a[i], b[i]), summed in component order like the scalar dot
+    template <typename T>
+    void dotBatch(const Vector2<T> *a, const Vector2<T> *b, T *out, std::size_t count);
+    template <typename T>
+    void dotBatch(const Vector3<T> *a, const Vector3<T> *b, T *out, std::size_t count);
+    template <typename T>
+    void dotBatch(const Vector4<T> *a, const Vector4<T> *b, T *out, std::size_t count);
+
+    // Integer-only magnitude estimate: max(hi, 28/32 hi + 17/32 lo) in 2D and
+    // max(hi, 27/32 hi + 17/32 mid + 9/32 lo) in 3D over the sorted absolute components.
+    // Relative error is within 3% (2D) and 5% (3D) once the largest component reaches 256 units
+    // (raw units for Fixed16); results saturate instead of wrapping.
+    template <typename T>
+    void approxMagnitudeBatch(const Vector2<T> *vectors, T *out, std::size_t count);
+    template <typename T>
+    void approxMagnitudeBatch(const Vector3<T> *vectors, T *out, std::size_t count);
+
+} // namespace lumina
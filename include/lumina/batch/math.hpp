@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+
+namespace lumina
+{
+
+    // Accuracy tier of the vectorized elementary functions.
+    // Precise is within a few ulp of the standard library; Fast uses shorter polynomials
+    // (about 4e-5 absolute for float sin/cos, single precision class results for double).
+    enum class MathAccuracy
+    {
+        Fast,
+        Precise
+    };
+
+    // How batch kernels write their output.
+    // Streaming uses non-temporal stores, which skip the read-for-ownership of every output line and
+    // keep the output from evicting cached data, and prefetches the input ahead of the stores. It pays off
+    // only when the output does not fit in the last-level cache; Auto picks it above streamingThreshold().
+    // Streaming starts at the first output element on a 16-byte boundary; an output with none writes regularly.
+    enum class StoreMode
+    {
+        Auto,
+        Regular,
+        Streaming
+    };
+
+    // Output size in bytes from which StoreMode::Auto streams: the last-level cache size reported by
+    // the system, or 8 MiB when it is unknown
+    std::size_t streamingThreshold();
+
+    // Element-wise batch functions; `in` and `out` may alias. Streaming needs every output of a call to
+    // share its alignment modulo 16 bytes. A NaN input gives NaN wherever it sits in the array.
+    template <typename T>
+    void sinBatch(const T *in, T *out, std::size_t count, MathAccuracy accuracy = MathAccuracy::Precise,
+                  StoreMode mode = StoreMode::Auto);
+    template <typename T>
+    void cosBatch(const T *in, T *out, std::size_t count, MathAccuracy accuracy = MathAccuracy::Precise,
+                  StoreMode mode = StoreMode::Auto);
+    template <typename T>
+    void sincosBatch(const T *in, T *sinOut, T *cosOut, std::size_t count,
+                     MathAccuracy accuracy = MathAccuracy::Precise, StoreMode mode = StoreMode::Auto);
+    // Input is clamped to [-1, 1]
+    template <typename T>
+    void acosBatch(const T *in, T *out, std::size_t count, MathAccuracy accuracy = MathAccuracy::Precise,
+                  StoreMode mode = StoreMode::Auto);
+    template <typename T>
+    void atan2Batch(const T *y, const T *x, T *out, std::size_t count,
+                    MathAccuracy accuracy = MathAccuracy::Precise, StoreMode mode = StoreMode::Auto);
+    template <typename T>
+    void rsqrtBatch(const T *in, T *out, std::size_t count, MathAccuracy accuracy = MathAccuracy::Precise,
+                  StoreMode mode = StoreMode::Auto);
+    template <typename T>
+    void expBatch(const T *in, T *out, std::size_t count, MathAccuracy accuracy = MathAccuracy::Precise,
+                  StoreMode mode = StoreMode::Auto);
+
+} // namespace lumina
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <lumina/batch/soa.hpp>
+#include <lumina/batch/strided_view.hpp>
+#include <lumina/geometry/bounds.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace lumina
+{
+
+    // Batch predicates write one bit per element into 64-bit mask words:
+    // element i maps to bit (i % 64) of masks[i / 64]. Bits past `count` in the last word are cleared.
+    // Masks feed compact() and maskToIndices() in batch/compact.hpp.
+    inline std::size_t maskWordCount(std::size_t count)
+    {
+        return (count + 63) / 64;
+    }
+
+    enum class Comparison
+    {
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal,
+        NotEqual
+    };
+
+    // values[i] <comparison> threshold; only NotEqual holds for NaN
+    template <typename T>
+    void compare(const T *values, std::size_t count, Comparison comparison, T threshold, std::uint64_t *masks);
+
+    // Element-wise Vector::approxEqual(a[i], b[i], epsilon)
+    template <typename T>
+    void approxEqual(const Vector2<T> *a, const Vector2<T> *b, std::size_t count, T epsilon, std::uint64_t *masks);
+    template <typename T>
+    void approxEqual(const Vector3<T> *a, const Vector3<T> *b, std::size_t count, T epsilon, std::uint64_t *masks);
+    template <typename T>
+    void approxEqual(const Vector4<T> *a, const Vector4<T> *b, std::size_t count, T epsilon, std::uint64_t *masks);
+    template <typename T>
+    void approxEqual(const StridedView<Vector2<T>> &a, const StridedView<Vector2<T>> &b, T epsilon,
+                     std::uint64_t *masks);
+    template <typename T>
+    void approxEqual(const StridedView<Vector3<T>> &a, const StridedView<Vector3<T>> &b, T epsilon,
+                     std::uint64_t *masks);
+    template <typename T>
+    void approxEqual(const StridedView<Vector4<T>> &a, const StridedView<Vector4<T>> &b, T epsilon,
+                     std::uint64_t *masks);
+    template <typename T>
+    void approxEqual(const Vector3SoAView<T> &a, const Vector3SoAView<T> &b, T epsilon, std::uint64_t *masks);
+
+    // (points[i] - center).sqrMagnitude() <= radius * radius
+    template <typename T>
+    void withinDistance(const Vector2<T> *points, std::size_t count, const Vector2<T> &center, T radius,
+                        std::uint64_t *masks);
+    template <typename T>
+    void withinDistance(const Vector3<T> *points, std::size_t count, const Vector3<T> &center, T radius,
+                        std::uint64_t *masks);
+    template <typename T>
+    void withinDistance(const StridedView<Vector3<T>> &points, const Vector3<T> &center, T radius,
+                        std::uint64_t *masks);
+    template <typename T>
+    void withinDistance(const Vector3SoAView<T> &points, const Vector3<T> &center, T radius, std::uint64_t *masks);
+
+    // Bounds3::contains(points[i]): min <= point <= max on every axis
+    template <typename T>
+    void insideBounds(const Vector3<T> *points, std::size_t count, const Bounds3<T> &bounds, std::uint64_t *masks);
+    template <typename T>
+    void insideBounds(const StridedView<Vector3<T>> &points, const Bounds3<T> &bounds, std::uint64_t *masks);
+    template <typename T>
+    void insideBounds(const Vector3SoAView<T> &points, const Bounds3<T> &bounds, std::uint64_t *masks);
+
+} // namespace lumina
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <lumina/batch/soa.hpp>
+#include <lumina/batch/strided_view.hpp>
+#include <lumina/geometry/bounds.hpp>
+#include <cstddef>
+
+namespace lumina
+{
+
+    // Summary of a point set gathered in a single pass over memory
+    template <typename T>
+    struct PointStats
+    {
+        std::size_t count = 0;
+        Vector3<T> sum;
+        Vector3<T> mean;
+        Bounds3<T> bounds;
+        // Population covariance (divided by count), symmetric
+        T covariance[3][3] = {};
+    };
+
+    // Batch reductions.
+    // Sums are Kahan-Babuska compensated in every SIMD lane within a block, then across lanes and
+    // blocks in double precision; covariance is built from per-block co-moments about the block
+    // mean, merged with Chan's pairwise update.
+    // `threads` = 0 uses every hardware thread; small inputs run on the calling thread.
+
+    template <typename T>
+    PointStats<T> pointStats(const Vector3SoAView<T> &points, unsigned threads = 0);
+    template <typename T>
+    PointStats<T> pointStats(const Vector3<T> *points, std::size_t count, unsigned threads = 0);
+    template <typename T>
+    PointStats<T> pointStats(const StridedView<Vector3<T>> &points, unsigned threads = 0);
+
+    template <typename T>
+    Vector3<T> sum(const Vector3SoAView<T> &points, unsigned threads = 0);
+    template <typename T>
+    Vector3<T> sum(const Vector3<T> *points, std::size_t count, unsigned threads = 0);
+    template <typename T>
+    Vector3<T> sum(const StridedView<Vector3<T>> &points, unsigned threads = 0);
+
+    // Returns zero for an empty input
+    template <typename T>
+    Vector3<T> centroid(const Vector3SoAView<T> &points, unsigned threads = 0);
+    template <typename T>
+    Vector3<T> centroid(const Vector3<T> *points, std::size_t count, unsigned threads = 0);
+    template <typename T>
+    Vector3<T> centroid(const StridedView<Vector3<T>> &points, unsigned threads = 0);
+
+    // Returns Bounds3<T>::empty() for an empty input
+    template <typename T>
+    Bounds3<T> bounds(const Vector3SoAView<T> &points, unsigned threads = 0);
+    template <typename T>
+    Bounds3<T> bounds(const Vector3<T> *points, std::size_t count, unsigned threads = 0);
+    template <typename T>
+    Bounds3<T> bounds(const StridedView<Vector3<T>> &points, unsigned threads = 0);
+
+} // namespace lumina
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <lumina/vector/vector3.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace lumina
+{
+
+    // Non-owning structure-of-arrays views consumed by the batch kernels
+    template <typename T>
+    struct Vector3SoAView
+    {
+        const T *x;
+        const T *y;
+        const T *z;
+        std::size_t count;
+    };
+
+    template <typename T>
+    struct Vector3SoARef
+    {
+        T *x;
+        T *y;
+        T *z;
+        std::size_t count;
+    };
+
+    // Owning structure-of-arrays storage for Vector3
+    template <typename T>
+    class Vector3SoA
+    {
+    public:
+        // Member variables
+        std::vector<T> x, y, z;
+
+        // Constructors
+        Vector3SoA();
+        explicit Vector3SoA(std::size_t count);
+        Vector3SoA(const Vector3<T> *vectors, std::size_t count);
+
+        // Element access
+        Vector3<T> get(std::size_t index) const;
+        void set(std::size_t index, const Vector3<T> &vector);
+
+        // Size management
+        std::size_t size() const;
+        bool empty() const;
+        void resize(std::size_t count);
+        void reserve(std::size_t count);
+        void clear();
+        void push_back(const Vector3<T> &vector);
+
+        // Views
+        Vector3SoAView<T> view() const;
+        Vector3SoARef<T> ref();
+
+        // AoS conversion
+        void toAoS(Vector3<T> *out) const;
+    };
+
+} // namespace lumina
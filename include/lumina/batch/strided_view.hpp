@@ -0,0 +1,149 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace lumina
+{
+
+    // Non-owning views over vectors embedded in interleaved buffers: element i lives at
+    // base + i * stride. Used by the batch kernels in place of copying positions out of vertex buffers.
+    // The buffer must hold a V at every element (for Vector3<float>, three consecutive floats)
+    // and be suitably aligned; StridedView reads, StridedRef also writes.
+
+    template <typename V>
+    class StridedIterator
+    {
+    public:
+        using Byte = std::conditional_t<std::is_const_v<V>, const std::byte, std::byte>;
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<V>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V *;
+        using reference = V &;
+
+        // Member variables
+        Byte *address = nullptr;
+        std::ptrdiff_t stride = 0;
+
+        // Constructors
+        StridedIterator() = default;
+        StridedIterator(Byte *address, std::ptrdiff_t stride) : address(address), stride(stride) {}
+
+        // Element access
+        V &operator*() const { return *reinterpret_cast<V *>(address); }
+        V *operator->() const { return reinterpret_cast<V *>(address); }
+        V &operator[](std::ptrdiff_t n) const { return *reinterpret_cast<V *>(address + n * stride); }
+
+        // Traversal
+        StridedIterator &operator++() { address += stride; return *this; }
+        StridedIterator &operator--() { address -= stride; return *this; }
+        StridedIterator operator++(int) { StridedIterator old = *this; address += stride; return old; }
+        StridedIterator operator--(int) { StridedIterator old = *this; address -= stride; return old; }
+        StridedIterator &operator+=(std::ptrdiff_t n) { address += n * stride; return *this; }
+        StridedIterator &operator-=(std::ptrdiff_t n) { address -= n * stride; return *this; }
+        StridedIterator operator+(std::ptrdiff_t n) const { return {address + n * stride, stride}; }
+        StridedIterator operator-(std::ptrdiff_t n) const { return {address - n * stride, stride}; }
+        friend StridedIterator operator+(std::ptrdiff_t n, const StridedIterator &it) { return it + n; }
+        std::ptrdiff_t operator-(const StridedIterator &other) const { return (address - other.address) / stride; }
+
+        // Comparison operators
+        bool operator==(const StridedIterator &other) const { return address == other.address; }
+        std::strong_ordering operator<=>(const StridedIterator &other) const { return address <=> other.address; }
+    };
+
+    template <typename V, typename Element>
+    class StridedBase
+    {
+    public:
+        using Byte = typename StridedIterator<Element>::Byte;
+        using Void = std::conditional_t<std::is_const_v<Element>, const void, void>;
+
+        // Member variables
+        Byte *base = nullptr;
+        std::size_t stride = sizeof(V);
+        std::size_t count = 0;
+
+        // Constructors
+        StridedBase() = default;
+        StridedBase(Element *data, std::size_t count) : base(reinterpret_cast<Byte *>(data)), count(count) {}
+
+        // `offset` is the byte offset of the first vector inside buffer (e.g. offsetof the position attribute)
+        StridedBase(Void *buffer, std::size_t count, std::size_t stride, std::size_t offset = 0)
+            : base(static_cast<Byte *>(buffer) + offset), stride(stride), count(count)
+        {
+            if (stride < sizeof(V) || stride % alignof(V) != 0 ||
+                reinterpret_cast<std::uintptr_t>(base) % alignof(V) != 0)
+                throw std::invalid_argument("Strided view stride or offset does not fit the element type");
+        }
+
+        // Element access
+        Element &operator[](std::size_t index) const { return *reinterpret_cast<Element *>(base + index * stride); }
+
+        // Properties
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        bool isContiguous() const { return stride == sizeof(V); }
+
+        // Iteration
+        StridedIterator<Element> begin() const { return {base, std::ptrdiff_t(stride)}; }
+        StridedIterator<Element> end() const { return {base + count * stride, std::ptrdiff_t(stride)}; }
+
+    protected:
+        // Elements [first, first + length) must lie inside the view
+        void checkSubview(std::size_t first, std::size_t length) const
+        {
+            if (first > count || length > count - first)
+                throw std::out_of_range("Strided subview out of range");
+        }
+    };
+
+    template <typename V>
+    class StridedView : public StridedBase<V, const V>
+    {
+    public:
+        using StridedBase<V, const V>::StridedBase;
+
+        StridedView subview(std::size_t first, std::size_t length) const
+        {
+            this->checkSubview(first, length);
+            StridedView view = *this;
+            view.base += first * this->stride;
+            view.count = length;
+            return view;
+        }
+    };
+
+    template <typename V>
+    class StridedRef : public StridedBase<V, V>
+    {
+    public:
+        using StridedBase<V, V>::StridedBase;
+
+        StridedRef subview(std::size_t first, std::size_t length) const
+        {
+            this->checkSubview(first, length);
+            StridedRef ref = *this;
+            ref.base += first * this->stride;
+            ref.count = length;
+            return ref;
+        }
+
+        StridedView<V> view() const
+        {
+            StridedView<V> view;
+            view.base = this->base;
+            view.stride = this->stride;
+            view.count = this->count;
+            return view;
+        }
+
+        operator StridedView<V>() const { return view(); }
+    };
+
+} // namespace lumina
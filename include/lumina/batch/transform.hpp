@@ -0,0 +1,23 @@
+#pragma once
+
+#include <lumina/batch/math.hpp>
+#include <lumina/matrix/matrix4.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <cstddef>
+
+namespace lumina
+{
+
+    // out[i] = matrix * in[i]; `in` and `out` must not overlap
+    template <typename T>
+    void transformBatch(const Matrix4<T> &matrix, const Vector4<T> *in, Vector4<T> *out, std::size_t count,
+                        StoreMode mode = StoreMode::Auto, unsigned threads = 0);
+
+    // out[i] = in[i].normalized(), zero vectors staying zero; `in` and `out` must not overlap
+    template <typename T>
+    void normalizeBatch(const Vector3<T> *in, Vector3<T> *out, std::size_t count,
+                        MathAccuracy accuracy = MathAccuracy::Precise, StoreMode mode = StoreMode::Auto,
+                        unsigned threads = 0);
+
+} // namespace lumina
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lumina
+{
+
+    // Lock-free accumulation into shared vectors.
+    // atomicAdd updates each component with its own compare-and-swap loop, so concurrent adds never
+    // lose a contribution, but a reader racing with them may see a vector with only some components
+    // updated. Memory order is relaxed: publish the results with a join or another synchronization.
+
+    template <typename T>
+    inline void atomicAdd(T &target, T value)
+    {
+        std::atomic_ref<T> ref(target);
+        T expected = ref.load(std::memory_order_relaxed);
+        while (!ref.compare_exchange_weak(expected, expected + value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    template <typename T>
+    inline void atomicAdd(Vector2<T> &target, const Vector2<T> &value)
+    {
+        atomicAdd(target.x, value.x);
+        atomicAdd(target.y, value.y);
+    }
+
+    template <typename T>
+    inline void atomicAdd(Vector3<T> &target, const Vector3<T> &value)
+    {
+        atomicAdd(target.x, value.x);
+        atomicAdd(target.y, value.y);
+        atomicAdd(target.z, value.z);
+    }
+
+    template <typename T>
+    inline void atomicAdd(Vector4<T> &target, const Vector4<T> &value)
+    {
+        atomicAdd(target.x, value.x);
+        atomicAdd(target.y, value.y);
+        atomicAdd(target.z, value.z);
+        atomicAdd(target.w, value.w);
+    }
+
+    // Per-thread buffered scatter-add.
+    // Producers append (index, value) pairs to their own slot with no synchronization at all; merge()
+    // then adds them into the targets in a second pass where each thread owns a disjoint index range.
+    // Contributions to one target are summed in slot order, then insertion order, so the result is
+    // bit-identical from run to run regardless of thread timing.
+    template <typename T>
+    class BufferedScatterAdd
+    {
+    public:
+        struct Entry
+        {
+            std::uint32_t index;
+            Vector3<T> value;
+        };
+
+        // Number of index ranges the buffers are bucketed into, which bounds merge parallelism
+        static constexpr std::size_t BucketCount = 64;
+
+        // Member variables
+        std::size_t targetCount;
+        unsigned slotCount;
+        std::size_t bucketWidth;
+        // buckets[slot * BucketCount + index / bucketWidth]
+        std::vector<std::vector<Entry>> buckets;
+
+        // Constructors
+        BufferedScatterAdd(std::size_t targetCount, unsigned slotCount);
+
+        // Size management
+        std::size_t size() const;
+        bool empty() const;
+        void clear();
+
+        // Accumulation; each slot may only be used by one thread at a time
+        void add(unsigned slot, std::uint32_t index, const Vector3<T> &value);
+
+        // Adds every buffered contribution into targets[0, targetCount) and clears the buffers
+        void merge(Vector3<T> *targets, unsigned threads = 0);
+    };
+
+} // namespace lumina
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <lumina/curve/cubic_spline.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace lumina
+{
+
+    // Cumulative arc length of a spline sampled at uniform parameter steps,
+    // used to move along the curve at constant speed
+    template <typename V>
+    class ArcLengthTable
+    {
+    public:
+        using Scalar = typename CubicSpline<V>::Scalar;
+
+        // Member variables
+        // lengths[i] is the arc length from u = 0 to u = i * step
+        std::vector<Scalar> lengths;
+        Scalar step;
+
+        // Constructors
+        ArcLengthTable();
+        ArcLengthTable(const CubicSpline<V> &spline, std::size_t samplesPerSegment = 16);
+
+        // Table queries; out-of-range arguments clamp to the table, NaN throws std::invalid_argument
+        Scalar totalLength() const;
+        Scalar lengthAt(Scalar u) const;
+        Scalar parameterAt(Scalar distance) const;
+
+        // Batch reparameterization; ascending distances are resolved with a moving cursor
+        void parametersAt(const Scalar *distances, std::size_t count, Scalar *out) const;
+    };
+
+} // namespace lumina
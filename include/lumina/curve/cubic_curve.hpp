@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+
+namespace lumina
+{
+
+    // Single cubic segment over Vector2, Vector3 or Vector4, stored in power basis
+    // p(t) = ((a * t + b) * t + c) * t + d so evaluation is three multiply-adds per component.
+    template <typename V>
+    class CubicCurve
+    {
+    public:
+        using Scalar = decltype(V::x);
+        static constexpr std::size_t Dimension = sizeof(V) / sizeof(Scalar);
+
+        // Member variables
+        V a, b, c, d;
+
+        // Constructors
+        CubicCurve();
+        CubicCurve(const V &a, const V &b, const V &c, const V &d);
+
+        // Evaluation
+        V evaluate(Scalar t) const;
+        V derivative(Scalar t) const;
+        V secondDerivative(Scalar t) const;
+
+        // Batch evaluation at many parameter values
+        void evaluate(const Scalar *t, std::size_t count, V *out) const;
+        void derivative(const Scalar *t, std::size_t count, V *out) const;
+
+        // Static constructors from control data
+        static CubicCurve bezier(const V &p0, const V &p1, const V &p2, const V &p3);
+        static CubicCurve hermite(const V &p0, const V &m0, const V &p1, const V &m1);
+        // Uniform Catmull-Rom segment from p1 to p2; tension scales the tangents (0.5 is the classic spline)
+        static CubicCurve catmullRom(const V &p0, const V &p1, const V &p2, const V &p3, Scalar tension = Scalar(0.5));
+    };
+
+} // namespace lumina
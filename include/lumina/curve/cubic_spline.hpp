@@ -0,0 +1,45 @@
+#pragma once
+
+#include <lumina/curve/cubic_curve.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace lumina
+{
+
+    // Piecewise cubic curve. The global parameter u runs over [0, segmentCount()],
+    // segment i covering [i, i + 1]; values outside are clamped and NaN throws std::invalid_argument.
+    template <typename V>
+    class CubicSpline
+    {
+    public:
+        using Scalar = typename CubicCurve<V>::Scalar;
+
+        // Member variables
+        std::vector<CubicCurve<V>> segments;
+
+        // Constructors
+        CubicSpline();
+        explicit CubicSpline(std::vector<CubicCurve<V>> segments);
+
+        // Spline properties
+        std::size_t segmentCount() const;
+
+        // Evaluation
+        V evaluate(Scalar u) const;
+        V derivative(Scalar u) const;
+
+        // Batch evaluation; runs of parameters that fall in the same segment are evaluated in SIMD,
+        // so sorted input is fastest
+        void evaluate(const Scalar *u, std::size_t count, V *out) const;
+        void derivative(const Scalar *u, std::size_t count, V *out) const;
+
+        // Static constructors from control data
+        // Passes through every point; end tangents come from reflected neighbours
+        static CubicSpline catmullRom(const V *points, std::size_t count, Scalar tension = Scalar(0.5));
+        // count must be 3 * segments + 1, consecutive segments share an end point
+        static CubicSpline bezier(const V *controlPoints, std::size_t count);
+        static CubicSpline hermite(const V *points, const V *tangents, std::size_t count);
+    };
+
+} // namespace lumina
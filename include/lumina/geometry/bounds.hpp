@@ -0,0 +1,45 @@
+#pragma once
+
+#include <lumina/vector/vector3.hpp>
+
+namespace lumina
+{
+
+    // Axis-aligned bounding box
+    template <typename T>
+    class Bounds3
+    {
+    public:
+        // Member variables
+        Vector3<T> min, max;
+
+        // Constructors
+        Bounds3();
+        Bounds3(const Vector3<T> &min, const Vector3<T> &max);
+
+        // Comparison operators
+        bool operator==(const Bounds3 &other) const;
+        bool operator!=(const Bounds3 &other) const;
+
+        // Bounds properties
+        bool isEmpty() const;
+        Vector3<T> center() const;
+        Vector3<T> size() const;
+        Vector3<T> extents() const;
+
+        // Queries
+        bool contains(const Vector3<T> &point) const;
+        bool overlaps(const Bounds3 &other) const;
+
+        // Growth
+        void encapsulate(const Vector3<T> &point);
+        void encapsulate(const Bounds3 &other);
+
+        // Static predefined bounds
+        static Bounds3 empty();
+
+        // Static bounds operations
+        static Bounds3 merge(const Bounds3 &a, const Bounds3 &b);
+    };
+
+} // namespace lumina
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <lumina/geometry/plane.hpp>
+
+namespace lumina
+{
+
+    // Convex volume bounded by six inward facing planes.
+    template <typename T>
+    class Frustum
+    {
+    public:
+        enum Side
+        {
+            Left = 0,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+            PlaneCount
+        };
+
+        // Member variables
+        Plane<T> planes[PlaneCount];
+
+        // Constructors
+        Frustum();
+        Frustum(const Plane<T> &left, const Plane<T> &right,
+                const Plane<T> &bottom, const Plane<T> &top,
+                const Plane<T> &near, const Plane<T> &far);
+
+        // Array-style access operators
+        Plane<T> &operator[](int index);
+        const Plane<T> &operator[](int index) const;
+
+        // Containment tests
+        bool containsPoint(const Vector3<T> &point) const;
+        bool intersectsSphere(const Vector3<T> &center, const T radius) const;
+    };
+
+} // namespace lumina
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <lumina/batch/predicates.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lumina
+{
+
+    // Batch 2D queries. Mask outputs follow batch/predicates.hpp: element i maps to bit (i % 64) of
+    // masks[i / 64], with maskWordCount(count) words written.
+
+    // Convex hull with Andrew's monotone chain, counter-clockwise from the lowest (x, y) point.
+    // Collinear and duplicate points are dropped. Each thread builds the hull of its share of the
+    // points, and the hull of those partial hulls is the result, so it does not depend on the
+    // thread count. Points must be finite.
+    template <typename T>
+    std::vector<Vector2<T>> convexHull(const Vector2<T> *points, std::size_t count, unsigned threads = 0);
+
+    // Nonzero-winding test of every point against one closed polygon (vertices in either order,
+    // the last edge joins the back vertex to the front one). Points on an edge may land on either side.
+    template <typename T>
+    void insidePolygon(const Vector2<T> *points, std::size_t count, const Vector2<T> *polygon,
+                       std::size_t vertexCount, std::uint64_t *masks, unsigned threads = 0);
+
+    // Closed segments [p0, p1] and [q0, q1] share at least one point, touching and collinear
+    // overlaps included
+    template <typename T>
+    bool segmentsIntersect(const Vector2<T> &p0, const Vector2<T> &p1, const Vector2<T> &q0, const Vector2<T> &q1);
+
+    // Crossing point of non-parallel segments; returns false when they are parallel or do not meet
+    template <typename T>
+    bool segmentIntersection(const Vector2<T> &p0, const Vector2<T> &p1, const Vector2<T> &q0, const Vector2<T> &q1,
+                             Vector2<T> &point);
+
+    // Element-wise segmentsIntersect(p0[i], p1[i], q0[i], q1[i])
+    template <typename T>
+    void segmentsIntersect(const Vector2<T> *p0, const Vector2<T> *p1, const Vector2<T> *q0, const Vector2<T> *q1,
+                           std::size_t count, std::uint64_t *masks);
+
+} // namespace lumina
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <lumina/vector/vector3.hpp>
+
+namespace lumina
+{
+
+    // Plane defined by dot(normal, p) + distance = 0.
+    // Points with a positive signed distance lie on the side the normal points to.
+    template <typename T>
+    class Plane
+    {
+    public:
+        // Member variables
+        Vector3<T> normal;
+        T distance;
+
+        // Constructors
+        Plane();
+        Plane(const Vector3<T> &normal, const T distance);
+        Plane(const Vector3<T> &normal, const Vector3<T> &point);
+        Plane(const T a, const T b, const T c, const T d);
+
+        // Comparison operators
+        bool operator==(const Plane &other) const;
+        bool operator!=(const Plane &other) const;
+
+        // Plane properties
+        Plane normalized() const;
+        Plane flipped() const;
+        T signedDistance(const Vector3<T> &point) const;
+        Vector3<T> closestPoint(const Vector3<T> &point) const;
+
+        // Static plane operations
+        static Plane fromPoints(const Vector3<T> &a, const Vector3<T> &b, const Vector3<T> &c);
+    };
+
+} // namespace lumina
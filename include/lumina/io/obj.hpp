@@ -0,0 +1,38 @@
+#pragma once
+
+#include <lumina/batch/soa.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lumina
+{
+
+    // Vertex attributes of a Wavefront OBJ file in file order.
+    // Faces, groups, materials and every other statement are skipped.
+    template <typename T>
+    struct ObjVertices
+    {
+        // `v x y z`; an optional w or trailing vertex colour is ignored
+        std::vector<Vector3<T>> positions;
+        // `vn x y z`
+        std::vector<Vector3<T>> normals;
+        // `vt u [v]`; a missing v is 0
+        std::vector<Vector2<T>> texcoords;
+    };
+
+    // Large inputs are parsed in parallel, line-aligned chunks. A vertex statement with missing or
+    // malformed numbers throws std::invalid_argument naming its line; readObjFile throws
+    // std::runtime_error when the file cannot be read.
+    template <typename T>
+    ObjVertices<T> readObj(std::string_view text, unsigned threads = 0);
+    template <typename T>
+    ObjVertices<T> readObjFile(const std::string &path, unsigned threads = 0);
+
+    // Positions only, written straight into SoA storage
+    template <typename T>
+    void readObjPositions(std::string_view text, Vector3SoA<T> &positions, unsigned threads = 0);
+
+} // namespace lumina
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <lumina/batch/soa.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lumina
+{
+
+    // Vertex positions of a PLY file in ascii, binary_little_endian or binary_big_endian format.
+    // x, y and z may have any PLY scalar type and are converted to T; other properties and elements
+    // are skipped. ASCII vertex lines are parsed in parallel chunks and binary vertices in parallel
+    // index ranges. A malformed header or body throws std::invalid_argument; the file variants throw
+    // std::runtime_error when the file cannot be read. `positions` is replaced.
+    template <typename T>
+    void readPly(std::string_view data, std::vector<Vector3<T>> &positions, unsigned threads = 0);
+    template <typename T>
+    void readPly(std::string_view data, Vector3SoA<T> &positions, unsigned threads = 0);
+    template <typename T>
+    void readPlyFile(const std::string &path, std::vector<Vector3<T>> &positions, unsigned threads = 0);
+    template <typename T>
+    void readPlyFile(const std::string &path, Vector3SoA<T> &positions, unsigned threads = 0);
+
+} // namespace lumina
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <lumina/batch/soa.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lumina
+{
+
+    // Delimited text input: every non-blank line holds one vector in its first 2 or 3 fields,
+    // separated by any mix of spaces, tabs and commas; further fields on the line are ignored.
+    // Blank lines and lines starting with '#' are skipped. Large inputs are parsed in parallel,
+    // line-aligned chunks. A malformed line throws std::invalid_argument naming its line number.
+    // `out` is replaced.
+    template <typename T>
+    void parseVectors(std::string_view text, std::vector<Vector2<T>> &out, unsigned threads = 0);
+    template <typename T>
+    void parseVectors(std::string_view text, std::vector<Vector3<T>> &out, unsigned threads = 0);
+    template <typename T>
+    void parseVectors(std::string_view text, Vector3SoA<T> &out, unsigned threads = 0);
+
+    // Appends one line per vector, with the shortest representation that parses back to the same value
+    template <typename T>
+    void formatVectors(const Vector2<T> *vectors, std::size_t count, std::string &out, char separator = ' ');
+    template <typename T>
+    void formatVectors(const Vector3<T> *vectors, std::size_t count, std::string &out, char separator = ' ');
+
+} // namespace lumina
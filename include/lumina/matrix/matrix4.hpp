@@ -0,0 +1,63 @@
+#pragma once
+
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+
+namespace lumina
+{
+
+    // 4x4 matrix stored column-major: columns[c] is column c, columns[3] holds the translation.
+    // Matrices multiply column vectors from the left, so (a * b) * v applies b first.
+    template <typename T>
+    class Matrix4
+    {
+    public:
+        // Member variables
+        Vector4<T> columns[4];
+
+        // Constructors
+        // Identity
+        Matrix4();
+        Matrix4(const Vector4<T> &c0, const Vector4<T> &c1, const Vector4<T> &c2, const Vector4<T> &c3);
+
+        // Arithmetic operators
+        Matrix4 operator*(const Matrix4 &other) const;
+        Vector4<T> operator*(const Vector4<T> &vector) const;
+        Matrix4 &operator*=(const Matrix4 &other);
+
+        // Comparison operators
+        bool operator==(const Matrix4 &other) const;
+        bool operator!=(const Matrix4 &other) const;
+
+        // Column access
+        Vector4<T> &operator[](int column);
+        const Vector4<T> &operator[](int column) const;
+
+        // Element access
+        T &operator()(int row, int column);
+        const T &operator()(int row, int column) const;
+
+        // Pointer access to data, 16 values column by column
+        T *data();
+        const T *data() const;
+
+        // Transforms a point (w = 1) or a direction (w = 0); the projective row is ignored
+        Vector3<T> transformPoint(const Vector3<T> &point) const;
+        Vector3<T> transformVector(const Vector3<T> &vector) const;
+
+        Matrix4 transposed() const;
+
+        // Static predefined matrices
+        static Matrix4 identity();
+        static Matrix4 translation(const Vector3<T> &offset);
+        static Matrix4 scale(const Vector3<T> &factors);
+        // Rotation by a unit quaternion stored as (x, y, z, w)
+        static Matrix4 rotation(const Vector4<T> &quaternion);
+        // translation * rotation * scale
+        static Matrix4 trs(const Vector3<T> &offset, const Vector4<T> &quaternion, const Vector3<T> &factors);
+
+        // True when every element differs by at most epsilon
+        static bool approxEqual(const Matrix4 &a, const Matrix4 &b, T epsilon);
+    };
+
+} // namespace lumina
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <lumina/batch/math.hpp>
+#include <lumina/batch/strided_view.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lumina
+{
+
+    // Meshes are indexed triangle lists: triangle t uses vertices indices[3t], indices[3t + 1], indices[3t + 2].
+
+    enum class NormalWeighting
+    {
+        // Face normals weighted by triangle area
+        Area,
+        // Face normals weighted by the corner angle at the vertex
+        Angle
+    };
+
+    // Vertex to triangle-corner adjacency in compressed rows: the corners (3 * triangle + k)
+    // touching vertex v are corners[offsets[v]] .. corners[offsets[v + 1] - 1], in ascending order.
+    // Build it once per topology and reuse it every frame the positions change.
+    class VertexFaceAdjacency
+    {
+    public:
+        // Member variables
+        std::vector<std::uint32_t> offsets;
+        std::vector<std::uint32_t> corners;
+
+        // Constructors
+        VertexFaceAdjacency() = default;
+        VertexFaceAdjacency(const std::uint32_t *indices, std::size_t triangleCount, std::size_t vertexCount);
+
+        std::size_t vertexCount() const;
+    };
+
+    // Per-triangle normals; unnormalized normals have twice the triangle area as length.
+    // `mode` selects regular or non-temporal stores for the normals, as for transformBatch.
+    template <typename T>
+    void faceNormals(const Vector3<T> *positions, const std::uint32_t *indices, std::size_t triangleCount,
+                     Vector3<T> *normals, bool normalize = true, StoreMode mode = StoreMode::Auto,
+                     unsigned threads = 0);
+
+    // Unit vertex normals gathered per vertex through the adjacency, so no two threads write the same vertex.
+    // Vertices without a non-degenerate triangle get a zero normal.
+    template <typename T>
+    void vertexNormals(const Vector3<T> *positions, const std::uint32_t *indices, std::size_t triangleCount,
+                       const VertexFaceAdjacency &adjacency, Vector3<T> *normals,
+                       NormalWeighting weighting = NormalWeighting::Area, StoreMode mode = StoreMode::Auto,
+                       unsigned threads = 0);
+
+    // Branchless orthonormal basis around unit normals (Frisvad, revised by Duff et al.)
+    template <typename T>
+    void orthonormalBasis(const Vector3<T> *normals, std::size_t count, Vector3<T> *tangents, Vector3<T> *bitangents);
+
+    // Per-vertex tangent frames from texture coordinates: xyz is the tangent, Gram-Schmidt orthogonalized
+    // against the normal, and w = +-1 the handedness, so bitangent = cross(normal, tangent) * w.
+    // Vertices whose UV mapping is degenerate fall back to the orthonormalBasis tangent.
+    template <typename T>
+    void vertexTangents(const Vector3<T> *positions, const Vector3<T> *normals, const Vector2<T> *uvs,
+                        const std::uint32_t *indices, std::size_t triangleCount,
+                        const VertexFaceAdjacency &adjacency, Vector4<T> *tangents, unsigned threads = 0);
+
+    // Strided overloads read and write vertex attributes in place inside interleaved vertex buffers.
+    // Per-vertex views must hold at least adjacency.vertexCount() elements and basis views the same count.
+    // Strided outputs share cache lines with the other attributes and are always written regularly.
+    template <typename T>
+    void faceNormals(const StridedView<Vector3<T>> &positions, const std::uint32_t *indices,
+                     std::size_t triangleCount, Vector3<T> *normals, bool normalize = true,
+                     StoreMode mode = StoreMode::Auto, unsigned threads = 0);
+    template <typename T>
+    void vertexNormals(const StridedView<Vector3<T>> &positions, const std::uint32_t *indices,
+                       std::size_t triangleCount, const VertexFaceAdjacency &adjacency,
+                       const StridedRef<Vector3<T>> &normals, NormalWeighting weighting = NormalWeighting::Area,
+                       unsigned threads = 0);
+    template <typename T>
+    void orthonormalBasis(const StridedView<Vector3<T>> &normals, const StridedRef<Vector3<T>> &tangents,
+                          const StridedRef<Vector3<T>> &bitangents);
+    template <typename T>
+    void vertexTangents(const StridedView<Vector3<T>> &positions, const StridedView<Vector3<T>> &normals,
+                        const StridedView<Vector2<T>> &uvs, const std::uint32_t *indices, std::size_t triangleCount,
+                        const VertexFaceAdjacency &adjacency, const StridedRef<Vector4<T>> &tangents,
+                        unsigned threads = 0);
+
+} // namespace lumina
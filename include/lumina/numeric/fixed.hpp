@@ -0,0 +1,312 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace lumina
+{
+
+    namespace detail
+    {
+        __extension__ typedef __int128 Int128;
+        __extension__ typedef unsigned __int128 UInt128;
+
+        // Integers twice as wide as Raw, so products and shifted dividends are exact
+        template <typename Raw>
+        struct WideInt;
+
+        template <>
+        struct WideInt<std::int32_t>
+        {
+            using type = std::int64_t;
+            using unsignedType = std::uint64_t;
+        };
+
+        template <>
+        struct WideInt<std::int64_t>
+        {
+            using type = Int128;
+            using unsignedType = UInt128;
+        };
+
+        template <typename Raw, typename Wide>
+        constexpr Raw saturate(Wide value)
+        {
+            if (value > Wide(std::numeric_limits<Raw>::max()))
+                return std::numeric_limits<Raw>::max();
+            if (value < Wide(std::numeric_limits<Raw>::min()))
+                return std::numeric_limits<Raw>::min();
+            return Raw(value);
+        }
+
+        // floor(sqrt(value)), one result bit per step
+        template <typename U>
+        constexpr U isqrtBits(U value)
+        {
+            U result = 0;
+            U bit = U(1) << (sizeof(U) * 8 - 2);
+            while (bit > value)
+                bit >>= 2;
+            while (bit != 0)
+            {
+                if (value >= result + bit)
+                {
+                    value -= result + bit;
+                    result = (result >> 1) + bit;
+                }
+                else
+                {
+                    result >>= 1;
+                }
+                bit >>= 2;
+            }
+            return result;
+        }
+
+        // atan(2^-i) in Q32.32
+        inline constexpr std::int64_t AtanTableQ32[33] = {
+            3373259426, 1991351318, 1052175346, 534100635, 268086748, 134174063, 67103403,
+            33553749, 16777131, 8388597, 4194303, 2097152, 1048576, 524288, 262144, 131072,
+            65536, 32768, 16384, 8192, 4096, 2048, 1024, 512, 256, 128, 64, 32, 16, 8, 4, 2, 1};
+
+        inline constexpr std::int64_t PiQ32 = 13493037705;
+
+        // acos of a Q32.32 value in [-1, 1], in Q32.32 radians: CORDIC vectoring on (cos, sin)
+        constexpr std::int64_t acosQ32(std::int64_t c)
+        {
+            std::int64_t x = c < 0 ? -c : c;
+            std::int64_t y = std::int64_t(isqrtBits((UInt128(1) << 64) - UInt128(x) * UInt128(x)));
+            std::int64_t angle = 0;
+            for (int i = 0; i < 33; ++i)
+            {
+                std::int64_t dx = y >> i, dy = x >> i;
+                if (y > 0)
+                {
+                    x += dx;
+                    y -= dy;
+                    angle += AtanTableQ32[i];
+                }
+                else
+                {
+                    x -= dx;
+                    y += dy;
+                    angle -= AtanTableQ32[i];
+                }
+            }
+            return c < 0 ? PiQ32 - angle : angle;
+        }
+    } // namespace detail
+
+    // floor(sqrt(value)) in integer arithmetic
+    constexpr std::uint64_t isqrt(std::uint64_t value)
+    {
+        if (value == 0)
+            return 0;
+        // Start at the highest even bit position at or below the leading one
+        std::uint64_t result = 0;
+        std::uint64_t bit = std::uint64_t(1) << ((std::bit_width(value) - 1) & ~1);
+        while (bit != 0)
+        {
+            if (value >= result + bit)
+            {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            }
+            else
+            {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return result;
+    }
+
+    // Signed fixed-point number: Raw holds the value scaled by 2^FractionBits.
+    // Every operation is integer-only, so results are bit-identical across compilers and instruction sets.
+    // Arithmetic saturates at the representable range instead of wrapping; products round toward
+    // negative infinity, quotients toward zero, and division by zero saturates by the sign of the
+    // dividend (0 / 0 is 0).
+    template <typename Raw, int FractionBits>
+    class Fixed
+    {
+    public:
+        static_assert(std::is_same_v<Raw, std::int32_t> || std::is_same_v<Raw, std::int64_t>,
+                      "Fixed is defined over int32_t and int64_t");
+        static_assert(FractionBits > 0 && FractionBits < int(sizeof(Raw) * 8) - 1, "Invalid fraction width");
+
+        using RawType = Raw;
+        static constexpr int fractionBits = FractionBits;
+
+        // Member variables
+        Raw raw;
+
+        // Constructors
+        constexpr Fixed() : raw(0) {}
+        // Saturates outside the integer range
+        template <std::integral I>
+        constexpr Fixed(I value);
+        // Rounds to nearest (ties away from zero) and saturates; NaN converts to 0
+        template <std::floating_point F>
+        explicit Fixed(F value);
+
+        static constexpr Fixed fromRaw(Raw raw);
+
+        // Conversions
+        template <std::floating_point F>
+        explicit operator F() const;
+        // Rounds toward negative infinity
+        constexpr Raw toInt() const { return raw >> FractionBits; }
+
+        // Arithmetic operators
+        constexpr Fixed operator+(Fixed other) const;
+        constexpr Fixed operator-(Fixed other) const;
+        constexpr Fixed operator*(Fixed other) const;
+        constexpr Fixed operator/(Fixed other) const;
+
+        // Unary operators
+        constexpr Fixed operator+() const { return *this; }
+        constexpr Fixed operator-() const;
+
+        // Compound assignment operators
+        constexpr Fixed &operator+=(Fixed other) { return *this = *this + other; }
+        constexpr Fixed &operator-=(Fixed other) { return *this = *this - other; }
+        constexpr Fixed &operator*=(Fixed other) { return *this = *this * other; }
+        constexpr Fixed &operator/=(Fixed other) { return *this = *this / other; }
+
+        // Comparison operators
+        constexpr bool operator==(const Fixed &other) const = default;
+        constexpr auto operator<=>(const Fixed &other) const = default;
+
+        // Limits
+        static constexpr Fixed max() { return fromRaw(std::numeric_limits<Raw>::max()); }
+        static constexpr Fixed min() { return fromRaw(std::numeric_limits<Raw>::min()); }
+        static constexpr Fixed epsilon() { return fromRaw(1); }
+
+    private:
+        using Wide = typename detail::WideInt<Raw>::type;
+        using UWide = typename detail::WideInt<Raw>::unsignedType;
+    };
+
+    // Q16.16 and Q32.32
+    using Fixed16 = Fixed<std::int32_t, 16>;
+    using Fixed32 = Fixed<std::int64_t, 32>;
+
+    template <typename Raw, int FractionBits>
+    template <std::integral I>
+    constexpr Fixed<Raw, FractionBits>::Fixed(I value) : raw(0)
+    {
+        constexpr Raw limit = std::numeric_limits<Raw>::max() >> FractionBits;
+        if (std::cmp_greater(value, limit))
+            raw = std::numeric_limits<Raw>::max();
+        else if (std::cmp_less(value, -limit - 1))
+            raw = std::numeric_limits<Raw>::min();
+        else
+            raw = Raw(Raw(value) * (Raw(1) << FractionBits));
+    }
+
+    template <typename Raw, int FractionBits>
+    template <std::floating_point F>
+    Fixed<Raw, FractionBits>::Fixed(F value) : raw(0)
+    {
+        double scaled = std::round(std::ldexp(double(value), FractionBits));
+        if (scaled != scaled)
+            raw = 0;
+        else if (scaled >= double(std::numeric_limits<Raw>::max()))
+            raw = std::numeric_limits<Raw>::max();
+        else if (scaled <= double(std::numeric_limits<Raw>::min()))
+            raw = std::numeric_limits<Raw>::min();
+        else
+            raw = Raw(scaled);
+    }
+
+    template <typename Raw, int FractionBits>
+    constexpr Fixed<Raw, FractionBits> Fixed<Raw, FractionBits>::fromRaw(Raw raw)
+    {
+        Fixed result;
+        result.raw = raw;
+        return result;
+    }
+
+    template <typename Raw, int FractionBits>
+    template <std::floating_point F>
+    Fixed<Raw, FractionBits>::operator F() const
+    {
+        return F(std::ldexp(double(raw), -FractionBits));
+    }
+
+    template <typename Raw, int FractionBits>
+    constexpr Fixed<Raw, FractionBits> Fixed<Raw, FractionBits>::operator+(Fixed other) const
+    {
+        return fromRaw(detail::saturate<Raw>(Wide(raw) + other.raw));
+    }
+
+    template <typename Raw, int FractionBits>
+    constexpr Fixed<Raw, FractionBits> Fixed<Raw, FractionBits>::operator-(Fixed other) const
+    {
+        return fromRaw(detail::saturate<Raw>(Wide(raw) - other.raw));
+    }
+
+    template <typename Raw, int FractionBits>
+    constexpr Fixed<Raw, FractionBits> Fixed<Raw, FractionBits>::operator*(Fixed other) const
+    {
+        return fromRaw(detail::saturate<Raw>((Wide(raw) * other.raw) >> FractionBits));
+    }
+
+    template <typename Raw, int FractionBits>
+    constexpr Fixed<Raw, FractionBits> Fixed<Raw, FractionBits>::operator/(Fixed other) const
+    {
+        if (other.raw == 0)
+            return raw > 0 ? max() : (raw < 0 ? min() : Fixed());
+        return fromRaw(detail::saturate<Raw>(Wide(raw) * (Wide(1) << FractionBits) / other.raw));
+    }
+
+    template <typename Raw, int FractionBits>
+    constexpr Fixed<Raw, FractionBits> Fixed<Raw, FractionBits>::operator-() const
+    {
+        return fromRaw(detail::saturate<Raw>(-Wide(raw)));
+    }
+
+    // Saturates, so abs(min()) is max()
+    template <typename Raw, int FractionBits>
+    constexpr Fixed<Raw, FractionBits> abs(Fixed<Raw, FractionBits> value)
+    {
+        return value.raw < 0 ? -value : value;
+    }
+
+    // Rounds toward zero; negative inputs give 0
+    template <typename Raw, int FractionBits>
+    constexpr Fixed<Raw, FractionBits> sqrt(Fixed<Raw, FractionBits> value)
+    {
+        using UWide = typename detail::WideInt<Raw>::unsignedType;
+        if (value.raw <= 0)
+            return Fixed<Raw, FractionBits>();
+        return Fixed<Raw, FractionBits>::fromRaw(Raw(detail::isqrtBits(UWide(value.raw) << FractionBits)));
+    }
+
+    // Radians in [0, pi], accurate to about 2^-30; the input is clamped to [-1, 1]
+    template <typename Raw, int FractionBits>
+    constexpr Fixed<Raw, FractionBits> acos(Fixed<Raw, FractionBits> value)
+    {
+        constexpr Raw one = Raw(1) << FractionBits;
+        Raw c = value.raw < -one ? -one : (value.raw > one ? one : value.raw);
+        std::int64_t angle;
+        if constexpr (FractionBits <= 32)
+        {
+            angle = detail::acosQ32(std::int64_t(c) * (std::int64_t(1) << (32 - FractionBits)));
+            if constexpr (FractionBits < 32)
+                angle = (angle + (std::int64_t(1) << (31 - FractionBits))) >> (32 - FractionBits);
+        }
+        else
+        {
+            angle = detail::acosQ32(c >> (FractionBits - 32)) << (FractionBits - 32);
+        }
+        return Fixed<Raw, FractionBits>::fromRaw(Raw(angle));
+    }
+
+} // namespace lumina
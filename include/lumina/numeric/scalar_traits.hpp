@@ -0,0 +1,145 @@
+#pragma once
+
+#include <lumina/numeric/fixed.hpp>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace lumina
+{
+
+    namespace detail
+    {
+        // Arithmetic through the type's own operators: IEEE for floating point, saturating for Fixed
+        template <typename T>
+        struct OperatorArithmetic
+        {
+            static T add(T a, T b) { return a + b; }
+            static T sub(T a, T b) { return a - b; }
+            static T mul(T a, T b) { return a * b; }
+            static T div(T a, T b) { return a / b; }
+            static T negate(T value) { return -value; }
+        };
+    } // namespace detail
+
+    // Scalar functions behind the vector classes' arithmetic, magnitude, angle and abs.
+    // Floating-point types forward to <cmath>; integer and fixed-point types stay in integer
+    // arithmetic, so their results are exact and identical on every platform.
+    template <typename T>
+    struct ScalarTraits : detail::OperatorArithmetic<T>
+    {
+        static T sqrt(T value) { return std::sqrt(value); }
+        static T acos(T value) { return std::acos(value); }
+        static T abs(T value) { return std::abs(value); }
+        static bool approxEqual(T a, T b, T epsilon) { return std::abs(a - b) <= epsilon; }
+
+        // sqrt of the sum of squares, summed left to right like the hand-written expression
+        template <typename... C>
+        static T length(C... components) { return std::sqrt((... + (components * components))); }
+    };
+
+    // add, sub, mul and negate wrap around in two's complement like the int batch kernels, and
+    // min / -1 gives min; division by zero stays undefined. abs saturates, so abs(min) is max, like
+    // the batch absSaturate. Square roots round down and negative inputs give 0. length() sums exact
+    // squares in a wider integer and saturates the result, so it never overflows. There is no acos:
+    // integer vectors have no normalized() or angle().
+    template <std::integral T>
+    struct ScalarTraits<T>
+    {
+        static T add(T a, T b) { return T(Wrap(a) + Wrap(b)); }
+        static T sub(T a, T b) { return T(Wrap(a) - Wrap(b)); }
+        static T mul(T a, T b) { return T(Wrap(a) * Wrap(b)); }
+        static T div(T a, T b)
+        {
+            if constexpr (std::is_signed_v<T>)
+            {
+                if (b == T(-1))
+                    return negate(a);
+            }
+            return a / b;
+        }
+        static T negate(T value) { return T(Wrap(0) - Wrap(value)); }
+
+        static T sqrt(T value) { return value <= 0 ? T(0) : T(isqrt(std::uint64_t(value))); }
+        static T abs(T value)
+        {
+            if constexpr (std::is_signed_v<T>)
+            {
+                if (value == std::numeric_limits<T>::min())
+                    return std::numeric_limits<T>::max();
+                return value < 0 ? T(-value) : value;
+            }
+            else
+                return value;
+        }
+
+        // Compares the exact distance, which may not fit in T
+        static bool approxEqual(T a, T b, T epsilon)
+        {
+            if (epsilon < T(0))
+                return false;
+            Wrap distance = a < b ? Wrap(b) - Wrap(a) : Wrap(a) - Wrap(b);
+            return distance <= Wrap(epsilon);
+        }
+
+        template <typename... C>
+        static T length(C... components)
+        {
+            using Wide = std::conditional_t<sizeof(T) <= 4, std::uint64_t, detail::UInt128>;
+            Wide sum = 0;
+            for (Wide c : {magnitudeOf<Wide>(components)...})
+                sum = sum + c * c < sum ? ~Wide(0) : sum + c * c;
+            Wide root;
+            if constexpr (sizeof(T) <= 4)
+                root = isqrt(sum);
+            else
+                root = detail::isqrtBits(sum);
+            return root > Wide(std::numeric_limits<T>::max()) ? std::numeric_limits<T>::max() : T(root);
+        }
+
+    private:
+        // Unsigned arithmetic of at least int's width, where overflow is defined
+        using Wrap = std::common_type_t<std::make_unsigned_t<T>, unsigned>;
+
+        template <typename Wide>
+        static Wide magnitudeOf(T value)
+        {
+            if constexpr (std::is_signed_v<T>)
+                return value < 0 ? Wide(0) - Wide(value) : Wide(value);
+            else
+                return Wide(value);
+        }
+    };
+
+    // length() takes the square root of the exact sum of squared raw values, so it neither loses
+    // the fraction bits of the squares nor saturates before the final result does.
+    template <typename Raw, int FractionBits>
+    struct ScalarTraits<Fixed<Raw, FractionBits>> : detail::OperatorArithmetic<Fixed<Raw, FractionBits>>
+    {
+        using T = Fixed<Raw, FractionBits>;
+
+        static T sqrt(T value) { return lumina::sqrt(value); }
+        static T acos(T value) { return lumina::acos(value); }
+        static T abs(T value) { return lumina::abs(value); }
+        // The saturated difference exceeds any epsilon below max() whenever the true one does
+        static bool approxEqual(T a, T b, T epsilon) { return lumina::abs(a - b) <= epsilon; }
+
+        template <typename... C>
+        static T length(C... components)
+        {
+            using UWide = typename detail::WideInt<Raw>::unsignedType;
+            UWide sum = 0;
+            for (Raw raw : {components.raw...})
+            {
+                UWide c = raw < 0 ? UWide(0) - UWide(raw) : UWide(raw);
+                UWide square = c * c;
+                sum = sum + square < sum ? ~UWide(0) : sum + square;
+            }
+            UWide root = detail::isqrtBits(sum);
+            return root > UWide(std::numeric_limits<Raw>::max()) ? T::max() : T::fromRaw(Raw(root));
+        }
+    };
+
+} // namespace lumina
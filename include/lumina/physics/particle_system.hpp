@@ -0,0 +1,65 @@
+#pragma once
+
+#include <lumina/batch/soa.hpp>
+#include <lumina/batch/strided_view.hpp>
+#include <lumina/geometry/bounds.hpp>
+#include <cstddef>
+
+namespace lumina
+{
+
+    enum class Integrator
+    {
+        SemiImplicitEuler,
+        // Velocity Verlet in kick-drift-kick form
+        Verlet,
+        RungeKutta4
+    };
+
+    enum class BoundaryMode
+    {
+        None,
+        // Positions are clamped to the bounds and the outward velocity component is removed
+        Clamp,
+        // Positions are mirrored back inside and the normal velocity is reflected, scaled by restitution
+        Reflect
+    };
+
+    // Particles stored as SoA buffers and advanced by one fused pass over memory per step.
+    // The acceleration of a particle is acceleration + accelerations[i] - drag * velocity;
+    // the per-particle term is optional and ignored while `accelerations` is empty.
+    template <typename T>
+    class ParticleSystem
+    {
+    public:
+        // Member variables
+        Vector3SoA<T> positions;
+        Vector3SoA<T> velocities;
+        Vector3SoA<T> accelerations;
+        Vector3<T> acceleration;
+        T drag;
+        Bounds3<T> bounds;
+        BoundaryMode boundaryMode;
+        T restitution;
+
+        // Constructors
+        ParticleSystem();
+        explicit ParticleSystem(std::size_t count);
+
+        // Size management
+        std::size_t size() const;
+        void resize(std::size_t count);
+        void add(const Vector3<T> &position, const Vector3<T> &velocity);
+
+        // Simulation
+        void step(T dt, Integrator integrator = Integrator::SemiImplicitEuler, unsigned threads = 0);
+
+        // Advances particles kept outside the system, e.g. position and velocity attributes of an
+        // interleaved vertex buffer, with this system's forces and boundaries. Per-particle
+        // accelerations are not applied; both views must have the same count.
+        void step(T dt, const StridedRef<Vector3<T>> &externalPositions,
+                  const StridedRef<Vector3<T>> &externalVelocities,
+                  Integrator integrator = Integrator::SemiImplicitEuler, unsigned threads = 0) const;
+    };
+
+} // namespace lumina
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace lumina
+{
+
+    // Philox4x32-10 counter-based generator.
+    // A block is a pure function of (seed, stream, counter, block index), so any part of a sequence
+    // can be generated independently: threads need no shared state and results do not depend on how
+    // the work is split. Streams with different ids never overlap.
+    class Philox4x32
+    {
+    public:
+        using Block = std::array<std::uint32_t, 4>;
+
+        // Member variables
+        std::uint64_t seed;
+        std::uint32_t stream;
+
+        // Constructors
+        Philox4x32();
+        explicit Philox4x32(std::uint64_t seed, std::uint32_t stream = 0);
+
+        // Generation; the 128-bit Philox counter is (counter, stream, block) from the low word up
+        Block generate(std::uint64_t counter, std::uint32_t block = 0) const;
+    };
+
+} // namespace lumina
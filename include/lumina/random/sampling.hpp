@@ -0,0 +1,56 @@
+#pragma once
+
+#include <lumina/batch/math.hpp>
+#include <lumina/geometry/bounds.hpp>
+#include <lumina/random/philox.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace lumina
+{
+
+    enum class HemisphereDistribution
+    {
+        Uniform,
+        // Density proportional to the cosine of the angle to +Z
+        Cosine
+    };
+
+    // Batch samplers on Philox4x32, using direct inverse-CDF mappings instead of rejection loops.
+    // out[i] depends only on the generator and counter `offset + i`: calls covering disjoint offset
+    // ranges never repeat a sample, and the output is the same for every thread count.
+    // Uniform variates lie in [0, 1) with 24 (float) or 53 (double) random bits.
+
+    template <typename T>
+    void sampleUniform(const Philox4x32 &rng, std::uint64_t offset, T *out, std::size_t count, unsigned threads = 0);
+
+    // Uniform directions on the unit sphere
+    template <typename T>
+    void sampleSphere(const Philox4x32 &rng, std::uint64_t offset, Vector3<T> *out, std::size_t count,
+                      MathAccuracy accuracy = MathAccuracy::Precise, unsigned threads = 0);
+
+    // Uniform points inside the unit sphere; the radius is the largest of three uniforms,
+    // whose distribution r^3 is exactly that of the unit ball
+    template <typename T>
+    void sampleBall(const Philox4x32 &rng, std::uint64_t offset, Vector3<T> *out, std::size_t count,
+                    MathAccuracy accuracy = MathAccuracy::Precise, unsigned threads = 0);
+
+    // Directions on the unit hemisphere around +Z
+    template <typename T>
+    void sampleHemisphere(const Philox4x32 &rng, std::uint64_t offset, Vector3<T> *out, std::size_t count,
+                          HemisphereDistribution distribution = HemisphereDistribution::Uniform,
+                          MathAccuracy accuracy = MathAccuracy::Precise, unsigned threads = 0);
+
+    // Uniform points inside the unit disk
+    template <typename T>
+    void sampleDisk(const Philox4x32 &rng, std::uint64_t offset, Vector2<T> *out, std::size_t count,
+                    MathAccuracy accuracy = MathAccuracy::Precise, unsigned threads = 0);
+
+    // Uniform points inside the box; throws std::invalid_argument for empty bounds
+    template <typename T>
+    void sampleBox(const Philox4x32 &rng, std::uint64_t offset, const Bounds3<T> &bounds, Vector3<T> *out,
+                   std::size_t count, unsigned threads = 0);
+
+} // namespace lumina
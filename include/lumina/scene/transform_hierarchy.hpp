@@ -0,0 +1,65 @@
+#pragma once
+
+#include <lumina/matrix/matrix4.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lumina
+{
+
+    // Transform hierarchy in flat arrays indexed by node, cached world matrices and dirty tracking.
+    // Nodes are appended depth-first: a new node's parent is the last node added or one of its
+    // ancestors (or NoParent for a new root). Every subtree is then the contiguous range
+    // [node, node + subtreeSizes[node]), so update() recomputes only the subtrees under nodes
+    // changed since the last update, each as one forward sweep.
+    // Edit local transforms through the setters, or call markDirty after writing the arrays.
+    template <typename T>
+    class TransformHierarchy
+    {
+    public:
+        static constexpr std::size_t NoParent = ~std::size_t(0);
+
+        // Member variables
+        std::vector<std::size_t> parents;
+        std::vector<std::size_t> subtreeSizes;
+        std::vector<Vector3<T>> translations;
+        // Unit quaternions (x, y, z, w)
+        std::vector<Vector4<T>> rotations;
+        std::vector<Vector3<T>> scales;
+        // parent world * translation * rotation * scale, valid after update()
+        std::vector<Matrix4<T>> worlds;
+        // Nodes changed since the last update, each listed once
+        std::vector<std::size_t> dirtyNodes;
+        std::vector<std::uint8_t> dirtyFlags;
+
+        // Constructors
+        TransformHierarchy();
+
+        // Size management
+        std::size_t size() const;
+        void reserve(std::size_t count);
+        // Returns the new node's index; throws std::invalid_argument when the order above is violated
+        std::size_t add(std::size_t parent, const Vector3<T> &translation = Vector3<T>(0),
+                        const Vector4<T> &rotation = Vector4<T>(0, 0, 0, 1), const Vector3<T> &scale = Vector3<T>(1));
+
+        // Local transform edits; each marks the node dirty
+        void setTranslation(std::size_t node, const Vector3<T> &translation);
+        void setRotation(std::size_t node, const Vector4<T> &rotation);
+        void setScale(std::size_t node, const Vector3<T> &scale);
+        void setLocal(std::size_t node, const Vector3<T> &translation, const Vector4<T> &rotation,
+                      const Vector3<T> &scale);
+        void markDirty(std::size_t node);
+
+        // Recomputes the world matrices of dirty nodes and their descendants, independent subtrees
+        // in parallel, and returns how many nodes were recomputed
+        std::size_t update(unsigned threads = 0);
+
+        // World-space queries, valid after update()
+        const Matrix4<T> &world(std::size_t node) const;
+        Vector3<T> worldPosition(std::size_t node) const;
+    };
+
+} // namespace lumina
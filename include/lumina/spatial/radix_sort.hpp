@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lumina
+{
+
+    // Stable LSD radix sort of 64-bit keys with 8-bit digits.
+    // Keys are sorted in place and permutation[i] receives the original index of the i-th sorted key.
+    // Only the low `keyBits` bits are considered; passes whose digit is shared by every key are skipped.
+    void radixSort(std::uint64_t *keys, std::uint32_t *permutation, std::size_t count,
+                   unsigned threads = 0, int keyBits = 64);
+
+    // out[i] = in[permutation[i]]
+    template <typename T>
+    void applyPermutation(const std::uint32_t *permutation, const T *in, T *out, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = in[permutation[i]];
+    }
+
+} // namespace lumina
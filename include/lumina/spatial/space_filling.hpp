@@ -0,0 +1,67 @@
+#pragma once
+
+#include <lumina/batch/soa.hpp>
+#include <lumina/batch/strided_view.hpp>
+#include <lumina/geometry/bounds.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lumina
+{
+
+    enum class SpaceFillingCurve
+    {
+        Morton,
+        Hilbert
+    };
+
+    // Scalar encoding of grid coordinates.
+    // 2D codes use 32 bits per axis, 3D codes use the low 21 bits per axis.
+    std::uint64_t mortonEncode2(std::uint32_t x, std::uint32_t y);
+    std::uint64_t mortonEncode3(std::uint32_t x, std::uint32_t y, std::uint32_t z);
+    void mortonDecode2(std::uint64_t code, std::uint32_t &x, std::uint32_t &y);
+    void mortonDecode3(std::uint64_t code, std::uint32_t &x, std::uint32_t &y, std::uint32_t &z);
+    std::uint64_t hilbertEncode2(std::uint32_t x, std::uint32_t y);
+    std::uint64_t hilbertEncode3(std::uint32_t x, std::uint32_t y, std::uint32_t z);
+
+    // Batch code generation. Points are quantized onto the full grid spanned by the given bounds;
+    // points outside the bounds are clamped to its faces and NaN coordinates map to the minimum cell.
+    template <typename T>
+    void spaceFillingCodes(const Vector3<T> *points, std::size_t count, const Bounds3<T> &bounds,
+                           std::uint64_t *codes, SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+                           unsigned threads = 0);
+    template <typename T>
+    void spaceFillingCodes(const Vector3SoAView<T> &points, const Bounds3<T> &bounds,
+                           std::uint64_t *codes, SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+                           unsigned threads = 0);
+    template <typename T>
+    void spaceFillingCodes(const Vector2<T> *points, std::size_t count, const Vector2<T> &min,
+                           const Vector2<T> &max, std::uint64_t *codes,
+                           SpaceFillingCurve curve = SpaceFillingCurve::Morton, unsigned threads = 0);
+    template <typename T>
+    void spaceFillingCodes(const StridedView<Vector3<T>> &points, const Bounds3<T> &bounds,
+                           std::uint64_t *codes, SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+                           unsigned threads = 0);
+    template <typename T>
+    void spaceFillingCodes(const StridedView<Vector2<T>> &points, const Vector2<T> &min, const Vector2<T> &max,
+                           std::uint64_t *codes, SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+                           unsigned threads = 0);
+
+    // Reorders the points along the curve (bounds are computed from the data) and returns
+    // the permutation, so attached attributes can follow with applyPermutation().
+    template <typename T>
+    std::vector<std::uint32_t> spatialSort(Vector3<T> *points, std::size_t count,
+                                           SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+                                           unsigned threads = 0);
+    template <typename T>
+    std::vector<std::uint32_t> spatialSort(Vector3SoA<T> &points,
+                                           SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+                                           unsigned threads = 0);
+    template <typename T>
+    std::vector<std::uint32_t> spatialSort(Vector2<T> *points, std::size_t count,
+                                           SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+                                           unsigned threads = 0);
+
+} // namespace lumina
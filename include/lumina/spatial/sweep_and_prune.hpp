@@ -0,0 +1,54 @@
+#pragma once
+
+#include <lumina/batch/soa.hpp>
+#include <lumina/geometry/bounds.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lumina
+{
+
+    // Indices of two overlapping boxes, first < second
+    struct OverlapPair
+    {
+        std::uint32_t first, second;
+    };
+
+    // Sweep-and-prune broadphase over axis-aligned boxes kept in SoA form.
+    // Each findPairs call sweeps along the axis with the largest variance of box centers. The box
+    // order along that axis is kept between calls and repaired with insertion sort, which is close
+    // to linear while boxes move coherently from frame to frame; changing the axis or heavy
+    // reshuffling falls back to a full sort. Candidates along the sweep are tested on the other two
+    // axes several boxes at a time with SIMD compares.
+    // Touching boxes overlap, as in Bounds3::overlaps; boxes must have min <= max on every axis.
+    template <typename T>
+    class SweepAndPrune
+    {
+    public:
+        // Member variables
+        // Box corners by box index; may be written directly between findPairs calls
+        Vector3SoA<T> minimums, maximums;
+        // Box indices sorted by minimum along `axis` (0 = x, 1 = y, 2 = z) as of the last findPairs
+        std::vector<std::uint32_t> order;
+        int axis;
+        // Scratch: corners in sweep order with the axes rotated so the sweep axis is x,
+        // padded for full SIMD loads
+        Vector3SoA<T> sortedMinimums, sortedMaximums;
+
+        // Constructors
+        SweepAndPrune();
+
+        // Box management
+        std::size_t size() const;
+        std::uint32_t add(const Bounds3<T> &box);
+        void set(std::uint32_t index, const Bounds3<T> &box);
+        Bounds3<T> get(std::uint32_t index) const;
+        void clear();
+
+        // Replaces `pairs` with every overlapping pair. The result is ordered by the sweep and
+        // independent of the thread count.
+        void findPairs(std::vector<OverlapPair> &pairs, unsigned threads = 0);
+    };
+
+} // namespace lumina
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <lumina/batch/strided_view.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lumina
+{
+
+    template <typename T>
+    struct WeldResult
+    {
+        // First occurrence of every distinct vertex, in input order
+        std::vector<Vector3<T>> vertices;
+        // remap[i] is the index into `vertices` that input vertex i was merged into
+        std::vector<std::uint32_t> remap;
+    };
+
+    // Merges vertices that are Vector3::approxEqual within epsilon, in linear expected time.
+    // Each vertex joins the first kept vertex it matches, in input order, so the result is
+    // deterministic and independent of the thread count. Matches are searched in parallel; only
+    // resolving them into kept vertices runs on the calling thread.
+    // epsilon = 0 merges exact duplicates only (0 and -0 compare equal).
+    template <typename T>
+    WeldResult<T> weldVertices(const Vector3<T> *vertices, std::size_t count, T epsilon, unsigned threads = 0);
+    // Welds the position attribute of an interleaved vertex buffer in place of a position array
+    template <typename T>
+    WeldResult<T> weldVertices(const StridedView<Vector3<T>> &vertices, T epsilon, unsigned threads = 0);
+
+} // namespace lumina
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <concepts>
+
 namespace lumina
 {
 
@@ -49,8 +51,9 @@ namespace lumina
         T *data();
         const T *data() const;
 
-        // Vector properties
-        Vector2 normalized() const;
+        // Vector properties; integer vectors have no unit length, so normalized, normalize and
+        // angle exist only for floating-point and fixed-point components
+        Vector2 normalized() const requires(!std::integral<T>);
         T magnitude() const;
         T sqrMagnitude() const;
 
@@ -63,16 +66,21 @@ namespace lumina
         static Vector2 right();
 
         // Static vector operations
-        static T angle(const Vector2 &a, const Vector2 &b);
+        static T angle(const Vector2 &a, const Vector2 &b) requires(!std::integral<T>);
         static T distance(const Vector2 &a, const Vector2 &b);
         static T dot(const Vector2 &a, const Vector2 &b);
+        // Perp-dot product a.x * b.y - a.y * b.x; positive when b turns counter-clockwise from a
+        static T cross(const Vector2 &a, const Vector2 &b);
         static Vector2 lerp(const Vector2 &a, const Vector2 &b, T t);
         static Vector2 reflect(const Vector2 &vector, const Vector2 &normal);
         static Vector2 min(const Vector2 &a, const Vector2 &b);
         static Vector2 max(const Vector2 &a, const Vector2 &b);
         static Vector2 clamp(const Vector2 &vector, const Vector2 &min, const Vector2 &max);
-        static Vector2 normalize(const Vector2 &vector);
+        static Vector2 normalize(const Vector2 &vector) requires(!std::integral<T>);
         static Vector2 abs(const Vector2 &vector);
+
+        // True when every component differs by at most epsilon
+        static bool approxEqual(const Vector2 &a, const Vector2 &b, T epsilon);
     };
 
 } // namespace lumina
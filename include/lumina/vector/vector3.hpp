@@ -1,5 +1,7 @@
 #pragma once
 
+#include <concepts>
+
 namespace lumina
 {
 
@@ -49,8 +51,9 @@ namespace lumina
         T *data();
         const T *data() const;
 
-        // Vector properties
-        Vector3 normalized() const;
+        // Vector properties; integer vectors have no unit length, so normalized, normalize and
+        // angle exist only for floating-point and fixed-point components
+        Vector3 normalized() const requires(!std::integral<T>);
         T magnitude() const;
         T sqrMagnitude() const;
 
@@ -65,7 +68,7 @@ namespace lumina
         static Vector3 back();
 
         // Static vector operations
-        static T angle(const Vector3 &a, const Vector3 &b);
+        static T angle(const Vector3 &a, const Vector3 &b) requires(!std::integral<T>);
         static T distance(const Vector3 &a, const Vector3 &b);
         static T dot(const Vector3 &a, const Vector3 &b);
         static Vector3 cross(const Vector3 &a, const Vector3 &b);
@@ -74,8 +77,11 @@ namespace lumina
         static Vector3 min(const Vector3 &a, const Vector3 &b);
         static Vector3 max(const Vector3 &a, const Vector3 &b);
         static Vector3 clamp(const Vector3 &vector, const Vector3 &min, const Vector3 &max);
-        static Vector3 normalize(const Vector3 &vector);
+        static Vector3 normalize(const Vector3 &vector) requires(!std::integral<T>);
         static Vector3 abs(const Vector3 &vector);
+
+        // True when every component differs by at most epsilon
+        static bool approxEqual(const Vector3 &a, const Vector3 &b, T epsilon);
     };
 
 } // namespace lumina
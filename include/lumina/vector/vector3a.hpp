@@ -0,0 +1,551 @@
+#pragma once
+
+#include <lumina/vector/vector3.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace lumina
+{
+
+    // Vector3 padded to four lanes and aligned to their size, so arrays of it never straddle a
+    // 16-byte (float) or 32-byte (double) boundary and every operation runs as one 4-wide SIMD op.
+    // The padding lane is zero after construction and unspecified after arithmetic; comparisons,
+    // reductions and element access ignore it.
+    // Unlike Vector3 the members are defined inline below, so values stay in registers across calls.
+    // Results match Vector3 bit for bit when the including code is compiled without floating-point
+    // contraction (-ffp-contract=off, as meson.build sets for the vector sources). GCC contracts by default
+    // once FMA is enabled (e.g. -march=haswell); cross and lerp then stay within 2 ulp of their
+    // largest product term and reflect within 3 ulp of its largest term. x87 builds round to extended
+    // precision and match neither bit for bit.
+    template <typename T>
+    class alignas(4 * sizeof(T)) Vector3A
+    {
+    public:
+        // Member variables
+        T x, y, z;
+        T pad;
+
+        // Constructors
+        Vector3A();
+        Vector3A(const T scalar);
+        Vector3A(const T x, const T y, const T z);
+        explicit Vector3A(const Vector3<T> &vector);
+
+        // Conversion
+        operator Vector3<T>() const;
+
+        // Arithmetic operators with another Vector3A
+        Vector3A operator+(const Vector3A &other) const;
+        Vector3A operator-(const Vector3A &other) const;
+        Vector3A operator*(const Vector3A &other) const;
+        Vector3A operator/(const Vector3A &other) const;
+
+        // Arithmetic operators with scalar
+        Vector3A operator+(T scalar) const;
+        Vector3A operator-(T scalar) const;
+        Vector3A operator*(T scalar) const;
+        Vector3A operator/(T scalar) const;
+
+        // Unary operators
+        Vector3A operator+() const;
+        Vector3A operator-() const;
+
+        // Compound assignment operators
+        Vector3A &operator+=(const Vector3A &other);
+        Vector3A &operator-=(const Vector3A &other);
+        Vector3A &operator*=(const Vector3A &other);
+        Vector3A &operator/=(const Vector3A &other);
+
+        // Comparison operators
+        bool operator==(const Vector3A &other) const;
+        bool operator!=(const Vector3A &other) const;
+
+        // Array-style access operators
+        T &operator[](int index);
+        const T &operator[](int index) const;
+
+        // Pointer access to data
+        T *data();
+        const T *data() const;
+
+        // Vector properties
+        Vector3A normalized() const;
+        T magnitude() const;
+        T sqrMagnitude() const;
+
+        // Static predefined vectors
+        static Vector3A zero();
+        static Vector3A one();
+        static Vector3A up();
+        static Vector3A down();
+        static Vector3A left();
+        static Vector3A right();
+        static Vector3A forward();
+        static Vector3A back();
+
+        // Static vector operations
+        static T angle(const Vector3A &a, const Vector3A &b);
+        static T distance(const Vector3A &a, const Vector3A &b);
+        static T dot(const Vector3A &a, const Vector3A &b);
+        static Vector3A cross(const Vector3A &a, const Vector3A &b);
+        static Vector3A lerp(const Vector3A &a, const Vector3A &b, T t);
+        static Vector3A reflect(const Vector3A &vector, const Vector3A &normal);
+        static Vector3A min(const Vector3A &a, const Vector3A &b);
+        static Vector3A max(const Vector3A &a, const Vector3A &b);
+        static Vector3A clamp(const Vector3A &vector, const Vector3A &min, const Vector3A &max);
+        static Vector3A normalize(const Vector3A &vector);
+        static Vector3A abs(const Vector3A &vector);
+
+        // True when every component differs by at most epsilon
+        static bool approxEqual(const Vector3A &a, const Vector3A &b, T epsilon);
+    };
+
+    namespace detail
+    {
+        // The four lanes of a Vector3A as one register. min/max follow std::min/std::max operand order
+        // (the first argument wins ties and NaNs), so results match Vector3 lane for lane.
+        template <typename T>
+        struct Quad
+        {
+            T v[4];
+
+            static Quad load(const Vector3A<T> &a) { return {{a.x, a.y, a.z, a.pad}}; }
+            static Quad broadcast(T s) { return {{s, s, s, s}}; }
+            void store(Vector3A<T> &a) const
+            {
+                a.x = v[0];
+                a.y = v[1];
+                a.z = v[2];
+                a.pad = v[3];
+            }
+
+            template <typename Op>
+            Quad map(Quad o, Op op) const
+            {
+                return {{op(v[0], o.v[0]), op(v[1], o.v[1]), op(v[2], o.v[2]), op(v[3], o.v[3])}};
+            }
+
+            Quad operator+(Quad o) const { return map(o, [](T a, T b) { return a + b; }); }
+            Quad operator-(Quad o) const { return map(o, [](T a, T b) { return a - b; }); }
+            Quad operator*(Quad o) const { return map(o, [](T a, T b) { return a * b; }); }
+            Quad operator/(Quad o) const { return map(o, [](T a, T b) { return a / b; }); }
+            Quad operator-() const { return {{-v[0], -v[1], -v[2], -v[3]}}; }
+
+            // (y, z, x, pad)
+            Quad yzx() const { return {{v[1], v[2], v[0], v[3]}}; }
+            T sum3() const { return v[0] + v[1] + v[2]; }
+            bool equal3(Quad o) const { return v[0] == o.v[0] && v[1] == o.v[1] && v[2] == o.v[2]; }
+            bool lessEqual3(Quad o) const { return v[0] <= o.v[0] && v[1] <= o.v[1] && v[2] <= o.v[2]; }
+        };
+
+        template <typename T>
+        inline Quad<T> min(Quad<T> a, Quad<T> b) { return a.map(b, [](T x, T y) { return std::min(x, y); }); }
+        template <typename T>
+        inline Quad<T> max(Quad<T> a, Quad<T> b) { return a.map(b, [](T x, T y) { return std::max(x, y); }); }
+        template <typename T>
+        inline Quad<T> abs(Quad<T> a) { return a.map(a, [](T x, T) { return std::abs(x); }); }
+
+#if defined(__SSE2__)
+        template <>
+        struct Quad<float>
+        {
+            __m128 v;
+
+            static Quad load(const Vector3A<float> &a) { return {_mm_load_ps(&a.x)}; }
+            static Quad broadcast(float s) { return {_mm_set1_ps(s)}; }
+            void store(Vector3A<float> &a) const { _mm_store_ps(&a.x, v); }
+
+            Quad operator+(Quad o) const { return {_mm_add_ps(v, o.v)}; }
+            Quad operator-(Quad o) const { return {_mm_sub_ps(v, o.v)}; }
+            Quad operator*(Quad o) const { return {_mm_mul_ps(v, o.v)}; }
+            Quad operator/(Quad o) const { return {_mm_div_ps(v, o.v)}; }
+            Quad operator-() const { return {_mm_xor_ps(v, _mm_set1_ps(-0.0f))}; }
+
+            Quad yzx() const { return {_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1))}; }
+            float sum3() const
+            {
+                __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+                __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+                return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(v, y), z));
+            }
+            bool equal3(Quad o) const { return (_mm_movemask_ps(_mm_cmpeq_ps(v, o.v)) & 7) == 7; }
+            bool lessEqual3(Quad o) const { return (_mm_movemask_ps(_mm_cmple_ps(v, o.v)) & 7) == 7; }
+        };
+
+        // minps/maxps return their second operand on ties and NaNs, hence the swapped arguments
+        inline Quad<float> min(Quad<float> a, Quad<float> b) { return {_mm_min_ps(b.v, a.v)}; }
+        inline Quad<float> max(Quad<float> a, Quad<float> b) { return {_mm_max_ps(b.v, a.v)}; }
+        inline Quad<float> abs(Quad<float> a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+#endif
+
+#if defined(__AVX2__)
+        template <>
+        struct Quad<double>
+        {
+            __m256d v;
+
+            static Quad load(const Vector3A<double> &a) { return {_mm256_load_pd(&a.x)}; }
+            static Quad broadcast(double s) { return {_mm256_set1_pd(s)}; }
+            void store(Vector3A<double> &a) const { _mm256_store_pd(&a.x, v); }
+
+            Quad operator+(Quad o) const { return {_mm256_add_pd(v, o.v)}; }
+            Quad operator-(Quad o) const { return {_mm256_sub_pd(v, o.v)}; }
+            Quad operator*(Quad o) const { return {_mm256_mul_pd(v, o.v)}; }
+            Quad operator/(Quad o) const { return {_mm256_div_pd(v, o.v)}; }
+            Quad operator-() const { return {_mm256_xor_pd(v, _mm256_set1_pd(-0.0))}; }
+
+            Quad yzx() const { return {_mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 0, 2, 1))}; }
+            double sum3() const
+            {
+                __m128d xy = _mm256_castpd256_pd128(v);
+                __m128d z = _mm256_extractf128_pd(v, 1);
+                return _mm_cvtsd_f64(_mm_add_sd(_mm_add_sd(xy, _mm_unpackhi_pd(xy, xy)), z));
+            }
+            bool equal3(Quad o) const { return (_mm256_movemask_pd(_mm256_cmp_pd(v, o.v, _CMP_EQ_OQ)) & 7) == 7; }
+            bool lessEqual3(Quad o) const { return (_mm256_movemask_pd(_mm256_cmp_pd(v, o.v, _CMP_LE_OQ)) & 7) == 7; }
+        };
+
+        inline Quad<double> min(Quad<double> a, Quad<double> b) { return {_mm256_min_pd(b.v, a.v)}; }
+        inline Quad<double> max(Quad<double> a, Quad<double> b) { return {_mm256_max_pd(b.v, a.v)}; }
+        inline Quad<double> abs(Quad<double> a) { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+#endif
+
+        template <typename T>
+        inline Quad<T> lanes(const Vector3A<T> &a)
+        {
+            return Quad<T>::load(a);
+        }
+
+        template <typename T>
+        inline Vector3A<T> fromLanes(Quad<T> q)
+        {
+            Vector3A<T> result;
+            q.store(result);
+            return result;
+        }
+
+    } // namespace detail
+
+    template <typename T>
+    Vector3A<T>::Vector3A() : x(T(0)), y(T(0)), z(T(0)), pad(T(0)) {}
+
+    template <typename T>
+    Vector3A<T>::Vector3A(const T scalar) : x(scalar), y(scalar), z(scalar), pad(T(0)) {}
+
+    template <typename T>
+    Vector3A<T>::Vector3A(const T x, const T y, const T z) : x(x), y(y), z(z), pad(T(0)) {}
+
+    template <typename T>
+    Vector3A<T>::Vector3A(const Vector3<T> &vector) : x(vector.x), y(vector.y), z(vector.z), pad(T(0)) {}
+
+    // Conversion
+    template <typename T>
+    Vector3A<T>::operator Vector3<T>() const
+    {
+        return Vector3<T>(x, y, z);
+    }
+
+    // Arithmetic operators with another Vector3A
+    template <typename T>
+    Vector3A<T> Vector3A<T>::operator+(const Vector3A &other) const
+    {
+        return detail::fromLanes(detail::lanes(*this) + detail::lanes(other));
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::operator-(const Vector3A &other) const
+    {
+        return detail::fromLanes(detail::lanes(*this) - detail::lanes(other));
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::operator*(const Vector3A &other) const
+    {
+        return detail::fromLanes(detail::lanes(*this) * detail::lanes(other));
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::operator/(const Vector3A &other) const
+    {
+        return detail::fromLanes(detail::lanes(*this) / detail::lanes(other));
+    }
+
+    // Arithmetic operators with scalar
+    template <typename T>
+    Vector3A<T> Vector3A<T>::operator+(T scalar) const
+    {
+        return detail::fromLanes(detail::lanes(*this) + detail::Quad<T>::broadcast(scalar));
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::operator-(T scalar) const
+    {
+        return detail::fromLanes(detail::lanes(*this) - detail::Quad<T>::broadcast(scalar));
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::operator*(T scalar) const
+    {
+        return detail::fromLanes(detail::lanes(*this) * detail::Quad<T>::broadcast(scalar));
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::operator/(T scalar) const
+    {
+        return detail::fromLanes(detail::lanes(*this) / detail::Quad<T>::broadcast(scalar));
+    }
+
+    // Unary operators
+    template <typename T>
+    Vector3A<T> Vector3A<T>::operator+() const
+    {
+        return *this;
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::operator-() const
+    {
+        return detail::fromLanes(-detail::lanes(*this));
+    }
+
+    // Compound assignment operators
+    template <typename T>
+    Vector3A<T> &Vector3A<T>::operator+=(const Vector3A &other)
+    {
+        (detail::lanes(*this) + detail::lanes(other)).store(*this);
+        return *this;
+    }
+
+    template <typename T>
+    Vector3A<T> &Vector3A<T>::operator-=(const Vector3A &other)
+    {
+        (detail::lanes(*this) - detail::lanes(other)).store(*this);
+        return *this;
+    }
+
+    template <typename T>
+    Vector3A<T> &Vector3A<T>::operator*=(const Vector3A &other)
+    {
+        (detail::lanes(*this) * detail::lanes(other)).store(*this);
+        return *this;
+    }
+
+    template <typename T>
+    Vector3A<T> &Vector3A<T>::operator/=(const Vector3A &other)
+    {
+        (detail::lanes(*this) / detail::lanes(other)).store(*this);
+        return *this;
+    }
+
+    // Comparison operators
+    template <typename T>
+    bool Vector3A<T>::operator==(const Vector3A &other) const
+    {
+        return detail::lanes(*this).equal3(detail::lanes(other));
+    }
+
+    template <typename T>
+    bool Vector3A<T>::operator!=(const Vector3A &other) const
+    {
+        return !(*this == other);
+    }
+
+    // Array-style access operators
+    template <typename T>
+    T &Vector3A<T>::operator[](int index)
+    {
+        if (index == 0)
+            return x;
+        else if (index == 1)
+            return y;
+        else if (index == 2)
+            return z;
+        else
+            throw std::out_of_range("Vector3A index out of range");
+    }
+
+    template <typename T>
+    const T &Vector3A<T>::operator[](int index) const
+    {
+        if (index == 0)
+            return x;
+        else if (index == 1)
+            return y;
+        else if (index == 2)
+            return z;
+        else
+            throw std::out_of_range("Vector3A index out of range");
+    }
+
+    // Pointer access to data
+    template <typename T>
+    T *Vector3A<T>::data()
+    {
+        return &x;
+    }
+
+    template <typename T>
+    const T *Vector3A<T>::data() const
+    {
+        return &x;
+    }
+
+    // Vector properties
+    template <typename T>
+    Vector3A<T> Vector3A<T>::normalized() const
+    {
+        T mag = magnitude();
+        if (mag == T(0))
+            return Vector3A(0);
+        return *this / mag;
+    }
+
+    template <typename T>
+    T Vector3A<T>::magnitude() const
+    {
+        return std::sqrt(sqrMagnitude());
+    }
+
+    template <typename T>
+    T Vector3A<T>::sqrMagnitude() const
+    {
+        detail::Quad<T> v = detail::lanes(*this);
+        return (v * v).sum3();
+    }
+
+    // Static predefined vectors
+    template <typename T>
+    Vector3A<T> Vector3A<T>::zero()
+    {
+        return Vector3A(0, 0, 0);
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::one()
+    {
+        return Vector3A(1, 1, 1);
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::up()
+    {
+        return Vector3A(0, 1, 0);
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::down()
+    {
+        return Vector3A(0, -1, 0);
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::left()
+    {
+        return Vector3A(-1, 0, 0);
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::right()
+    {
+        return Vector3A(1, 0, 0);
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::forward()
+    {
+        return Vector3A(0, 0, 1);
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::back()
+    {
+        return Vector3A(0, 0, -1);
+    }
+
+    // Static vector operations
+    template <typename T>
+    T Vector3A<T>::angle(const Vector3A &a, const Vector3A &b)
+    {
+        T dotProduct = dot(a.normalized(), b.normalized());
+        dotProduct = std::clamp(dotProduct, T(-1), T(1)); // Clamp for safety
+        return std::acos(dotProduct); // Returns radians
+    }
+
+    template <typename T>
+    T Vector3A<T>::distance(const Vector3A &a, const Vector3A &b)
+    {
+        return (a - b).magnitude();
+    }
+
+    template <typename T>
+    T Vector3A<T>::dot(const Vector3A &a, const Vector3A &b)
+    {
+        return (detail::lanes(a) * detail::lanes(b)).sum3();
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::cross(const Vector3A &a, const Vector3A &b)
+    {
+        // (a * b.yzx - a.yzx * b).yzx needs three shuffles instead of four
+        detail::Quad<T> va = detail::lanes(a), vb = detail::lanes(b);
+        return detail::fromLanes((va * vb.yzx() - va.yzx() * vb).yzx());
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::lerp(const Vector3A &a, const Vector3A &b, T t)
+    {
+        return a + (b - a) * t;
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::reflect(const Vector3A &vector, const Vector3A &normal)
+    {
+        // R = V - 2*(V·N)*N
+        T dotProduct = dot(vector, normal);
+        return vector - normal * (T(2) * dotProduct);
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::min(const Vector3A &a, const Vector3A &b)
+    {
+        return detail::fromLanes(detail::min(detail::lanes(a), detail::lanes(b)));
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::max(const Vector3A &a, const Vector3A &b)
+    {
+        return detail::fromLanes(detail::max(detail::lanes(a), detail::lanes(b)));
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::clamp(const Vector3A &vector, const Vector3A &minVec, const Vector3A &maxVec)
+    {
+        // std::clamp(v, lo, hi) == std::min(std::max(v, lo), hi), NaN included
+        detail::Quad<T> lower = detail::max(detail::lanes(vector), detail::lanes(minVec));
+        return detail::fromLanes(detail::min(lower, detail::lanes(maxVec)));
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::normalize(const Vector3A &vector)
+    {
+        return vector.normalized();
+    }
+
+    template <typename T>
+    Vector3A<T> Vector3A<T>::abs(const Vector3A &vector)
+    {
+        return detail::fromLanes(detail::abs(detail::lanes(vector)));
+    }
+
+    template <typename T>
+    bool Vector3A<T>::approxEqual(const Vector3A &a, const Vector3A &b, T epsilon)
+    {
+        return detail::abs(detail::lanes(a) - detail::lanes(b)).lessEqual3(detail::Quad<T>::broadcast(epsilon));
+    }
+
+} // namespace lumina
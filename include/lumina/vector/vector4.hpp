@@ -1,5 +1,7 @@
 #pragma once
 
+#include <concepts>
+
 namespace lumina
 {
 
@@ -49,8 +51,9 @@ namespace lumina
         T *data();
         const T *data() const;
 
-        // Vector properties
-        Vector4 normalized() const;
+        // Vector properties; integer vectors have no unit length, so normalized, normalize and
+        // angle exist only for floating-point and fixed-point components
+        Vector4 normalized() const requires(!std::integral<T>);
         T magnitude() const;
         T sqrMagnitude() const;
 
@@ -59,7 +62,7 @@ namespace lumina
         static Vector4 one();
 
         // Static vector operations
-        static T angle(const Vector4 &a, const Vector4 &b);
+        static T angle(const Vector4 &a, const Vector4 &b) requires(!std::integral<T>);
         static T distance(const Vector4 &a, const Vector4 &b);
         static T dot(const Vector4 &a, const Vector4 &b);
         static Vector4 lerp(const Vector4 &a, const Vector4 &b, T t);
@@ -67,8 +70,11 @@ namespace lumina
         static Vector4 min(const Vector4 &a, const Vector4 &b);
         static Vector4 max(const Vector4 &a, const Vector4 &b);
         static Vector4 clamp(const Vector4 &vector, const Vector4 &min, const Vector4 &max);
-        static Vector4 normalize(const Vector4 &vector);
+        static Vector4 normalize(const Vector4 &vector) requires(!std::integral<T>);
         static Vector4 abs(const Vector4 &vector);
+
+        // True when every component differs by at most epsilon
+        static bool approxEqual(const Vector4 &a, const Vector4 &b, T epsilon);
     };
 
 } // namespace lumina
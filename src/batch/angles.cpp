@@ -0,0 +1,262 @@
+#include <lumina/batch/angles.hpp>
+#include "../simd/simd_math.hpp"
+#include <stdexcept>
+
+namespace lumina
+{
+
+namespace
+{
+
+template <typename P>
+inline P halfPi()
+{
+    return P::broadcast(typename P::Scalar(1.57079632679489661923));
+}
+
+template <typename A, typename B>
+void checkCounts(const A &a, const B &b)
+{
+    if (a.count != b.count)
+        throw std::invalid_argument("Strided views differ in length");
+}
+
+// Kernels are written once against simd::loadComponent / storeComponent, which accept both
+// contiguous arrays and strided views
+
+// atan2(|a ^ b|, a . b), with |a ^ b|^2 summed over the wedge terms a_j b_k - a_k b_j (Lagrange's
+// identity; the 3D cross product, the 2D perp-dot). Those terms cancel for near-parallel inputs, so each
+// is a compensated difference of products; the dot product only cancels near pi/2, where that costs
+// an absolute error of about one ulp of the angle.
+template <std::size_t D, typename T, typename Source>
+void anglesImpl(const Source &a, const Source &b, T *out, std::size_t count, MathAccuracy accuracy)
+{
+    simd::forEachPack<T>(count, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+    {
+        P ak[D], bk[D];
+        for (std::size_t k = 0; k < D; ++k)
+        {
+            ak[k] = simd::loadComponent<P>(a, i, k);
+            bk[k] = simd::loadComponent<P>(b, i, k);
+        }
+
+        P zero = P::broadcast(T(0));
+        P dot = zero, sqrA = zero, sqrB = zero;
+        for (std::size_t k = 0; k < D; ++k)
+        {
+            dot = simd::fmadd(ak[k], bk[k], dot);
+            sqrA = simd::fmadd(ak[k], ak[k], sqrA);
+            sqrB = simd::fmadd(bk[k], bk[k], sqrB);
+        }
+
+        P wedgeLength;
+        if constexpr (D == 2)
+        {
+            wedgeLength = simd::abs(simd::differenceOfProducts(ak[0], bk[1], ak[1], bk[0]));
+        }
+        else
+        {
+            P sqrWedge = zero;
+            for (std::size_t j = 0; j < D; ++j)
+            {
+                for (std::size_t k = j + 1; k < D; ++k)
+                {
+                    P w = simd::differenceOfProducts(ak[j], bk[k], ak[k], bk[j]);
+                    sqrWedge = simd::fmadd(w, w, sqrWedge);
+                }
+            }
+            wedgeLength = simd::sqrt(sqrWedge);
+        }
+
+        auto degenerate = (sqrA == zero) | (sqrB == zero);
+        simd::select(degenerate, halfPi<P>(), simd::atan2<A>(wedgeLength, dot)).store(out + i);
+    });
+}
+
+template <typename T, typename Source, typename Target>
+void rotate2(const Source &in, const T *angles, const Target &out, std::size_t count, MathAccuracy accuracy)
+{
+    simd::forEachPack<T>(count, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+    {
+        P x = simd::loadComponent<P>(in, i, 0), y = simd::loadComponent<P>(in, i, 1);
+        P s, c;
+        simd::sincos<A>(P::load(angles + i), s, c);
+        simd::storeComponent(simd::fmadd(x, c, -(y * s)), out, i, 0);
+        simd::storeComponent(simd::fmadd(x, s, y * c), out, i, 1);
+    });
+}
+
+template <typename T, typename Source, typename Target>
+void rotate3(const Source &in, const Source &axes, const T *angles, const Target &out, std::size_t count,
+             MathAccuracy accuracy)
+{
+    simd::forEachPack<T>(count, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+    {
+        P vx = simd::loadComponent<P>(in, i, 0), vy = simd::loadComponent<P>(in, i, 1),
+          vz = simd::loadComponent<P>(in, i, 2);
+        P kx = simd::loadComponent<P>(axes, i, 0), ky = simd::loadComponent<P>(axes, i, 1),
+          kz = simd::loadComponent<P>(axes, i, 2);
+        P s, c;
+        simd::sincos<A>(P::load(angles + i), s, c);
+
+        // v' = v cos + (k x v) sin + k (k . v)(1 - cos)
+        P cx = simd::fmadd(ky, vz, -(kz * vy));
+        P cy = simd::fmadd(kz, vx, -(kx * vz));
+        P cz = simd::fmadd(kx, vy, -(ky * vx));
+        P along = simd::fmadd(kx, vx, simd::fmadd(ky, vy, kz * vz)) * (P::broadcast(T(1)) - c);
+
+        simd::storeComponent(simd::fmadd(vx, c, simd::fmadd(cx, s, kx * along)), out, i, 0);
+        simd::storeComponent(simd::fmadd(vy, c, simd::fmadd(cy, s, ky * along)), out, i, 1);
+        simd::storeComponent(simd::fmadd(vz, c, simd::fmadd(cz, s, kz * along)), out, i, 2);
+    });
+}
+
+template <typename T, typename Source>
+void toPolarImpl(const Source &in, T *radius, T *angle, std::size_t count, MathAccuracy accuracy)
+{
+    simd::forEachPack<T>(count, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+    {
+        P x = simd::loadComponent<P>(in, i, 0), y = simd::loadComponent<P>(in, i, 1);
+        simd::sqrt(simd::fmadd(x, x, y * y)).store(radius + i);
+        simd::atan2<A>(y, x).store(angle + i);
+    });
+}
+
+template <typename T, typename Target>
+void fromPolarImpl(const T *radius, const T *angle, const Target &out, std::size_t count, MathAccuracy accuracy)
+{
+    simd::forEachPack<T>(count, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+    {
+        P r = P::load(radius + i);
+        P s, c;
+        simd::sincos<A>(P::load(angle + i), s, c);
+        simd::storeComponent(r * c, out, i, 0);
+        simd::storeComponent(r * s, out, i, 1);
+    });
+}
+
+} // namespace
+
+// Contiguous arrays
+template <typename T>
+void angles(const Vector2<T> *a, const Vector2<T> *b, T *out, std::size_t count, MathAccuracy accuracy)
+{
+    anglesImpl<2>(a, b, out, count, accuracy);
+}
+
+template <typename T>
+void angles(const Vector3<T> *a, const Vector3<T> *b, T *out, std::size_t count, MathAccuracy accuracy)
+{
+    anglesImpl<3>(a, b, out, count, accuracy);
+}
+
+template <typename T>
+void angles(const Vector4<T> *a, const Vector4<T> *b, T *out, std::size_t count, MathAccuracy accuracy)
+{
+    anglesImpl<4>(a, b, out, count, accuracy);
+}
+
+template <typename T>
+void rotate(const Vector2<T> *in, const T *angles, Vector2<T> *out, std::size_t count, MathAccuracy accuracy)
+{
+    rotate2(in, angles, out, count, accuracy);
+}
+
+template <typename T>
+void rotate(const Vector3<T> *in, const Vector3<T> *axes, const T *angles, Vector3<T> *out,
+            std::size_t count, MathAccuracy accuracy)
+{
+    rotate3(in, axes, angles, out, count, accuracy);
+}
+
+template <typename T>
+void toPolar(const Vector2<T> *in, T *radius, T *angle, std::size_t count, MathAccuracy accuracy)
+{
+    toPolarImpl(in, radius, angle, count, accuracy);
+}
+
+template <typename T>
+void fromPolar(const T *radius, const T *angle, Vector2<T> *out, std::size_t count, MathAccuracy accuracy)
+{
+    fromPolarImpl(radius, angle, out, count, accuracy);
+}
+
+// Strided views
+template <typename T>
+void angles(const StridedView<Vector2<T>> &a, const StridedView<Vector2<T>> &b, T *out, MathAccuracy accuracy)
+{
+    checkCounts(a, b);
+    anglesImpl<2>(a, b, out, a.count, accuracy);
+}
+
+template <typename T>
+void angles(const StridedView<Vector3<T>> &a, const StridedView<Vector3<T>> &b, T *out, MathAccuracy accuracy)
+{
+    checkCounts(a, b);
+    anglesImpl<3>(a, b, out, a.count, accuracy);
+}
+
+template <typename T>
+void angles(const StridedView<Vector4<T>> &a, const StridedView<Vector4<T>> &b, T *out, MathAccuracy accuracy)
+{
+    checkCounts(a, b);
+    anglesImpl<4>(a, b, out, a.count, accuracy);
+}
+
+template <typename T>
+void rotate(const StridedView<Vector2<T>> &in, const T *angles, const StridedRef<Vector2<T>> &out,
+            MathAccuracy accuracy)
+{
+    checkCounts(in, out);
+    rotate2(in, angles, out, in.count, accuracy);
+}
+
+template <typename T>
+void rotate(const StridedView<Vector3<T>> &in, const StridedView<Vector3<T>> &axes, const T *angles,
+            const StridedRef<Vector3<T>> &out, MathAccuracy accuracy)
+{
+    checkCounts(in, axes);
+    checkCounts(in, out);
+    rotate3(in, axes, angles, out, in.count, accuracy);
+}
+
+template <typename T>
+void toPolar(const StridedView<Vector2<T>> &in, T *radius, T *angle, MathAccuracy accuracy)
+{
+    toPolarImpl(in, radius, angle, in.count, accuracy);
+}
+
+template <typename T>
+void fromPolar(const T *radius, const T *angle, const StridedRef<Vector2<T>> &out, MathAccuracy accuracy)
+{
+    fromPolarImpl(radius, angle, out, out.count, accuracy);
+}
+
+#define LUMINA_INSTANTIATE_ANGLES(T)                                                                         \
+    template void angles<T>(const Vector2<T> *, const Vector2<T> *, T *, std::size_t, MathAccuracy);         \
+    template void angles<T>(const Vector3<T> *, const Vector3<T> *, T *, std::size_t, MathAccuracy);         \
+    template void angles<T>(const Vector4<T> *, const Vector4<T> *, T *, std::size_t, MathAccuracy);         \
+    template void rotate<T>(const Vector2<T> *, const T *, Vector2<T> *, std::size_t, MathAccuracy);         \
+    template void rotate<T>(const Vector3<T> *, const Vector3<T> *, const T *, Vector3<T> *, std::size_t,    \
+                            MathAccuracy);                                                                   \
+    template void toPolar<T>(const Vector2<T> *, T *, T *, std::size_t, MathAccuracy);                       \
+    template void fromPolar<T>(const T *, const T *, Vector2<T> *, std::size_t, MathAccuracy);               \
+    template void angles<T>(const StridedView<Vector2<T>> &, const StridedView<Vector2<T>> &, T *,           \
+                            MathAccuracy);                                                                   \
+    template void angles<T>(const StridedView<Vector3<T>> &, const StridedView<Vector3<T>> &, T *,           \
+                            MathAccuracy);                                                                   \
+    template void angles<T>(const StridedView<Vector4<T>> &, const StridedView<Vector4<T>> &, T *,           \
+                            MathAccuracy);                                                                   \
+    template void rotate<T>(const StridedView<Vector2<T>> &, const T *, const StridedRef<Vector2<T>> &,      \
+                            MathAccuracy);                                                                   \
+    template void rotate<T>(const StridedView<Vector3<T>> &, const StridedView<Vector3<T>> &, const T *,     \
+                            const StridedRef<Vector3<T>> &, MathAccuracy);                                   \
+    template void toPolar<T>(const StridedView<Vector2<T>> &, T *, T *, MathAccuracy);                       \
+    template void fromPolar<T>(const T *, const T *, const StridedRef<Vector2<T>> &, MathAccuracy);
+
+LUMINA_INSTANTIATE_ANGLES(float)
+LUMINA_INSTANTIATE_ANGLES(double)
+
+#undef LUMINA_INSTANTIATE_ANGLES
+
+} // namespace lumina
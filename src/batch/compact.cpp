@@ -0,0 +1,194 @@
+#include <lumina/batch/compact.hpp>
+#include "../simd/simd.hpp"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace lumina
+{
+
+namespace
+{
+
+// Lane bits of the pack starting at element i; packs never straddle two mask words
+template <typename P>
+unsigned packBits(const std::uint64_t *masks, std::size_t i)
+{
+    constexpr std::uint64_t laneMask = (std::uint64_t(1) << P::width) - 1;
+    return unsigned((masks[i / 64] >> (i % 64)) & laneMask);
+}
+
+// Calls copy(source, destination) for every selected element in ascending order.
+// Full mask words are forwarded as runs so dense masks copy at memcpy speed.
+template <typename Copy, typename CopyRun>
+std::size_t forEachSelected(const std::uint64_t *masks, std::size_t count, Copy &&copy, CopyRun &&copyRun)
+{
+    std::size_t written = 0;
+    for (std::size_t word = 0; word < maskWordCount(count); ++word)
+    {
+        std::uint64_t bits = masks[word];
+        std::size_t base = word * 64;
+        if (bits == ~std::uint64_t(0) && base + 64 <= count)
+        {
+            copyRun(base, written, 64);
+            written += 64;
+            continue;
+        }
+        if (base + 64 > count)
+            bits &= (std::uint64_t(1) << (count - base)) - 1;
+        while (bits)
+        {
+            copy(base + std::size_t(std::countr_zero(bits)), written++);
+            bits &= bits - 1;
+        }
+    }
+    return written;
+}
+
+template <typename V, typename Source>
+std::size_t compactVectors(const Source &values, std::size_t count, const std::uint64_t *masks, V *out,
+                           std::uint32_t *indices)
+{
+    return forEachSelected(masks, count, [&](std::size_t source, std::size_t destination)
+    {
+        out[destination] = values[source];
+        if (indices)
+            indices[destination] = std::uint32_t(source);
+    },
+    [&](std::size_t source, std::size_t destination, std::size_t length)
+    {
+        for (std::size_t j = 0; j < length; ++j)
+        {
+            out[destination + j] = values[source + j];
+            if (indices)
+                indices[destination + j] = std::uint32_t(source + j);
+        }
+    });
+}
+
+void checkIndexRange(std::size_t count)
+{
+    if (count > std::size_t(UINT32_MAX) + 1)
+        throw std::length_error("compact supports at most 2^32 elements");
+}
+
+} // namespace
+
+std::size_t countMask(const std::uint64_t *masks, std::size_t count)
+{
+    std::size_t words = maskWordCount(count);
+    std::size_t total = 0;
+    for (std::size_t word = 0; word < words; ++word)
+        total += std::size_t(std::popcount(masks[word]));
+    // Tolerate callers that left garbage past `count` in the last word
+    if (count % 64)
+        total -= std::size_t(std::popcount(masks[words - 1] >> (count % 64)));
+    return total;
+}
+
+std::size_t maskToIndices(const std::uint64_t *masks, std::size_t count, std::uint32_t *indices)
+{
+    checkIndexRange(count);
+    return forEachSelected(masks, count, [&](std::size_t source, std::size_t destination)
+    {
+        indices[destination] = std::uint32_t(source);
+    },
+    [&](std::size_t source, std::size_t destination, std::size_t length)
+    {
+        for (std::size_t j = 0; j < length; ++j)
+            indices[destination + j] = std::uint32_t(source + j);
+    });
+}
+
+template <typename T>
+std::size_t compact(const T *values, std::size_t count, const std::uint64_t *masks, T *out, std::uint32_t *indices)
+{
+    checkIndexRange(count);
+    std::size_t written = 0;
+    simd::forEachPack<T>(count, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        unsigned bits = packBits<P>(masks, i);
+        if (!bits)
+            return;
+        if (indices)
+            simd::compressIndices<P>(bits, i, indices + written);
+        written += simd::compressStore<P>(P::load(values + i), bits, out + written);
+    });
+    return written;
+}
+
+template <typename T>
+std::size_t compact(const Vector2<T> *values, std::size_t count, const std::uint64_t *masks, Vector2<T> *out,
+                    std::uint32_t *indices)
+{
+    checkIndexRange(count);
+    return compactVectors(values, count, masks, out, indices);
+}
+
+template <typename T>
+std::size_t compact(const Vector3<T> *values, std::size_t count, const std::uint64_t *masks, Vector3<T> *out,
+                    std::uint32_t *indices)
+{
+    checkIndexRange(count);
+    return compactVectors(values, count, masks, out, indices);
+}
+
+template <typename T>
+std::size_t compact(const Vector4<T> *values, std::size_t count, const std::uint64_t *masks, Vector4<T> *out,
+                    std::uint32_t *indices)
+{
+    checkIndexRange(count);
+    return compactVectors(values, count, masks, out, indices);
+}
+
+template <typename T>
+std::size_t compact(const StridedView<Vector3<T>> &values, const std::uint64_t *masks, Vector3<T> *out,
+                    std::uint32_t *indices)
+{
+    checkIndexRange(values.count);
+    return compactVectors(values, values.count, masks, out, indices);
+}
+
+template <typename T>
+std::size_t compact(const Vector3SoAView<T> &values, const std::uint64_t *masks, const Vector3SoARef<T> &out,
+                    std::uint32_t *indices)
+{
+    if (out.count != values.count)
+        throw std::invalid_argument("compact output must match the input count");
+    checkIndexRange(values.count);
+    std::size_t written = 0;
+    simd::forEachPack<T>(values.count, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        unsigned bits = packBits<P>(masks, i);
+        if (!bits)
+            return;
+        if (indices)
+            simd::compressIndices<P>(bits, i, indices + written);
+        simd::compressStore<P>(P::load(values.x + i), bits, out.x + written);
+        simd::compressStore<P>(P::load(values.y + i), bits, out.y + written);
+        written += simd::compressStore<P>(P::load(values.z + i), bits, out.z + written);
+    });
+    return written;
+}
+
+#define LUMINA_INSTANTIATE_COMPACT(T)                                                                            \
+    template std::size_t compact<T>(const T *, std::size_t, const std::uint64_t *, T *, std::uint32_t *);        \
+    template std::size_t compact<T>(const Vector2<T> *, std::size_t, const std::uint64_t *, Vector2<T> *,        \
+                                    std::uint32_t *);                                                            \
+    template std::size_t compact<T>(const Vector3<T> *, std::size_t, const std::uint64_t *, Vector3<T> *,        \
+                                    std::uint32_t *);                                                            \
+    template std::size_t compact<T>(const Vector4<T> *, std::size_t, const std::uint64_t *, Vector4<T> *,        \
+                                    std::uint32_t *);                                                            \
+    template std::size_t compact<T>(const StridedView<Vector3<T>> &, const std::uint64_t *, Vector3<T> *,        \
+                                    std::uint32_t *);                                                            \
+    template std::size_t compact<T>(const Vector3SoAView<T> &, const std::uint64_t *, const Vector3SoARef<T> &,  \
+                                    std::uint32_t *);
+
+LUMINA_INSTANTIATE_COMPACT(float)
+LUMINA_INSTANTIATE_COMPACT(double)
+
+#undef LUMINA_INSTANTIATE_COMPACT
+
+} // namespace lumina
@@ -0,0 +1,150 @@
+#include <lumina/batch/culling.hpp>
+#include "../simd/simd.hpp"
+#include <cstdint>
+#include <stdexcept>
+
+namespace lumina
+{
+
+namespace
+{
+
+template <typename T>
+struct PlaneLanes
+{
+    T nx, ny, nz, d;
+};
+
+template <typename T>
+void splatPlanes(const Frustum<T> &frustum, PlaneLanes<T> (&out)[Frustum<T>::PlaneCount])
+{
+    for (int p = 0; p < Frustum<T>::PlaneCount; ++p)
+        out[p] = {frustum.planes[p].normal.x, frustum.planes[p].normal.y,
+                  frustum.planes[p].normal.z, frustum.planes[p].distance};
+}
+
+template <typename T, typename P>
+inline P planeDistance(const PlaneLanes<T> &plane, P x, P y, P z)
+{
+    return simd::fmadd(x, P::broadcast(plane.nx),
+           simd::fmadd(y, P::broadcast(plane.ny),
+           simd::fmadd(z, P::broadcast(plane.nz), P::broadcast(plane.d))));
+}
+
+template <typename T, typename Points>
+std::size_t cullPointsImpl(const Frustum<T> &frustum, const Points &points, std::size_t count,
+                           std::uint32_t *survivors)
+{
+    PlaneLanes<T> planes[Frustum<T>::PlaneCount];
+    splatPlanes(frustum, planes);
+
+    std::size_t written = 0;
+    simd::forEachPack<T>(count, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P x = simd::loadComponent<P>(points, i, 0);
+        P y = simd::loadComponent<P>(points, i, 1);
+        P z = simd::loadComponent<P>(points, i, 2);
+        P zero = P::broadcast(T(0));
+
+        auto inside = planeDistance(planes[0], x, y, z) >= zero;
+        for (int p = 1; p < Frustum<T>::PlaneCount; ++p)
+            inside = inside & (planeDistance(planes[p], x, y, z) >= zero);
+        written += simd::compressIndices<P>(inside.bits(), i, survivors + written);
+    });
+    return written;
+}
+
+template <typename P, typename T>
+inline P loadRadii(const T *radii, std::size_t i)
+{
+    return P::load(radii + i);
+}
+
+template <typename P, typename T>
+inline P loadRadii(const StridedView<T> &radii, std::size_t i)
+{
+    return simd::loadComponent<P>(radii, i, 0);
+}
+
+template <typename T, typename Centers, typename Radii>
+std::size_t cullSpheresImpl(const Frustum<T> &frustum, const Centers &centers, const Radii &radii, std::size_t count,
+                            std::uint32_t *survivors)
+{
+    PlaneLanes<T> planes[Frustum<T>::PlaneCount];
+    splatPlanes(frustum, planes);
+
+    std::size_t written = 0;
+    simd::forEachPack<T>(count, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P x = simd::loadComponent<P>(centers, i, 0);
+        P y = simd::loadComponent<P>(centers, i, 1);
+        P z = simd::loadComponent<P>(centers, i, 2);
+        P negRadius = -loadRadii<P>(radii, i);
+
+        auto inside = planeDistance(planes[0], x, y, z) >= negRadius;
+        for (int p = 1; p < Frustum<T>::PlaneCount; ++p)
+            inside = inside & (planeDistance(planes[p], x, y, z) >= negRadius);
+        written += simd::compressIndices<P>(inside.bits(), i, survivors + written);
+    });
+    return written;
+}
+
+// Survivor indices are 32-bit
+void checkIndexRange(std::size_t count)
+{
+    if (count > std::size_t(UINT32_MAX) + 1)
+        throw std::length_error("culling supports at most 2^32 elements");
+}
+
+} // namespace
+
+template <typename T>
+std::size_t cullPoints(const Frustum<T> &frustum, const Vector3SoAView<T> &points, std::uint32_t *survivors)
+{
+    checkIndexRange(points.count);
+    return cullPointsImpl(frustum, points, points.count, survivors);
+}
+
+template <typename T>
+std::size_t cullPoints(const Frustum<T> &frustum, const StridedView<Vector3<T>> &points, std::uint32_t *survivors)
+{
+    checkIndexRange(points.count);
+    return cullPointsImpl(frustum, points, points.count, survivors);
+}
+
+template <typename T>
+std::size_t cullSpheres(const Frustum<T> &frustum, const Vector3SoAView<T> &centers, const T *radii,
+                        std::uint32_t *survivors)
+{
+    checkIndexRange(centers.count);
+    return cullSpheresImpl(frustum, centers, radii, centers.count, survivors);
+}
+
+template <typename T>
+std::size_t cullSpheres(const Frustum<T> &frustum, const StridedView<Vector3<T>> &centers,
+                        const StridedView<T> &radii, std::uint32_t *survivors)
+{
+    if (centers.count != radii.count)
+        throw std::invalid_argument("Strided views differ in length");
+    checkIndexRange(centers.count);
+    return cullSpheresImpl(frustum, centers, radii, centers.count, survivors);
+}
+
+template std::size_t cullPoints<float>(const Frustum<float> &, const Vector3SoAView<float> &, std::uint32_t *);
+template std::size_t cullPoints<double>(const Frustum<double> &, const Vector3SoAView<double> &, std::uint32_t *);
+template std::size_t cullPoints<float>(const Frustum<float> &, const StridedView<Vector3<float>> &,
+                                       std::uint32_t *);
+template std::size_t cullPoints<double>(const Frustum<double> &, const StridedView<Vector3<double>> &,
+                                        std::uint32_t *);
+template std::size_t cullSpheres<float>(const Frustum<float> &, const Vector3SoAView<float> &, const float *,
+                                        std::uint32_t *);
+template std::size_t cullSpheres<double>(const Frustum<double> &, const Vector3SoAView<double> &, const double *,
+                                         std::uint32_t *);
+template std::size_t cullSpheres<float>(const Frustum<float> &, const StridedView<Vector3<float>> &,
+                                        const StridedView<float> &, std::uint32_t *);
+template std::size_t cullSpheres<double>(const Frustum<double> &, const StridedView<Vector3<double>> &,
+                                         const StridedView<double> &, std::uint32_t *);
+
+} // namespace lumina
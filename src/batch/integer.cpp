@@ -0,0 +1,214 @@
+#include <lumina/batch/integer.hpp>
+#include "../simd/simd.hpp"
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace lumina
+{
+
+namespace
+{
+
+// Lane arithmetic for each component type; both pack widths share it so the tail matches the body
+template <typename T>
+struct LaneOps;
+
+template <>
+struct LaneOps<int>
+{
+    template <typename P>
+    static P add(P a, P b) { return a + b; }
+    template <typename P>
+    static P sub(P a, P b) { return a - b; }
+    template <typename P>
+    static P mul(P a, P b) { return a * b; }
+};
+
+template <>
+struct LaneOps<Fixed16>
+{
+    template <typename P>
+    static P add(P a, P b) { return simd::addSaturate(a, b); }
+    template <typename P>
+    static P sub(P a, P b) { return simd::subSaturate(a, b); }
+    template <typename P>
+    static P mul(P a, P b) { return simd::mulShiftSaturate(a, b, Fixed16::fractionBits); }
+};
+
+template <typename V>
+using ComponentOf = std::remove_cvref_t<decltype(std::declval<V &>().x)>;
+
+template <typename V>
+constexpr std::size_t DimensionOf = sizeof(V) / sizeof(ComponentOf<V>);
+
+// Vectors are read as flat int32 component streams: int directly, Fixed16 through its raw value
+template <typename T>
+const std::int32_t *raw(const T *p)
+{
+    static_assert(sizeof(T) % sizeof(std::int32_t) == 0);
+    return reinterpret_cast<const std::int32_t *>(p);
+}
+
+template <typename T>
+std::int32_t *raw(T *p)
+{
+    return reinterpret_cast<std::int32_t *>(p);
+}
+
+// Runs body(tag, index) over [0, count) in integer packs, then single lanes for the tail
+template <typename Body>
+void forEachLanes(std::size_t count, Body &&body)
+{
+    std::size_t i = 0;
+    for (; i + simd::PackI32::width <= count; i += simd::PackI32::width)
+        body(std::type_identity<simd::PackI32>{}, i);
+    for (; i < count; ++i)
+        body(std::type_identity<simd::ScalarI32>{}, i);
+}
+
+template <typename V, typename Op>
+void componentWise(const V *a, const V *b, V *out, std::size_t count, Op op)
+{
+    static_assert(sizeof(V) == DimensionOf<V> * sizeof(std::int32_t), "Vector components must be packed int32");
+    const std::int32_t *ra = raw(a);
+    const std::int32_t *rb = raw(b);
+    std::int32_t *ro = raw(out);
+    forEachLanes(count * DimensionOf<V>, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        op(P::load(ra + i), P::load(rb + i)).store(ro + i);
+    });
+}
+
+template <typename V, typename T>
+void dotProducts(const V *a, const V *b, T *out, std::size_t count)
+{
+    constexpr std::size_t Dim = DimensionOf<V>;
+    const std::int32_t *ra = raw(a);
+    const std::int32_t *rb = raw(b);
+    forEachLanes(count, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P pa[Dim], pb[Dim];
+        simd::loadComponents(ra + i * Dim, pa);
+        simd::loadComponents(rb + i * Dim, pb);
+        P sum = LaneOps<T>::mul(pa[0], pb[0]);
+        for (std::size_t k = 1; k < Dim; ++k)
+            sum = LaneOps<T>::add(sum, LaneOps<T>::mul(pa[k], pb[k]));
+        sum.store(raw(out) + i);
+    });
+}
+
+} // namespace
+
+template <typename V>
+void addBatch(const V *a, const V *b, V *out, std::size_t count)
+{
+    componentWise(a, b, out, count, [](auto x, auto y) { return LaneOps<ComponentOf<V>>::add(x, y); });
+}
+
+template <typename V>
+void subBatch(const V *a, const V *b, V *out, std::size_t count)
+{
+    componentWise(a, b, out, count, [](auto x, auto y) { return LaneOps<ComponentOf<V>>::sub(x, y); });
+}
+
+template <typename V>
+void mulBatch(const V *a, const V *b, V *out, std::size_t count)
+{
+    componentWise(a, b, out, count, [](auto x, auto y) { return LaneOps<ComponentOf<V>>::mul(x, y); });
+}
+
+template <typename V>
+void minBatch(const V *a, const V *b, V *out, std::size_t count)
+{
+    componentWise(a, b, out, count, [](auto x, auto y) { return simd::min(x, y); });
+}
+
+template <typename V>
+void maxBatch(const V *a, const V *b, V *out, std::size_t count)
+{
+    componentWise(a, b, out, count, [](auto x, auto y) { return simd::max(x, y); });
+}
+
+template <typename T>
+void dotBatch(const Vector2<T> *a, const Vector2<T> *b, T *out, std::size_t count)
+{
+    dotProducts(a, b, out, count);
+}
+
+template <typename T>
+void dotBatch(const Vector3<T> *a, const Vector3<T> *b, T *out, std::size_t count)
+{
+    dotProducts(a, b, out, count);
+}
+
+template <typename T>
+void dotBatch(const Vector4<T> *a, const Vector4<T> *b, T *out, std::size_t count)
+{
+    dotProducts(a, b, out, count);
+}
+
+// Each fraction is a short sum of shifts, so no intermediate can leave the int32 range
+// except the final add, which saturates
+template <typename T>
+void approxMagnitudeBatch(const Vector2<T> *vectors, T *out, std::size_t count)
+{
+    const std::int32_t *in = raw(vectors);
+    forEachLanes(count, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P c[2];
+        simd::loadComponents(in + i * 2, c);
+        P x = simd::absSaturate(c[0]), y = simd::absSaturate(c[1]);
+        P hi = simd::max(x, y), lo = simd::min(x, y);
+        P estimate = simd::addSaturate(hi - (hi >> 3), (lo >> 1) + (lo >> 5));
+        simd::max(hi, estimate).store(raw(out) + i);
+    });
+}
+
+template <typename T>
+void approxMagnitudeBatch(const Vector3<T> *vectors, T *out, std::size_t count)
+{
+    const std::int32_t *in = raw(vectors);
+    forEachLanes(count, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P c[3];
+        simd::loadComponents(in + i * 3, c);
+        P x = simd::absSaturate(c[0]), y = simd::absSaturate(c[1]), z = simd::absSaturate(c[2]);
+        P xyLo = simd::min(x, y), xyHi = simd::max(x, y);
+        P hi = simd::max(xyHi, z);
+        P mid = simd::max(xyLo, simd::min(xyHi, z));
+        P lo = simd::min(xyLo, z);
+        P rest = (mid >> 1) + (mid >> 5) + (lo >> 2) + (lo >> 5);
+        P estimate = simd::addSaturate(hi - (hi >> 3) - (hi >> 5), rest);
+        simd::max(hi, estimate).store(raw(out) + i);
+    });
+}
+
+#define LUMINA_INSTANTIATE_INTEGER_VECTOR(V)                            \
+    template void addBatch<V>(const V *, const V *, V *, std::size_t);  \
+    template void subBatch<V>(const V *, const V *, V *, std::size_t);  \
+    template void mulBatch<V>(const V *, const V *, V *, std::size_t);  \
+    template void minBatch<V>(const V *, const V *, V *, std::size_t);  \
+    template void maxBatch<V>(const V *, const V *, V *, std::size_t);
+
+#define LUMINA_INSTANTIATE_INTEGER(T)                                                     \
+    LUMINA_INSTANTIATE_INTEGER_VECTOR(Vector2<T>)                                         \
+    LUMINA_INSTANTIATE_INTEGER_VECTOR(Vector3<T>)                                         \
+    LUMINA_INSTANTIATE_INTEGER_VECTOR(Vector4<T>)                                         \
+    template void dotBatch<T>(const Vector2<T> *, const Vector2<T> *, T *, std::size_t);  \
+    template void dotBatch<T>(const Vector3<T> *, const Vector3<T> *, T *, std::size_t);  \
+    template void dotBatch<T>(const Vector4<T> *, const Vector4<T> *, T *, std::size_t);  \
+    template void approxMagnitudeBatch<T>(const Vector2<T> *, T *, std::size_t);          \
+    template void approxMagnitudeBatch<T>(const Vector3<T> *, T *, std::size_t);
+
+LUMINA_INSTANTIATE_INTEGER(int)
+LUMINA_INSTANTIATE_INTEGER(Fixed16)
+
+#undef LUMINA_INSTANTIATE_INTEGER
+#undef LUMINA_INSTANTIATE_INTEGER_VECTOR
+
+} // namespace lumina
@@ -0,0 +1,145 @@
+#include <lumina/batch/math.hpp>
+#include "../simd/simd_math.hpp"
+#include "stream.hpp"
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+namespace lumina
+{
+
+namespace
+{
+
+std::size_t detectLastLevelCache()
+{
+#if defined(_SC_LEVEL3_CACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+    for (int level : {_SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE})
+    {
+        long bytes = sysconf(level);
+        if (bytes > 0)
+            return std::size_t(bytes);
+    }
+#endif
+    return std::size_t(8) << 20;
+}
+
+// The elementary functions run on the calling thread
+template <typename Kernel, typename... Out>
+void writeSerial(std::initializer_list<stream::Input> inputs, std::size_t count, StoreMode mode, Kernel &&kernel,
+                 Out *...out)
+{
+    stream::writeBatch(inputs, count, mode, 1, count, kernel, out...);
+}
+
+} // namespace
+
+std::size_t streamingThreshold()
+{
+    static const std::size_t threshold = detectLastLevelCache();
+    return threshold;
+}
+
+template <typename T>
+void sinBatch(const T *in, T *out, std::size_t count, MathAccuracy accuracy, StoreMode mode)
+{
+    writeSerial({{in, sizeof(T)}}, count, mode, [&](std::size_t begin, std::size_t n, T *dst)
+    {
+        simd::forEachPack<T>(n, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+        {
+            simd::sin<A>(P::load(in + begin + i)).store(dst + i);
+        });
+    }, out);
+}
+
+template <typename T>
+void cosBatch(const T *in, T *out, std::size_t count, MathAccuracy accuracy, StoreMode mode)
+{
+    writeSerial({{in, sizeof(T)}}, count, mode, [&](std::size_t begin, std::size_t n, T *dst)
+    {
+        simd::forEachPack<T>(n, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+        {
+            simd::cos<A>(P::load(in + begin + i)).store(dst + i);
+        });
+    }, out);
+}
+
+template <typename T>
+void sincosBatch(const T *in, T *sinOut, T *cosOut, std::size_t count, MathAccuracy accuracy, StoreMode mode)
+{
+    writeSerial({{in, sizeof(T)}}, count, mode, [&](std::size_t begin, std::size_t n, T *sinDst, T *cosDst)
+    {
+        simd::forEachPack<T>(n, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+        {
+            P s, c;
+            simd::sincos<A>(P::load(in + begin + i), s, c);
+            s.store(sinDst + i);
+            c.store(cosDst + i);
+        });
+    }, sinOut, cosOut);
+}
+
+template <typename T>
+void acosBatch(const T *in, T *out, std::size_t count, MathAccuracy accuracy, StoreMode mode)
+{
+    writeSerial({{in, sizeof(T)}}, count, mode, [&](std::size_t begin, std::size_t n, T *dst)
+    {
+        simd::forEachPack<T>(n, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+        {
+            simd::acos<A>(P::load(in + begin + i)).store(dst + i);
+        });
+    }, out);
+}
+
+template <typename T>
+void atan2Batch(const T *y, const T *x, T *out, std::size_t count, MathAccuracy accuracy, StoreMode mode)
+{
+    writeSerial({{y, sizeof(T)}, {x, sizeof(T)}}, count, mode, [&](std::size_t begin, std::size_t n, T *dst)
+    {
+        simd::forEachPack<T>(n, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+        {
+            simd::atan2<A>(P::load(y + begin + i), P::load(x + begin + i)).store(dst + i);
+        });
+    }, out);
+}
+
+template <typename T>
+void rsqrtBatch(const T *in, T *out, std::size_t count, MathAccuracy accuracy, StoreMode mode)
+{
+    writeSerial({{in, sizeof(T)}}, count, mode, [&](std::size_t begin, std::size_t n, T *dst)
+    {
+        simd::forEachPack<T>(n, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+        {
+            simd::rsqrt<A>(P::load(in + begin + i)).store(dst + i);
+        });
+    }, out);
+}
+
+template <typename T>
+void expBatch(const T *in, T *out, std::size_t count, MathAccuracy accuracy, StoreMode mode)
+{
+    writeSerial({{in, sizeof(T)}}, count, mode, [&](std::size_t begin, std::size_t n, T *dst)
+    {
+        simd::forEachPack<T>(n, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+        {
+            simd::exp<A>(P::load(in + begin + i)).store(dst + i);
+        });
+    }, out);
+}
+
+#define LUMINA_INSTANTIATE_MATH(T)                                                                 \
+    template void sinBatch<T>(const T *, T *, std::size_t, MathAccuracy, StoreMode);               \
+    template void cosBatch<T>(const T *, T *, std::size_t, MathAccuracy, StoreMode);               \
+    template void sincosBatch<T>(const T *, T *, T *, std::size_t, MathAccuracy, StoreMode);       \
+    template void acosBatch<T>(const T *, T *, std::size_t, MathAccuracy, StoreMode);              \
+    template void atan2Batch<T>(const T *, const T *, T *, std::size_t, MathAccuracy, StoreMode);  \
+    template void rsqrtBatch<T>(const T *, T *, std::size_t, MathAccuracy, StoreMode);             \
+    template void expBatch<T>(const T *, T *, std::size_t, MathAccuracy, StoreMode);
+
+LUMINA_INSTANTIATE_MATH(float)
+LUMINA_INSTANTIATE_MATH(double)
+
+#undef LUMINA_INSTANTIATE_MATH
+
+} // namespace lumina
@@ -0,0 +1,235 @@
+#include <lumina/batch/predicates.hpp>
+#include "../simd/simd.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace lumina
+{
+
+namespace
+{
+
+// Clears the mask words and ORs in the lane bits of test(tag, index) for every pack.
+// Full packs start at multiples of the pack width, which divides 64, so a pack never straddles two words.
+template <typename T, typename Test>
+void evaluateMasks(std::size_t count, std::uint64_t *masks, Test &&test)
+{
+    std::fill(masks, masks + maskWordCount(count), std::uint64_t(0));
+    simd::forEachPack<T>(count, [&](auto tag, std::size_t i)
+    {
+        masks[i / 64] |= std::uint64_t(test(tag, i).bits()) << (i % 64);
+    });
+}
+
+template <typename A, typename B>
+void checkCounts(const A &a, const B &b)
+{
+    if (a.count != b.count)
+        throw std::invalid_argument("approxEqual views differ in length");
+}
+
+// Sources are contiguous arrays, strided views or SoA views, all read through simd::loadComponent
+
+template <typename T, int Dimension, typename Source>
+void approxEqualImpl(const Source &a, const Source &b, std::size_t count, T epsilon, std::uint64_t *masks)
+{
+    evaluateMasks<T>(count, masks, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P eps = P::broadcast(epsilon);
+        auto equal = simd::abs(simd::loadComponent<P>(a, i, 0) - simd::loadComponent<P>(b, i, 0)) <= eps;
+        for (int k = 1; k < Dimension; ++k)
+            equal = equal & (simd::abs(simd::loadComponent<P>(a, i, k) - simd::loadComponent<P>(b, i, k)) <= eps);
+        return equal;
+    });
+}
+
+template <typename T, int Dimension, typename Source>
+void withinDistanceImpl(const Source &points, std::size_t count, const T (&center)[Dimension], T radius,
+                        std::uint64_t *masks)
+{
+    evaluateMasks<T>(count, masks, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P sqrDistance = P::broadcast(T(0));
+        for (int k = 0; k < Dimension; ++k)
+        {
+            P d = simd::loadComponent<P>(points, i, k) - P::broadcast(center[k]);
+            sqrDistance = simd::fmadd(d, d, sqrDistance);
+        }
+        return sqrDistance <= P::broadcast(radius * radius);
+    });
+}
+
+template <typename T, typename Source>
+void insideBoundsImpl(const Source &points, std::size_t count, const Bounds3<T> &bounds, std::uint64_t *masks)
+{
+    const T lo[3] = {bounds.min.x, bounds.min.y, bounds.min.z};
+    const T hi[3] = {bounds.max.x, bounds.max.y, bounds.max.z};
+    evaluateMasks<T>(count, masks, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P x = simd::loadComponent<P>(points, i, 0);
+        auto inside = (x >= P::broadcast(lo[0])) & (x <= P::broadcast(hi[0]));
+        for (int k = 1; k < 3; ++k)
+        {
+            P c = simd::loadComponent<P>(points, i, k);
+            inside = inside & (c >= P::broadcast(lo[k])) & (c <= P::broadcast(hi[k]));
+        }
+        return inside;
+    });
+}
+
+} // namespace
+
+template <typename T>
+void compare(const T *values, std::size_t count, Comparison comparison, T threshold, std::uint64_t *masks)
+{
+    evaluateMasks<T>(count, masks, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P v = P::load(values + i);
+        P t = P::broadcast(threshold);
+        switch (comparison)
+        {
+        case Comparison::Less:
+            return v < t;
+        case Comparison::LessEqual:
+            return v <= t;
+        case Comparison::Greater:
+            return v > t;
+        case Comparison::GreaterEqual:
+            return v >= t;
+        case Comparison::Equal:
+            return v == t;
+        case Comparison::NotEqual:
+            break;
+        }
+        return ~(v == t);
+    });
+}
+
+template <typename T>
+void approxEqual(const Vector2<T> *a, const Vector2<T> *b, std::size_t count, T epsilon, std::uint64_t *masks)
+{
+    approxEqualImpl<T, 2>(a, b, count, epsilon, masks);
+}
+
+template <typename T>
+void approxEqual(const Vector3<T> *a, const Vector3<T> *b, std::size_t count, T epsilon, std::uint64_t *masks)
+{
+    approxEqualImpl<T, 3>(a, b, count, epsilon, masks);
+}
+
+template <typename T>
+void approxEqual(const Vector4<T> *a, const Vector4<T> *b, std::size_t count, T epsilon, std::uint64_t *masks)
+{
+    approxEqualImpl<T, 4>(a, b, count, epsilon, masks);
+}
+
+template <typename T>
+void approxEqual(const StridedView<Vector2<T>> &a, const StridedView<Vector2<T>> &b, T epsilon,
+                 std::uint64_t *masks)
+{
+    checkCounts(a, b);
+    approxEqualImpl<T, 2>(a, b, a.count, epsilon, masks);
+}
+
+template <typename T>
+void approxEqual(const StridedView<Vector3<T>> &a, const StridedView<Vector3<T>> &b, T epsilon,
+                 std::uint64_t *masks)
+{
+    checkCounts(a, b);
+    approxEqualImpl<T, 3>(a, b, a.count, epsilon, masks);
+}
+
+template <typename T>
+void approxEqual(const StridedView<Vector4<T>> &a, const StridedView<Vector4<T>> &b, T epsilon,
+                 std::uint64_t *masks)
+{
+    checkCounts(a, b);
+    approxEqualImpl<T, 4>(a, b, a.count, epsilon, masks);
+}
+
+template <typename T>
+void approxEqual(const Vector3SoAView<T> &a, const Vector3SoAView<T> &b, T epsilon, std::uint64_t *masks)
+{
+    checkCounts(a, b);
+    approxEqualImpl<T, 3>(a, b, a.count, epsilon, masks);
+}
+
+template <typename T>
+void withinDistance(const Vector2<T> *points, std::size_t count, const Vector2<T> &center, T radius,
+                    std::uint64_t *masks)
+{
+    const T c[2] = {center.x, center.y};
+    withinDistanceImpl(points, count, c, radius, masks);
+}
+
+template <typename T>
+void withinDistance(const Vector3<T> *points, std::size_t count, const Vector3<T> &center, T radius,
+                    std::uint64_t *masks)
+{
+    const T c[3] = {center.x, center.y, center.z};
+    withinDistanceImpl(points, count, c, radius, masks);
+}
+
+template <typename T>
+void withinDistance(const StridedView<Vector3<T>> &points, const Vector3<T> &center, T radius,
+                    std::uint64_t *masks)
+{
+    const T c[3] = {center.x, center.y, center.z};
+    withinDistanceImpl(points, points.count, c, radius, masks);
+}
+
+template <typename T>
+void withinDistance(const Vector3SoAView<T> &points, const Vector3<T> &center, T radius, std::uint64_t *masks)
+{
+    const T c[3] = {center.x, center.y, center.z};
+    withinDistanceImpl(points, points.count, c, radius, masks);
+}
+
+template <typename T>
+void insideBounds(const Vector3<T> *points, std::size_t count, const Bounds3<T> &bounds, std::uint64_t *masks)
+{
+    insideBoundsImpl(points, count, bounds, masks);
+}
+
+template <typename T>
+void insideBounds(const StridedView<Vector3<T>> &points, const Bounds3<T> &bounds, std::uint64_t *masks)
+{
+    insideBoundsImpl(points, points.count, bounds, masks);
+}
+
+template <typename T>
+void insideBounds(const Vector3SoAView<T> &points, const Bounds3<T> &bounds, std::uint64_t *masks)
+{
+    insideBoundsImpl(points, points.count, bounds, masks);
+}
+
+#define LUMINA_INSTANTIATE_PREDICATES(T)                                                                       \
+    template void compare<T>(const T *, std::size_t, Comparison, T, std::uint64_t *);                          \
+    template void approxEqual<T>(const Vector2<T> *, const Vector2<T> *, std::size_t, T, std::uint64_t *);     \
+    template void approxEqual<T>(const Vector3<T> *, const Vector3<T> *, std::size_t, T, std::uint64_t *);     \
+    template void approxEqual<T>(const Vector4<T> *, const Vector4<T> *, std::size_t, T, std::uint64_t *);     \
+    template void approxEqual<T>(const StridedView<Vector2<T>> &, const StridedView<Vector2<T>> &, T,          \
+                                 std::uint64_t *);                                                             \
+    template void approxEqual<T>(const StridedView<Vector3<T>> &, const StridedView<Vector3<T>> &, T,          \
+                                 std::uint64_t *);                                                             \
+    template void approxEqual<T>(const StridedView<Vector4<T>> &, const StridedView<Vector4<T>> &, T,          \
+                                 std::uint64_t *);                                                             \
+    template void approxEqual<T>(const Vector3SoAView<T> &, const Vector3SoAView<T> &, T, std::uint64_t *);    \
+    template void withinDistance<T>(const Vector2<T> *, std::size_t, const Vector2<T> &, T, std::uint64_t *);  \
+    template void withinDistance<T>(const Vector3<T> *, std::size_t, const Vector3<T> &, T, std::uint64_t *);  \
+    template void withinDistance<T>(const StridedView<Vector3<T>> &, const Vector3<T> &, T, std::uint64_t *);  \
+    template void withinDistance<T>(const Vector3SoAView<T> &, const Vector3<T> &, T, std::uint64_t *);        \
+    template void insideBounds<T>(const Vector3<T> *, std::size_t, const Bounds3<T> &, std::uint64_t *);       \
+    template void insideBounds<T>(const StridedView<Vector3<T>> &, const Bounds3<T> &, std::uint64_t *);       \
+    template void insideBounds<T>(const Vector3SoAView<T> &, const Bounds3<T> &, std::uint64_t *);
+
+LUMINA_INSTANTIATE_PREDICATES(float)
+LUMINA_INSTANTIATE_PREDICATES(double)
+
+#undef LUMINA_INSTANTIATE_PREDICATES
+
+} // namespace lumina
@@ -0,0 +1,494 @@
+#include <lumina/batch/reduce.hpp>
+#include "../parallel/parallel_for.hpp"
+#include "../simd/simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace lumina
+{
+
+namespace
+{
+
+// Points per block; three float blocks stay resident in L1 between the two block passes
+constexpr std::size_t BlockSize = 1024;
+// Below this many points per thread the spawn cost outweighs the work
+constexpr std::size_t MinPointsPerThread = std::size_t(1) << 16;
+
+// Kahan-Babuska (Neumaier) compensated accumulator
+struct CompensatedSum
+{
+    double sum = 0.0;
+    double compensation = 0.0;
+
+    void add(double value)
+    {
+        double t = sum + value;
+        if (std::abs(sum) >= std::abs(value))
+            compensation += (sum - t) + value;
+        else
+            compensation += (value - t) + sum;
+        sum = t;
+    }
+
+    void add(const CompensatedSum &other)
+    {
+        add(other.sum);
+        add(other.compensation);
+    }
+
+    double value() const { return sum + compensation; }
+};
+
+// Running moments of a point set; m2 holds co-moments xx, xy, xz, yy, yz, zz
+template <typename T>
+struct Moments
+{
+    std::size_t count = 0;
+    CompensatedSum sum[3];
+    double mean[3] = {};
+    double m2[6] = {};
+    T min[3] = {std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max()};
+    T max[3] = {std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest()};
+
+    // Chan et al. pairwise update
+    void merge(const Moments &other)
+    {
+        if (other.count == 0)
+            return;
+        if (count == 0)
+        {
+            *this = other;
+            return;
+        }
+
+        double n = double(count + other.count);
+        double weight = double(count) * double(other.count) / n;
+        double delta[3];
+        for (int k = 0; k < 3; ++k)
+            delta[k] = other.mean[k] - mean[k];
+
+        m2[0] += other.m2[0] + delta[0] * delta[0] * weight;
+        m2[1] += other.m2[1] + delta[0] * delta[1] * weight;
+        m2[2] += other.m2[2] + delta[0] * delta[2] * weight;
+        m2[3] += other.m2[3] + delta[1] * delta[1] * weight;
+        m2[4] += other.m2[4] + delta[1] * delta[2] * weight;
+        m2[5] += other.m2[5] + delta[2] * delta[2] * weight;
+
+        for (int k = 0; k < 3; ++k)
+        {
+            mean[k] += delta[k] * double(other.count) / n;
+            sum[k].add(other.sum[k]);
+            min[k] = std::min(min[k], other.min[k]);
+            max[k] = std::max(max[k], other.max[k]);
+        }
+        count += other.count;
+    }
+};
+
+// Neumaier step in every lane
+template <typename P>
+void compensatedAdd(P &sum, P &compensation, P value)
+{
+    P t = sum + value;
+    P lost = simd::select(simd::abs(sum) >= simd::abs(value), (sum - t) + value, (value - t) + sum);
+    compensation = compensation + lost;
+    sum = t;
+}
+
+// Adds every lane of a compensated pack to a double accumulator
+template <typename P>
+void drainLanes(P sum, P compensation, CompensatedSum &total)
+{
+    using T = typename P::Scalar;
+    T lanes[P::width], corrections[P::width];
+    sum.store(lanes);
+    compensation.store(corrections);
+    for (std::size_t j = 0; j < P::width; ++j)
+    {
+        total.add(double(lanes[j]));
+        total.add(double(corrections[j]));
+    }
+}
+
+// Min and max of one block, and with WithSum its compensated sum
+template <bool WithSum, typename T>
+void blockSumBounds(const T *x, const T *y, const T *z, std::size_t n, CompensatedSum (&sum)[3], T (&lo)[3],
+                    T (&hi)[3])
+{
+    using P = simd::Pack<T>;
+    constexpr std::size_t W = P::width;
+
+    std::size_t i = 0;
+    if (n >= W)
+    {
+        P sx = P::broadcast(T(0)), sy = sx, sz = sx, cx = sx, cy = sx, cz = sx;
+        P lox = P::broadcast(std::numeric_limits<T>::max()), loy = lox, loz = lox;
+        P hix = P::broadcast(std::numeric_limits<T>::lowest()), hiy = hix, hiz = hix;
+        for (; i + W <= n; i += W)
+        {
+            P px = P::load(x + i), py = P::load(y + i), pz = P::load(z + i);
+            if constexpr (WithSum)
+            {
+                compensatedAdd(sx, cx, px);
+                compensatedAdd(sy, cy, py);
+                compensatedAdd(sz, cz, pz);
+            }
+            lox = simd::min(lox, px);
+            loy = simd::min(loy, py);
+            loz = simd::min(loz, pz);
+            hix = simd::max(hix, px);
+            hiy = simd::max(hiy, py);
+            hiz = simd::max(hiz, pz);
+        }
+        if constexpr (WithSum)
+        {
+            drainLanes(sx, cx, sum[0]);
+            drainLanes(sy, cy, sum[1]);
+            drainLanes(sz, cz, sum[2]);
+        }
+        lo[0] = simd::reduceMin(lox);
+        lo[1] = simd::reduceMin(loy);
+        lo[2] = simd::reduceMin(loz);
+        hi[0] = simd::reduceMax(hix);
+        hi[1] = simd::reduceMax(hiy);
+        hi[2] = simd::reduceMax(hiz);
+    }
+    else
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            lo[k] = std::numeric_limits<T>::max();
+            hi[k] = std::numeric_limits<T>::lowest();
+        }
+    }
+
+    for (; i < n; ++i)
+    {
+        if constexpr (WithSum)
+        {
+            sum[0].add(double(x[i]));
+            sum[1].add(double(y[i]));
+            sum[2].add(double(z[i]));
+        }
+        lo[0] = std::min(lo[0], x[i]);
+        lo[1] = std::min(lo[1], y[i]);
+        lo[2] = std::min(lo[2], z[i]);
+        hi[0] = std::max(hi[0], x[i]);
+        hi[1] = std::max(hi[1], y[i]);
+        hi[2] = std::max(hi[2], z[i]);
+    }
+}
+
+// Full moments of one block: the second pass re-reads the block from cache
+// and accumulates co-moments about the block mean
+template <typename T>
+Moments<T> blockMoments(const T *x, const T *y, const T *z, std::size_t n)
+{
+    using P = simd::Pack<T>;
+    constexpr std::size_t W = P::width;
+
+    Moments<T> block;
+    block.count = n;
+
+    blockSumBounds<true>(x, y, z, n, block.sum, block.min, block.max);
+    for (int k = 0; k < 3; ++k)
+        block.mean[k] = block.sum[k].value() / double(n);
+
+    T mx = T(block.mean[0]), my = T(block.mean[1]), mz = T(block.mean[2]);
+    T c[6] = {};
+    std::size_t i = 0;
+    if (n >= W)
+    {
+        P cxx = P::broadcast(T(0)), cxy = cxx, cxz = cxx, cyy = cxx, cyz = cxx, czz = cxx;
+        P pmx = P::broadcast(mx), pmy = P::broadcast(my), pmz = P::broadcast(mz);
+        for (; i + W <= n; i += W)
+        {
+            P dx = P::load(x + i) - pmx;
+            P dy = P::load(y + i) - pmy;
+            P dz = P::load(z + i) - pmz;
+            cxx = simd::fmadd(dx, dx, cxx);
+            cxy = simd::fmadd(dx, dy, cxy);
+            cxz = simd::fmadd(dx, dz, cxz);
+            cyy = simd::fmadd(dy, dy, cyy);
+            cyz = simd::fmadd(dy, dz, cyz);
+            czz = simd::fmadd(dz, dz, czz);
+        }
+        c[0] = simd::reduceAdd(cxx);
+        c[1] = simd::reduceAdd(cxy);
+        c[2] = simd::reduceAdd(cxz);
+        c[3] = simd::reduceAdd(cyy);
+        c[4] = simd::reduceAdd(cyz);
+        c[5] = simd::reduceAdd(czz);
+    }
+    for (; i < n; ++i)
+    {
+        T dx = x[i] - mx, dy = y[i] - my, dz = z[i] - mz;
+        c[0] += dx * dx;
+        c[1] += dx * dy;
+        c[2] += dx * dz;
+        c[3] += dy * dy;
+        c[4] += dy * dz;
+        c[5] += dz * dz;
+    }
+
+    // Co-moments were taken about the rounded mean; shift them to the exact block mean
+    double shift[3] = {double(mx) - block.mean[0], double(my) - block.mean[1], double(mz) - block.mean[2]};
+    double count = double(n);
+    block.m2[0] = double(c[0]) - count * shift[0] * shift[0];
+    block.m2[1] = double(c[1]) - count * shift[0] * shift[1];
+    block.m2[2] = double(c[2]) - count * shift[0] * shift[2];
+    block.m2[3] = double(c[3]) - count * shift[1] * shift[1];
+    block.m2[4] = double(c[4]) - count * shift[1] * shift[2];
+    block.m2[5] = double(c[5]) - count * shift[2] * shift[2];
+    return block;
+}
+
+// Source adapters: SoA reads in place, AoS arrays and strided views are gathered
+// block by block into a local SoA tile
+template <typename T>
+struct SoASource
+{
+    const Vector3SoAView<T> &points;
+
+    template <typename Fn>
+    void forEachBlock(std::size_t begin, std::size_t end, Fn &&fn) const
+    {
+        for (std::size_t b = begin; b < end; b += BlockSize)
+        {
+            std::size_t n = std::min(BlockSize, end - b);
+            fn(points.x + b, points.y + b, points.z + b, n);
+        }
+    }
+};
+
+template <typename T, typename Points = const Vector3<T> *>
+struct AoSSource
+{
+    Points points;
+
+    template <typename Fn>
+    void forEachBlock(std::size_t begin, std::size_t end, Fn &&fn) const
+    {
+        T x[BlockSize], y[BlockSize], z[BlockSize];
+        for (std::size_t b = begin; b < end; b += BlockSize)
+        {
+            std::size_t n = std::min(BlockSize, end - b);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                x[i] = points[b + i].x;
+                y[i] = points[b + i].y;
+                z[i] = points[b + i].z;
+            }
+            fn(x, y, z, n);
+        }
+    }
+};
+
+// Splits the range across threads, reduces each chunk block by block and merges chunks in order
+template <typename T, typename Partial, typename Source, typename BlockFn>
+Partial reduceBlocks(const Source &source, std::size_t count, unsigned threads, BlockFn &&blockFn)
+{
+    unsigned chunks = parallel::chunkCount(count, threads, MinPointsPerThread);
+    std::vector<Partial> partials(chunks);
+    parallel::forEachChunk(count, chunks, [&](unsigned chunk, std::size_t begin, std::size_t end)
+    {
+        Partial &partial = partials[chunk];
+        source.forEachBlock(begin, end, [&](const T *x, const T *y, const T *z, std::size_t n)
+        {
+            blockFn(partial, x, y, z, n);
+        });
+    });
+
+    Partial result = partials[0];
+    for (unsigned c = 1; c < chunks; ++c)
+        result.merge(partials[c]);
+    return result;
+}
+
+// Partial results for the lighter reductions
+struct SumPartial
+{
+    CompensatedSum sum[3];
+
+    void merge(const SumPartial &other)
+    {
+        for (int k = 0; k < 3; ++k)
+            sum[k].add(other.sum[k]);
+    }
+};
+
+template <typename T>
+struct BoundsPartial
+{
+    Bounds3<T> bounds;
+
+    void merge(const BoundsPartial &other) { bounds.encapsulate(other.bounds); }
+};
+
+template <typename T, typename Source>
+PointStats<T> statsImpl(const Source &source, std::size_t count, unsigned threads)
+{
+    Moments<T> moments = reduceBlocks<T, Moments<T>>(source, count, threads,
+        [](Moments<T> &partial, const T *x, const T *y, const T *z, std::size_t n)
+        {
+            partial.merge(blockMoments(x, y, z, n));
+        });
+
+    PointStats<T> stats;
+    stats.count = moments.count;
+    if (moments.count == 0)
+        return stats;
+
+    double n = double(moments.count);
+    stats.sum = Vector3<T>(T(moments.sum[0].value()), T(moments.sum[1].value()), T(moments.sum[2].value()));
+    stats.mean = Vector3<T>(T(moments.sum[0].value() / n), T(moments.sum[1].value() / n),
+                            T(moments.sum[2].value() / n));
+    stats.bounds = Bounds3<T>(Vector3<T>(moments.min[0], moments.min[1], moments.min[2]),
+                              Vector3<T>(moments.max[0], moments.max[1], moments.max[2]));
+
+    const int index[3][3] = {{0, 1, 2}, {1, 3, 4}, {2, 4, 5}};
+    for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 3; ++c)
+            stats.covariance[r][c] = T(moments.m2[index[r][c]] / n);
+    return stats;
+}
+
+template <typename T, typename Source>
+SumPartial sumBlocks(const Source &source, std::size_t count, unsigned threads)
+{
+    return reduceBlocks<T, SumPartial>(source, count, threads,
+        [](SumPartial &partial, const T *x, const T *y, const T *z, std::size_t n)
+        {
+            T lo[3], hi[3];
+            blockSumBounds<true>(x, y, z, n, partial.sum, lo, hi);
+        });
+}
+
+template <typename T, typename Source>
+Vector3<T> sumImpl(const Source &source, std::size_t count, unsigned threads)
+{
+    SumPartial total = sumBlocks<T>(source, count, threads);
+    return Vector3<T>(T(total.sum[0].value()), T(total.sum[1].value()), T(total.sum[2].value()));
+}
+
+template <typename T, typename Source>
+Vector3<T> centroidImpl(const Source &source, std::size_t count, unsigned threads)
+{
+    if (count == 0)
+        return Vector3<T>::zero();
+    SumPartial total = sumBlocks<T>(source, count, threads);
+    double n = double(count);
+    return Vector3<T>(T(total.sum[0].value() / n), T(total.sum[1].value() / n), T(total.sum[2].value() / n));
+}
+
+template <typename T, typename Source>
+Bounds3<T> boundsImpl(const Source &source, std::size_t count, unsigned threads)
+{
+    BoundsPartial<T> total = reduceBlocks<T, BoundsPartial<T>>(source, count, threads,
+        [](BoundsPartial<T> &partial, const T *x, const T *y, const T *z, std::size_t n)
+        {
+            CompensatedSum sum[3];
+            T lo[3], hi[3];
+            blockSumBounds<false>(x, y, z, n, sum, lo, hi);
+            partial.bounds.encapsulate(Bounds3<T>(Vector3<T>(lo[0], lo[1], lo[2]), Vector3<T>(hi[0], hi[1], hi[2])));
+        });
+    return total.bounds;
+}
+
+} // namespace
+
+template <typename T>
+PointStats<T> pointStats(const Vector3SoAView<T> &points, unsigned threads)
+{
+    return statsImpl<T>(SoASource<T>{points}, points.count, threads);
+}
+
+template <typename T>
+PointStats<T> pointStats(const Vector3<T> *points, std::size_t count, unsigned threads)
+{
+    return statsImpl<T>(AoSSource<T>{points}, count, threads);
+}
+
+template <typename T>
+PointStats<T> pointStats(const StridedView<Vector3<T>> &points, unsigned threads)
+{
+    return statsImpl<T>(AoSSource<T, StridedView<Vector3<T>>>{points}, points.count, threads);
+}
+
+template <typename T>
+Vector3<T> sum(const Vector3SoAView<T> &points, unsigned threads)
+{
+    return sumImpl<T>(SoASource<T>{points}, points.count, threads);
+}
+
+template <typename T>
+Vector3<T> sum(const Vector3<T> *points, std::size_t count, unsigned threads)
+{
+    return sumImpl<T>(AoSSource<T>{points}, count, threads);
+}
+
+template <typename T>
+Vector3<T> sum(const StridedView<Vector3<T>> &points, unsigned threads)
+{
+    return sumImpl<T>(AoSSource<T, StridedView<Vector3<T>>>{points}, points.count, threads);
+}
+
+template <typename T>
+Vector3<T> centroid(const Vector3SoAView<T> &points, unsigned threads)
+{
+    return centroidImpl<T>(SoASource<T>{points}, points.count, threads);
+}
+
+template <typename T>
+Vector3<T> centroid(const Vector3<T> *points, std::size_t count, unsigned threads)
+{
+    return centroidImpl<T>(AoSSource<T>{points}, count, threads);
+}
+
+template <typename T>
+Vector3<T> centroid(const StridedView<Vector3<T>> &points, unsigned threads)
+{
+    return centroidImpl<T>(AoSSource<T, StridedView<Vector3<T>>>{points}, points.count, threads);
+}
+
+template <typename T>
+Bounds3<T> bounds(const Vector3SoAView<T> &points, unsigned threads)
+{
+    return boundsImpl<T>(SoASource<T>{points}, points.count, threads);
+}
+
+template <typename T>
+Bounds3<T> bounds(const Vector3<T> *points, std::size_t count, unsigned threads)
+{
+    return boundsImpl<T>(AoSSource<T>{points}, count, threads);
+}
+
+template <typename T>
+Bounds3<T> bounds(const StridedView<Vector3<T>> &points, unsigned threads)
+{
+    return boundsImpl<T>(AoSSource<T, StridedView<Vector3<T>>>{points}, points.count, threads);
+}
+
+#define LUMINA_INSTANTIATE_REDUCE(T)                                                  \
+    template PointStats<T> pointStats<T>(const Vector3SoAView<T> &, unsigned);        \
+    template PointStats<T> pointStats<T>(const Vector3<T> *, std::size_t, unsigned);  \
+    template PointStats<T> pointStats<T>(const StridedView<Vector3<T>> &, unsigned);  \
+    template Vector3<T> sum<T>(const Vector3SoAView<T> &, unsigned);                  \
+    template Vector3<T> sum<T>(const Vector3<T> *, std::size_t, unsigned);            \
+    template Vector3<T> sum<T>(const StridedView<Vector3<T>> &, unsigned);            \
+    template Vector3<T> centroid<T>(const Vector3SoAView<T> &, unsigned);             \
+    template Vector3<T> centroid<T>(const Vector3<T> *, std::size_t, unsigned);       \
+    template Vector3<T> centroid<T>(const StridedView<Vector3<T>> &, unsigned);       \
+    template Bounds3<T> bounds<T>(const Vector3SoAView<T> &, unsigned);               \
+    template Bounds3<T> bounds<T>(const Vector3<T> *, std::size_t, unsigned);         \
+    template Bounds3<T> bounds<T>(const StridedView<Vector3<T>> &, unsigned);
+
+LUMINA_INSTANTIATE_REDUCE(float)
+LUMINA_INSTANTIATE_REDUCE(double)
+
+#undef LUMINA_INSTANTIATE_REDUCE
+
+} // namespace lumina
@@ -0,0 +1,112 @@
+#include <lumina/batch/soa.hpp>
+#include <stdexcept>
+
+namespace lumina
+{
+
+template <typename T>
+Vector3SoA<T>::Vector3SoA() {}
+
+template <typename T>
+Vector3SoA<T>::Vector3SoA(std::size_t count) : x(count), y(count), z(count) {}
+
+template <typename T>
+Vector3SoA<T>::Vector3SoA(const Vector3<T> *vectors, std::size_t count) : x(count), y(count), z(count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        x[i] = vectors[i].x;
+        y[i] = vectors[i].y;
+        z[i] = vectors[i].z;
+    }
+}
+
+// Element access
+template <typename T>
+Vector3<T> Vector3SoA<T>::get(std::size_t index) const
+{
+    if (index >= x.size())
+        throw std::out_of_range("Vector3SoA index out of range");
+    return Vector3<T>(x[index], y[index], z[index]);
+}
+
+template <typename T>
+void Vector3SoA<T>::set(std::size_t index, const Vector3<T> &vector)
+{
+    if (index >= x.size())
+        throw std::out_of_range("Vector3SoA index out of range");
+    x[index] = vector.x;
+    y[index] = vector.y;
+    z[index] = vector.z;
+}
+
+// Size management
+template <typename T>
+std::size_t Vector3SoA<T>::size() const
+{
+    return x.size();
+}
+
+template <typename T>
+bool Vector3SoA<T>::empty() const
+{
+    return x.empty();
+}
+
+template <typename T>
+void Vector3SoA<T>::resize(std::size_t count)
+{
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+}
+
+template <typename T>
+void Vector3SoA<T>::reserve(std::size_t count)
+{
+    x.reserve(count);
+    y.reserve(count);
+    z.reserve(count);
+}
+
+template <typename T>
+void Vector3SoA<T>::clear()
+{
+    x.clear();
+    y.clear();
+    z.clear();
+}
+
+template <typename T>
+void Vector3SoA<T>::push_back(const Vector3<T> &vector)
+{
+    x.push_back(vector.x);
+    y.push_back(vector.y);
+    z.push_back(vector.z);
+}
+
+// Views
+template <typename T>
+Vector3SoAView<T> Vector3SoA<T>::view() const
+{
+    return {x.data(), y.data(), z.data(), x.size()};
+}
+
+template <typename T>
+Vector3SoARef<T> Vector3SoA<T>::ref()
+{
+    return {x.data(), y.data(), z.data(), x.size()};
+}
+
+// AoS conversion
+template <typename T>
+void Vector3SoA<T>::toAoS(Vector3<T> *out) const
+{
+    for (std::size_t i = 0; i < x.size(); ++i)
+        out[i] = Vector3<T>(x[i], y[i], z[i]);
+}
+
+template class Vector3SoA<float>;
+template class Vector3SoA<double>;
+
+} // namespace lumina
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <lumina/batch/math.hpp>
+#include "../parallel/parallel_for.hpp"
+#include "../simd/simd.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <tuple>
+
+// Internal output path shared by the batch kernels that take a StoreMode.
+// A streamed chunk writes regularly up to the first element at which every output is 16-byte aligned,
+// then computes blocks into cache-resident buffers and copies them out with non-temporal stores while
+// prefetching the sequential inputs ahead. Outputs whose alignments never line up write regularly.
+
+namespace lumina::stream
+{
+
+    // Elements computed into the buffers per streamed block; a multiple of 16 keeps every block a whole
+    // number of 16-byte stores for any element size
+    constexpr std::size_t Block = 64;
+    // How far ahead of the current block the inputs are prefetched
+    constexpr std::size_t PrefetchBytes = 2048;
+    constexpr std::size_t CacheLine = 64;
+
+    // An input read sequentially at `stride` bytes per element
+    struct Input
+    {
+        const void *data;
+        std::size_t stride;
+    };
+
+    template <typename T>
+    struct alignas(CacheLine) Buffer
+    {
+        T data[Block];
+    };
+
+    template <typename... Out>
+    inline bool aligned(std::size_t index, Out *...out)
+    {
+        return ((reinterpret_cast<std::uintptr_t>(out + index) % 16 == 0) && ...);
+    }
+
+    // Runs kernel(begin, n, dst...) over chunks of [0, count) on the worker threads; the kernel computes
+    // elements [begin, begin + n) into dst[0, n) of every output.
+    template <typename Kernel, typename... Out>
+    void writeBatch(std::initializer_list<Input> inputs, std::size_t count, StoreMode mode, unsigned threads,
+                    std::size_t minPerThread, Kernel &&kernel, Out *...out)
+    {
+        bool streaming = mode == StoreMode::Streaming ||
+                         (mode == StoreMode::Auto && count * (sizeof(Out) + ...) >= streamingThreshold());
+        unsigned chunks = parallel::chunkCount(count, threads, minPerThread);
+        parallel::forEachChunk(count, chunks, [&](unsigned, std::size_t begin, std::size_t end)
+        {
+            std::size_t head = begin;
+            if (streaming)
+            {
+                while (head < end && head - begin < 16 && !aligned(head, out...))
+                    ++head;
+            }
+            if (!streaming || !aligned(head, out...))
+            {
+                kernel(begin, end - begin, (out + begin)...);
+                return;
+            }
+            kernel(begin, head - begin, (out + begin)...);
+
+            std::tuple<Buffer<Out>...> buffers;
+            std::size_t i = head;
+            for (; i + Block <= end; i += Block)
+            {
+                for (const Input &input : inputs)
+                {
+                    const char *bytes = static_cast<const char *>(input.data);
+                    std::size_t ahead = std::min(i * input.stride + PrefetchBytes, end * input.stride);
+                    std::size_t aheadEnd = std::min(ahead + Block * input.stride, end * input.stride);
+                    for (; ahead < aheadEnd; ahead += CacheLine)
+                        simd::prefetch(bytes + ahead);
+                }
+                std::apply([&](Buffer<Out> &...buffer) { kernel(i, Block, buffer.data...); }, buffers);
+                std::apply([&](const Buffer<Out> &...buffer)
+                {
+                    (simd::streamCopy(out + i, buffer.data, sizeof(buffer.data)), ...);
+                }, buffers);
+            }
+            kernel(i, end - i, (out + i)...);
+            simd::streamFence();
+        });
+    }
+
+} // namespace lumina::stream
@@ -0,0 +1,84 @@
+#include <lumina/batch/transform.hpp>
+#include "../simd/simd_math.hpp"
+#include "stream.hpp"
+
+namespace lumina
+{
+
+namespace
+{
+
+constexpr std::size_t MinVectorsPerThread = std::size_t(1) << 14;
+
+} // namespace
+
+// Columns are summed in the same order as Matrix4 * Vector4
+template <typename T>
+void transformBatch(const Matrix4<T> &matrix, const Vector4<T> *in, Vector4<T> *out, std::size_t count,
+                    StoreMode mode, unsigned threads)
+{
+    const T *m = matrix.data();
+    auto kernel = [in, m](std::size_t begin, std::size_t n, Vector4<T> *dst)
+    {
+        const Vector4<T> *src = in + begin;
+        simd::forEachPack<T>(n, [&](auto tag, std::size_t i)
+        {
+            using P = typename decltype(tag)::type;
+            P c[4], r[4];
+            simd::loadComponents(reinterpret_cast<const T *>(src + i), c);
+            for (int k = 0; k < 4; ++k)
+            {
+                r[k] = P::broadcast(m[k]) * c[0] + P::broadcast(m[4 + k]) * c[1] + P::broadcast(m[8 + k]) * c[2] +
+                       P::broadcast(m[12 + k]) * c[3];
+            }
+            simd::storeComponents(r, reinterpret_cast<T *>(dst + i));
+        });
+    };
+    stream::writeBatch({{in, sizeof(*in)}}, count, mode, threads, MinVectorsPerThread, kernel, out);
+}
+
+template <typename T>
+void normalizeBatch(const Vector3<T> *in, Vector3<T> *out, std::size_t count, MathAccuracy accuracy,
+                    StoreMode mode, unsigned threads)
+{
+    auto kernel = [in, accuracy](std::size_t begin, std::size_t n, Vector3<T> *dst)
+    {
+        const Vector3<T> *src = in + begin;
+        simd::forEachPack<T>(n, accuracy, [&]<MathAccuracy A, typename P>(std::size_t i)
+        {
+            P c[3], r[3];
+            simd::loadComponents(reinterpret_cast<const T *>(src + i), c);
+            P sqrMagnitude = c[0] * c[0] + c[1] * c[1] + c[2] * c[2];
+            P zero = P::broadcast(T(0));
+            auto degenerate = sqrMagnitude == zero;
+            if constexpr (A == MathAccuracy::Fast)
+            {
+                P scale = simd::rsqrt<A>(sqrMagnitude);
+                for (int k = 0; k < 3; ++k)
+                    r[k] = simd::select(degenerate, zero, c[k] * scale);
+            }
+            else
+            {
+                // Divide by the magnitude like Vector3::normalized
+                P magnitude = simd::sqrt(sqrMagnitude);
+                for (int k = 0; k < 3; ++k)
+                    r[k] = simd::select(degenerate, zero, c[k] / magnitude);
+            }
+            simd::storeComponents(r, reinterpret_cast<T *>(dst + i));
+        });
+    };
+    stream::writeBatch({{in, sizeof(*in)}}, count, mode, threads, MinVectorsPerThread, kernel, out);
+}
+
+#define LUMINA_INSTANTIATE_TRANSFORM(T)                                                                            \
+    template void transformBatch<T>(const Matrix4<T> &, const Vector4<T> *, Vector4<T> *, std::size_t, StoreMode,  \
+                                    unsigned);                                                                     \
+    template void normalizeBatch<T>(const Vector3<T> *, Vector3<T> *, std::size_t, MathAccuracy, StoreMode,        \
+                                    unsigned);
+
+LUMINA_INSTANTIATE_TRANSFORM(float)
+LUMINA_INSTANTIATE_TRANSFORM(double)
+
+#undef LUMINA_INSTANTIATE_TRANSFORM
+
+} // namespace lumina
@@ -0,0 +1,86 @@
+#include <lumina/concurrent/atomic_vector.hpp>
+#include "../parallel/parallel_for.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace lumina
+{
+
+namespace
+{
+
+constexpr std::size_t MinEntriesPerThread = std::size_t(1) << 14;
+
+} // namespace
+
+template <typename T>
+BufferedScatterAdd<T>::BufferedScatterAdd(std::size_t targetCount, unsigned slotCount)
+    : targetCount(targetCount), slotCount(slotCount),
+      bucketWidth(std::max<std::size_t>(1, (targetCount + BucketCount - 1) / BucketCount)),
+      buckets(std::size_t(slotCount) * BucketCount)
+{
+    if (slotCount == 0)
+        throw std::invalid_argument("BufferedScatterAdd needs at least one slot");
+    if (targetCount > std::size_t(UINT32_MAX) + 1)
+        throw std::length_error("BufferedScatterAdd supports at most 2^32 targets");
+}
+
+// Size management
+template <typename T>
+std::size_t BufferedScatterAdd<T>::size() const
+{
+    std::size_t total = 0;
+    for (const std::vector<Entry> &bucket : buckets)
+        total += bucket.size();
+    return total;
+}
+
+template <typename T>
+bool BufferedScatterAdd<T>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename T>
+void BufferedScatterAdd<T>::clear()
+{
+    // Keeps the capacity, so steady-state frames do not allocate
+    for (std::vector<Entry> &bucket : buckets)
+        bucket.clear();
+}
+
+// Accumulation
+template <typename T>
+void BufferedScatterAdd<T>::add(unsigned slot, std::uint32_t index, const Vector3<T> &value)
+{
+    if (slot >= slotCount || index >= targetCount)
+        throw std::out_of_range("BufferedScatterAdd slot or index out of range");
+    buckets[std::size_t(slot) * BucketCount + index / bucketWidth].push_back({index, value});
+}
+
+template <typename T>
+void BufferedScatterAdd<T>::merge(Vector3<T> *targets, unsigned threads)
+{
+    unsigned chunks = std::min<unsigned>(parallel::chunkCount(size(), threads, MinEntriesPerThread), BucketCount);
+    parallel::forEachChunk(BucketCount, chunks, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t b = begin; b < end; ++b)
+            for (unsigned slot = 0; slot < slotCount; ++slot)
+            {
+                std::vector<Entry> &bucket = buckets[std::size_t(slot) * BucketCount + b];
+                for (const Entry &entry : bucket)
+                {
+                    Vector3<T> &target = targets[entry.index];
+                    target.x += entry.value.x;
+                    target.y += entry.value.y;
+                    target.z += entry.value.z;
+                }
+                bucket.clear();
+            }
+    });
+}
+
+template class BufferedScatterAdd<float>;
+template class BufferedScatterAdd<double>;
+
+} // namespace lumina
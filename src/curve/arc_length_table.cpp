@@ -0,0 +1,137 @@
+#include <lumina/curve/arc_length_table.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace lumina
+{
+
+namespace
+{
+
+// 5-point Gauss-Legendre nodes and weights on [-1, 1]
+constexpr double GaussNodes[5] = {0.0, -0.5384693101056831, 0.5384693101056831,
+                                  -0.9061798459386640, 0.9061798459386640};
+constexpr double GaussWeights[5] = {0.5688888888888889, 0.4786286704993665, 0.4786286704993665,
+                                    0.2369268850561891, 0.2369268850561891};
+
+// Arc length of one segment between local parameters t0 and t1
+template <typename V, typename Scalar>
+Scalar segmentLength(const CubicCurve<V> &curve, Scalar t0, Scalar t1)
+{
+    Scalar half = (t1 - t0) * Scalar(0.5);
+    Scalar mid = (t1 + t0) * Scalar(0.5);
+    Scalar length = Scalar(0);
+    for (int k = 0; k < 5; ++k)
+        length += Scalar(GaussWeights[k]) * curve.derivative(mid + half * Scalar(GaussNodes[k])).magnitude();
+    return length * half;
+}
+
+} // namespace
+
+template <typename V>
+ArcLengthTable<V>::ArcLengthTable() : lengths(1, Scalar(0)), step(Scalar(1)) {}
+
+template <typename V>
+ArcLengthTable<V>::ArcLengthTable(const CubicSpline<V> &spline, std::size_t samplesPerSegment)
+    : step(Scalar(1) / Scalar(std::max<std::size_t>(1, samplesPerSegment)))
+{
+    samplesPerSegment = std::max<std::size_t>(1, samplesPerSegment);
+    lengths.reserve(spline.segmentCount() * samplesPerSegment + 1);
+    lengths.push_back(Scalar(0));
+    for (const CubicCurve<V> &curve : spline.segments)
+    {
+        for (std::size_t s = 0; s < samplesPerSegment; ++s)
+        {
+            Scalar t0 = Scalar(s) * step;
+            Scalar t1 = s + 1 == samplesPerSegment ? Scalar(1) : Scalar(s + 1) * step;
+            lengths.push_back(lengths.back() + segmentLength(curve, t0, t1));
+        }
+    }
+}
+
+// Table queries
+template <typename V>
+typename ArcLengthTable<V>::Scalar ArcLengthTable<V>::totalLength() const
+{
+    return lengths.back();
+}
+
+template <typename V>
+typename ArcLengthTable<V>::Scalar ArcLengthTable<V>::lengthAt(Scalar u) const
+{
+    if (std::isnan(u))
+        throw std::invalid_argument("ArcLengthTable::lengthAt parameter is NaN");
+    std::size_t intervals = lengths.size() - 1;
+    if (intervals == 0)
+        return Scalar(0);
+    // Clamped before the conversion, which is undefined outside the index range
+    Scalar position = std::clamp(u / step, Scalar(0), Scalar(intervals));
+    std::size_t i = std::min(static_cast<std::size_t>(position), intervals - 1);
+    Scalar f = position - Scalar(i);
+    return lengths[i] + (lengths[i + 1] - lengths[i]) * f;
+}
+
+template <typename V>
+typename ArcLengthTable<V>::Scalar ArcLengthTable<V>::parameterAt(Scalar distance) const
+{
+    if (std::isnan(distance))
+        throw std::invalid_argument("ArcLengthTable::parameterAt distance is NaN");
+    std::size_t intervals = lengths.size() - 1;
+    if (intervals == 0 || distance <= Scalar(0))
+        return Scalar(0);
+    if (distance >= lengths.back())
+        return Scalar(intervals) * step;
+
+    // First sample strictly beyond the distance bounds the interval
+    std::size_t upper = std::upper_bound(lengths.begin(), lengths.end(), distance) - lengths.begin();
+    std::size_t i = upper - 1;
+    Scalar span = lengths[i + 1] - lengths[i];
+    Scalar f = span > Scalar(0) ? (distance - lengths[i]) / span : Scalar(0);
+    return (Scalar(i) + f) * step;
+}
+
+template <typename V>
+void ArcLengthTable<V>::parametersAt(const Scalar *distances, std::size_t count, Scalar *out) const
+{
+    std::size_t intervals = lengths.size() - 1;
+    std::size_t i = 0;
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        Scalar distance = distances[n];
+        if (std::isnan(distance))
+            throw std::invalid_argument("ArcLengthTable::parametersAt distance is NaN");
+        if (intervals == 0 || distance <= Scalar(0))
+        {
+            out[n] = Scalar(0);
+            continue;
+        }
+        if (distance >= lengths.back())
+        {
+            out[n] = Scalar(intervals) * step;
+            continue;
+        }
+
+        // Walk forward from the previous interval; fall back to a search when going backwards
+        if (distance < lengths[i])
+            i = std::upper_bound(lengths.begin(), lengths.end(), distance) - lengths.begin() - 1;
+        while (lengths[i + 1] <= distance)
+            ++i;
+
+        Scalar span = lengths[i + 1] - lengths[i];
+        Scalar f = span > Scalar(0) ? (distance - lengths[i]) / span : Scalar(0);
+        out[n] = (Scalar(i) + f) * step;
+    }
+}
+
+template class ArcLengthTable<Vector2<float>>;
+template class ArcLengthTable<Vector2<double>>;
+template class ArcLengthTable<Vector3<float>>;
+template class ArcLengthTable<Vector3<double>>;
+template class ArcLengthTable<Vector4<float>>;
+template class ArcLengthTable<Vector4<double>>;
+
+} // namespace lumina
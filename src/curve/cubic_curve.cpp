@@ -0,0 +1,105 @@
+#include <lumina/curve/cubic_curve.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+#include "../simd/simd.hpp"
+
+namespace lumina
+{
+
+template <typename V>
+CubicCurve<V>::CubicCurve() : a(), b(), c(), d() {}
+
+template <typename V>
+CubicCurve<V>::CubicCurve(const V &a, const V &b, const V &c, const V &d) : a(a), b(b), c(c), d(d) {}
+
+// Evaluation
+template <typename V>
+V CubicCurve<V>::evaluate(Scalar t) const
+{
+    return ((a * t + b) * t + c) * t + d;
+}
+
+template <typename V>
+V CubicCurve<V>::derivative(Scalar t) const
+{
+    return (a * (Scalar(3) * t) + b * Scalar(2)) * t + c;
+}
+
+template <typename V>
+V CubicCurve<V>::secondDerivative(Scalar t) const
+{
+    return a * (Scalar(6) * t) + b * Scalar(2);
+}
+
+// Batch evaluation: parameters go across SIMD lanes, coefficients are broadcast per component
+template <typename V>
+void CubicCurve<V>::evaluate(const Scalar *t, std::size_t count, V *out) const
+{
+    const Scalar *ca = a.data(), *cb = b.data(), *cc = c.data(), *cd = d.data();
+    simd::forEachPack<Scalar>(count, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P pt = P::load(t + i);
+        for (std::size_t k = 0; k < Dimension; ++k)
+        {
+            P r = simd::fmadd(P::broadcast(ca[k]), pt, P::broadcast(cb[k]));
+            r = simd::fmadd(r, pt, P::broadcast(cc[k]));
+            r = simd::fmadd(r, pt, P::broadcast(cd[k]));
+            simd::storeComponent(r, out + i, k);
+        }
+    });
+}
+
+template <typename V>
+void CubicCurve<V>::derivative(const Scalar *t, std::size_t count, V *out) const
+{
+    const Scalar *ca = a.data(), *cb = b.data(), *cc = c.data();
+    simd::forEachPack<Scalar>(count, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P pt = P::load(t + i);
+        for (std::size_t k = 0; k < Dimension; ++k)
+        {
+            P r = simd::fmadd(P::broadcast(Scalar(3) * ca[k]), pt, P::broadcast(Scalar(2) * cb[k]));
+            r = simd::fmadd(r, pt, P::broadcast(cc[k]));
+            simd::storeComponent(r, out + i, k);
+        }
+    });
+}
+
+// Static constructors from control data
+template <typename V>
+CubicCurve<V> CubicCurve<V>::bezier(const V &p0, const V &p1, const V &p2, const V &p3)
+{
+    return CubicCurve(
+        (p1 - p2) * Scalar(3) + p3 - p0,
+        (p0 + p2) * Scalar(3) - p1 * Scalar(6),
+        (p1 - p0) * Scalar(3),
+        p0);
+}
+
+template <typename V>
+CubicCurve<V> CubicCurve<V>::hermite(const V &p0, const V &m0, const V &p1, const V &m1)
+{
+    return CubicCurve(
+        (p0 - p1) * Scalar(2) + m0 + m1,
+        (p1 - p0) * Scalar(3) - m0 * Scalar(2) - m1,
+        m0,
+        p0);
+}
+
+template <typename V>
+CubicCurve<V> CubicCurve<V>::catmullRom(const V &p0, const V &p1, const V &p2, const V &p3, Scalar tension)
+{
+    return hermite(p1, (p2 - p0) * tension, p2, (p3 - p1) * tension);
+}
+
+template class CubicCurve<Vector2<float>>;
+template class CubicCurve<Vector2<double>>;
+template class CubicCurve<Vector3<float>>;
+template class CubicCurve<Vector3<double>>;
+template class CubicCurve<Vector4<float>>;
+template class CubicCurve<Vector4<double>>;
+
+} // namespace lumina
@@ -0,0 +1,162 @@
+#include <lumina/curve/cubic_spline.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace lumina
+{
+
+namespace
+{
+
+// Local parameters are staged in small runs so the per-segment batch path can use SIMD
+constexpr std::size_t RunCapacity = 256;
+
+// Splits a global parameter into a segment index and a local t in [0, 1]; u is clamped before the
+// conversion to an index, which is undefined outside its range
+template <typename Scalar>
+inline std::size_t locate(Scalar u, std::size_t segmentCount, Scalar &t)
+{
+    if (std::isnan(u))
+        throw std::invalid_argument("CubicSpline parameter is NaN");
+    Scalar clamped = std::clamp(u, Scalar(0), Scalar(segmentCount));
+    std::size_t segment = std::min(static_cast<std::size_t>(clamped), segmentCount - 1);
+    t = clamped - Scalar(segment);
+    return segment;
+}
+
+template <typename V, typename Scalar, typename Fn>
+void forEachRun(const std::vector<CubicCurve<V>> &segments, const Scalar *u, std::size_t count, V *out, Fn &&fn)
+{
+    if (segments.empty())
+        throw std::out_of_range("CubicSpline has no segments");
+
+    Scalar local[RunCapacity];
+    std::size_t i = 0;
+    while (i < count)
+    {
+        std::size_t segment = locate(u[i], segments.size(), local[0]);
+        std::size_t run = 1;
+        while (i + run < count && run < RunCapacity)
+        {
+            Scalar t;
+            if (locate(u[i + run], segments.size(), t) != segment)
+                break;
+            local[run++] = t;
+        }
+        fn(segments[segment], local, run, out + i);
+        i += run;
+    }
+}
+
+} // namespace
+
+template <typename V>
+CubicSpline<V>::CubicSpline() {}
+
+template <typename V>
+CubicSpline<V>::CubicSpline(std::vector<CubicCurve<V>> segments) : segments(std::move(segments)) {}
+
+// Spline properties
+template <typename V>
+std::size_t CubicSpline<V>::segmentCount() const
+{
+    return segments.size();
+}
+
+// Evaluation
+template <typename V>
+V CubicSpline<V>::evaluate(Scalar u) const
+{
+    if (segments.empty())
+        throw std::out_of_range("CubicSpline has no segments");
+    Scalar t;
+    std::size_t segment = locate(u, segments.size(), t);
+    return segments[segment].evaluate(t);
+}
+
+template <typename V>
+V CubicSpline<V>::derivative(Scalar u) const
+{
+    if (segments.empty())
+        throw std::out_of_range("CubicSpline has no segments");
+    Scalar t;
+    std::size_t segment = locate(u, segments.size(), t);
+    return segments[segment].derivative(t);
+}
+
+template <typename V>
+void CubicSpline<V>::evaluate(const Scalar *u, std::size_t count, V *out) const
+{
+    forEachRun(segments, u, count, out, [](const CubicCurve<V> &curve, const Scalar *t, std::size_t n, V *dst)
+    {
+        curve.evaluate(t, n, dst);
+    });
+}
+
+template <typename V>
+void CubicSpline<V>::derivative(const Scalar *u, std::size_t count, V *out) const
+{
+    forEachRun(segments, u, count, out, [](const CubicCurve<V> &curve, const Scalar *t, std::size_t n, V *dst)
+    {
+        curve.derivative(t, n, dst);
+    });
+}
+
+// Static constructors from control data
+template <typename V>
+CubicSpline<V> CubicSpline<V>::catmullRom(const V *points, std::size_t count, Scalar tension)
+{
+    if (count < 2)
+        throw std::invalid_argument("CubicSpline::catmullRom needs at least two points");
+
+    std::vector<CubicCurve<V>> segments;
+    segments.reserve(count - 1);
+    for (std::size_t i = 0; i + 1 < count; ++i)
+    {
+        V before = i > 0 ? points[i - 1] : points[0] * Scalar(2) - points[1];
+        V after = i + 2 < count ? points[i + 2] : points[i + 1] * Scalar(2) - points[i];
+        segments.push_back(CubicCurve<V>::catmullRom(before, points[i], points[i + 1], after, tension));
+    }
+    return CubicSpline(std::move(segments));
+}
+
+template <typename V>
+CubicSpline<V> CubicSpline<V>::bezier(const V *controlPoints, std::size_t count)
+{
+    if (count < 4 || (count - 1) % 3 != 0)
+        throw std::invalid_argument("CubicSpline::bezier needs 3 * n + 1 control points");
+
+    std::vector<CubicCurve<V>> segments;
+    segments.reserve((count - 1) / 3);
+    for (std::size_t i = 0; i + 3 < count; i += 3)
+        segments.push_back(CubicCurve<V>::bezier(controlPoints[i], controlPoints[i + 1],
+                                                 controlPoints[i + 2], controlPoints[i + 3]));
+    return CubicSpline(std::move(segments));
+}
+
+template <typename V>
+CubicSpline<V> CubicSpline<V>::hermite(const V *points, const V *tangents, std::size_t count)
+{
+    if (count < 2)
+        throw std::invalid_argument("CubicSpline::hermite needs at least two points");
+
+    std::vector<CubicCurve<V>> segments;
+    segments.reserve(count - 1);
+    for (std::size_t i = 0; i + 1 < count; ++i)
+        segments.push_back(CubicCurve<V>::hermite(points[i], tangents[i], points[i + 1], tangents[i + 1]));
+    return CubicSpline(std::move(segments));
+}
+
+template class CubicSpline<Vector2<float>>;
+template class CubicSpline<Vector2<double>>;
+template class CubicSpline<Vector3<float>>;
+template class CubicSpline<Vector3<double>>;
+template class CubicSpline<Vector4<float>>;
+template class CubicSpline<Vector4<double>>;
+
+} // namespace lumina
@@ -0,0 +1,102 @@
+#include <lumina/geometry/bounds.hpp>
+#include <limits>
+
+namespace lumina
+{
+
+// Default bounds are empty (min > max) so the first encapsulate snaps to the point
+template <typename T>
+Bounds3<T>::Bounds3()
+    : min(std::numeric_limits<T>::max()), max(std::numeric_limits<T>::lowest()) {}
+
+template <typename T>
+Bounds3<T>::Bounds3(const Vector3<T> &min, const Vector3<T> &max) : min(min), max(max) {}
+
+// Comparison operators
+template <typename T>
+bool Bounds3<T>::operator==(const Bounds3 &other) const
+{
+    return min == other.min && max == other.max;
+}
+
+template <typename T>
+bool Bounds3<T>::operator!=(const Bounds3 &other) const
+{
+    return !(*this == other);
+}
+
+// Bounds properties
+template <typename T>
+bool Bounds3<T>::isEmpty() const
+{
+    return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+template <typename T>
+Vector3<T> Bounds3<T>::center() const
+{
+    return (min + max) * T(0.5);
+}
+
+template <typename T>
+Vector3<T> Bounds3<T>::size() const
+{
+    return max - min;
+}
+
+template <typename T>
+Vector3<T> Bounds3<T>::extents() const
+{
+    return (max - min) * T(0.5);
+}
+
+// Queries
+template <typename T>
+bool Bounds3<T>::contains(const Vector3<T> &point) const
+{
+    return point.x >= min.x && point.x <= max.x &&
+           point.y >= min.y && point.y <= max.y &&
+           point.z >= min.z && point.z <= max.z;
+}
+
+template <typename T>
+bool Bounds3<T>::overlaps(const Bounds3 &other) const
+{
+    return min.x <= other.max.x && max.x >= other.min.x &&
+           min.y <= other.max.y && max.y >= other.min.y &&
+           min.z <= other.max.z && max.z >= other.min.z;
+}
+
+// Growth
+template <typename T>
+void Bounds3<T>::encapsulate(const Vector3<T> &point)
+{
+    min = Vector3<T>::min(min, point);
+    max = Vector3<T>::max(max, point);
+}
+
+template <typename T>
+void Bounds3<T>::encapsulate(const Bounds3 &other)
+{
+    min = Vector3<T>::min(min, other.min);
+    max = Vector3<T>::max(max, other.max);
+}
+
+// Static predefined bounds
+template <typename T>
+Bounds3<T> Bounds3<T>::empty()
+{
+    return Bounds3();
+}
+
+// Static bounds operations
+template <typename T>
+Bounds3<T> Bounds3<T>::merge(const Bounds3 &a, const Bounds3 &b)
+{
+    return Bounds3(Vector3<T>::min(a.min, b.min), Vector3<T>::max(a.max, b.max));
+}
+
+template class Bounds3<float>;
+template class Bounds3<double>;
+
+} // namespace lumina
@@ -0,0 +1,76 @@
+#include <lumina/geometry/frustum.hpp>
+#include <stdexcept>
+
+namespace lumina
+{
+
+// Default frustum is the [-1, 1] cube
+template <typename T>
+Frustum<T>::Frustum()
+{
+    planes[Left] = Plane<T>(T(1), T(0), T(0), T(1));
+    planes[Right] = Plane<T>(T(-1), T(0), T(0), T(1));
+    planes[Bottom] = Plane<T>(T(0), T(1), T(0), T(1));
+    planes[Top] = Plane<T>(T(0), T(-1), T(0), T(1));
+    planes[Near] = Plane<T>(T(0), T(0), T(1), T(1));
+    planes[Far] = Plane<T>(T(0), T(0), T(-1), T(1));
+}
+
+// Planes are normalized so sphere radii compare against true distances
+template <typename T>
+Frustum<T>::Frustum(const Plane<T> &left, const Plane<T> &right,
+                    const Plane<T> &bottom, const Plane<T> &top,
+                    const Plane<T> &near, const Plane<T> &far)
+{
+    planes[Left] = left.normalized();
+    planes[Right] = right.normalized();
+    planes[Bottom] = bottom.normalized();
+    planes[Top] = top.normalized();
+    planes[Near] = near.normalized();
+    planes[Far] = far.normalized();
+}
+
+// Array-style access operators
+template <typename T>
+Plane<T> &Frustum<T>::operator[](int index)
+{
+    if (index < 0 || index >= PlaneCount)
+        throw std::out_of_range("Frustum index out of range");
+    return planes[index];
+}
+
+template <typename T>
+const Plane<T> &Frustum<T>::operator[](int index) const
+{
+    if (index < 0 || index >= PlaneCount)
+        throw std::out_of_range("Frustum index out of range");
+    return planes[index];
+}
+
+// Containment tests
+template <typename T>
+bool Frustum<T>::containsPoint(const Vector3<T> &point) const
+{
+    for (const Plane<T> &plane : planes)
+    {
+        if (plane.signedDistance(point) < T(0))
+            return false;
+    }
+    return true;
+}
+
+template <typename T>
+bool Frustum<T>::intersectsSphere(const Vector3<T> &center, const T radius) const
+{
+    for (const Plane<T> &plane : planes)
+    {
+        if (plane.signedDistance(center) < -radius)
+            return false;
+    }
+    return true;
+}
+
+template class Frustum<float>;
+template class Frustum<double>;
+
+} // namespace lumina
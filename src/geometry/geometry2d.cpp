@@ -0,0 +1,241 @@
+#include <lumina/geometry/geometry2d.hpp>
+#include "../parallel/parallel_for.hpp"
+#include "../simd/simd.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace lumina
+{
+
+namespace
+{
+
+constexpr std::size_t MinHullPointsPerThread = std::size_t(1) << 14;
+// Polygon tests cost one pass over the edges per point, so fewer points already fill a thread
+constexpr std::size_t MinPolygonWordsPerThread = std::size_t(1) << 4;
+
+template <typename T>
+bool lexicographicLess(const Vector2<T> &a, const Vector2<T> &b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Andrew's monotone chain over points sorted by (x, y) without duplicates: the lower chain left to
+// right, then the upper chain back, popping every vertex that does not make a strict left turn
+template <typename T>
+std::vector<Vector2<T>> monotoneChain(const std::vector<Vector2<T>> &sorted)
+{
+    std::size_t count = sorted.size();
+    if (count < 3)
+        return sorted;
+    std::vector<Vector2<T>> hull(2 * count);
+    std::size_t size = 0;
+    auto push = [&](const Vector2<T> &p, std::size_t floor)
+    {
+        while (size > floor && Vector2<T>::cross(hull[size - 1] - hull[size - 2], p - hull[size - 2]) <= T(0))
+            --size;
+        hull[size++] = p;
+    };
+    for (std::size_t i = 0; i < count; ++i)
+        push(sorted[i], 1);
+    std::size_t lowerSize = size;
+    for (std::size_t i = count - 1; i-- > 0;)
+        push(sorted[i], lowerSize);
+    // The upper chain ends back at the first point
+    hull.resize(size - 1);
+    return hull;
+}
+
+// Akl-Toussaint filter: points strictly inside the quadrilateral of the x and y extremes cannot be
+// hull vertices, which usually leaves only a small fraction of the input to sort
+template <typename T>
+std::vector<Vector2<T>> hullOfRange(const Vector2<T> *begin, const Vector2<T> *end)
+{
+    if (begin == end)
+        return {};
+    Vector2<T> quad[4] = {*begin, *begin, *begin, *begin};
+    for (const Vector2<T> *p = begin; p != end; ++p)
+    {
+        if (lexicographicLess(*p, quad[0]))
+            quad[0] = *p;
+        if (p->y < quad[1].y)
+            quad[1] = *p;
+        if (lexicographicLess(quad[2], *p))
+            quad[2] = *p;
+        if (p->y > quad[3].y)
+            quad[3] = *p;
+    }
+    // Counter-clockwise, so inside is strictly left of every edge; a degenerate quadrilateral has
+    // an edge nothing is strictly left of and keeps every point
+    std::vector<Vector2<T>> sorted;
+    for (const Vector2<T> *p = begin; p != end; ++p)
+    {
+        bool inside = true;
+        for (int e = 0; e < 4 && inside; ++e)
+            inside = Vector2<T>::cross(quad[(e + 1) % 4] - quad[e], *p - quad[e]) > T(0);
+        if (!inside)
+            sorted.push_back(*p);
+    }
+    std::sort(sorted.begin(), sorted.end(), lexicographicLess<T>);
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    return monotoneChain(sorted);
+}
+
+// cross(b - a, c - a) is split into its two products and callers compare them instead of taking
+// the difference, so no target can contract it into an fmadd and shared endpoints test exactly zero
+template <typename P>
+struct Orientation
+{
+    P left, right;
+};
+
+template <typename P>
+Orientation<P> orientation(P ax, P ay, P bx, P by, P cx, P cy)
+{
+    return {(bx - ax) * (cy - ay), (by - ay) * (cx - ax)};
+}
+
+// The two orientations are zero or of opposite signs
+template <typename P>
+typename P::Mask straddles(const Orientation<P> &d1, const Orientation<P> &d2)
+{
+    return ((d1.left <= d1.right) & (d2.left >= d2.right)) | ((d1.left >= d1.right) & (d2.left <= d2.right));
+}
+
+// Each segment's endpoints straddle the other's line, and the bounding boxes overlap; the box test
+// settles the collinear case where every orientation is zero
+template <typename P>
+typename P::Mask intersectMask(const P (&p0)[2], const P (&p1)[2], const P (&q0)[2], const P (&q1)[2])
+{
+    auto mask = straddles(orientation(q0[0], q0[1], q1[0], q1[1], p0[0], p0[1]),
+                          orientation(q0[0], q0[1], q1[0], q1[1], p1[0], p1[1])) &
+                straddles(orientation(p0[0], p0[1], p1[0], p1[1], q0[0], q0[1]),
+                          orientation(p0[0], p0[1], p1[0], p1[1], q1[0], q1[1]));
+    for (int k = 0; k < 2; ++k)
+    {
+        mask = mask & (simd::min(p0[k], p1[k]) <= simd::max(q0[k], q1[k])) &
+               (simd::min(q0[k], q1[k]) <= simd::max(p0[k], p1[k]));
+    }
+    return mask;
+}
+
+} // namespace
+
+template <typename T>
+std::vector<Vector2<T>> convexHull(const Vector2<T> *points, std::size_t count, unsigned threads)
+{
+    unsigned chunks = parallel::chunkCount(count, threads, MinHullPointsPerThread);
+    if (chunks <= 1)
+        return hullOfRange(points, points + count);
+
+    // Every point of the full hull is a hull point of its own chunk
+    std::vector<std::vector<Vector2<T>>> partial(chunks);
+    parallel::forEachChunk(count, chunks, [&](unsigned chunk, std::size_t begin, std::size_t end)
+    {
+        partial[chunk] = hullOfRange(points + begin, points + end);
+    });
+    std::vector<Vector2<T>> candidates;
+    for (const std::vector<Vector2<T>> &part : partial)
+        candidates.insert(candidates.end(), part.begin(), part.end());
+    return hullOfRange(candidates.data(), candidates.data() + candidates.size());
+}
+
+// Winding number per lane: an upward edge with the point strictly to its left adds one, a downward
+// edge with the point strictly to its right subtracts one. Edge vertices are broadcast, so each pack
+// of points walks the polygon once.
+template <typename T>
+void insidePolygon(const Vector2<T> *points, std::size_t count, const Vector2<T> *polygon, std::size_t vertexCount,
+                   std::uint64_t *masks, unsigned threads)
+{
+    if (vertexCount < 3)
+        throw std::invalid_argument("insidePolygon needs at least three vertices");
+
+    // Chunks split on mask words so no two threads write the same word
+    std::size_t words = maskWordCount(count);
+    unsigned chunks = parallel::chunkCount(words, threads, MinPolygonWordsPerThread);
+    parallel::forEachChunk(words, chunks, [&](unsigned, std::size_t wordBegin, std::size_t wordEnd)
+    {
+        std::fill(masks + wordBegin, masks + wordEnd, std::uint64_t(0));
+        std::size_t begin = wordBegin * 64;
+        std::size_t end = std::min(count, wordEnd * 64);
+        simd::forEachPack<T>(end - begin, [&](auto tag, std::size_t offset)
+        {
+            using P = typename decltype(tag)::type;
+            std::size_t i = begin + offset;
+            P px = simd::loadComponent<P>(points, i, 0);
+            P py = simd::loadComponent<P>(points, i, 1);
+            P zero = P::broadcast(T(0)), one = P::broadcast(T(1));
+            P winding = zero;
+            for (std::size_t e = 0; e < vertexCount; ++e)
+            {
+                const Vector2<T> &a = polygon[e];
+                const Vector2<T> &b = polygon[e + 1 == vertexCount ? 0 : e + 1];
+                P ax = P::broadcast(a.x), ay = P::broadcast(a.y);
+                Orientation<P> side = orientation(ax, ay, P::broadcast(b.x), P::broadcast(b.y), px, py);
+                auto aBelow = ay <= py, bBelow = P::broadcast(b.y) <= py;
+                auto up = aBelow & ~bBelow & (side.left > side.right);
+                auto down = ~aBelow & bBelow & (side.left < side.right);
+                winding = winding + simd::select(up, one, zero) - simd::select(down, one, zero);
+            }
+            masks[i / 64] |= std::uint64_t((~(winding == zero)).bits()) << (i % 64);
+        });
+    });
+}
+
+template <typename T>
+bool segmentsIntersect(const Vector2<T> &p0, const Vector2<T> &p1, const Vector2<T> &q0, const Vector2<T> &q1)
+{
+    using P = simd::ScalarPack<T>;
+    const P a0[2] = {P::broadcast(p0.x), P::broadcast(p0.y)}, a1[2] = {P::broadcast(p1.x), P::broadcast(p1.y)};
+    const P b0[2] = {P::broadcast(q0.x), P::broadcast(q0.y)}, b1[2] = {P::broadcast(q1.x), P::broadcast(q1.y)};
+    return intersectMask(a0, a1, b0, b1).all();
+}
+
+template <typename T>
+bool segmentIntersection(const Vector2<T> &p0, const Vector2<T> &p1, const Vector2<T> &q0, const Vector2<T> &q1,
+                         Vector2<T> &point)
+{
+    Vector2<T> r = p1 - p0, s = q1 - q0, offset = q0 - p0;
+    T denominator = Vector2<T>::cross(r, s);
+    if (denominator == T(0))
+        return false;
+    T t = Vector2<T>::cross(offset, s) / denominator;
+    T u = Vector2<T>::cross(offset, r) / denominator;
+    if (!(t >= T(0) && t <= T(1) && u >= T(0) && u <= T(1)))
+        return false;
+    point = p0 + r * t;
+    return true;
+}
+
+template <typename T>
+void segmentsIntersect(const Vector2<T> *p0, const Vector2<T> *p1, const Vector2<T> *q0, const Vector2<T> *q1,
+                       std::size_t count, std::uint64_t *masks)
+{
+    std::fill(masks, masks + maskWordCount(count), std::uint64_t(0));
+    simd::forEachPack<T>(count, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        const P a0[2] = {simd::loadComponent<P>(p0, i, 0), simd::loadComponent<P>(p0, i, 1)};
+        const P a1[2] = {simd::loadComponent<P>(p1, i, 0), simd::loadComponent<P>(p1, i, 1)};
+        const P b0[2] = {simd::loadComponent<P>(q0, i, 0), simd::loadComponent<P>(q0, i, 1)};
+        const P b1[2] = {simd::loadComponent<P>(q1, i, 0), simd::loadComponent<P>(q1, i, 1)};
+        masks[i / 64] |= std::uint64_t(intersectMask(a0, a1, b0, b1).bits()) << (i % 64);
+    });
+}
+
+#define LUMINA_INSTANTIATE_GEOMETRY2D(T)                                                                               \
+    template std::vector<Vector2<T>> convexHull(const Vector2<T> *, std::size_t, unsigned);                            \
+    template void insidePolygon(const Vector2<T> *, std::size_t, const Vector2<T> *, std::size_t, std::uint64_t *,     \
+                                unsigned);                                                                             \
+    template bool segmentsIntersect(const Vector2<T> &, const Vector2<T> &, const Vector2<T> &, const Vector2<T> &);   \
+    template bool segmentIntersection(const Vector2<T> &, const Vector2<T> &, const Vector2<T> &, const Vector2<T> &,  \
+                                      Vector2<T> &);                                                                   \
+    template void segmentsIntersect(const Vector2<T> *, const Vector2<T> *, const Vector2<T> *, const Vector2<T> *,    \
+                                    std::size_t, std::uint64_t *);
+
+LUMINA_INSTANTIATE_GEOMETRY2D(float)
+LUMINA_INSTANTIATE_GEOMETRY2D(double)
+
+#undef LUMINA_INSTANTIATE_GEOMETRY2D
+
+} // namespace lumina
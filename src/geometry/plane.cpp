@@ -0,0 +1,77 @@
+#include <lumina/geometry/plane.hpp>
+#include <cmath>
+
+namespace lumina
+{
+
+template <typename T>
+Plane<T>::Plane() : normal(Vector3<T>::up()), distance(T(0)) {}
+
+template <typename T>
+Plane<T>::Plane(const Vector3<T> &normal, const T distance) : normal(normal), distance(distance) {}
+
+template <typename T>
+Plane<T>::Plane(const Vector3<T> &normal, const Vector3<T> &point)
+    : normal(normal), distance(-Vector3<T>::dot(normal, point)) {}
+
+template <typename T>
+Plane<T>::Plane(const T a, const T b, const T c, const T d) : normal(a, b, c), distance(d) {}
+
+// Comparison operators
+template <typename T>
+bool Plane<T>::operator==(const Plane &other) const
+{
+    return normal == other.normal && distance == other.distance;
+}
+
+template <typename T>
+bool Plane<T>::operator!=(const Plane &other) const
+{
+    return !(*this == other);
+}
+
+// Plane properties
+template <typename T>
+Plane<T> Plane<T>::normalized() const
+{
+    T mag = normal.magnitude();
+    if (mag == T(0))
+        return *this;
+    return Plane(normal / mag, distance / mag);
+}
+
+template <typename T>
+Plane<T> Plane<T>::flipped() const
+{
+    return Plane(-normal, -distance);
+}
+
+template <typename T>
+T Plane<T>::signedDistance(const Vector3<T> &point) const
+{
+    return Vector3<T>::dot(normal, point) + distance;
+}
+
+template <typename T>
+Vector3<T> Plane<T>::closestPoint(const Vector3<T> &point) const
+{
+    // Works for non normalized planes too: project along n / |n|^2
+    T sqrMag = normal.sqrMagnitude();
+    if (sqrMag == T(0))
+        return point;
+    return point - normal * (signedDistance(point) / sqrMag);
+}
+
+// Static plane operations
+template <typename T>
+Plane<T> Plane<T>::fromPoints(const Vector3<T> &a, const Vector3<T> &b, const Vector3<T> &c)
+{
+    // Counter-clockwise winding a -> b -> c faces the normal
+    Vector3<T> n = Vector3<T>::cross(b - a, c - a).normalized();
+    return Plane(n, a);
+}
+
+template class Plane<float>;
+template class Plane<double>;
+
+} // namespace lumina
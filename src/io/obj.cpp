@@ -0,0 +1,109 @@
+#include <lumina/io/obj.hpp>
+#include "scan.hpp"
+
+namespace lumina
+{
+
+namespace
+{
+
+template <typename T>
+struct ObjChunk
+{
+    ObjVertices<T> vertices;
+    const char *error = nullptr;
+};
+
+template <typename T>
+bool parseVector3(const char *p, const char *end, std::vector<Vector3<T>> &out)
+{
+    T x, y, z;
+    if (!io::parseField(p, end, x) || !io::parseField(p, end, y) || !io::parseField(p, end, z))
+        return false;
+    out.emplace_back(x, y, z);
+    return true;
+}
+
+template <typename T>
+bool parseTexcoord(const char *p, const char *end, std::vector<Vector2<T>> &out)
+{
+    T u, v = T(0);
+    if (!io::parseField(p, end, u))
+        return false;
+    if (!io::isBlank(p, end) && !io::parseField(p, end, v))
+        return false;
+    out.emplace_back(u, v);
+    return true;
+}
+
+// Parses the vertex statements of [begin, end); with positionsOnly set, vn and vt lines are skipped too
+template <typename T>
+std::vector<ObjChunk<T>> parseObj(std::string_view text, bool positionsOnly, unsigned threads)
+{
+    const char *begin = text.data();
+    auto chunks = io::parseLineChunks<ObjChunk<T>>(begin, begin + text.size(), threads,
+                                                   [&](const char *first, const char *last, ObjChunk<T> &chunk)
+    {
+        io::forEachLine(first, last, [&](const char *line, const char *lineEnd)
+        {
+            const char *p = io::skipSeparators(line, lineEnd);
+            // A keyword ends at a separator or at the end of the line, where its numbers are missing
+            auto keywordEnds = [&](const char *q) { return q == lineEnd || io::isSeparator(*q); };
+            if (p == lineEnd || p[0] != 'v')
+                return true;
+            bool ok = true;
+            if (keywordEnds(p + 1))
+                ok = parseVector3(p + 1, lineEnd, chunk.vertices.positions);
+            else if (positionsOnly || lineEnd - p < 2 || !keywordEnds(p + 2))
+                return true;
+            else if (p[1] == 'n')
+                ok = parseVector3(p + 2, lineEnd, chunk.vertices.normals);
+            else if (p[1] == 't')
+                ok = parseTexcoord(p + 2, lineEnd, chunk.vertices.texcoords);
+            if (!ok)
+                chunk.error = line;
+            return ok;
+        });
+    });
+    io::checkChunks(chunks, begin, "readObj");
+    return chunks;
+}
+
+} // namespace
+
+template <typename T>
+ObjVertices<T> readObj(std::string_view text, unsigned threads)
+{
+    std::vector<ObjChunk<T>> chunks = parseObj<T>(text, false, threads);
+    ObjVertices<T> vertices;
+    io::gatherChunks(chunks, [](ObjChunk<T> &chunk) -> auto & { return chunk.vertices.positions; }, vertices.positions);
+    io::gatherChunks(chunks, [](ObjChunk<T> &chunk) -> auto & { return chunk.vertices.normals; }, vertices.normals);
+    io::gatherChunks(chunks, [](ObjChunk<T> &chunk) -> auto & { return chunk.vertices.texcoords; },
+                     vertices.texcoords);
+    return vertices;
+}
+
+template <typename T>
+ObjVertices<T> readObjFile(const std::string &path, unsigned threads)
+{
+    return readObj<T>(io::readFile(path), threads);
+}
+
+template <typename T>
+void readObjPositions(std::string_view text, Vector3SoA<T> &positions, unsigned threads)
+{
+    std::vector<ObjChunk<T>> chunks = parseObj<T>(text, true, threads);
+    io::gatherChunks(chunks, [](ObjChunk<T> &chunk) -> auto & { return chunk.vertices.positions; }, positions);
+}
+
+#define LUMINA_INSTANTIATE_OBJ(T)                                           \
+    template ObjVertices<T> readObj<T>(std::string_view, unsigned);         \
+    template ObjVertices<T> readObjFile<T>(const std::string &, unsigned);  \
+    template void readObjPositions<T>(std::string_view, Vector3SoA<T> &, unsigned);
+
+LUMINA_INSTANTIATE_OBJ(float)
+LUMINA_INSTANTIATE_OBJ(double)
+
+#undef LUMINA_INSTANTIATE_OBJ
+
+} // namespace lumina
@@ -0,0 +1,477 @@
+#include <lumina/io/ply.hpp>
+#include "scan.hpp"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace lumina
+{
+
+namespace
+{
+
+constexpr std::size_t MinVerticesPerThread = std::size_t(1) << 16;
+
+enum class Format
+{
+    Ascii,
+    BinaryLittleEndian,
+    BinaryBigEndian
+};
+
+enum class ScalarType
+{
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
+
+struct Property
+{
+    std::string name;
+    ScalarType type;
+    // List properties store a count of countType followed by that many values of type
+    bool isList;
+    ScalarType countType;
+};
+
+struct Element
+{
+    std::string name;
+    std::size_t count;
+    std::vector<Property> properties;
+};
+
+struct Header
+{
+    Format format;
+    std::vector<Element> elements;
+    const char *body;
+};
+
+[[noreturn]] void fail(const std::string &message)
+{
+    throw std::invalid_argument("readPly: " + message);
+}
+
+std::size_t scalarSize(ScalarType type)
+{
+    switch (type)
+    {
+    case ScalarType::Int8:
+    case ScalarType::UInt8:
+        return 1;
+    case ScalarType::Int16:
+    case ScalarType::UInt16:
+        return 2;
+    case ScalarType::Int32:
+    case ScalarType::UInt32:
+    case ScalarType::Float32:
+        return 4;
+    case ScalarType::Float64:
+        break;
+    }
+    return 8;
+}
+
+ScalarType parseScalarType(std::string_view name)
+{
+    static const std::array<std::pair<std::string_view, ScalarType>, 16> names = {{
+        {"char", ScalarType::Int8},     {"int8", ScalarType::Int8},       {"uchar", ScalarType::UInt8},
+        {"uint8", ScalarType::UInt8},   {"short", ScalarType::Int16},     {"int16", ScalarType::Int16},
+        {"ushort", ScalarType::UInt16}, {"uint16", ScalarType::UInt16},   {"int", ScalarType::Int32},
+        {"int32", ScalarType::Int32},   {"uint", ScalarType::UInt32},     {"uint32", ScalarType::UInt32},
+        {"float", ScalarType::Float32}, {"float32", ScalarType::Float32}, {"double", ScalarType::Float64},
+        {"float64", ScalarType::Float64},
+    }};
+    for (const auto &[text, type] : names)
+        if (text == name)
+            return type;
+    fail("unknown property type '" + std::string(name) + "'");
+}
+
+// Whitespace separated words of a header line
+std::vector<std::string_view> words(const char *p, const char *end)
+{
+    std::vector<std::string_view> result;
+    while (true)
+    {
+        p = io::skipSeparators(p, end);
+        if (p == end)
+            return result;
+        const char *word = p;
+        while (p < end && !io::isSeparator(*p))
+            ++p;
+        result.emplace_back(word, std::size_t(p - word));
+    }
+}
+
+Header parseHeader(std::string_view data)
+{
+    const char *p = data.data();
+    const char *end = p + data.size();
+    Header header{Format::Ascii, {}, nullptr};
+    bool sawFormat = false;
+
+    for (std::size_t lineNumber = 0; p < end; ++lineNumber)
+    {
+        const char *lineEnd = io::findNewline(p, end);
+        std::vector<std::string_view> line = words(p, lineEnd);
+        p = lineEnd == end ? end : lineEnd + 1;
+
+        if (lineNumber == 0)
+        {
+            if (line.size() != 1 || line[0] != "ply")
+                fail("missing 'ply' signature");
+            continue;
+        }
+        if (line.empty() || line[0] == "comment" || line[0] == "obj_info")
+            continue;
+        if (line[0] == "end_header")
+        {
+            if (!sawFormat)
+                fail("missing format line");
+            header.body = p;
+            return header;
+        }
+        if (line[0] == "format" && line.size() == 3)
+        {
+            if (line[1] == "ascii")
+                header.format = Format::Ascii;
+            else if (line[1] == "binary_little_endian")
+                header.format = Format::BinaryLittleEndian;
+            else if (line[1] == "binary_big_endian")
+                header.format = Format::BinaryBigEndian;
+            else
+                fail("unknown format '" + std::string(line[1]) + "'");
+            sawFormat = true;
+        }
+        else if (line[0] == "element" && line.size() == 3)
+        {
+            std::size_t count = 0;
+            auto [next, error] = std::from_chars(line[2].data(), line[2].data() + line[2].size(), count);
+            if (error != std::errc() || next != line[2].data() + line[2].size())
+                fail("bad element count '" + std::string(line[2]) + "'");
+            header.elements.push_back({std::string(line[1]), count, {}});
+        }
+        else if (line[0] == "property" && !header.elements.empty())
+        {
+            if (line.size() == 3)
+                header.elements.back().properties.push_back(
+                    {std::string(line[2]), parseScalarType(line[1]), false, ScalarType::UInt8});
+            else if (line.size() == 5 && line[1] == "list")
+                header.elements.back().properties.push_back(
+                    {std::string(line[4]), parseScalarType(line[3]), true, parseScalarType(line[2])});
+            else
+                fail("bad property line");
+        }
+        else
+        {
+            fail("unexpected header line '" + std::string(line[0]) + "'");
+        }
+    }
+    fail("missing end_header");
+}
+
+// Reads one binary scalar as T, byte swapping when the file endianness differs from the host's
+template <typename T>
+T readScalar(const char *p, ScalarType type, bool swap)
+{
+    unsigned char bytes[8];
+    std::size_t size = scalarSize(type);
+    std::memcpy(bytes, p, size);
+    if (swap)
+        std::reverse(bytes, bytes + size);
+
+    auto as = [&]<typename S>(S) {
+        S value;
+        std::memcpy(&value, bytes, sizeof(S));
+        return T(value);
+    };
+    switch (type)
+    {
+    case ScalarType::Int8:
+        return as(std::int8_t());
+    case ScalarType::UInt8:
+        return as(std::uint8_t());
+    case ScalarType::Int16:
+        return as(std::int16_t());
+    case ScalarType::UInt16:
+        return as(std::uint16_t());
+    case ScalarType::Int32:
+        return as(std::int32_t());
+    case ScalarType::UInt32:
+        return as(std::uint32_t());
+    case ScalarType::Float32:
+        return as(float());
+    case ScalarType::Float64:
+        break;
+    }
+    return as(double());
+}
+
+// Size of the binary element instance at p, walking list lengths, and optionally the byte offset of
+// each of its properties; throws when the instance runs past end
+std::size_t layoutInstance(const Element &element, const char *p, const char *end, bool swap,
+                           std::size_t *offsets = nullptr)
+{
+    std::size_t size = 0;
+    for (std::size_t column = 0; column < element.properties.size(); ++column)
+    {
+        const Property &property = element.properties[column];
+        if (offsets)
+            offsets[column] = size;
+        if (property.isList)
+        {
+            std::size_t countSize = scalarSize(property.countType);
+            if (std::size_t(end - p) < size + countSize)
+                fail("truncated " + element.name + " data");
+            // Float count types can hold anything, so the length is range checked as a double before
+            // it is converted; bounding it by the bytes left keeps the size sum from overflowing
+            double count = readScalar<double>(p + size, property.countType, swap);
+            if (!std::isfinite(count) || count < 0 || count != std::trunc(count))
+                fail("bad list length in " + element.name + " data");
+            std::size_t available = (std::size_t(end - p) - size - countSize) / scalarSize(property.type);
+            if (count > double(available) || std::size_t(count) > available)
+                fail("truncated " + element.name + " data");
+            size += countSize + std::size_t(count) * scalarSize(property.type);
+        }
+        else
+        {
+            size += scalarSize(property.type);
+        }
+    }
+    if (std::size_t(end - p) < size)
+        fail("truncated " + element.name + " data");
+    return size;
+}
+
+// Bytes of the smallest possible instance, with every list empty
+std::size_t minimumInstanceSize(const Element &element)
+{
+    std::size_t size = 0;
+    for (const Property &property : element.properties)
+        size += scalarSize(property.isList ? property.countType : property.type);
+    return size;
+}
+
+bool swapBytes(const Header &header)
+{
+    return (header.format == Format::BinaryLittleEndian) != (std::endian::native == std::endian::little);
+}
+
+bool hasLists(const Element &element)
+{
+    for (const Property &property : element.properties)
+        if (property.isList)
+            return true;
+    return false;
+}
+
+// Start of the data following `element`, which starts at p
+const char *skipElement(const Header &header, const Element &element, const char *p, const char *end)
+{
+    if (header.format == Format::Ascii)
+    {
+        const char *next = io::skipLines(p, end, element.count);
+        if (element.count > 0 && next == end && io::countNewlines(p, end) + 1 < element.count)
+            fail("truncated " + element.name + " data");
+        return next;
+    }
+    bool swap = swapBytes(header);
+    if (element.count == 0)
+        return p;
+    if (!hasLists(element))
+    {
+        std::size_t size = layoutInstance(element, p, end, swap);
+        if (std::size_t(end - p) / element.count < size)
+            fail("truncated " + element.name + " data");
+        return p + size * element.count;
+    }
+    for (std::size_t i = 0; i < element.count; ++i)
+        p += layoutInstance(element, p, end, swap);
+    return p;
+}
+
+// Column of each of x, y and z among the vertex properties
+std::array<std::size_t, 3> positionColumns(const Element &vertex)
+{
+    std::array<std::size_t, 3> columns;
+    const char *names[3] = {"x", "y", "z"};
+    for (int k = 0; k < 3; ++k)
+    {
+        std::size_t column = 0;
+        while (column < vertex.properties.size() && vertex.properties[column].name != names[k])
+            ++column;
+        if (column == vertex.properties.size() || vertex.properties[column].isList)
+            fail(std::string("vertex element has no scalar '") + names[k] + "' property");
+        columns[k] = column;
+    }
+    return columns;
+}
+
+template <typename T, typename Out>
+void readAsciiVertices(const Element &vertex, const char *begin, const char *end, const char *text, Out &out,
+                       unsigned threads)
+{
+    std::array<std::size_t, 3> columns = positionColumns(vertex);
+    const char *vertexEnd = io::skipLines(begin, end, vertex.count);
+
+    auto chunks = io::parseLineChunks<io::Chunk<Vector3<T>>>(begin, vertexEnd, threads,
+                                                             [&](const char *first, const char *last,
+                                                                 io::Chunk<Vector3<T>> &chunk)
+    {
+        io::forEachLine(first, last, [&](const char *line, const char *lineEnd)
+        {
+            const char *p = line;
+            T position[3] = {T(0), T(0), T(0)};
+            for (std::size_t column = 0; column < vertex.properties.size(); ++column)
+            {
+                bool ok = true;
+                if (vertex.properties[column].isList)
+                {
+                    std::size_t count = 0;
+                    ok = io::parseField(p, lineEnd, count);
+                    for (std::size_t i = 0; ok && i < count; ++i)
+                        ok = io::skipField(p, lineEnd);
+                }
+                else if (column == columns[0] || column == columns[1] || column == columns[2])
+                {
+                    int k = column == columns[0] ? 0 : (column == columns[1] ? 1 : 2);
+                    ok = io::parseField(p, lineEnd, position[k]);
+                }
+                else
+                {
+                    ok = io::skipField(p, lineEnd);
+                }
+                if (!ok)
+                {
+                    chunk.error = line;
+                    return false;
+                }
+            }
+            chunk.values.emplace_back(position[0], position[1], position[2]);
+            return true;
+        });
+    });
+    io::checkChunks(chunks, text, "readPly");
+
+    std::size_t total = 0;
+    for (const auto &chunk : chunks)
+        total += chunk.values.size();
+    if (total != vertex.count)
+        fail("expected " + std::to_string(vertex.count) + " vertices, found " + std::to_string(total));
+    io::gatherChunks(chunks, [](auto &chunk) -> auto & { return chunk.values; }, out);
+}
+
+template <typename T, typename Out>
+void readBinaryVertices(const Header &header, const Element &vertex, const char *begin, const char *end, Out &out,
+                        unsigned threads)
+{
+    std::array<std::size_t, 3> columns = positionColumns(vertex);
+    bool swap = swapBytes(header);
+    // Bound the count by the body before allocating, so a huge count in a short file fails cleanly.
+    // Without lists the minimum size is the stride, which makes this the whole length check.
+    if (vertex.count != 0 && std::size_t(end - begin) / vertex.count < minimumInstanceSize(vertex))
+        fail("truncated vertex data");
+    out.resize(vertex.count);
+    if (vertex.count == 0)
+        return;
+
+    std::vector<std::size_t> offsets(vertex.properties.size());
+    auto store = [&](std::size_t i, const char *p)
+    {
+        T position[3];
+        for (int k = 0; k < 3; ++k)
+            position[k] = readScalar<T>(p + offsets[columns[k]], vertex.properties[columns[k]].type, swap);
+        io::storeValue(out, i, Vector3<T>(position[0], position[1], position[2]));
+    };
+
+    if (hasLists(vertex))
+    {
+        // Offsets past a list depend on its length, so walk the vertices one by one
+        for (std::size_t i = 0; i < vertex.count; ++i)
+        {
+            std::size_t size = layoutInstance(vertex, begin, end, swap, offsets.data());
+            store(i, begin);
+            begin += size;
+        }
+        return;
+    }
+
+    std::size_t stride = layoutInstance(vertex, begin, end, swap, offsets.data());
+    unsigned chunks = parallel::chunkCount(vertex.count, threads, MinVerticesPerThread);
+    parallel::forEachChunk(vertex.count, chunks, [&](unsigned, std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+            store(i, begin + i * stride);
+    });
+}
+
+template <typename T, typename Out>
+void readPlyImpl(std::string_view data, Out &out, unsigned threads)
+{
+    Header header = parseHeader(data);
+    const char *end = data.data() + data.size();
+    const char *p = header.body;
+    for (const Element &element : header.elements)
+    {
+        if (element.name != "vertex")
+        {
+            p = skipElement(header, element, p, end);
+            continue;
+        }
+        if (header.format == Format::Ascii)
+            readAsciiVertices<T>(element, p, end, data.data(), out, threads);
+        else
+            readBinaryVertices<T>(header, element, p, end, out, threads);
+        return;
+    }
+    fail("no vertex element");
+}
+
+} // namespace
+
+template <typename T>
+void readPly(std::string_view data, std::vector<Vector3<T>> &positions, unsigned threads)
+{
+    readPlyImpl<T>(data, positions, threads);
+}
+
+template <typename T>
+void readPly(std::string_view data, Vector3SoA<T> &positions, unsigned threads)
+{
+    readPlyImpl<T>(data, positions, threads);
+}
+
+template <typename T>
+void readPlyFile(const std::string &path, std::vector<Vector3<T>> &positions, unsigned threads)
+{
+    readPlyImpl<T>(io::readFile(path), positions, threads);
+}
+
+template <typename T>
+void readPlyFile(const std::string &path, Vector3SoA<T> &positions, unsigned threads)
+{
+    readPlyImpl<T>(io::readFile(path), positions, threads);
+}
+
+#define LUMINA_INSTANTIATE_PLY(T)                                                            \
+    template void readPly<T>(std::string_view, std::vector<Vector3<T>> &, unsigned);         \
+    template void readPly<T>(std::string_view, Vector3SoA<T> &, unsigned);                   \
+    template void readPlyFile<T>(const std::string &, std::vector<Vector3<T>> &, unsigned);  \
+    template void readPlyFile<T>(const std::string &, Vector3SoA<T> &, unsigned);
+
+LUMINA_INSTANTIATE_PLY(float)
+LUMINA_INSTANTIATE_PLY(double)
+
+#undef LUMINA_INSTANTIATE_PLY
+
+} // namespace lumina
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "../parallel/parallel_for.hpp"
+#include <lumina/batch/soa.hpp>
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Internal text scanning helpers shared by the vector, OBJ and PLY readers.
+// Input is split into line-aligned chunks that are parsed in parallel; newlines are located
+// 32 (AVX2) or 16 (SSE2) bytes at a time.
+
+namespace lumina::io
+{
+
+    constexpr std::size_t MinBytesPerThread = std::size_t(1) << 20;
+
+#if defined(__AVX2__)
+    constexpr std::size_t ScanWidth = 32;
+
+    inline unsigned newlineBits(const char *p)
+    {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        return unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n'))));
+    }
+#elif defined(__SSE2__)
+    constexpr std::size_t ScanWidth = 16;
+
+    inline unsigned newlineBits(const char *p)
+    {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'))));
+    }
+#else
+    constexpr std::size_t ScanWidth = 8;
+
+    inline unsigned newlineBits(const char *p)
+    {
+        unsigned bits = 0;
+        for (std::size_t i = 0; i < ScanWidth; ++i)
+            bits |= unsigned(p[i] == '\n') << i;
+        return bits;
+    }
+#endif
+
+    // First '\n' in [p, end), or end
+    inline const char *findNewline(const char *p, const char *end)
+    {
+        for (; std::size_t(end - p) >= ScanWidth; p += ScanWidth)
+            if (unsigned bits = newlineBits(p))
+                return p + std::countr_zero(bits);
+        for (; p < end; ++p)
+            if (*p == '\n')
+                return p;
+        return end;
+    }
+
+    inline std::size_t countNewlines(const char *p, const char *end)
+    {
+        std::size_t count = 0;
+        for (; std::size_t(end - p) >= ScanWidth; p += ScanWidth)
+            count += std::size_t(std::popcount(newlineBits(p)));
+        for (; p < end; ++p)
+            count += *p == '\n';
+        return count;
+    }
+
+    // Start of the line after the one containing p, or end
+    inline const char *nextLine(const char *p, const char *end)
+    {
+        const char *newline = findNewline(p, end);
+        return newline == end ? end : newline + 1;
+    }
+
+    inline const char *skipLines(const char *p, const char *end, std::size_t lines)
+    {
+        for (; lines > 0 && p < end; --lines)
+            p = nextLine(p, end);
+        return p;
+    }
+
+    inline bool isSeparator(char c)
+    {
+        return c == ' ' || c == '\t' || c == ',' || c == '\r';
+    }
+
+    inline const char *skipSeparators(const char *p, const char *end)
+    {
+        while (p < end && isSeparator(*p))
+            ++p;
+        return p;
+    }
+
+    // Skips the next field; returns false at the end of the line
+    inline bool skipField(const char *&p, const char *end)
+    {
+        p = skipSeparators(p, end);
+        if (p == end)
+            return false;
+        while (p < end && !isSeparator(*p))
+            ++p;
+        return true;
+    }
+
+    // Parses the next number after any separators; one leading sign is accepted, '+' or '-'
+    template <typename T>
+    inline bool parseField(const char *&p, const char *end, T &value)
+    {
+        p = skipSeparators(p, end);
+        if (p < end && *p == '+')
+        {
+            ++p;
+            // from_chars reads its own '-', which would let "+-5" through
+            if (p < end && *p == '-')
+                return false;
+        }
+        auto [next, error] = std::from_chars(p, end, value);
+        if (error != std::errc() || (next < end && !isSeparator(*next)))
+            return false;
+        p = next;
+        return true;
+    }
+
+    // A line holding only separators or a '#' comment
+    inline bool isBlank(const char *p, const char *end)
+    {
+        p = skipSeparators(p, end);
+        return p == end || *p == '#';
+    }
+
+    // Calls fn(line, lineEnd) for every line in [first, last), excluding the '\n'; stops early when fn returns false
+    template <typename Fn>
+    inline void forEachLine(const char *first, const char *last, Fn &&fn)
+    {
+        for (const char *line = first; line < last;)
+        {
+            const char *lineEnd = findNewline(line, last);
+            if (!fn(line, lineEnd) || lineEnd == last)
+                return;
+            line = lineEnd + 1;
+        }
+    }
+
+    // Per-chunk parse output; `error` points at the first malformed line
+    template <typename Value>
+    struct Chunk
+    {
+        std::vector<Value> values;
+        const char *error = nullptr;
+    };
+
+    // Splits [begin, end) into line-aligned chunks and runs parse(first, last, result) on each in parallel.
+    // Result is default constructible with a `const char *error` member.
+    template <typename Result, typename Parse>
+    std::vector<Result> parseLineChunks(const char *begin, const char *end, unsigned threads, Parse &&parse)
+    {
+        unsigned chunks = parallel::chunkCount(std::size_t(end - begin), threads, MinBytesPerThread);
+        std::vector<const char *> starts(chunks + 1, end);
+        starts[0] = begin;
+        for (unsigned c = 1; c < chunks; ++c)
+        {
+            const char *split = std::max(begin + std::size_t(end - begin) * c / chunks, starts[c - 1]);
+            starts[c] = split == begin ? begin : nextLine(split - 1, end);
+        }
+
+        std::vector<Result> results(chunks);
+        parallel::forEachChunk(chunks, chunks, [&](unsigned c, std::size_t, std::size_t)
+        {
+            parse(starts[c], starts[c + 1], results[c]);
+        });
+        return results;
+    }
+
+    // Throws for the first malformed line, numbered from the start of `text`
+    template <typename Result>
+    void checkChunks(const std::vector<Result> &chunks, const char *text, const char *what)
+    {
+        for (const Result &chunk : chunks)
+            if (chunk.error)
+                throw std::invalid_argument(std::string(what) + ": malformed line " +
+                                            std::to_string(countNewlines(text, chunk.error) + 1));
+    }
+
+    template <typename V>
+    inline void storeValue(std::vector<V> &out, std::size_t index, const V &value)
+    {
+        out[index] = value;
+    }
+
+    template <typename T>
+    inline void storeValue(Vector3SoA<T> &out, std::size_t index, const Vector3<T> &value)
+    {
+        out.x[index] = value.x;
+        out.y[index] = value.y;
+        out.z[index] = value.z;
+    }
+
+    // Concatenates part(chunk) of every chunk in order into AoS or SoA storage, replacing its contents
+    template <typename Result, typename Part, typename Out>
+    void gatherChunks(std::vector<Result> &chunks, Part &&part, Out &out)
+    {
+        std::vector<std::size_t> offsets(chunks.size() + 1, 0);
+        for (std::size_t c = 0; c < chunks.size(); ++c)
+            offsets[c + 1] = offsets[c] + part(chunks[c]).size();
+        out.resize(offsets.back());
+        parallel::forEachChunk(chunks.size(), unsigned(chunks.size()), [&](unsigned c, std::size_t, std::size_t)
+        {
+            const auto &values = part(chunks[c]);
+            for (std::size_t i = 0; i < values.size(); ++i)
+                storeValue(out, offsets[c] + i, values[i]);
+        });
+    }
+
+    // Reads a whole file in binary mode
+    inline std::string readFile(const std::string &path)
+    {
+        std::error_code error;
+        std::uintmax_t size = std::filesystem::file_size(path, error);
+        std::FILE *file = error ? nullptr : std::fopen(path.c_str(), "rb");
+        if (!file)
+            throw std::runtime_error("cannot open " + path);
+        std::string data(std::size_t(size), '\0');
+        bool complete = std::fread(data.data(), 1, data.size(), file) == data.size();
+        std::fclose(file);
+        if (!complete)
+            throw std::runtime_error("cannot read " + path);
+        return data;
+    }
+
+} // namespace lumina::io
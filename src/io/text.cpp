@@ -0,0 +1,109 @@
+#include <lumina/io/text.hpp>
+#include "scan.hpp"
+
+namespace lumina
+{
+
+namespace
+{
+
+template <typename T, int Dimension, typename V>
+std::vector<io::Chunk<V>> parseChunks(std::string_view text, unsigned threads)
+{
+    const char *begin = text.data();
+    auto chunks = io::parseLineChunks<io::Chunk<V>>(begin, begin + text.size(), threads,
+                                                     [](const char *first, const char *last, io::Chunk<V> &chunk)
+    {
+        io::forEachLine(first, last, [&](const char *line, const char *lineEnd)
+        {
+            if (io::isBlank(line, lineEnd))
+                return true;
+            T components[Dimension];
+            const char *p = line;
+            for (int k = 0; k < Dimension; ++k)
+                if (!io::parseField(p, lineEnd, components[k]))
+                {
+                    chunk.error = line;
+                    return false;
+                }
+            if constexpr (Dimension == 2)
+                chunk.values.emplace_back(components[0], components[1]);
+            else
+                chunk.values.emplace_back(components[0], components[1], components[2]);
+            return true;
+        });
+    });
+    io::checkChunks(chunks, begin, "parseVectors");
+    return chunks;
+}
+
+template <typename T>
+void appendNumber(std::string &out, T value)
+{
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+} // namespace
+
+template <typename T>
+void parseVectors(std::string_view text, std::vector<Vector2<T>> &out, unsigned threads)
+{
+    auto chunks = parseChunks<T, 2, Vector2<T>>(text, threads);
+    io::gatherChunks(chunks, [](auto &chunk) -> auto & { return chunk.values; }, out);
+}
+
+template <typename T>
+void parseVectors(std::string_view text, std::vector<Vector3<T>> &out, unsigned threads)
+{
+    auto chunks = parseChunks<T, 3, Vector3<T>>(text, threads);
+    io::gatherChunks(chunks, [](auto &chunk) -> auto & { return chunk.values; }, out);
+}
+
+template <typename T>
+void parseVectors(std::string_view text, Vector3SoA<T> &out, unsigned threads)
+{
+    auto chunks = parseChunks<T, 3, Vector3<T>>(text, threads);
+    io::gatherChunks(chunks, [](auto &chunk) -> auto & { return chunk.values; }, out);
+}
+
+template <typename T>
+void formatVectors(const Vector2<T> *vectors, std::size_t count, std::string &out, char separator)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        appendNumber(out, vectors[i].x);
+        out.push_back(separator);
+        appendNumber(out, vectors[i].y);
+        out.push_back('\n');
+    }
+}
+
+template <typename T>
+void formatVectors(const Vector3<T> *vectors, std::size_t count, std::string &out, char separator)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        appendNumber(out, vectors[i].x);
+        out.push_back(separator);
+        appendNumber(out, vectors[i].y);
+        out.push_back(separator);
+        appendNumber(out, vectors[i].z);
+        out.push_back('\n');
+    }
+}
+
+#define LUMINA_INSTANTIATE_TEXT(T)                                                         \
+    template void parseVectors<T>(std::string_view, std::vector<Vector2<T>> &, unsigned);  \
+    template void parseVectors<T>(std::string_view, std::vector<Vector3<T>> &, unsigned);  \
+    template void parseVectors<T>(std::string_view, Vector3SoA<T> &, unsigned);            \
+    template void formatVectors<T>(const Vector2<T> *, std::size_t, std::string &, char);  \
+    template void formatVectors<T>(const Vector3<T> *, std::size_t, std::string &, char);
+
+LUMINA_INSTANTIATE_TEXT(float)
+LUMINA_INSTANTIATE_TEXT(double)
+
+#undef LUMINA_INSTANTIATE_TEXT
+
+} // namespace lumina
@@ -0,0 +1,241 @@
+#include <lumina/matrix/matrix4.hpp>
+#include <stdexcept>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace lumina
+{
+
+namespace
+{
+
+// Column j of a * b combines a's columns weighted by b's column j, summed in column order;
+// the SIMD overloads below keep that order. With contraction off (exact_src in meson.build) every
+// target that rounds to the declared precision produces the same bits; x87 excess precision does not
+template <typename T>
+Vector4<T> combine(const Matrix4<T> &a, const Vector4<T> &weights)
+{
+    return a.columns[0] * weights.x + a.columns[1] * weights.y + a.columns[2] * weights.z +
+           a.columns[3] * weights.w;
+}
+
+template <typename T>
+Matrix4<T> multiply(const Matrix4<T> &a, const Matrix4<T> &b)
+{
+    return Matrix4<T>(combine(a, b.columns[0]), combine(a, b.columns[1]), combine(a, b.columns[2]),
+                      combine(a, b.columns[3]));
+}
+
+#if defined(__SSE2__)
+Matrix4<float> multiply(const Matrix4<float> &a, const Matrix4<float> &b)
+{
+    __m128 c0 = _mm_loadu_ps(&a.columns[0].x);
+    __m128 c1 = _mm_loadu_ps(&a.columns[1].x);
+    __m128 c2 = _mm_loadu_ps(&a.columns[2].x);
+    __m128 c3 = _mm_loadu_ps(&a.columns[3].x);
+    Matrix4<float> result;
+    for (int j = 0; j < 4; ++j)
+    {
+        const Vector4<float> &w = b.columns[j];
+        __m128 sum = _mm_mul_ps(c0, _mm_set1_ps(w.x));
+        sum = _mm_add_ps(sum, _mm_mul_ps(c1, _mm_set1_ps(w.y)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(c2, _mm_set1_ps(w.z)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(c3, _mm_set1_ps(w.w)));
+        _mm_storeu_ps(&result.columns[j].x, sum);
+    }
+    return result;
+}
+#endif
+
+#if defined(__AVX2__)
+Matrix4<double> multiply(const Matrix4<double> &a, const Matrix4<double> &b)
+{
+    __m256d c0 = _mm256_loadu_pd(&a.columns[0].x);
+    __m256d c1 = _mm256_loadu_pd(&a.columns[1].x);
+    __m256d c2 = _mm256_loadu_pd(&a.columns[2].x);
+    __m256d c3 = _mm256_loadu_pd(&a.columns[3].x);
+    Matrix4<double> result;
+    for (int j = 0; j < 4; ++j)
+    {
+        const Vector4<double> &w = b.columns[j];
+        __m256d sum = _mm256_mul_pd(c0, _mm256_set1_pd(w.x));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(c1, _mm256_set1_pd(w.y)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(c2, _mm256_set1_pd(w.z)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(c3, _mm256_set1_pd(w.w)));
+        _mm256_storeu_pd(&result.columns[j].x, sum);
+    }
+    return result;
+}
+#endif
+
+} // namespace
+
+template <typename T>
+Matrix4<T>::Matrix4()
+    : columns{Vector4<T>(1, 0, 0, 0), Vector4<T>(0, 1, 0, 0), Vector4<T>(0, 0, 1, 0), Vector4<T>(0, 0, 0, 1)}
+{
+}
+
+template <typename T>
+Matrix4<T>::Matrix4(const Vector4<T> &c0, const Vector4<T> &c1, const Vector4<T> &c2, const Vector4<T> &c3)
+    : columns{c0, c1, c2, c3}
+{
+}
+
+// Arithmetic operators
+template <typename T>
+Matrix4<T> Matrix4<T>::operator*(const Matrix4 &other) const
+{
+    return multiply(*this, other);
+}
+
+template <typename T>
+Vector4<T> Matrix4<T>::operator*(const Vector4<T> &vector) const
+{
+    return combine(*this, vector);
+}
+
+template <typename T>
+Matrix4<T> &Matrix4<T>::operator*=(const Matrix4 &other)
+{
+    *this = multiply(*this, other);
+    return *this;
+}
+
+// Comparison operators
+template <typename T>
+bool Matrix4<T>::operator==(const Matrix4 &other) const
+{
+    return columns[0] == other.columns[0] && columns[1] == other.columns[1] && columns[2] == other.columns[2] &&
+           columns[3] == other.columns[3];
+}
+
+template <typename T>
+bool Matrix4<T>::operator!=(const Matrix4 &other) const
+{
+    return !(*this == other);
+}
+
+// Column access
+template <typename T>
+Vector4<T> &Matrix4<T>::operator[](int column)
+{
+    if (column < 0 || column > 3)
+        throw std::out_of_range("Matrix4 column out of range");
+    return columns[column];
+}
+
+template <typename T>
+const Vector4<T> &Matrix4<T>::operator[](int column) const
+{
+    if (column < 0 || column > 3)
+        throw std::out_of_range("Matrix4 column out of range");
+    return columns[column];
+}
+
+// Element access
+template <typename T>
+T &Matrix4<T>::operator()(int row, int column)
+{
+    return (*this)[column][row];
+}
+
+template <typename T>
+const T &Matrix4<T>::operator()(int row, int column) const
+{
+    return (*this)[column][row];
+}
+
+// Pointer access to data
+template <typename T>
+T *Matrix4<T>::data()
+{
+    return columns[0].data();
+}
+
+template <typename T>
+const T *Matrix4<T>::data() const
+{
+    return columns[0].data();
+}
+
+template <typename T>
+Vector3<T> Matrix4<T>::transformPoint(const Vector3<T> &point) const
+{
+    Vector4<T> r = columns[0] * point.x + columns[1] * point.y + columns[2] * point.z + columns[3];
+    return Vector3<T>(r.x, r.y, r.z);
+}
+
+template <typename T>
+Vector3<T> Matrix4<T>::transformVector(const Vector3<T> &vector) const
+{
+    Vector4<T> r = columns[0] * vector.x + columns[1] * vector.y + columns[2] * vector.z;
+    return Vector3<T>(r.x, r.y, r.z);
+}
+
+template <typename T>
+Matrix4<T> Matrix4<T>::transposed() const
+{
+    const Vector4<T> *c = columns;
+    return Matrix4(Vector4<T>(c[0].x, c[1].x, c[2].x, c[3].x), Vector4<T>(c[0].y, c[1].y, c[2].y, c[3].y),
+                   Vector4<T>(c[0].z, c[1].z, c[2].z, c[3].z), Vector4<T>(c[0].w, c[1].w, c[2].w, c[3].w));
+}
+
+// Static predefined matrices
+template <typename T>
+Matrix4<T> Matrix4<T>::identity()
+{
+    return Matrix4();
+}
+
+template <typename T>
+Matrix4<T> Matrix4<T>::translation(const Vector3<T> &offset)
+{
+    Matrix4 result;
+    result.columns[3] = Vector4<T>(offset.x, offset.y, offset.z, T(1));
+    return result;
+}
+
+template <typename T>
+Matrix4<T> Matrix4<T>::scale(const Vector3<T> &factors)
+{
+    return Matrix4(Vector4<T>(factors.x, 0, 0, 0), Vector4<T>(0, factors.y, 0, 0), Vector4<T>(0, 0, factors.z, 0),
+                   Vector4<T>(0, 0, 0, 1));
+}
+
+template <typename T>
+Matrix4<T> Matrix4<T>::rotation(const Vector4<T> &quaternion)
+{
+    return trs(Vector3<T>(0), quaternion, Vector3<T>(1));
+}
+
+// Rotation columns from the quaternion, each scaled by its axis factor
+template <typename T>
+Matrix4<T> Matrix4<T>::trs(const Vector3<T> &offset, const Vector4<T> &q, const Vector3<T> &factors)
+{
+    T xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    T xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    T wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    T sx = factors.x, sy = factors.y, sz = factors.z;
+    return Matrix4(
+        Vector4<T>((T(1) - T(2) * (yy + zz)) * sx, T(2) * (xy + wz) * sx, T(2) * (xz - wy) * sx, T(0)),
+        Vector4<T>(T(2) * (xy - wz) * sy, (T(1) - T(2) * (xx + zz)) * sy, T(2) * (yz + wx) * sy, T(0)),
+        Vector4<T>(T(2) * (xz + wy) * sz, T(2) * (yz - wx) * sz, (T(1) - T(2) * (xx + yy)) * sz, T(0)),
+        Vector4<T>(offset.x, offset.y, offset.z, T(1)));
+}
+
+template <typename T>
+bool Matrix4<T>::approxEqual(const Matrix4 &a, const Matrix4 &b, T epsilon)
+{
+    return Vector4<T>::approxEqual(a.columns[0], b.columns[0], epsilon) &&
+           Vector4<T>::approxEqual(a.columns[1], b.columns[1], epsilon) &&
+           Vector4<T>::approxEqual(a.columns[2], b.columns[2], epsilon) &&
+           Vector4<T>::approxEqual(a.columns[3], b.columns[3], epsilon);
+}
+
+template class Matrix4<float>;
+template class Matrix4<double>;
+
+} // namespace lumina
@@ -0,0 +1,445 @@
+#include <lumina/mesh/normals.hpp>
+#include "../batch/stream.hpp"
+#include "../parallel/parallel_for.hpp"
+#include "../simd/simd.hpp"
+#include "../simd/simd_math.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace lumina
+{
+
+namespace
+{
+
+constexpr std::size_t MinTrianglesPerThread = std::size_t(1) << 13;
+constexpr std::size_t MinVerticesPerThread = std::size_t(1) << 13;
+
+// Splits [0, count) over threads and runs body(tag, index) as simd::forEachPack within each chunk
+template <typename T, typename Body>
+void forEachPackParallel(std::size_t count, unsigned threads, std::size_t minPerThread, Body &&body)
+{
+    unsigned chunks = parallel::chunkCount(count, threads, minPerThread);
+    parallel::forEachChunk(count, chunks, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        simd::forEachPack<T>(end - begin, [&](auto tag, std::size_t i) { body(tag, begin + i); });
+    });
+}
+
+// Calls fn(vertex) for every vertex, split over threads
+template <typename Fn>
+void forEachVertex(std::size_t count, unsigned threads, Fn &&fn)
+{
+    unsigned chunks = parallel::chunkCount(count, threads, MinVerticesPerThread);
+    parallel::forEachChunk(count, chunks, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t v = begin; v < end; ++v)
+            fn(v);
+    });
+}
+
+// Edge vectors p1 - p0 and p2 - p0 of the triangles starting at `triangle`
+template <typename P, typename Positions>
+inline void triangleEdges(const Positions &positions, const std::uint32_t *triangle, P (&e1)[3], P (&e2)[3])
+{
+    for (int k = 0; k < 3; ++k)
+    {
+        P p0 = simd::gatherComponent<P>(positions, triangle, 3, k);
+        e1[k] = simd::gatherComponent<P>(positions, triangle + 1, 3, k) - p0;
+        e2[k] = simd::gatherComponent<P>(positions, triangle + 2, 3, k) - p0;
+    }
+}
+
+template <typename P>
+inline void cross(const P (&a)[3], const P (&b)[3], P (&out)[3])
+{
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+template <typename P>
+inline P dot(const P (&a)[3], const P (&b)[3])
+{
+    return simd::fmadd(a[0], b[0], simd::fmadd(a[1], b[1], a[2] * b[2]));
+}
+
+// Scales v to unit length, leaving zero vectors at zero
+template <typename P>
+inline void normalizeOrZero(P (&v)[3])
+{
+    using T = typename P::Scalar;
+    P length = simd::sqrt(dot(v, v));
+    P zero = P::broadcast(T(0));
+    auto valid = length > zero;
+    P inverse = simd::select(valid, P::broadcast(T(1)) / simd::select(valid, length, P::broadcast(T(1))), zero);
+    for (int k = 0; k < 3; ++k)
+        v[k] = v[k] * inverse;
+}
+
+template <typename T>
+inline void storeNormalized(T x, T y, T z, Vector3<T> &out)
+{
+    T length = std::sqrt(x * x + y * y + z * z);
+    T inverse = length > T(0) ? T(1) / length : T(0);
+    out.x = x * inverse;
+    out.y = y * inverse;
+    out.z = z * inverse;
+}
+
+// Scalar form of the branchless basis, used for degenerate tangents
+template <typename T>
+inline Vector3<T> basisTangent(const Vector3<T> &n)
+{
+    T sign = std::copysign(T(1), n.z);
+    T a = T(-1) / (sign + n.z);
+    T b = n.x * n.y * a;
+    return Vector3<T>(T(1) + sign * n.x * n.x * a, sign * b, -sign * n.x);
+}
+
+void checkAdjacency(const VertexFaceAdjacency &adjacency, std::size_t triangleCount)
+{
+    if (adjacency.corners.size() != triangleCount * 3 || adjacency.offsets.empty())
+        throw std::invalid_argument("VertexFaceAdjacency does not match the triangle count");
+}
+
+// Every vertex the adjacency was built for must be addressable in each view
+template <typename... Views>
+void checkVertexViews(const VertexFaceAdjacency &adjacency, const Views &...views)
+{
+    if (((views.count < adjacency.vertexCount()) || ...))
+        throw std::invalid_argument("Strided view is shorter than the adjacency vertex count");
+}
+
+template <typename A, typename B>
+void checkCounts(const A &a, const B &b)
+{
+    if (a.count != b.count)
+        throw std::invalid_argument("Strided views differ in length");
+}
+
+// Kernels are written once against simd::loadComponent / storeComponent / gatherComponent and
+// element access, which accept both contiguous arrays and strided views
+
+template <typename T, typename Positions>
+void faceNormalsImpl(const Positions &positions, const std::uint32_t *indices, std::size_t triangleCount,
+                     Vector3<T> *normals, bool normalize, StoreMode mode, unsigned threads)
+{
+    auto kernel = [&](std::size_t begin, std::size_t count, Vector3<T> *dst)
+    {
+        simd::forEachPack<T>(count, [&](auto tag, std::size_t i)
+        {
+            using P = typename decltype(tag)::type;
+            P e1[3], e2[3], n[3];
+            triangleEdges(positions, indices + 3 * (begin + i), e1, e2);
+            cross(e1, e2, n);
+            if (normalize)
+                normalizeOrZero(n);
+            for (int k = 0; k < 3; ++k)
+                simd::storeComponent(n[k], dst + i, k);
+        });
+    };
+    stream::writeBatch({{indices, 3 * sizeof(std::uint32_t)}}, triangleCount, mode, threads, MinTrianglesPerThread,
+                       kernel, normals);
+}
+
+template <typename T, typename Positions, typename Normals>
+void vertexNormalsImpl(const Positions &positions, const std::uint32_t *indices, std::size_t triangleCount,
+                       const VertexFaceAdjacency &adjacency, const Normals &normals, NormalWeighting weighting,
+                       StoreMode mode, unsigned threads)
+{
+    checkAdjacency(adjacency, triangleCount);
+
+    // Area weighting uses the unnormalized face normals directly; angle weighting needs
+    // unit face normals and the three corner angles of every triangle (stored as x, y, z)
+    bool byAngle = weighting == NormalWeighting::Angle;
+    std::vector<Vector3<T>> faces(triangleCount);
+    std::vector<Vector3<T>> angles(byAngle ? triangleCount : 0);
+    forEachPackParallel<T>(triangleCount, threads, MinTrianglesPerThread, [&](auto tag, std::size_t t)
+    {
+        using P = typename decltype(tag)::type;
+        P e1[3], e2[3], n[3];
+        triangleEdges(positions, indices + 3 * t, e1, e2);
+        cross(e1, e2, n);
+        if (byAngle)
+        {
+            // Every corner angle shares |e1 x e2| as the sine term
+            P sine = simd::sqrt(dot(n, n));
+            P d12 = dot(e1, e2);
+            P cosines[3] = {d12, dot(e1, e1) - d12, dot(e2, e2) - d12};
+            for (int k = 0; k < 3; ++k)
+                simd::storeComponent(simd::atan2<MathAccuracy::Precise>(sine, cosines[k]), angles.data() + t, k);
+            normalizeOrZero(n);
+        }
+        for (int k = 0; k < 3; ++k)
+            simd::storeComponent(n[k], faces.data() + t, k);
+    });
+
+    auto vertexNormal = [&](std::size_t v, Vector3<T> &out)
+    {
+        T x = T(0), y = T(0), z = T(0);
+        for (std::uint32_t i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; ++i)
+        {
+            std::uint32_t corner = adjacency.corners[i];
+            const Vector3<T> &face = faces[corner / 3];
+            T weight = T(1);
+            if (byAngle)
+            {
+                const Vector3<T> &corners = angles[corner / 3];
+                weight = corner % 3 == 0 ? corners.x : (corner % 3 == 1 ? corners.y : corners.z);
+            }
+            x += face.x * weight;
+            y += face.y * weight;
+            z += face.z * weight;
+        }
+        storeNormalized(x, y, z, out);
+    };
+
+    // Contiguous outputs can stream; strided ones share their cache lines with other attributes
+    if constexpr (std::is_pointer_v<Normals>)
+    {
+        auto kernel = [&](std::size_t begin, std::size_t count, Vector3<T> *dst)
+        {
+            for (std::size_t v = 0; v < count; ++v)
+                vertexNormal(begin + v, dst[v]);
+        };
+        stream::writeBatch({{adjacency.offsets.data(), sizeof(std::uint32_t)}}, adjacency.vertexCount(), mode,
+                           threads, MinVerticesPerThread, kernel, normals);
+    }
+    else
+    {
+        forEachVertex(adjacency.vertexCount(), threads, [&](std::size_t v) { vertexNormal(v, normals[v]); });
+    }
+}
+
+template <typename T, typename Normals, typename Basis>
+void orthonormalBasisImpl(const Normals &normals, std::size_t count, const Basis &tangents, const Basis &bitangents)
+{
+    simd::forEachPack<T>(count, [&](auto tag, std::size_t i)
+    {
+        using P = typename decltype(tag)::type;
+        P nx = simd::loadComponent<P>(normals, i, 0);
+        P ny = simd::loadComponent<P>(normals, i, 1);
+        P nz = simd::loadComponent<P>(normals, i, 2);
+        P one = P::broadcast(T(1));
+
+        P sign = simd::select(nz < P::broadcast(T(0)), -one, one);
+        P a = -one / (sign + nz);
+        P b = nx * ny * a;
+
+        simd::storeComponent(simd::fmadd(sign * nx * nx, a, one), tangents, i, 0);
+        simd::storeComponent(sign * b, tangents, i, 1);
+        simd::storeComponent(-sign * nx, tangents, i, 2);
+        simd::storeComponent(b, bitangents, i, 0);
+        simd::storeComponent(simd::fmadd(ny * ny, a, sign), bitangents, i, 1);
+        simd::storeComponent(-ny, bitangents, i, 2);
+    });
+}
+
+template <typename T, typename Positions, typename Normals, typename UVs, typename Tangents>
+void vertexTangentsImpl(const Positions &positions, const Normals &normals, const UVs &uvs,
+                        const std::uint32_t *indices, std::size_t triangleCount,
+                        const VertexFaceAdjacency &adjacency, const Tangents &tangents, unsigned threads)
+{
+    checkAdjacency(adjacency, triangleCount);
+
+    // Per-triangle texture-space directions (Lengyel); triangles with a degenerate UV mapping contribute nothing
+    std::vector<Vector3<T>> faceTangents(triangleCount), faceBitangents(triangleCount);
+    forEachPackParallel<T>(triangleCount, threads, MinTrianglesPerThread, [&](auto tag, std::size_t t)
+    {
+        using P = typename decltype(tag)::type;
+        const std::uint32_t *triangle = indices + 3 * t;
+        P e1[3], e2[3];
+        triangleEdges(positions, triangle, e1, e2);
+
+        P u0 = simd::gatherComponent<P>(uvs, triangle, 3, 0), v0 = simd::gatherComponent<P>(uvs, triangle, 3, 1);
+        P du1 = simd::gatherComponent<P>(uvs, triangle + 1, 3, 0) - u0;
+        P dv1 = simd::gatherComponent<P>(uvs, triangle + 1, 3, 1) - v0;
+        P du2 = simd::gatherComponent<P>(uvs, triangle + 2, 3, 0) - u0;
+        P dv2 = simd::gatherComponent<P>(uvs, triangle + 2, 3, 1) - v0;
+
+        P det = du1 * dv2 - du2 * dv1;
+        P zero = P::broadcast(T(0));
+        auto valid = simd::abs(det) > zero;
+        P inverse = simd::select(valid, P::broadcast(T(1)) / simd::select(valid, det, P::broadcast(T(1))), zero);
+        for (int k = 0; k < 3; ++k)
+        {
+            simd::storeComponent((e1[k] * dv2 - e2[k] * dv1) * inverse, faceTangents.data() + t, k);
+            simd::storeComponent((e2[k] * du1 - e1[k] * du2) * inverse, faceBitangents.data() + t, k);
+        }
+    });
+
+    const T degenerate = std::sqrt(std::numeric_limits<T>::epsilon());
+    forEachVertex(adjacency.vertexCount(), threads, [&](std::size_t v)
+    {
+        T tx = T(0), ty = T(0), tz = T(0), bx = T(0), by = T(0), bz = T(0);
+        for (std::uint32_t i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; ++i)
+        {
+            std::uint32_t triangle = adjacency.corners[i] / 3;
+            tx += faceTangents[triangle].x;
+            ty += faceTangents[triangle].y;
+            tz += faceTangents[triangle].z;
+            bx += faceBitangents[triangle].x;
+            by += faceBitangents[triangle].y;
+            bz += faceBitangents[triangle].z;
+        }
+
+        // Gram-Schmidt against the normal
+        const Vector3<T> &n = normals[v];
+        T sourceLength = std::sqrt(tx * tx + ty * ty + tz * tz);
+        T projection = n.x * tx + n.y * ty + n.z * tz;
+        tx -= n.x * projection;
+        ty -= n.y * projection;
+        tz -= n.z * projection;
+        T length = std::sqrt(tx * tx + ty * ty + tz * tz);
+
+        Vector4<T> &out = tangents[v];
+        if (length > degenerate * sourceLength && length > T(0))
+        {
+            out.x = tx / length;
+            out.y = ty / length;
+            out.z = tz / length;
+        }
+        else
+        {
+            Vector3<T> fallback = basisTangent(n);
+            out.x = fallback.x;
+            out.y = fallback.y;
+            out.z = fallback.z;
+        }
+
+        // Handedness: does cross(n, t) point along the accumulated bitangent?
+        T cx = n.y * out.z - n.z * out.y;
+        T cy = n.z * out.x - n.x * out.z;
+        T cz = n.x * out.y - n.y * out.x;
+        out.w = cx * bx + cy * by + cz * bz < T(0) ? T(-1) : T(1);
+    });
+}
+
+} // namespace
+
+// Constructors
+VertexFaceAdjacency::VertexFaceAdjacency(const std::uint32_t *indices, std::size_t triangleCount,
+                                         std::size_t vertexCount)
+{
+    std::size_t cornerCount = triangleCount * 3;
+    if (cornerCount > std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error("VertexFaceAdjacency is limited to 2^32 corners");
+
+    offsets.assign(vertexCount + 1, 0);
+    for (std::size_t c = 0; c < cornerCount; ++c)
+    {
+        if (indices[c] >= vertexCount)
+            throw std::out_of_range("Triangle index exceeds the vertex count");
+        ++offsets[indices[c] + 1];
+    }
+    for (std::size_t v = 0; v < vertexCount; ++v)
+        offsets[v + 1] += offsets[v];
+
+    // Filling in corner order keeps every row sorted
+    corners.resize(cornerCount);
+    std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (std::size_t c = 0; c < cornerCount; ++c)
+        corners[cursor[indices[c]]++] = static_cast<std::uint32_t>(c);
+}
+
+std::size_t VertexFaceAdjacency::vertexCount() const
+{
+    return offsets.empty() ? 0 : offsets.size() - 1;
+}
+
+template <typename T>
+void faceNormals(const Vector3<T> *positions, const std::uint32_t *indices, std::size_t triangleCount,
+                 Vector3<T> *normals, bool normalize, StoreMode mode, unsigned threads)
+{
+    faceNormalsImpl<T>(positions, indices, triangleCount, normals, normalize, mode, threads);
+}
+
+template <typename T>
+void vertexNormals(const Vector3<T> *positions, const std::uint32_t *indices, std::size_t triangleCount,
+                   const VertexFaceAdjacency &adjacency, Vector3<T> *normals, NormalWeighting weighting,
+                   StoreMode mode, unsigned threads)
+{
+    vertexNormalsImpl<T>(positions, indices, triangleCount, adjacency, normals, weighting, mode, threads);
+}
+
+template <typename T>
+void orthonormalBasis(const Vector3<T> *normals, std::size_t count, Vector3<T> *tangents, Vector3<T> *bitangents)
+{
+    orthonormalBasisImpl<T>(normals, count, tangents, bitangents);
+}
+
+template <typename T>
+void vertexTangents(const Vector3<T> *positions, const Vector3<T> *normals, const Vector2<T> *uvs,
+                    const std::uint32_t *indices, std::size_t triangleCount,
+                    const VertexFaceAdjacency &adjacency, Vector4<T> *tangents, unsigned threads)
+{
+    vertexTangentsImpl<T>(positions, normals, uvs, indices, triangleCount, adjacency, tangents, threads);
+}
+
+// Strided views
+template <typename T>
+void faceNormals(const StridedView<Vector3<T>> &positions, const std::uint32_t *indices, std::size_t triangleCount,
+                 Vector3<T> *normals, bool normalize, StoreMode mode, unsigned threads)
+{
+    faceNormalsImpl<T>(positions, indices, triangleCount, normals, normalize, mode, threads);
+}
+
+template <typename T>
+void vertexNormals(const StridedView<Vector3<T>> &positions, const std::uint32_t *indices,
+                   std::size_t triangleCount, const VertexFaceAdjacency &adjacency,
+                   const StridedRef<Vector3<T>> &normals, NormalWeighting weighting, unsigned threads)
+{
+    checkVertexViews(adjacency, positions, normals);
+    vertexNormalsImpl<T>(positions, indices, triangleCount, adjacency, normals, weighting, StoreMode::Regular,
+                         threads);
+}
+
+template <typename T>
+void orthonormalBasis(const StridedView<Vector3<T>> &normals, const StridedRef<Vector3<T>> &tangents,
+                      const StridedRef<Vector3<T>> &bitangents)
+{
+    checkCounts(normals, tangents);
+    checkCounts(normals, bitangents);
+    orthonormalBasisImpl<T>(normals, normals.count, tangents, bitangents);
+}
+
+template <typename T>
+void vertexTangents(const StridedView<Vector3<T>> &positions, const StridedView<Vector3<T>> &normals,
+                    const StridedView<Vector2<T>> &uvs, const std::uint32_t *indices, std::size_t triangleCount,
+                    const VertexFaceAdjacency &adjacency, const StridedRef<Vector4<T>> &tangents,
+                    unsigned threads)
+{
+    checkVertexViews(adjacency, positions, normals, uvs, tangents);
+    vertexTangentsImpl<T>(positions, normals, uvs, indices, triangleCount, adjacency, tangents, threads);
+}
+
+#define LUMINA_INSTANTIATE_NORMALS(T)                                                                         \
+    template void faceNormals<T>(const Vector3<T> *, const std::uint32_t *, std::size_t, Vector3<T> *, bool,  \
+                                 StoreMode, unsigned);                                                        \
+    template void vertexNormals<T>(const Vector3<T> *, const std::uint32_t *, std::size_t,                    \
+                                   const VertexFaceAdjacency &, Vector3<T> *, NormalWeighting, StoreMode,     \
+                                   unsigned);                                                                 \
+    template void orthonormalBasis<T>(const Vector3<T> *, std::size_t, Vector3<T> *, Vector3<T> *);           \
+    template void vertexTangents<T>(const Vector3<T> *, const Vector3<T> *, const Vector2<T> *,               \
+                                    const std::uint32_t *, std::size_t, const VertexFaceAdjacency &,          \
+                                    Vector4<T> *, unsigned);                                                  \
+    template void faceNormals<T>(const StridedView<Vector3<T>> &, const std::uint32_t *, std::size_t,         \
+                                 Vector3<T> *, bool, StoreMode, unsigned);                                    \
+    template void vertexNormals<T>(const StridedView<Vector3<T>> &, const std::uint32_t *, std::size_t,       \
+                                   const VertexFaceAdjacency &, const StridedRef<Vector3<T>> &,               \
+                                   NormalWeighting, unsigned);                                                \
+    template void orthonormalBasis<T>(const StridedView<Vector3<T>> &, const StridedRef<Vector3<T>> &,        \
+                                      const StridedRef<Vector3<T>> &);                                        \
+    template void vertexTangents<T>(const StridedView<Vector3<T>> &, const StridedView<Vector3<T>> &,         \
+                                    const StridedView<Vector2<T>> &, const std::uint32_t *, std::size_t,      \
+                                    const VertexFaceAdjacency &, const StridedRef<Vector4<T>> &, unsigned);
+
+LUMINA_INSTANTIATE_NORMALS(float)
+LUMINA_INSTANTIATE_NORMALS(double)
+
+#undef LUMINA_INSTANTIATE_NORMALS
+
+} // namespace lumina
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Internal fork-join helpers used by the multithreaded batch kernels.
+// A requested thread count of 0 means "use every hardware thread".
+
+namespace lumina::parallel
+{
+
+    // Number of chunks to split `count` items into, keeping at least `minPerChunk` items in each
+    inline unsigned chunkCount(std::size_t count, unsigned requested, std::size_t minPerChunk)
+    {
+        unsigned threads = requested != 0 ? requested : std::max(1u, std::thread::hardware_concurrency());
+        std::size_t byWork = std::max<std::size_t>(1, count / std::max<std::size_t>(1, minPerChunk));
+        return static_cast<unsigned>(std::min<std::size_t>(threads, byWork));
+    }
+
+    // Calls fn(chunk, begin, end) for `chunks` contiguous ranges covering [0, count).
+    // Chunk 0 runs on the calling thread; the call returns once every chunk is done.
+    template <typename Fn>
+    void forEachChunk(std::size_t count, unsigned chunks, Fn &&fn)
+    {
+        chunks = std::max(1u, chunks);
+        auto rangeBegin = [&](unsigned c) { return count * c / chunks; };
+
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+        for (unsigned c = 1; c < chunks; ++c)
+            workers.emplace_back([&fn, c, b = rangeBegin(c), e = rangeBegin(c + 1)]() { fn(c, b, e); });
+
+        fn(0u, rangeBegin(0), rangeBegin(1));
+        for (std::thread &worker : workers)
+            worker.join();
+    }
+
+} // namespace lumina::parallel
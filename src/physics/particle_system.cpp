@@ -0,0 +1,238 @@
+#include <lumina/physics/particle_system.hpp>
+#include "../parallel/parallel_for.hpp"
+#include "../simd/simd.hpp"
+#include <stdexcept>
+
+namespace lumina
+{
+
+namespace
+{
+
+constexpr std::size_t MinParticlesPerThread = std::size_t(1) << 14;
+
+// The three axes are independent (uniform drag, per-axis forces), so every integrator
+// and boundary rule is written for one axis and applied to x, y and z in the same pass
+template <Integrator I, typename P>
+inline void integrateAxis(P &x, P &v, P a, P drag, P dt)
+{
+    if constexpr (I == Integrator::SemiImplicitEuler)
+    {
+        v = simd::fmadd(a - drag * v, dt, v);
+        x = simd::fmadd(v, dt, x);
+    }
+    else if constexpr (I == Integrator::Verlet)
+    {
+        P halfDt = dt * P::broadcast(typename P::Scalar(0.5));
+        v = simd::fmadd(a - drag * v, halfDt, v);
+        x = simd::fmadd(v, dt, x);
+        v = simd::fmadd(a - drag * v, halfDt, v);
+    }
+    else
+    {
+        P halfDt = dt * P::broadcast(typename P::Scalar(0.5));
+        P two = P::broadcast(typename P::Scalar(2));
+        P k1v = a - drag * v;
+        P v2 = simd::fmadd(k1v, halfDt, v);
+        P k2v = a - drag * v2;
+        P v3 = simd::fmadd(k2v, halfDt, v);
+        P k3v = a - drag * v3;
+        P v4 = simd::fmadd(k3v, dt, v);
+        P k4v = a - drag * v4;
+
+        P sixthDt = dt * P::broadcast(typename P::Scalar(1) / typename P::Scalar(6));
+        x = simd::fmadd(v + two * (v2 + v3) + v4, sixthDt, x);
+        v = simd::fmadd(k1v + two * (k2v + k3v) + k4v, sixthDt, v);
+    }
+}
+
+template <BoundaryMode B, typename P>
+inline void boundAxis(P &x, P &v, P lo, P hi, P restitution)
+{
+    if constexpr (B == BoundaryMode::Clamp)
+    {
+        auto below = x < lo;
+        auto above = x > hi;
+        P zero = P::broadcast(typename P::Scalar(0));
+        x = simd::min(simd::max(x, lo), hi);
+        v = simd::select(below, simd::max(v, zero), v);
+        v = simd::select(above, simd::min(v, zero), v);
+    }
+    else if constexpr (B == BoundaryMode::Reflect)
+    {
+        P zero = P::broadcast(typename P::Scalar(0));
+        P two = P::broadcast(typename P::Scalar(2));
+        auto below = x < lo;
+        auto above = x > hi;
+        // Mirror the overshoot; the clamp covers overshoots larger than the box itself
+        x = simd::select(below, two * lo - x, x);
+        x = simd::select(above, two * hi - x, x);
+        x = simd::min(simd::max(x, lo), hi);
+        v = simd::select(below & (v < zero), -v * restitution, v);
+        v = simd::select(above & (v > zero), -v * restitution, v);
+    }
+}
+
+template <typename T>
+struct StepParams
+{
+    T dt;
+    T drag;
+    T restitution;
+    Vector3<T> acceleration;
+    Bounds3<T> bounds;
+};
+
+// Positions and velocities are SoA refs or strided views, read and written in place
+template <typename T, Integrator I, BoundaryMode B, bool Field, typename Storage>
+void stepRange(const Storage &pos, const Storage &vel, const Vector3SoAView<T> &acc, const StepParams<T> &params,
+               std::size_t begin, std::size_t end)
+{
+    const T uniform[3] = {params.acceleration.x, params.acceleration.y, params.acceleration.z};
+    const T lo[3] = {params.bounds.min.x, params.bounds.min.y, params.bounds.min.z};
+    const T hi[3] = {params.bounds.max.x, params.bounds.max.y, params.bounds.max.z};
+
+    simd::forEachPack<T>(end - begin, [&](auto tag, std::size_t j)
+    {
+        using P = typename decltype(tag)::type;
+        std::size_t i = begin + j;
+        P dt = P::broadcast(params.dt);
+        P drag = P::broadcast(params.drag);
+        for (int k = 0; k < 3; ++k)
+        {
+            P x = simd::loadComponent<P>(pos, i, k);
+            P v = simd::loadComponent<P>(vel, i, k);
+            P a = P::broadcast(uniform[k]);
+            if constexpr (Field)
+                a = a + simd::loadComponent<P>(acc, i, k);
+            integrateAxis<I>(x, v, a, drag, dt);
+            boundAxis<B>(x, v, P::broadcast(lo[k]), P::broadcast(hi[k]), P::broadcast(params.restitution));
+            simd::storeComponent(x, pos, i, k);
+            simd::storeComponent(v, vel, i, k);
+        }
+    });
+}
+
+// `acc` is applied when it holds one acceleration per particle
+template <typename T, Integrator I, BoundaryMode B, typename Storage>
+void stepWith(const Storage &pos, const Storage &vel, const Vector3SoAView<T> &acc, std::size_t count,
+              const StepParams<T> &params, unsigned threads)
+{
+    bool field = acc.count == count && count > 0;
+    unsigned chunks = parallel::chunkCount(count, threads, MinParticlesPerThread);
+    parallel::forEachChunk(count, chunks, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        if (field)
+            stepRange<T, I, B, true>(pos, vel, acc, params, begin, end);
+        else
+            stepRange<T, I, B, false>(pos, vel, acc, params, begin, end);
+    });
+}
+
+template <typename T, Integrator I, typename Storage>
+void stepWith(BoundaryMode mode, const Storage &pos, const Storage &vel, const Vector3SoAView<T> &acc,
+              std::size_t count, const StepParams<T> &params, unsigned threads)
+{
+    switch (mode)
+    {
+    case BoundaryMode::None:
+        stepWith<T, I, BoundaryMode::None>(pos, vel, acc, count, params, threads);
+        break;
+    case BoundaryMode::Clamp:
+        stepWith<T, I, BoundaryMode::Clamp>(pos, vel, acc, count, params, threads);
+        break;
+    case BoundaryMode::Reflect:
+        stepWith<T, I, BoundaryMode::Reflect>(pos, vel, acc, count, params, threads);
+        break;
+    }
+}
+
+template <typename T, typename Storage>
+void stepWith(Integrator integrator, BoundaryMode mode, const Storage &pos, const Storage &vel,
+              const Vector3SoAView<T> &acc, std::size_t count, const StepParams<T> &params, unsigned threads)
+{
+    switch (integrator)
+    {
+    case Integrator::SemiImplicitEuler:
+        stepWith<T, Integrator::SemiImplicitEuler>(mode, pos, vel, acc, count, params, threads);
+        break;
+    case Integrator::Verlet:
+        stepWith<T, Integrator::Verlet>(mode, pos, vel, acc, count, params, threads);
+        break;
+    case Integrator::RungeKutta4:
+        stepWith<T, Integrator::RungeKutta4>(mode, pos, vel, acc, count, params, threads);
+        break;
+    }
+}
+
+} // namespace
+
+template <typename T>
+ParticleSystem<T>::ParticleSystem()
+    : acceleration(Vector3<T>::zero()), drag(T(0)), boundaryMode(BoundaryMode::None), restitution(T(1)) {}
+
+template <typename T>
+ParticleSystem<T>::ParticleSystem(std::size_t count)
+    : positions(count), velocities(count), acceleration(Vector3<T>::zero()), drag(T(0)),
+      boundaryMode(BoundaryMode::None), restitution(T(1)) {}
+
+// Size management
+template <typename T>
+std::size_t ParticleSystem<T>::size() const
+{
+    return positions.size();
+}
+
+template <typename T>
+void ParticleSystem<T>::resize(std::size_t count)
+{
+    positions.resize(count);
+    velocities.resize(count);
+    if (!accelerations.empty())
+        accelerations.resize(count);
+}
+
+template <typename T>
+void ParticleSystem<T>::add(const Vector3<T> &position, const Vector3<T> &velocity)
+{
+    positions.push_back(position);
+    velocities.push_back(velocity);
+    if (!accelerations.empty())
+        accelerations.push_back(Vector3<T>::zero());
+}
+
+// Simulation
+template <typename T>
+void ParticleSystem<T>::step(T dt, Integrator integrator, unsigned threads)
+{
+    if (velocities.size() != positions.size())
+        throw std::logic_error("ParticleSystem velocity buffer does not match positions");
+    if (!accelerations.empty() && accelerations.size() != positions.size())
+        throw std::logic_error("ParticleSystem acceleration buffer does not match positions");
+    if (boundaryMode != BoundaryMode::None && bounds.isEmpty())
+        throw std::logic_error("ParticleSystem boundary mode needs non-empty bounds");
+
+    StepParams<T> params{dt, drag, restitution, acceleration, bounds};
+    stepWith(integrator, boundaryMode, positions.ref(), velocities.ref(), accelerations.view(), size(), params,
+             threads);
+}
+
+template <typename T>
+void ParticleSystem<T>::step(T dt, const StridedRef<Vector3<T>> &externalPositions,
+                             const StridedRef<Vector3<T>> &externalVelocities, Integrator integrator,
+                             unsigned threads) const
+{
+    if (externalVelocities.count != externalPositions.count)
+        throw std::invalid_argument("Strided views differ in length");
+    if (boundaryMode != BoundaryMode::None && bounds.isEmpty())
+        throw std::logic_error("ParticleSystem boundary mode needs non-empty bounds");
+
+    StepParams<T> params{dt, drag, restitution, acceleration, bounds};
+    stepWith(integrator, boundaryMode, externalPositions, externalVelocities, Vector3SoAView<T>{},
+             externalPositions.count, params, threads);
+}
+
+template class ParticleSystem<float>;
+template class ParticleSystem<double>;
+
+} // namespace lumina
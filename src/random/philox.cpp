@@ -0,0 +1,21 @@
+#include <lumina/random/philox.hpp>
+#include "../simd/simd.hpp"
+
+namespace lumina
+{
+
+Philox4x32::Philox4x32() : seed(0), stream(0) {}
+
+Philox4x32::Philox4x32(std::uint64_t seed, std::uint32_t stream) : seed(seed), stream(stream) {}
+
+Philox4x32::Block Philox4x32::generate(std::uint64_t counter, std::uint32_t block) const
+{
+    simd::ScalarU32 words[4] = {{static_cast<std::uint32_t>(counter)},
+                                {static_cast<std::uint32_t>(counter >> 32)},
+                                {stream},
+                                {block}};
+    simd::philox4x32(words, seed);
+    return {words[0].v, words[1].v, words[2].v, words[3].v};
+}
+
+} // namespace lumina
@@ -0,0 +1,216 @@
+#include <lumina/random/sampling.hpp>
+#include "../parallel/parallel_for.hpp"
+#include "../simd/simd_math.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace lumina
+{
+
+namespace
+{
+
+constexpr std::size_t MinSamplesPerThread = std::size_t(1) << 14;
+constexpr std::size_t Lanes = simd::PackU32::width;
+
+// Fills uniforms[d][j] in [0, 1) for counters counter + j, j < Lanes.
+// Each uniform takes one 32-bit word (float) or two (double), so several blocks may be needed.
+template <typename T, std::size_t Uniforms>
+void generateUniforms(const Philox4x32 &rng, std::uint64_t counter, T (&uniforms)[Uniforms][Lanes])
+{
+    constexpr std::size_t WordsPerUniform = sizeof(T) / sizeof(std::uint32_t);
+    constexpr std::size_t Blocks = (Uniforms * WordsPerUniform + 3) / 4;
+    using U = simd::PackU32;
+
+    std::uint32_t low[Lanes], high[Lanes];
+    for (std::size_t j = 0; j < Lanes; ++j)
+    {
+        low[j] = static_cast<std::uint32_t>(counter + j);
+        high[j] = static_cast<std::uint32_t>((counter + j) >> 32);
+    }
+
+    std::uint32_t words[Blocks * 4][Lanes];
+    for (std::size_t b = 0; b < Blocks; ++b)
+    {
+        U block[4] = {U::load(low), U::load(high), U::broadcast(rng.stream),
+                      U::broadcast(static_cast<std::uint32_t>(b))};
+        simd::philox4x32(block, rng.seed);
+        for (std::size_t k = 0; k < 4; ++k)
+            block[k].store(words[b * 4 + k]);
+    }
+
+    for (std::size_t d = 0; d < Uniforms; ++d)
+        for (std::size_t j = 0; j < Lanes; ++j)
+        {
+            if constexpr (WordsPerUniform == 1)
+                uniforms[d][j] = T(words[d][j] >> 8) * T(0x1p-24);
+            else
+                uniforms[d][j] = T((std::uint64_t(words[2 * d][j]) << 21) | (words[2 * d + 1][j] >> 11)) * T(0x1p-53);
+        }
+}
+
+// Runs kernel<A, P>(index, uniform) over [0, count), where uniform(d) loads the d-th uniform variate
+// of the samples index .. index + P::width - 1 as a pack
+template <typename T, std::size_t Uniforms, typename Kernel>
+void sampleBatch(const Philox4x32 &rng, std::uint64_t offset, std::size_t count, MathAccuracy accuracy,
+                 unsigned threads, Kernel &&kernel)
+{
+    unsigned chunks = parallel::chunkCount(count, threads, MinSamplesPerThread);
+    parallel::forEachChunk(count, chunks, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        T uniforms[Uniforms][Lanes];
+        for (std::size_t base = begin; base < end; base += Lanes)
+        {
+            generateUniforms<T>(rng, offset + base, uniforms);
+            simd::forEachPack<T>(std::min(Lanes, end - base), accuracy,
+                                 [&]<MathAccuracy A, typename P>(std::size_t i)
+            {
+                kernel.template operator()<A, P>(base + i, [&](std::size_t d) { return P::load(&uniforms[d][i]); });
+            });
+        }
+    });
+}
+
+// Point on the unit circle at azimuth 2 pi v - pi
+template <MathAccuracy A, typename P>
+void unitCircle(P v, P &x, P &y)
+{
+    using simd::detail::constant;
+    simd::sincos<A>(simd::fmadd(v, constant<P>(6.28318530717958647692), constant<P>(-3.14159265358979323846)), y, x);
+}
+
+// Uniform direction with z = 1 - 2u
+template <MathAccuracy A, typename P>
+void sphereDirection(P u, P v, P &x, P &y, P &z)
+{
+    P one = P::broadcast(1);
+    z = simd::fmadd(P::broadcast(-2), u, one);
+    P radius = simd::sqrt(simd::max(one - z * z, P::broadcast(0)));
+    unitCircle<A>(v, x, y);
+    x = radius * x;
+    y = radius * y;
+}
+
+void checkCounter(std::uint64_t offset, std::size_t count)
+{
+    if (count != 0 && count - 1 > ~offset)
+        throw std::length_error("sample counter range wraps around");
+}
+
+} // namespace
+
+template <typename T>
+void sampleUniform(const Philox4x32 &rng, std::uint64_t offset, T *out, std::size_t count, unsigned threads)
+{
+    checkCounter(offset, count);
+    sampleBatch<T, 1>(rng, offset, count, MathAccuracy::Precise, threads,
+                      [&]<MathAccuracy, typename P>(std::size_t i, auto uniform) { uniform(0).store(out + i); });
+}
+
+template <typename T>
+void sampleSphere(const Philox4x32 &rng, std::uint64_t offset, Vector3<T> *out, std::size_t count,
+                  MathAccuracy accuracy, unsigned threads)
+{
+    checkCounter(offset, count);
+    sampleBatch<T, 2>(rng, offset, count, accuracy, threads,
+                      [&]<MathAccuracy A, typename P>(std::size_t i, auto uniform)
+    {
+        P x, y, z;
+        sphereDirection<A>(uniform(0), uniform(1), x, y, z);
+        simd::storeComponent(x, out, i, 0);
+        simd::storeComponent(y, out, i, 1);
+        simd::storeComponent(z, out, i, 2);
+    });
+}
+
+template <typename T>
+void sampleBall(const Philox4x32 &rng, std::uint64_t offset, Vector3<T> *out, std::size_t count,
+                MathAccuracy accuracy, unsigned threads)
+{
+    checkCounter(offset, count);
+    sampleBatch<T, 5>(rng, offset, count, accuracy, threads,
+                      [&]<MathAccuracy A, typename P>(std::size_t i, auto uniform)
+    {
+        P x, y, z;
+        sphereDirection<A>(uniform(0), uniform(1), x, y, z);
+        P radius = simd::max(uniform(2), simd::max(uniform(3), uniform(4)));
+        simd::storeComponent(x * radius, out, i, 0);
+        simd::storeComponent(y * radius, out, i, 1);
+        simd::storeComponent(z * radius, out, i, 2);
+    });
+}
+
+template <typename T>
+void sampleHemisphere(const Philox4x32 &rng, std::uint64_t offset, Vector3<T> *out, std::size_t count,
+                      HemisphereDistribution distribution, MathAccuracy accuracy, unsigned threads)
+{
+    checkCounter(offset, count);
+    bool cosine = distribution == HemisphereDistribution::Cosine;
+    sampleBatch<T, 2>(rng, offset, count, accuracy, threads,
+                      [&]<MathAccuracy A, typename P>(std::size_t i, auto uniform)
+    {
+        // Uniform: z = 1 - u. Cosine: project a uniform disk point up, so z = sqrt(1 - u) and r = sqrt(u).
+        P one = P::broadcast(1);
+        P u = uniform(0);
+        P z = cosine ? simd::sqrt(one - u) : one - u;
+        P radius = cosine ? simd::sqrt(u) : simd::sqrt(simd::max(one - z * z, P::broadcast(0)));
+        P c, s;
+        unitCircle<A>(uniform(1), c, s);
+        simd::storeComponent(radius * c, out, i, 0);
+        simd::storeComponent(radius * s, out, i, 1);
+        simd::storeComponent(z, out, i, 2);
+    });
+}
+
+template <typename T>
+void sampleDisk(const Philox4x32 &rng, std::uint64_t offset, Vector2<T> *out, std::size_t count,
+                MathAccuracy accuracy, unsigned threads)
+{
+    checkCounter(offset, count);
+    sampleBatch<T, 2>(rng, offset, count, accuracy, threads,
+                      [&]<MathAccuracy A, typename P>(std::size_t i, auto uniform)
+    {
+        P radius = simd::sqrt(uniform(0));
+        P c, s;
+        unitCircle<A>(uniform(1), c, s);
+        simd::storeComponent(radius * c, out, i, 0);
+        simd::storeComponent(radius * s, out, i, 1);
+    });
+}
+
+template <typename T>
+void sampleBox(const Philox4x32 &rng, std::uint64_t offset, const Bounds3<T> &bounds, Vector3<T> *out,
+               std::size_t count, unsigned threads)
+{
+    if (bounds.isEmpty())
+        throw std::invalid_argument("sampleBox requires non-empty bounds");
+    checkCounter(offset, count);
+    const T lo[3] = {bounds.min.x, bounds.min.y, bounds.min.z};
+    const T size[3] = {bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y, bounds.max.z - bounds.min.z};
+    sampleBatch<T, 3>(rng, offset, count, MathAccuracy::Precise, threads,
+                      [&]<MathAccuracy, typename P>(std::size_t i, auto uniform)
+    {
+        for (std::size_t k = 0; k < 3; ++k)
+            simd::storeComponent(simd::fmadd(uniform(k), P::broadcast(size[k]), P::broadcast(lo[k])), out, i, k);
+    });
+}
+
+#define LUMINA_INSTANTIATE_SAMPLING(T)                                                                         \
+    template void sampleUniform<T>(const Philox4x32 &, std::uint64_t, T *, std::size_t, unsigned);             \
+    template void sampleSphere<T>(const Philox4x32 &, std::uint64_t, Vector3<T> *, std::size_t, MathAccuracy,  \
+                                  unsigned);                                                                   \
+    template void sampleBall<T>(const Philox4x32 &, std::uint64_t, Vector3<T> *, std::size_t, MathAccuracy,    \
+                                unsigned);                                                                     \
+    template void sampleHemisphere<T>(const Philox4x32 &, std::uint64_t, Vector3<T> *, std::size_t,            \
+                                      HemisphereDistribution, MathAccuracy, unsigned);                         \
+    template void sampleDisk<T>(const Philox4x32 &, std::uint64_t, Vector2<T> *, std::size_t, MathAccuracy,    \
+                                unsigned);                                                                     \
+    template void sampleBox<T>(const Philox4x32 &, std::uint64_t, const Bounds3<T> &, Vector3<T> *,            \
+                               std::size_t, unsigned);
+
+LUMINA_INSTANTIATE_SAMPLING(float)
+LUMINA_INSTANTIATE_SAMPLING(double)
+
+#undef LUMINA_INSTANTIATE_SAMPLING
+
+} // namespace lumina
@@ -0,0 +1,1112 @@
+#pragma once
+
+#include <lumina/batch/soa.hpp>
+#include <lumina/batch/strided_view.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Internal SIMD layer used by the batch kernels.
+// Pack<T> is the widest native register for T (AVX2, SSE2 or a single scalar),
+// ScalarPack<T> has the same interface with one lane and is used for loop tails.
+
+namespace lumina::simd
+{
+
+    // Single lane fallback
+    template <typename T>
+    struct ScalarMask
+    {
+        bool v;
+
+        unsigned bits() const { return v ? 1u : 0u; }
+        bool any() const { return v; }
+        bool all() const { return v; }
+
+        ScalarMask operator&(ScalarMask o) const { return {v && o.v}; }
+        ScalarMask operator|(ScalarMask o) const { return {v || o.v}; }
+        ScalarMask operator~() const { return {!v}; }
+    };
+
+    template <typename T>
+    struct ScalarPack
+    {
+        using Scalar = T;
+        using Mask = ScalarMask<T>;
+        static constexpr std::size_t width = 1;
+
+        T v;
+
+        static ScalarPack load(const T *p) { return {*p}; }
+        static ScalarPack broadcast(T s) { return {s}; }
+        void store(T *p) const { *p = v; }
+
+        ScalarPack operator+(ScalarPack o) const { return {v + o.v}; }
+        ScalarPack operator-(ScalarPack o) const { return {v - o.v}; }
+        ScalarPack operator*(ScalarPack o) const { return {v * o.v}; }
+        ScalarPack operator/(ScalarPack o) const { return {v / o.v}; }
+        ScalarPack operator-() const { return {-v}; }
+
+        Mask operator<(ScalarPack o) const { return {v < o.v}; }
+        Mask operator<=(ScalarPack o) const { return {v <= o.v}; }
+        Mask operator>(ScalarPack o) const { return {v > o.v}; }
+        Mask operator>=(ScalarPack o) const { return {v >= o.v}; }
+        Mask operator==(ScalarPack o) const { return {v == o.v}; }
+    };
+
+    // Like minps/maxps, the second operand is returned on ties and NaNs, so tails match full packs
+    template <typename T>
+    inline ScalarPack<T> min(ScalarPack<T> a, ScalarPack<T> b) { return {a.v < b.v ? a.v : b.v}; }
+    template <typename T>
+    inline ScalarPack<T> max(ScalarPack<T> a, ScalarPack<T> b) { return {a.v > b.v ? a.v : b.v}; }
+    template <typename T>
+    inline ScalarPack<T> abs(ScalarPack<T> a) { return {std::abs(a.v)}; }
+    template <typename T>
+    inline ScalarPack<T> sqrt(ScalarPack<T> a) { return {std::sqrt(a.v)}; }
+    // Fused exactly when the native packs fuse, so tail lanes round like full packs
+    template <typename T>
+    inline ScalarPack<T> fmadd(ScalarPack<T> a, ScalarPack<T> b, ScalarPack<T> c)
+    {
+#if defined(__AVX2__) && defined(__FMA__)
+        return {std::fma(a.v, b.v, c.v)};
+#else
+        return {a.v * b.v + c.v};
+#endif
+    }
+    // Rounding error of product = a * b by Dekker's split product: a * b == product + error exactly
+    // unless the product overflows or the error underflows. The split's multiplies and adds must not be
+    // contracted, which only FMA targets could do, and those use the fused productError overloads.
+    template <typename P>
+    inline P splitProductError(P a, P b, P product)
+    {
+        using T = typename P::Scalar;
+        const P factor = P::broadcast(std::is_same_v<T, float> ? T(4097) : T(134217729));
+        P ca = factor * a, cb = factor * b;
+        P aHigh = ca - (ca - a), bHigh = cb - (cb - b);
+        P aLow = a - aHigh, bLow = b - bHigh;
+        return aLow * bLow - (((product - aHigh * bHigh) - aLow * bHigh) - aHigh * bLow);
+    }
+    // The error is exact either way, so tail lanes match full packs
+    template <typename T>
+    inline ScalarPack<T> productError(ScalarPack<T> a, ScalarPack<T> b, ScalarPack<T> product)
+    {
+#if defined(__FMA__)
+        return {std::fma(a.v, b.v, -product.v)};
+#else
+        return splitProductError(a, b, product);
+#endif
+    }
+    template <typename T>
+    inline ScalarPack<T> select(ScalarMask<T> m, ScalarPack<T> a, ScalarPack<T> b) { return {m.v ? a.v : b.v}; }
+    template <typename T>
+    inline ScalarPack<T> roundNearest(ScalarPack<T> a) { return {std::nearbyint(a.v)}; }
+    template <typename T>
+    inline ScalarPack<T> rsqrtEstimate(ScalarPack<T> a) { return {T(1) / std::sqrt(a.v)}; }
+#if defined(__AVX2__) || defined(__SSE2__)
+    // The same hardware estimate as rsqrtps, so float tail lanes match full packs
+    inline ScalarPack<float> rsqrtEstimate(ScalarPack<float> a)
+    {
+        return {_mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(a.v)))};
+    }
+#endif
+    // 2^n for integral n within the normal exponent range
+    template <typename T>
+    inline ScalarPack<T> exp2i(ScalarPack<T> n) { return {std::ldexp(T(1), int(n.v))}; }
+
+#if defined(__AVX2__)
+
+    // 8 x float
+    struct MaskF
+    {
+        __m256 v;
+
+        unsigned bits() const { return unsigned(_mm256_movemask_ps(v)); }
+        bool any() const { return bits() != 0; }
+        bool all() const { return bits() == 0xFFu; }
+
+        MaskF operator&(MaskF o) const { return {_mm256_and_ps(v, o.v)}; }
+        MaskF operator|(MaskF o) const { return {_mm256_or_ps(v, o.v)}; }
+        MaskF operator~() const { return {_mm256_xor_ps(v, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))}; }
+    };
+
+    struct PackF
+    {
+        using Scalar = float;
+        using Mask = MaskF;
+        static constexpr std::size_t width = 8;
+
+        __m256 v;
+
+        static PackF load(const float *p) { return {_mm256_loadu_ps(p)}; }
+        static PackF broadcast(float s) { return {_mm256_set1_ps(s)}; }
+        void store(float *p) const { _mm256_storeu_ps(p, v); }
+
+        PackF operator+(PackF o) const { return {_mm256_add_ps(v, o.v)}; }
+        PackF operator-(PackF o) const { return {_mm256_sub_ps(v, o.v)}; }
+        PackF operator*(PackF o) const { return {_mm256_mul_ps(v, o.v)}; }
+        PackF operator/(PackF o) const { return {_mm256_div_ps(v, o.v)}; }
+        PackF operator-() const { return {_mm256_xor_ps(v, _mm256_set1_ps(-0.0f))}; }
+
+        MaskF operator<(PackF o) const { return {_mm256_cmp_ps(v, o.v, _CMP_LT_OQ)}; }
+        MaskF operator<=(PackF o) const { return {_mm256_cmp_ps(v, o.v, _CMP_LE_OQ)}; }
+        MaskF operator>(PackF o) const { return {_mm256_cmp_ps(v, o.v, _CMP_GT_OQ)}; }
+        MaskF operator>=(PackF o) const { return {_mm256_cmp_ps(v, o.v, _CMP_GE_OQ)}; }
+        MaskF operator==(PackF o) const { return {_mm256_cmp_ps(v, o.v, _CMP_EQ_OQ)}; }
+    };
+
+    inline PackF min(PackF a, PackF b) { return {_mm256_min_ps(a.v, b.v)}; }
+    inline PackF max(PackF a, PackF b) { return {_mm256_max_ps(a.v, b.v)}; }
+    inline PackF abs(PackF a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+    inline PackF sqrt(PackF a) { return {_mm256_sqrt_ps(a.v)}; }
+    inline PackF select(MaskF m, PackF a, PackF b) { return {_mm256_blendv_ps(b.v, a.v, m.v)}; }
+    inline PackF roundNearest(PackF a) { return {_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+    inline PackF rsqrtEstimate(PackF a) { return {_mm256_rsqrt_ps(a.v)}; }
+    inline PackF exp2i(PackF n)
+    {
+        __m256i e = _mm256_add_epi32(_mm256_cvtps_epi32(n.v), _mm256_set1_epi32(127));
+        return {_mm256_castsi256_ps(_mm256_slli_epi32(e, 23))};
+    }
+#if defined(__FMA__)
+    inline PackF fmadd(PackF a, PackF b, PackF c) { return {_mm256_fmadd_ps(a.v, b.v, c.v)}; }
+    inline PackF productError(PackF a, PackF b, PackF p) { return {_mm256_fmsub_ps(a.v, b.v, p.v)}; }
+#else
+    inline PackF fmadd(PackF a, PackF b, PackF c) { return a * b + c; }
+    inline PackF productError(PackF a, PackF b, PackF p) { return splitProductError(a, b, p); }
+#endif
+
+    // 4 x double
+    struct MaskD
+    {
+        __m256d v;
+
+        unsigned bits() const { return unsigned(_mm256_movemask_pd(v)); }
+        bool any() const { return bits() != 0; }
+        bool all() const { return bits() == 0xFu; }
+
+        MaskD operator&(MaskD o) const { return {_mm256_and_pd(v, o.v)}; }
+        MaskD operator|(MaskD o) const { return {_mm256_or_pd(v, o.v)}; }
+        MaskD operator~() const { return {_mm256_xor_pd(v, _mm256_castsi256_pd(_mm256_set1_epi32(-1)))}; }
+    };
+
+    struct PackD
+    {
+        using Scalar = double;
+        using Mask = MaskD;
+        static constexpr std::size_t width = 4;
+
+        __m256d v;
+
+        static PackD load(const double *p) { return {_mm256_loadu_pd(p)}; }
+        static PackD broadcast(double s) { return {_mm256_set1_pd(s)}; }
+        void store(double *p) const { _mm256_storeu_pd(p, v); }
+
+        PackD operator+(PackD o) const { return {_mm256_add_pd(v, o.v)}; }
+        PackD operator-(PackD o) const { return {_mm256_sub_pd(v, o.v)}; }
+        PackD operator*(PackD o) const { return {_mm256_mul_pd(v, o.v)}; }
+        PackD operator/(PackD o) const { return {_mm256_div_pd(v, o.v)}; }
+        PackD operator-() const { return {_mm256_xor_pd(v, _mm256_set1_pd(-0.0))}; }
+
+        MaskD operator<(PackD o) const { return {_mm256_cmp_pd(v, o.v, _CMP_LT_OQ)}; }
+        MaskD operator<=(PackD o) const { return {_mm256_cmp_pd(v, o.v, _CMP_LE_OQ)}; }
+        MaskD operator>(PackD o) const { return {_mm256_cmp_pd(v, o.v, _CMP_GT_OQ)}; }
+        MaskD operator>=(PackD o) const { return {_mm256_cmp_pd(v, o.v, _CMP_GE_OQ)}; }
+        MaskD operator==(PackD o) const { return {_mm256_cmp_pd(v, o.v, _CMP_EQ_OQ)}; }
+    };
+
+    inline PackD min(PackD a, PackD b) { return {_mm256_min_pd(a.v, b.v)}; }
+    inline PackD max(PackD a, PackD b) { return {_mm256_max_pd(a.v, b.v)}; }
+    inline PackD abs(PackD a) { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+    inline PackD sqrt(PackD a) { return {_mm256_sqrt_pd(a.v)}; }
+    inline PackD select(MaskD m, PackD a, PackD b) { return {_mm256_blendv_pd(b.v, a.v, m.v)}; }
+    inline PackD roundNearest(PackD a) { return {_mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+    inline PackD rsqrtEstimate(PackD a) { return {_mm256_div_pd(_mm256_set1_pd(1.0), _mm256_sqrt_pd(a.v))}; }
+    inline PackD exp2i(PackD n)
+    {
+        // n + 1.5 * 2^52 leaves n in the low mantissa bits
+        __m256i bits = _mm256_castpd_si256(_mm256_add_pd(n.v, _mm256_set1_pd(6755399441055744.0)));
+        __m256i e = _mm256_add_epi64(bits, _mm256_set1_epi64x(1023 - 0x4338000000000000ll));
+        return {_mm256_castsi256_pd(_mm256_slli_epi64(e, 52))};
+    }
+#if defined(__FMA__)
+    inline PackD fmadd(PackD a, PackD b, PackD c) { return {_mm256_fmadd_pd(a.v, b.v, c.v)}; }
+    inline PackD productError(PackD a, PackD b, PackD p) { return {_mm256_fmsub_pd(a.v, b.v, p.v)}; }
+#else
+    inline PackD fmadd(PackD a, PackD b, PackD c) { return a * b + c; }
+    inline PackD productError(PackD a, PackD b, PackD p) { return splitProductError(a, b, p); }
+#endif
+
+#elif defined(__SSE2__)
+
+    // 4 x float
+    struct MaskF
+    {
+        __m128 v;
+
+        unsigned bits() const { return unsigned(_mm_movemask_ps(v)); }
+        bool any() const { return bits() != 0; }
+        bool all() const { return bits() == 0xFu; }
+
+        MaskF operator&(MaskF o) const { return {_mm_and_ps(v, o.v)}; }
+        MaskF operator|(MaskF o) const { return {_mm_or_ps(v, o.v)}; }
+        MaskF operator~() const { return {_mm_xor_ps(v, _mm_castsi128_ps(_mm_set1_epi32(-1)))}; }
+    };
+
+    struct PackF
+    {
+        using Scalar = float;
+        using Mask = MaskF;
+        static constexpr std::size_t width = 4;
+
+        __m128 v;
+
+        static PackF load(const float *p) { return {_mm_loadu_ps(p)}; }
+        static PackF broadcast(float s) { return {_mm_set1_ps(s)}; }
+        void store(float *p) const { _mm_storeu_ps(p, v); }
+
+        PackF operator+(PackF o) const { return {_mm_add_ps(v, o.v)}; }
+        PackF operator-(PackF o) const { return {_mm_sub_ps(v, o.v)}; }
+        PackF operator*(PackF o) const { return {_mm_mul_ps(v, o.v)}; }
+        PackF operator/(PackF o) const { return {_mm_div_ps(v, o.v)}; }
+        PackF operator-() const { return {_mm_xor_ps(v, _mm_set1_ps(-0.0f))}; }
+
+        MaskF operator<(PackF o) const { return {_mm_cmplt_ps(v, o.v)}; }
+        MaskF operator<=(PackF o) const { return {_mm_cmple_ps(v, o.v)}; }
+        MaskF operator>(PackF o) const { return {_mm_cmpgt_ps(v, o.v)}; }
+        MaskF operator>=(PackF o) const { return {_mm_cmpge_ps(v, o.v)}; }
+        MaskF operator==(PackF o) const { return {_mm_cmpeq_ps(v, o.v)}; }
+    };
+
+    inline PackF min(PackF a, PackF b) { return {_mm_min_ps(a.v, b.v)}; }
+    inline PackF max(PackF a, PackF b) { return {_mm_max_ps(a.v, b.v)}; }
+    inline PackF abs(PackF a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+    inline PackF sqrt(PackF a) { return {_mm_sqrt_ps(a.v)}; }
+    inline PackF select(MaskF m, PackF a, PackF b) { return {_mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v))}; }
+    // Round to nearest even like roundps: adding and subtracting 2^23 with the sign of a rounds every
+    // |a| < 2^23, larger values are already integral, and the sign is put back so -0.3 gives -0
+    inline PackF roundNearest(PackF a)
+    {
+        __m128 sign = _mm_and_ps(a.v, _mm_set1_ps(-0.0f));
+        __m128 magic = _mm_or_ps(_mm_set1_ps(8388608.0f), sign);
+        __m128 r = _mm_or_ps(_mm_sub_ps(_mm_add_ps(a.v, magic), magic), sign);
+        __m128 small = _mm_cmplt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v), _mm_set1_ps(8388608.0f));
+        return {_mm_or_ps(_mm_and_ps(small, r), _mm_andnot_ps(small, a.v))};
+    }
+    inline PackF rsqrtEstimate(PackF a) { return {_mm_rsqrt_ps(a.v)}; }
+    inline PackF exp2i(PackF n)
+    {
+        __m128i e = _mm_add_epi32(_mm_cvtps_epi32(n.v), _mm_set1_epi32(127));
+        return {_mm_castsi128_ps(_mm_slli_epi32(e, 23))};
+    }
+    inline PackF fmadd(PackF a, PackF b, PackF c) { return a * b + c; }
+#if defined(__FMA__)
+    inline PackF productError(PackF a, PackF b, PackF p) { return {_mm_fmsub_ps(a.v, b.v, p.v)}; }
+#else
+    inline PackF productError(PackF a, PackF b, PackF p) { return splitProductError(a, b, p); }
+#endif
+
+    // 2 x double
+    struct MaskD
+    {
+        __m128d v;
+
+        unsigned bits() const { return unsigned(_mm_movemask_pd(v)); }
+        bool any() const { return bits() != 0; }
+        bool all() const { return bits() == 0x3u; }
+
+        MaskD operator&(MaskD o) const { return {_mm_and_pd(v, o.v)}; }
+        MaskD operator|(MaskD o) const { return {_mm_or_pd(v, o.v)}; }
+        MaskD operator~() const { return {_mm_xor_pd(v, _mm_castsi128_pd(_mm_set1_epi32(-1)))}; }
+    };
+
+    struct PackD
+    {
+        using Scalar = double;
+        using Mask = MaskD;
+        static constexpr std::size_t width = 2;
+
+        __m128d v;
+
+        static PackD load(const double *p) { return {_mm_loadu_pd(p)}; }
+        static PackD broadcast(double s) { return {_mm_set1_pd(s)}; }
+        void store(double *p) const { _mm_storeu_pd(p, v); }
+
+        PackD operator+(PackD o) const { return {_mm_add_pd(v, o.v)}; }
+        PackD operator-(PackD o) const { return {_mm_sub_pd(v, o.v)}; }
+        PackD operator*(PackD o) const { return {_mm_mul_pd(v, o.v)}; }
+        PackD operator/(PackD o) const { return {_mm_div_pd(v, o.v)}; }
+        PackD operator-() const { return {_mm_xor_pd(v, _mm_set1_pd(-0.0))}; }
+
+        MaskD operator<(PackD o) const { return {_mm_cmplt_pd(v, o.v)}; }
+        MaskD operator<=(PackD o) const { return {_mm_cmple_pd(v, o.v)}; }
+        MaskD operator>(PackD o) const { return {_mm_cmpgt_pd(v, o.v)}; }
+        MaskD operator>=(PackD o) const { return {_mm_cmpge_pd(v, o.v)}; }
+        MaskD operator==(PackD o) const { return {_mm_cmpeq_pd(v, o.v)}; }
+    };
+
+    inline PackD min(PackD a, PackD b) { return {_mm_min_pd(a.v, b.v)}; }
+    inline PackD max(PackD a, PackD b) { return {_mm_max_pd(a.v, b.v)}; }
+    inline PackD abs(PackD a) { return {_mm_andnot_pd(_mm_set1_pd(-0.0), a.v)}; }
+    inline PackD sqrt(PackD a) { return {_mm_sqrt_pd(a.v)}; }
+    inline PackD select(MaskD m, PackD a, PackD b) { return {_mm_or_pd(_mm_and_pd(m.v, a.v), _mm_andnot_pd(m.v, b.v))}; }
+    // Round to nearest even like roundpd, with 2^52 as the magic number
+    inline PackD roundNearest(PackD a)
+    {
+        __m128d sign = _mm_and_pd(a.v, _mm_set1_pd(-0.0));
+        __m128d magic = _mm_or_pd(_mm_set1_pd(4503599627370496.0), sign);
+        __m128d r = _mm_or_pd(_mm_sub_pd(_mm_add_pd(a.v, magic), magic), sign);
+        __m128d small = _mm_cmplt_pd(_mm_andnot_pd(_mm_set1_pd(-0.0), a.v), _mm_set1_pd(4503599627370496.0));
+        return {_mm_or_pd(_mm_and_pd(small, r), _mm_andnot_pd(small, a.v))};
+    }
+    inline PackD rsqrtEstimate(PackD a) { return {_mm_div_pd(_mm_set1_pd(1.0), _mm_sqrt_pd(a.v))}; }
+    inline PackD exp2i(PackD n)
+    {
+        // n + 1.5 * 2^52 leaves n in the low mantissa bits
+        __m128i bits = _mm_castpd_si128(_mm_add_pd(n.v, _mm_set1_pd(6755399441055744.0)));
+        __m128i e = _mm_add_epi64(bits, _mm_set1_epi64x(1023 - 0x4338000000000000ll));
+        return {_mm_castsi128_pd(_mm_slli_epi64(e, 52))};
+    }
+    inline PackD fmadd(PackD a, PackD b, PackD c) { return a * b + c; }
+#if defined(__FMA__)
+    inline PackD productError(PackD a, PackD b, PackD p) { return {_mm_fmsub_pd(a.v, b.v, p.v)}; }
+#else
+    inline PackD productError(PackD a, PackD b, PackD p) { return splitProductError(a, b, p); }
+#endif
+
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    template <typename T>
+    using Pack = std::conditional_t<std::is_same_v<T, float>, PackF, PackD>;
+#else
+    template <typename T>
+    using Pack = ScalarPack<T>;
+#endif
+
+    // a * b - c * d within a few ulp even when the products nearly cancel, in the range where
+    // productError is exact. Where they do cancel ab - cd is exact, leaving only the error terms to round.
+    template <typename P>
+    inline P differenceOfProducts(P a, P b, P c, P d)
+    {
+        P ab = a * b, cd = c * d;
+        return (ab - cd) + (productError(a, b, ab) - productError(c, d, cd));
+    }
+
+    // Horizontal reductions across the lanes of a pack
+    template <typename P>
+    inline typename P::Scalar reduceAdd(P p)
+    {
+        typename P::Scalar lanes[P::width];
+        p.store(lanes);
+        typename P::Scalar result = lanes[0];
+        for (std::size_t i = 1; i < P::width; ++i)
+            result += lanes[i];
+        return result;
+    }
+
+    template <typename P>
+    inline typename P::Scalar reduceMin(P p)
+    {
+        typename P::Scalar lanes[P::width];
+        p.store(lanes);
+        typename P::Scalar result = lanes[0];
+        for (std::size_t i = 1; i < P::width; ++i)
+            result = lanes[i] < result ? lanes[i] : result;
+        return result;
+    }
+
+    template <typename P>
+    inline typename P::Scalar reduceMax(P p)
+    {
+        typename P::Scalar lanes[P::width];
+        p.store(lanes);
+        typename P::Scalar result = lanes[0];
+        for (std::size_t i = 1; i < P::width; ++i)
+            result = result < lanes[i] ? lanes[i] : result;
+        return result;
+    }
+
+    // Moves one component of P::width consecutive AoS vectors in or out of a pack
+    template <typename P, typename V>
+    inline P loadComponent(const V *vectors, std::size_t component)
+    {
+        using Scalar = typename P::Scalar;
+        constexpr std::size_t Dimension = sizeof(V) / sizeof(Scalar);
+        const Scalar *src = reinterpret_cast<const Scalar *>(vectors);
+        Scalar lanes[P::width];
+        for (std::size_t l = 0; l < P::width; ++l)
+            lanes[l] = src[l * Dimension + component];
+        return P::load(lanes);
+    }
+
+    template <typename P, typename V>
+    inline void storeComponent(P value, V *vectors, std::size_t component)
+    {
+        using Scalar = typename P::Scalar;
+        constexpr std::size_t Dimension = sizeof(V) / sizeof(Scalar);
+        Scalar *dst = reinterpret_cast<Scalar *>(vectors);
+        Scalar lanes[P::width];
+        value.store(lanes);
+        for (std::size_t l = 0; l < P::width; ++l)
+            dst[l * Dimension + component] = lanes[l];
+    }
+
+    // The same moves addressed by element index, for contiguous arrays and strided views alike
+    template <typename P, typename V>
+    inline P loadComponent(const V *vectors, std::size_t index, std::size_t component)
+    {
+        return loadComponent<P>(vectors + index, component);
+    }
+
+    template <typename P, typename V>
+    inline void storeComponent(P value, V *vectors, std::size_t index, std::size_t component)
+    {
+        storeComponent(value, vectors + index, component);
+    }
+
+    template <typename P, typename V>
+    inline P loadComponent(const StridedView<V> &view, std::size_t index, std::size_t component)
+    {
+        using Scalar = typename P::Scalar;
+        const std::byte *src = view.base + index * view.stride + component * sizeof(Scalar);
+        Scalar lanes[P::width];
+        for (std::size_t l = 0; l < P::width; ++l)
+            lanes[l] = *reinterpret_cast<const Scalar *>(src + l * view.stride);
+        return P::load(lanes);
+    }
+
+    template <typename P, typename V>
+    inline void storeComponent(P value, const StridedRef<V> &ref, std::size_t index, std::size_t component)
+    {
+        using Scalar = typename P::Scalar;
+        std::byte *dst = ref.base + index * ref.stride + component * sizeof(Scalar);
+        Scalar lanes[P::width];
+        value.store(lanes);
+        for (std::size_t l = 0; l < P::width; ++l)
+            *reinterpret_cast<Scalar *>(dst + l * ref.stride) = lanes[l];
+    }
+
+    // Writable views are read in place as well, so read-modify-write kernels take one argument
+    template <typename P, typename V>
+    inline P loadComponent(const StridedRef<V> &ref, std::size_t index, std::size_t component)
+    {
+        return loadComponent<P>(ref.view(), index, component);
+    }
+
+    template <typename P, typename T>
+    inline P loadComponent(const Vector3SoAView<T> &view, std::size_t index, std::size_t component)
+    {
+        const T *axis = component == 0 ? view.x : (component == 1 ? view.y : view.z);
+        return P::load(axis + index);
+    }
+
+    template <typename P, typename T>
+    inline P loadComponent(const Vector3SoARef<T> &ref, std::size_t index, std::size_t component)
+    {
+        const T *axis = component == 0 ? ref.x : (component == 1 ? ref.y : ref.z);
+        return P::load(axis + index);
+    }
+
+    template <typename P, typename T>
+    inline void storeComponent(P value, const Vector3SoARef<T> &ref, std::size_t index, std::size_t component)
+    {
+        T *axis = component == 0 ? ref.x : (component == 1 ? ref.y : ref.z);
+        value.store(axis + index);
+    }
+
+    // Loads one component of the vectors at indices[l * indexStride] for every lane l
+    template <typename P, typename V>
+    inline P gatherComponent(const V *vectors, const std::uint32_t *indices, std::size_t indexStride,
+                             std::size_t component)
+    {
+        using Scalar = typename P::Scalar;
+        constexpr std::size_t Dimension = sizeof(V) / sizeof(Scalar);
+        const Scalar *src = reinterpret_cast<const Scalar *>(vectors);
+        Scalar lanes[P::width];
+        for (std::size_t l = 0; l < P::width; ++l)
+            lanes[l] = src[std::size_t(indices[l * indexStride]) * Dimension + component];
+        return P::load(lanes);
+    }
+
+    template <typename P, typename V>
+    inline P gatherComponent(const StridedView<V> &view, const std::uint32_t *indices, std::size_t indexStride,
+                             std::size_t component)
+    {
+        using Scalar = typename P::Scalar;
+        const std::byte *src = view.base + component * sizeof(Scalar);
+        Scalar lanes[P::width];
+        for (std::size_t l = 0; l < P::width; ++l)
+            lanes[l] = *reinterpret_cast<const Scalar *>(src + std::size_t(indices[l * indexStride]) * view.stride);
+        return P::load(lanes);
+    }
+
+    // Stream compaction primitives. compressStore writes the lanes selected by `bits` to out[0..n)
+    // and compressIndices writes base + lane for the same lanes; both return n. Native versions store
+    // a full pack, so out must have P::width writable slots even when fewer lanes survive.
+    template <typename P>
+    inline std::size_t compressStore(P value, unsigned bits, typename P::Scalar *out)
+    {
+        typename P::Scalar lanes[P::width];
+        value.store(lanes);
+        std::size_t written = 0;
+        for (; bits != 0; bits &= bits - 1)
+            out[written++] = lanes[std::countr_zero(bits)];
+        return written;
+    }
+
+    template <typename P>
+    inline std::size_t compressIndices(unsigned bits, std::size_t base, std::uint32_t *out)
+    {
+        std::size_t written = 0;
+        for (; bits != 0; bits &= bits - 1)
+            out[written++] = static_cast<std::uint32_t>(base + std::countr_zero(bits));
+        return written;
+    }
+
+#if defined(__AVX2__)
+    namespace detail
+    {
+        // For each 8-bit lane mask, the surviving lane numbers packed as nibbles, lowest first
+        inline constexpr std::array<std::uint32_t, 256> CompressNibbles = []
+        {
+            std::array<std::uint32_t, 256> table{};
+            for (unsigned bits = 0; bits < 256; ++bits)
+            {
+                unsigned slot = 0;
+                for (unsigned lane = 0; lane < 8; ++lane)
+                    if (bits & (1u << lane))
+                        table[bits] |= lane << (4 * slot++);
+            }
+            return table;
+        }();
+
+        inline __m256i compressPermutation(unsigned bits)
+        {
+            __m256i nibbles = _mm256_set1_epi32(int(CompressNibbles[bits]));
+            __m256i shifted = _mm256_srlv_epi32(nibbles, _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28));
+            return _mm256_and_si256(shifted, _mm256_set1_epi32(0xF));
+        }
+
+        // Widens a 4-lane double mask to the 8-lane float mask covering the same bytes
+        inline unsigned widenMask(unsigned bits)
+        {
+            return (bits & 1u) * 0x03u | ((bits >> 1) & 1u) * 0x0Cu | ((bits >> 2) & 1u) * 0x30u |
+                   ((bits >> 3) & 1u) * 0xC0u;
+        }
+    } // namespace detail
+
+    template <>
+    inline std::size_t compressStore<PackF>(PackF value, unsigned bits, float *out)
+    {
+        _mm256_storeu_ps(out, _mm256_permutevar8x32_ps(value.v, detail::compressPermutation(bits)));
+        return std::size_t(std::popcount(bits));
+    }
+
+    template <>
+    inline std::size_t compressStore<PackD>(PackD value, unsigned bits, double *out)
+    {
+        __m256 pairs = _mm256_castpd_ps(value.v);
+        __m256 packed = _mm256_permutevar8x32_ps(pairs, detail::compressPermutation(detail::widenMask(bits)));
+        _mm256_storeu_pd(out, _mm256_castps_pd(packed));
+        return std::size_t(std::popcount(bits));
+    }
+
+    template <>
+    inline std::size_t compressIndices<PackF>(unsigned bits, std::size_t base, std::uint32_t *out)
+    {
+        __m256i lanes = _mm256_add_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(int(base)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                            _mm256_permutevar8x32_epi32(lanes, detail::compressPermutation(bits)));
+        return std::size_t(std::popcount(bits));
+    }
+#endif
+
+    // Cache control for outputs larger than the last-level cache. streamCopy moves `bytes` (a multiple
+    // of 16) from a 16-byte aligned src to a 16-byte aligned dst with non-temporal stores, which skip
+    // the read-for-ownership and leave the cache alone; streamFence orders them before later stores
+    // and must run before another thread reads the data. prefetch requests the line at p ahead of
+    // its use. Targets without SSE2 fall back to plain copies and no prefetch.
+    inline void streamCopy(void *dst, const void *src, std::size_t bytes)
+    {
+#if defined(__SSE2__)
+        __m128i *d = static_cast<__m128i *>(dst);
+        const __m128i *s = static_cast<const __m128i *>(src);
+        for (std::size_t k = 0; k < bytes / 16; ++k)
+            _mm_stream_si128(d + k, _mm_load_si128(s + k));
+#else
+        std::memcpy(dst, src, bytes);
+#endif
+    }
+
+    inline void streamFence()
+    {
+#if defined(__SSE2__)
+        _mm_sfence();
+#endif
+    }
+
+    inline void prefetch([[maybe_unused]] const void *p)
+    {
+#if defined(__SSE2__)
+        _mm_prefetch(static_cast<const char *>(p), _MM_HINT_T0);
+#endif
+    }
+
+    // Unsigned 32-bit integer lanes, as many as Pack<float> has; used by the counter-based generators.
+    // Only the operations Philox needs are provided: wrap-around add, xor and the widening multiply.
+    struct ScalarU32
+    {
+        static constexpr std::size_t width = 1;
+
+        std::uint32_t v;
+
+        static ScalarU32 load(const std::uint32_t *p) { return {*p}; }
+        static ScalarU32 broadcast(std::uint32_t s) { return {s}; }
+        void store(std::uint32_t *p) const { *p = v; }
+
+        ScalarU32 operator+(ScalarU32 o) const { return {v + o.v}; }
+        ScalarU32 operator^(ScalarU32 o) const { return {v ^ o.v}; }
+    };
+
+    // Full 64-bit product of a and b split into its high and low words
+    inline void mulWide(ScalarU32 a, ScalarU32 b, ScalarU32 &hi, ScalarU32 &lo)
+    {
+        std::uint64_t product = std::uint64_t(a.v) * b.v;
+        hi = {static_cast<std::uint32_t>(product >> 32)};
+        lo = {static_cast<std::uint32_t>(product)};
+    }
+
+#if defined(__AVX2__)
+    struct PackU32
+    {
+        static constexpr std::size_t width = 8;
+
+        __m256i v;
+
+        static PackU32 load(const std::uint32_t *p)
+        {
+            return {_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p))};
+        }
+        static PackU32 broadcast(std::uint32_t s) { return {_mm256_set1_epi32(static_cast<int>(s))}; }
+        void store(std::uint32_t *p) const { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+
+        PackU32 operator+(PackU32 o) const { return {_mm256_add_epi32(v, o.v)}; }
+        PackU32 operator^(PackU32 o) const { return {_mm256_xor_si256(v, o.v)}; }
+    };
+
+    // mul_epu32 multiplies the even lanes; the odd lanes are shifted down for a second multiply
+    inline void mulWide(PackU32 a, PackU32 b, PackU32 &hi, PackU32 &lo)
+    {
+        __m256i even = _mm256_mul_epu32(a.v, b.v);
+        __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a.v, 32), _mm256_srli_epi64(b.v, 32));
+        hi = {_mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA)};
+        lo = {_mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA)};
+    }
+#elif defined(__SSE2__)
+    struct PackU32
+    {
+        static constexpr std::size_t width = 4;
+
+        __m128i v;
+
+        static PackU32 load(const std::uint32_t *p) { return {_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))}; }
+        static PackU32 broadcast(std::uint32_t s) { return {_mm_set1_epi32(static_cast<int>(s))}; }
+        void store(std::uint32_t *p) const { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+
+        PackU32 operator+(PackU32 o) const { return {_mm_add_epi32(v, o.v)}; }
+        PackU32 operator^(PackU32 o) const { return {_mm_xor_si128(v, o.v)}; }
+    };
+
+    inline void mulWide(PackU32 a, PackU32 b, PackU32 &hi, PackU32 &lo)
+    {
+        __m128i even = _mm_mul_epu32(a.v, b.v);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a.v, 32), _mm_srli_epi64(b.v, 32));
+        __m128i low = _mm_set1_epi64x(0xFFFFFFFF);
+        hi = {_mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(low, odd))};
+        lo = {_mm_or_si128(_mm_and_si128(even, low), _mm_slli_epi64(odd, 32))};
+    }
+#else
+    using PackU32 = ScalarU32;
+#endif
+
+    // Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3") applied lane-wise:
+    // encrypts the 128-bit counter (counter[0] lowest) in place under the 64-bit key
+    template <typename U>
+    inline void philox4x32(U (&counter)[4], std::uint64_t key)
+    {
+        std::uint32_t k0 = static_cast<std::uint32_t>(key);
+        std::uint32_t k1 = static_cast<std::uint32_t>(key >> 32);
+        for (int round = 0; round < 10; ++round)
+        {
+            U hi0, lo0, hi1, lo1;
+            mulWide(U::broadcast(0xD2511F53u), counter[0], hi0, lo0);
+            mulWide(U::broadcast(0xCD9E8D57u), counter[2], hi1, lo1);
+            counter[0] = hi1 ^ counter[1] ^ U::broadcast(k0);
+            counter[1] = lo1;
+            counter[2] = hi0 ^ counter[3] ^ U::broadcast(k1);
+            counter[3] = lo0;
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+    }
+
+    // Signed 32-bit integer lanes for the integer and Q16.16 kernels. Plain operators wrap around;
+    // the Saturate functions clamp to the int32 range. Only AVX2 has a vector form: SSE2 lacks
+    // 32-bit mullo/min/max, so other targets run the scalar lanes.
+    struct ScalarI32
+    {
+        static constexpr std::size_t width = 1;
+
+        std::int32_t v;
+
+        static ScalarI32 load(const std::int32_t *p) { return {*p}; }
+        static ScalarI32 broadcast(std::int32_t s) { return {s}; }
+        void store(std::int32_t *p) const { *p = v; }
+
+        ScalarI32 operator+(ScalarI32 o) const { return {wrap(std::uint32_t(v) + std::uint32_t(o.v))}; }
+        ScalarI32 operator-(ScalarI32 o) const { return {wrap(std::uint32_t(v) - std::uint32_t(o.v))}; }
+        ScalarI32 operator*(ScalarI32 o) const { return {wrap(std::uint32_t(v) * std::uint32_t(o.v))}; }
+        // Arithmetic shift
+        ScalarI32 operator>>(int n) const { return {v >> n}; }
+
+    private:
+        static std::int32_t wrap(std::uint32_t u) { return static_cast<std::int32_t>(u); }
+    };
+
+    inline ScalarI32 min(ScalarI32 a, ScalarI32 b) { return {std::min(a.v, b.v)}; }
+    inline ScalarI32 max(ScalarI32 a, ScalarI32 b) { return {std::max(a.v, b.v)}; }
+
+    inline std::int32_t saturateI32(std::int64_t value)
+    {
+        return static_cast<std::int32_t>(std::clamp<std::int64_t>(value, INT32_MIN, INT32_MAX));
+    }
+
+    // |a|, with INT32_MIN going to INT32_MAX
+    inline ScalarI32 absSaturate(ScalarI32 a) { return {saturateI32(a.v < 0 ? -std::int64_t(a.v) : a.v)}; }
+    inline ScalarI32 addSaturate(ScalarI32 a, ScalarI32 b) { return {saturateI32(std::int64_t(a.v) + b.v)}; }
+    inline ScalarI32 subSaturate(ScalarI32 a, ScalarI32 b) { return {saturateI32(std::int64_t(a.v) - b.v)}; }
+
+    // Fixed-point product floor(a * b / 2^shift), saturated; shift is in [1, 31]
+    inline ScalarI32 mulShiftSaturate(ScalarI32 a, ScalarI32 b, int shift)
+    {
+        return {saturateI32((std::int64_t(a.v) * b.v) >> shift)};
+    }
+
+    // Splits `width` consecutive Dim-component int32 vectors at p into one pack per component
+    template <std::size_t Dim>
+    inline void loadComponents(const std::int32_t *p, ScalarI32 (&components)[Dim])
+    {
+        for (std::size_t k = 0; k < Dim; ++k)
+            components[k] = {p[k]};
+    }
+
+#if defined(__AVX2__)
+    struct PackI32
+    {
+        static constexpr std::size_t width = 8;
+
+        __m256i v;
+
+        static PackI32 load(const std::int32_t *p)
+        {
+            return {_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p))};
+        }
+        static PackI32 broadcast(std::int32_t s) { return {_mm256_set1_epi32(s)}; }
+        void store(std::int32_t *p) const { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+
+        PackI32 operator+(PackI32 o) const { return {_mm256_add_epi32(v, o.v)}; }
+        PackI32 operator-(PackI32 o) const { return {_mm256_sub_epi32(v, o.v)}; }
+        PackI32 operator*(PackI32 o) const { return {_mm256_mullo_epi32(v, o.v)}; }
+        PackI32 operator>>(int n) const { return {_mm256_srai_epi32(v, n)}; }
+    };
+
+    inline PackI32 min(PackI32 a, PackI32 b) { return {_mm256_min_epi32(a.v, b.v)}; }
+    inline PackI32 max(PackI32 a, PackI32 b) { return {_mm256_max_epi32(a.v, b.v)}; }
+
+    // abs_epi32 leaves INT32_MIN as 0x80000000, which the unsigned min clamps
+    inline PackI32 absSaturate(PackI32 a)
+    {
+        return {_mm256_min_epu32(_mm256_abs_epi32(a.v), _mm256_set1_epi32(INT32_MAX))};
+    }
+
+    namespace detail
+    {
+        // INT32_MAX where sign is non-negative, INT32_MIN where it is negative
+        inline __m256i saturationBound(__m256i sign)
+        {
+            return _mm256_xor_si256(_mm256_srai_epi32(sign, 31), _mm256_set1_epi32(INT32_MAX));
+        }
+    } // namespace detail
+
+    // Overflow happened when the result's sign differs from both operands' (add) or from a's
+    // while a and b differ in sign (sub); the saturated value then takes a's sign
+    inline PackI32 addSaturate(PackI32 a, PackI32 b)
+    {
+        __m256i sum = _mm256_add_epi32(a.v, b.v);
+        __m256i overflow = _mm256_and_si256(_mm256_xor_si256(a.v, sum), _mm256_xor_si256(b.v, sum));
+        return {_mm256_blendv_epi8(sum, detail::saturationBound(a.v), _mm256_srai_epi32(overflow, 31))};
+    }
+
+    inline PackI32 subSaturate(PackI32 a, PackI32 b)
+    {
+        __m256i diff = _mm256_sub_epi32(a.v, b.v);
+        __m256i overflow = _mm256_and_si256(_mm256_xor_si256(a.v, b.v), _mm256_xor_si256(a.v, diff));
+        return {_mm256_blendv_epi8(diff, detail::saturationBound(a.v), _mm256_srai_epi32(overflow, 31))};
+    }
+
+    // Even and odd lanes are multiplied separately into 64-bit products. The shifted product fits
+    // int32 exactly when product bits [shift + 31, 63] all match the sign bit.
+    inline PackI32 mulShiftSaturate(PackI32 a, PackI32 b, int shift)
+    {
+        __m256i even = _mm256_mul_epi32(a.v, b.v);
+        __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a.v, 32), _mm256_srli_epi64(b.v, 32));
+        __m128i right = _mm_cvtsi32_si128(shift);
+        __m128i left = _mm_cvtsi32_si128(32 - shift);
+        __m256i result = _mm256_blend_epi32(_mm256_srl_epi64(even, right), _mm256_sll_epi64(odd, left), 0xAA);
+        __m256i hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+        __m256i sign = _mm256_srai_epi32(hi, 31);
+        __m256i fits = _mm256_cmpeq_epi32(_mm256_sra_epi32(hi, _mm_cvtsi32_si128(shift - 1)), sign);
+        return {_mm256_blendv_epi8(detail::saturationBound(hi), result, fits)};
+    }
+
+    // Register transposes instead of gathers: 2 and 4 components through unpacks and lane
+    // permutes; 3 components by blending each component's lanes from the three loads, where
+    // they sit at distinct positions, then restoring vector order with one permute
+    template <std::size_t Dim>
+    inline void loadComponents(const std::int32_t *p, PackI32 (&components)[Dim])
+    {
+        auto load = [p](std::size_t i) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p) + i); };
+        if constexpr (Dim == 2)
+        {
+            __m256i split = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+            __m256i lo = _mm256_permutevar8x32_epi32(load(0), split);
+            __m256i hi = _mm256_permutevar8x32_epi32(load(1), split);
+            components[0] = {_mm256_permute2x128_si256(lo, hi, 0x20)};
+            components[1] = {_mm256_permute2x128_si256(lo, hi, 0x31)};
+        }
+        else if constexpr (Dim == 3)
+        {
+            __m256i r0 = load(0), r1 = load(1), r2 = load(2);
+            __m256i x = _mm256_blend_epi32(_mm256_blend_epi32(r0, r1, 0x92), r2, 0x24);
+            __m256i y = _mm256_blend_epi32(_mm256_blend_epi32(r0, r1, 0x24), r2, 0x49);
+            __m256i z = _mm256_blend_epi32(_mm256_blend_epi32(r0, r1, 0x49), r2, 0x92);
+            components[0] = {_mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5))};
+            components[1] = {_mm256_permutevar8x32_epi32(y, _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6))};
+            components[2] = {_mm256_permutevar8x32_epi32(z, _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7))};
+        }
+        else
+        {
+            static_assert(Dim == 4, "Vectors have 2, 3 or 4 components");
+            __m256i t0 = _mm256_unpacklo_epi32(load(0), load(1));
+            __m256i t1 = _mm256_unpackhi_epi32(load(0), load(1));
+            __m256i t2 = _mm256_unpacklo_epi32(load(2), load(3));
+            __m256i t3 = _mm256_unpackhi_epi32(load(2), load(3));
+            // Lanes come out as vectors 0 2 4 6 1 3 5 7
+            __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+            components[0] = {_mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(t0, t2), order)};
+            components[1] = {_mm256_permutevar8x32_epi32(_mm256_unpackhi_epi64(t0, t2), order)};
+            components[2] = {_mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(t1, t3), order)};
+            components[3] = {_mm256_permutevar8x32_epi32(_mm256_unpackhi_epi64(t1, t3), order)};
+        }
+    }
+#else
+    using PackI32 = ScalarI32;
+#endif
+
+    // Splits P::width consecutive Dim-component float or double vectors at p into one pack per
+    // component, and writes them back. Register transposes where the target has them (AVX2, and
+    // 4 float components with SSE2; AVX2 float reuses the int32 shuffles), lane copies otherwise.
+    template <std::size_t Dim, typename P>
+    inline void loadComponents(const typename P::Scalar *p, P (&components)[Dim])
+    {
+        typename P::Scalar lanes[P::width];
+        for (std::size_t k = 0; k < Dim; ++k)
+        {
+            for (std::size_t l = 0; l < P::width; ++l)
+                lanes[l] = p[l * Dim + k];
+            components[k] = P::load(lanes);
+        }
+    }
+
+    template <std::size_t Dim, typename P>
+    inline void storeComponents(const P (&components)[Dim], typename P::Scalar *p)
+    {
+        typename P::Scalar lanes[P::width];
+        for (std::size_t k = 0; k < Dim; ++k)
+        {
+            components[k].store(lanes);
+            for (std::size_t l = 0; l < P::width; ++l)
+                p[l * Dim + k] = lanes[l];
+        }
+    }
+
+#if defined(__AVX2__)
+    template <std::size_t Dim>
+    inline void loadComponents(const float *p, PackF (&components)[Dim])
+    {
+        PackI32 bits[Dim];
+        loadComponents(reinterpret_cast<const std::int32_t *>(p), bits);
+        for (std::size_t k = 0; k < Dim; ++k)
+            components[k] = {_mm256_castsi256_ps(bits[k].v)};
+    }
+
+    // The inverse shuffles of loadComponents
+    template <std::size_t Dim>
+    inline void storeComponents(const PackF (&components)[Dim], float *p)
+    {
+        auto lanes = [&](std::size_t k) { return _mm256_castps_si256(components[k].v); };
+        auto store = [p](std::size_t i, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p) + i, v); };
+        if constexpr (Dim == 2)
+        {
+            __m256i lo = _mm256_permute2x128_si256(lanes(0), lanes(1), 0x20);
+            __m256i hi = _mm256_permute2x128_si256(lanes(0), lanes(1), 0x31);
+            __m256i merge = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+            store(0, _mm256_permutevar8x32_epi32(lo, merge));
+            store(1, _mm256_permutevar8x32_epi32(hi, merge));
+        }
+        else if constexpr (Dim == 3)
+        {
+            __m256i x = _mm256_permutevar8x32_epi32(lanes(0), _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5));
+            __m256i y = _mm256_permutevar8x32_epi32(lanes(1), _mm256_setr_epi32(5, 0, 3, 6, 1, 4, 7, 2));
+            __m256i z = _mm256_permutevar8x32_epi32(lanes(2), _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7));
+            store(0, _mm256_blend_epi32(_mm256_blend_epi32(x, y, 0x92), z, 0x24));
+            store(1, _mm256_blend_epi32(_mm256_blend_epi32(x, y, 0x24), z, 0x49));
+            store(2, _mm256_blend_epi32(_mm256_blend_epi32(x, y, 0x49), z, 0x92));
+        }
+        else
+        {
+            static_assert(Dim == 4, "Vectors have 2, 3 or 4 components");
+            __m256i t0 = _mm256_unpacklo_epi32(lanes(0), lanes(1));
+            __m256i t1 = _mm256_unpackhi_epi32(lanes(0), lanes(1));
+            __m256i t2 = _mm256_unpacklo_epi32(lanes(2), lanes(3));
+            __m256i t3 = _mm256_unpackhi_epi32(lanes(2), lanes(3));
+            // Rows hold vectors 0|4, 1|5, 2|6 and 3|7
+            __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+            __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+            store(0, _mm256_permute2x128_si256(u0, u1, 0x20));
+            store(1, _mm256_permute2x128_si256(u2, u3, 0x20));
+            store(2, _mm256_permute2x128_si256(u0, u1, 0x31));
+            store(3, _mm256_permute2x128_si256(u2, u3, 0x31));
+        }
+    }
+
+    namespace detail
+    {
+        // 4x4 double transpose; its own inverse
+        inline void transpose4(const __m256d (&in)[4], __m256d (&out)[4])
+        {
+            __m256d t0 = _mm256_unpacklo_pd(in[0], in[1]), t1 = _mm256_unpackhi_pd(in[0], in[1]);
+            __m256d t2 = _mm256_unpacklo_pd(in[2], in[3]), t3 = _mm256_unpackhi_pd(in[2], in[3]);
+            out[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+            out[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+            out[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+            out[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+        }
+    } // namespace detail
+
+    // 3 components: each 128-bit half holds two values, so regrouping halves into
+    // (x0 y0 x2 y2), (z0 x1 z2 x3) and (y1 z1 y3 z3) leaves one blend or shuffle per component
+    template <std::size_t Dim>
+    inline void loadComponents(const double *p, PackD (&components)[Dim])
+    {
+        if constexpr (Dim == 2)
+        {
+            __m256d r0 = _mm256_loadu_pd(p), r1 = _mm256_loadu_pd(p + 4);
+            components[0] = {_mm256_permute4x64_pd(_mm256_unpacklo_pd(r0, r1), 0xD8)};
+            components[1] = {_mm256_permute4x64_pd(_mm256_unpackhi_pd(r0, r1), 0xD8)};
+        }
+        else if constexpr (Dim == 3)
+        {
+            __m256d r0 = _mm256_loadu_pd(p), r1 = _mm256_loadu_pd(p + 4), r2 = _mm256_loadu_pd(p + 8);
+            __m256d a = _mm256_blend_pd(r0, r1, 0xC);
+            __m256d b = _mm256_permute2f128_pd(r0, r2, 0x21);
+            __m256d c = _mm256_blend_pd(r1, r2, 0xC);
+            components[0] = {_mm256_blend_pd(a, b, 0xA)};
+            components[1] = {_mm256_shuffle_pd(a, c, 0x5)};
+            components[2] = {_mm256_blend_pd(b, c, 0xA)};
+        }
+        else
+        {
+            static_assert(Dim == 4, "Vectors have 2, 3 or 4 components");
+            __m256d rows[4] = {_mm256_loadu_pd(p), _mm256_loadu_pd(p + 4), _mm256_loadu_pd(p + 8),
+                               _mm256_loadu_pd(p + 12)};
+            __m256d columns[4];
+            detail::transpose4(rows, columns);
+            for (std::size_t k = 0; k < 4; ++k)
+                components[k] = {columns[k]};
+        }
+    }
+
+    template <std::size_t Dim>
+    inline void storeComponents(const PackD (&components)[Dim], double *p)
+    {
+        if constexpr (Dim == 2)
+        {
+            __m256d x = _mm256_permute4x64_pd(components[0].v, 0xD8);
+            __m256d y = _mm256_permute4x64_pd(components[1].v, 0xD8);
+            _mm256_storeu_pd(p, _mm256_unpacklo_pd(x, y));
+            _mm256_storeu_pd(p + 4, _mm256_unpackhi_pd(x, y));
+        }
+        else if constexpr (Dim == 3)
+        {
+            __m256d x = components[0].v, y = components[1].v, z = components[2].v;
+            __m256d a = _mm256_shuffle_pd(x, y, 0x0);
+            __m256d b = _mm256_blend_pd(x, z, 0x5);
+            __m256d c = _mm256_shuffle_pd(y, z, 0xF);
+            _mm256_storeu_pd(p, _mm256_permute2f128_pd(a, b, 0x20));
+            _mm256_storeu_pd(p + 4, _mm256_blend_pd(a, c, 0x3));
+            _mm256_storeu_pd(p + 8, _mm256_permute2f128_pd(b, c, 0x31));
+        }
+        else
+        {
+            static_assert(Dim == 4, "Vectors have 2, 3 or 4 components");
+            __m256d columns[4] = {components[0].v, components[1].v, components[2].v, components[3].v};
+            __m256d rows[4];
+            detail::transpose4(columns, rows);
+            for (std::size_t k = 0; k < 4; ++k)
+                _mm256_storeu_pd(p + 4 * k, rows[k]);
+        }
+    }
+#elif defined(__SSE2__)
+    inline void loadComponents(const float *p, PackF (&components)[4])
+    {
+        __m128 r0 = _mm_loadu_ps(p), r1 = _mm_loadu_ps(p + 4), r2 = _mm_loadu_ps(p + 8), r3 = _mm_loadu_ps(p + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        components[0] = {r0};
+        components[1] = {r1};
+        components[2] = {r2};
+        components[3] = {r3};
+    }
+
+    inline void storeComponents(const PackF (&components)[4], float *p)
+    {
+        __m128 r0 = components[0].v, r1 = components[1].v, r2 = components[2].v, r3 = components[3].v;
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(p, r0);
+        _mm_storeu_ps(p + 4, r1);
+        _mm_storeu_ps(p + 8, r2);
+        _mm_storeu_ps(p + 12, r3);
+    }
+#endif
+
+    // Runs body(tag, index) over [0, count) with full packs first and single lanes for the tail.
+    // The tag's ::type names the pack type used for that call.
+    template <typename T, typename Body>
+    inline void forEachPack(std::size_t count, Body &&body)
+    {
+        std::size_t i = 0;
+        for (; i + Pack<T>::width <= count; i += Pack<T>::width)
+            body(std::type_identity<Pack<T>>{}, i);
+        for (; i < count; ++i)
+            body(std::type_identity<ScalarPack<T>>{}, i);
+    }
+
+} // namespace lumina::simd
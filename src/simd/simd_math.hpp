@@ -0,0 +1,291 @@
+#pragma once
+
+#include <lumina/batch/math.hpp>
+#include "simd.hpp"
+#include <cmath>
+#include <type_traits>
+
+// Internal vectorized elementary functions over any pack type (including ScalarPack).
+// Precise follows the Cephes polynomials for the lane type; Fast trades accuracy for fewer terms:
+// float sin/cos drop to Taylor degree 5/6 and rsqrt uses the hardware estimate plus one Newton step,
+// double lanes use the single precision polynomials.
+// Trigonometric range reduction is accurate for |x| < 8192 (float) and |x| < 1e9 (double).
+
+namespace lumina::simd
+{
+
+    namespace detail
+    {
+        template <typename P>
+        inline constexpr bool IsDouble = std::is_same_v<typename P::Scalar, double>;
+
+        template <typename P>
+        inline P constant(double value)
+        {
+            return P::broadcast(typename P::Scalar(value));
+        }
+
+        template <typename P>
+        inline P floor(P x)
+        {
+            P r = roundNearest(x);
+            return r - select(r > x, constant<P>(1.0), constant<P>(0.0));
+        }
+
+        // Evaluates sin(r) and cos(r) for r in [-pi/4, pi/4]
+        template <MathAccuracy A, typename P>
+        inline void sincosKernel(P r, P &s, P &c)
+        {
+            P z = r * r;
+            if constexpr (A == MathAccuracy::Precise && IsDouble<P>)
+            {
+                P sp = constant<P>(1.58962301576546568060E-10);
+                sp = fmadd(sp, z, constant<P>(-2.50507477628578072866E-8));
+                sp = fmadd(sp, z, constant<P>(2.75573136213857245213E-6));
+                sp = fmadd(sp, z, constant<P>(-1.98412698295895385996E-4));
+                sp = fmadd(sp, z, constant<P>(8.33333333332211858878E-3));
+                sp = fmadd(sp, z, constant<P>(-1.66666666666666307295E-1));
+                s = fmadd(sp * z, r, r);
+
+                P cp = constant<P>(-1.13585365213876817300E-11);
+                cp = fmadd(cp, z, constant<P>(2.08757008419747316778E-9));
+                cp = fmadd(cp, z, constant<P>(-2.75573141792967388112E-7));
+                cp = fmadd(cp, z, constant<P>(2.48015872888517045348E-5));
+                cp = fmadd(cp, z, constant<P>(-1.38888888888730564116E-3));
+                cp = fmadd(cp, z, constant<P>(4.16666666666665929218E-2));
+                c = fmadd(cp * z, z, fmadd(constant<P>(-0.5), z, constant<P>(1.0)));
+            }
+            else if constexpr (A == MathAccuracy::Precise || IsDouble<P>)
+            {
+                P sp = constant<P>(-1.9515295891E-4);
+                sp = fmadd(sp, z, constant<P>(8.3321608736E-3));
+                sp = fmadd(sp, z, constant<P>(-1.6666654611E-1));
+                s = fmadd(sp * z, r, r);
+
+                P cp = constant<P>(2.443315711809948E-5);
+                cp = fmadd(cp, z, constant<P>(-1.388731625493765E-3));
+                cp = fmadd(cp, z, constant<P>(4.166664568298827E-2));
+                c = fmadd(cp * z, z, fmadd(constant<P>(-0.5), z, constant<P>(1.0)));
+            }
+            else
+            {
+                P sp = fmadd(constant<P>(1.0 / 120.0), z, constant<P>(-1.0 / 6.0));
+                s = fmadd(sp * z, r, r);
+                P cp = fmadd(constant<P>(-1.0 / 720.0), z, constant<P>(1.0 / 24.0));
+                c = fmadd(cp * z, z, fmadd(constant<P>(-0.5), z, constant<P>(1.0)));
+            }
+        }
+
+        // Reduces x to r in [-pi/4, pi/4] and the quadrant (0..3) it came from
+        template <typename P>
+        inline P reduceQuadrant(P x, P &quadrant)
+        {
+            P q = roundNearest(x * constant<P>(0.63661977236758134308));
+            P r;
+            if constexpr (IsDouble<P>)
+            {
+                r = fmadd(q, constant<P>(-1.57079625129699707031E0), x);
+                r = fmadd(q, constant<P>(-7.54978941586159635335E-8), r);
+                r = fmadd(q, constant<P>(-5.39030285815811905290E-15), r);
+            }
+            else
+            {
+                r = fmadd(q, constant<P>(-1.5703125), x);
+                r = fmadd(q, constant<P>(-4.837512969970703125E-4), r);
+                r = fmadd(q, constant<P>(-7.54978995489188216E-8), r);
+            }
+            quadrant = q - constant<P>(4.0) * floor(q * constant<P>(0.25));
+            return r;
+        }
+
+        // atan(t) for t in [0, 1]
+        template <MathAccuracy A, typename P>
+        inline P atanUnit(P t)
+        {
+            // Fold (tan(pi/8), 1] onto [-tan(pi/8), 0] around pi/4
+            auto fold = t > constant<P>(0.41421356237309504880);
+            P base = select(fold, constant<P>(0.78539816339744830962), constant<P>(0.0));
+            P x = select(fold, (t - constant<P>(1.0)) / (t + constant<P>(1.0)), t);
+            P z = x * x;
+            if constexpr (A == MathAccuracy::Precise && IsDouble<P>)
+            {
+                P p = constant<P>(-8.750608600031904122785E-1);
+                p = fmadd(p, z, constant<P>(-1.615753718733365076637E1));
+                p = fmadd(p, z, constant<P>(-7.500855792314704667340E1));
+                p = fmadd(p, z, constant<P>(-1.228866684490136173410E2));
+                p = fmadd(p, z, constant<P>(-6.485021904942025371773E1));
+                P q = z + constant<P>(2.485846490142306297962E1);
+                q = fmadd(q, z, constant<P>(1.650270098316988542046E2));
+                q = fmadd(q, z, constant<P>(4.328810604912902668951E2));
+                q = fmadd(q, z, constant<P>(4.853903996359136964868E2));
+                q = fmadd(q, z, constant<P>(1.945506571482613964425E2));
+                P more = select(fold, constant<P>(3.061616997868382943065E-17), constant<P>(0.0));
+                return base + (fmadd(x * z, p / q, x) + more);
+            }
+            else
+            {
+                P p = constant<P>(8.05374449538E-2);
+                p = fmadd(p, z, constant<P>(-1.38776856032E-1));
+                p = fmadd(p, z, constant<P>(1.99777106478E-1));
+                p = fmadd(p, z, constant<P>(-3.33329491539E-1));
+                return base + fmadd(p * z, x, x);
+            }
+        }
+    } // namespace detail
+
+    template <MathAccuracy A, typename P>
+    inline void sincos(P x, P &s, P &c)
+    {
+        P quadrant;
+        P r = detail::reduceQuadrant(x, quadrant);
+        P sr, cr;
+        detail::sincosKernel<A>(r, sr, cr);
+
+        P one = detail::constant<P>(1.0);
+        P two = detail::constant<P>(2.0);
+        auto odd = (quadrant == one) | (quadrant == detail::constant<P>(3.0));
+        P sinBase = select(odd, cr, sr);
+        P cosBase = select(odd, sr, cr);
+        s = select(quadrant >= two, -sinBase, sinBase);
+        c = select((quadrant == one) | (quadrant == two), -cosBase, cosBase);
+    }
+
+    template <MathAccuracy A, typename P>
+    inline P sin(P x)
+    {
+        P s, c;
+        sincos<A>(x, s, c);
+        return s;
+    }
+
+    template <MathAccuracy A, typename P>
+    inline P cos(P x)
+    {
+        P s, c;
+        sincos<A>(x, s, c);
+        return c;
+    }
+
+    // Full-quadrant arctangent; atan2(0, 0) is 0 and a NaN in either argument gives NaN
+    template <MathAccuracy A, typename P>
+    inline P atan2(P y, P x)
+    {
+        P ax = abs(x), ay = abs(y);
+        P hi = max(ax, ay), lo = min(ax, ay);
+        P zero = detail::constant<P>(0.0);
+        P t = select(hi > zero, lo / hi, zero);
+
+        P angle = detail::atanUnit<A>(t);
+        angle = select(ay > ax, detail::constant<P>(1.57079632679489661923) - angle, angle);
+        angle = select(x < zero, detail::constant<P>(3.14159265358979323846) - angle, angle);
+        angle = select(y < zero, -angle, angle);
+        return select((x == x) & (y == y), angle, x + y);
+    }
+
+    // acos(x) = 2 atan(sqrt((1 - x) / (1 + x))), which stays accurate near +-1; input is clamped to [-1, 1]
+    // and NaN passes through
+    template <MathAccuracy A, typename P>
+    inline P acos(P x)
+    {
+        P one = detail::constant<P>(1.0);
+        P clamped = min(max(x, -one), one);
+        P angle = detail::constant<P>(2.0) * atan2<A>(sqrt(one - clamped), sqrt(one + clamped));
+        return select(x == x, angle, x);
+    }
+
+    template <MathAccuracy A, typename P>
+    inline P rsqrt(P x)
+    {
+        if constexpr (A == MathAccuracy::Fast && !detail::IsDouble<P>)
+        {
+            // One Newton-Raphson step on the hardware estimate
+            P y = rsqrtEstimate(x);
+            return y * fmadd(detail::constant<P>(-0.5) * x, y * y, detail::constant<P>(1.5));
+        }
+        else
+        {
+            return detail::constant<P>(1.0) / sqrt(x);
+        }
+    }
+
+    // Underflows to 0 below the normal range and overflows to infinity above it; NaN passes through
+    template <MathAccuracy A, typename P>
+    inline P exp(P input)
+    {
+        using detail::constant;
+        constexpr bool Wide = A == MathAccuracy::Precise && detail::IsDouble<P>;
+        P hiLimit = constant<P>(detail::IsDouble<P> ? 709.782712893384 : 88.72283905206835);
+        P loLimit = constant<P>(detail::IsDouble<P> ? -708.3964185322641 : -87.33654475055310);
+        auto underflow = input < loLimit;
+        auto overflow = input > hiLimit;
+        P x = min(max(input, loLimit), hiLimit);
+
+        P n = roundNearest(x * constant<P>(1.44269504088896341));
+        P r;
+        if constexpr (detail::IsDouble<P>)
+        {
+            r = fmadd(n, constant<P>(-6.93145751953125E-1), x);
+            r = fmadd(n, constant<P>(-1.42860682030941723212E-6), r);
+        }
+        else
+        {
+            r = fmadd(n, constant<P>(-0.693359375), x);
+            r = fmadd(n, constant<P>(2.12194440e-4), r);
+        }
+
+        P y;
+        if constexpr (Wide)
+        {
+            // Pade form: e^r = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2))
+            P z = r * r;
+            P p = constant<P>(1.26177193074810590878E-4);
+            p = fmadd(p, z, constant<P>(3.02994407707441961300E-2));
+            p = fmadd(p, z, constant<P>(9.99999999999999999910E-1));
+            p = p * r;
+            P q = constant<P>(3.00198505138664455042E-6);
+            q = fmadd(q, z, constant<P>(2.52448340349684104192E-3));
+            q = fmadd(q, z, constant<P>(2.27265548208155028766E-1));
+            q = fmadd(q, z, constant<P>(2.00000000000000000009E0));
+            y = fmadd(constant<P>(2.0), p / (q - p), constant<P>(1.0));
+        }
+        else
+        {
+            P p = constant<P>(1.9875691500E-4);
+            p = fmadd(p, r, constant<P>(1.3981999507E-3));
+            p = fmadd(p, r, constant<P>(8.3334519073E-3));
+            p = fmadd(p, r, constant<P>(4.1665795894E-2));
+            p = fmadd(p, r, constant<P>(1.6666665459E-1));
+            p = fmadd(p, r, constant<P>(5.0000001201E-1));
+            y = fmadd(p, r * r, r) + constant<P>(1.0);
+        }
+
+        // Scale in two halves so n at either end of the range stays inside the exponent field
+        P half = detail::floor(n * constant<P>(0.5));
+        y = y * exp2i(half) * exp2i(n - half);
+        y = select(overflow, constant<P>(HUGE_VAL), y);
+        y = select(underflow, constant<P>(0.0), y);
+        return select(input == input, y, input);
+    }
+
+    // forEachPack with the accuracy tier picked at run time;
+    // the kernel is called as kernel.template operator()<A, P>(index)
+    template <typename T, typename Kernel>
+    inline void forEachPack(std::size_t count, MathAccuracy accuracy, Kernel &&kernel)
+    {
+        if (accuracy == MathAccuracy::Fast)
+        {
+            forEachPack<T>(count, [&](auto tag, std::size_t i)
+            {
+                kernel.template operator()<MathAccuracy::Fast, typename decltype(tag)::type>(i);
+            });
+        }
+        else
+        {
+            forEachPack<T>(count, [&](auto tag, std::size_t i)
+            {
+                kernel.template operator()<MathAccuracy::Precise, typename decltype(tag)::type>(i);
+            });
+        }
+    }
+
+} // namespace lumina::simd
@@ -0,0 +1,103 @@
+#include <lumina/spatial/radix_sort.hpp>
+#include "../parallel/parallel_for.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace lumina
+{
+
+namespace
+{
+
+constexpr int DigitBits = 8;
+constexpr std::size_t DigitCount = std::size_t(1) << DigitBits;
+constexpr std::size_t MinKeysPerThread = std::size_t(1) << 16;
+
+using Histogram = std::array<std::size_t, DigitCount>;
+
+inline std::size_t digitOf(std::uint64_t key, int shift, std::size_t mask)
+{
+    return std::size_t(key >> shift) & mask;
+}
+
+} // namespace
+
+void radixSort(std::uint64_t *keys, std::uint32_t *permutation, std::size_t count, unsigned threads, int keyBits)
+{
+    if (count > std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error("radixSort permutation is limited to 2^32 keys");
+
+    for (std::size_t i = 0; i < count; ++i)
+        permutation[i] = static_cast<std::uint32_t>(i);
+    if (count < 2)
+        return;
+
+    std::vector<std::uint64_t> keyBuffer(count);
+    std::vector<std::uint32_t> permutationBuffer(count);
+    std::uint64_t *srcKeys = keys, *dstKeys = keyBuffer.data();
+    std::uint32_t *srcPermutation = permutation, *dstPermutation = permutationBuffer.data();
+
+    unsigned chunks = parallel::chunkCount(count, threads, MinKeysPerThread);
+    std::vector<Histogram> histograms(chunks);
+
+    keyBits = std::clamp(keyBits, 0, 64);
+    int passes = (keyBits + DigitBits - 1) / DigitBits;
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        // The last digit is narrower when keyBits is not a multiple of DigitBits
+        int shift = pass * DigitBits;
+        std::size_t mask = (std::size_t(1) << std::min(DigitBits, keyBits - shift)) - 1;
+
+        parallel::forEachChunk(count, chunks, [&](unsigned chunk, std::size_t begin, std::size_t end)
+        {
+            Histogram &histogram = histograms[chunk];
+            histogram.fill(0);
+            for (std::size_t i = begin; i < end; ++i)
+                ++histogram[digitOf(srcKeys[i], shift, mask)];
+        });
+
+        // Per-chunk scatter offsets: digit-major, chunk-minor keeps the sort stable
+        bool trivial = false;
+        std::size_t offset = 0;
+        for (std::size_t digit = 0; digit < DigitCount; ++digit)
+        {
+            std::size_t digitTotal = 0;
+            for (unsigned chunk = 0; chunk < chunks; ++chunk)
+            {
+                std::size_t n = histograms[chunk][digit];
+                histograms[chunk][digit] = offset;
+                offset += n;
+                digitTotal += n;
+            }
+            trivial = trivial || digitTotal == count;
+        }
+        if (trivial)
+            continue;
+
+        parallel::forEachChunk(count, chunks, [&](unsigned chunk, std::size_t begin, std::size_t end)
+        {
+            Histogram &cursor = histograms[chunk];
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                std::size_t target = cursor[digitOf(srcKeys[i], shift, mask)]++;
+                dstKeys[target] = srcKeys[i];
+                dstPermutation[target] = srcPermutation[i];
+            }
+        });
+
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcPermutation, dstPermutation);
+    }
+
+    if (srcKeys != keys)
+    {
+        std::copy(srcKeys, srcKeys + count, keys);
+        std::copy(srcPermutation, srcPermutation + count, permutation);
+    }
+}
+
+} // namespace lumina
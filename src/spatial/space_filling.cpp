@@ -0,0 +1,353 @@
+#include <lumina/spatial/space_filling.hpp>
+#include <lumina/batch/reduce.hpp>
+#include <lumina/spatial/radix_sort.hpp>
+#include "../parallel/parallel_for.hpp"
+#include <algorithm>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace lumina
+{
+
+namespace
+{
+
+constexpr std::uint64_t Mask2 = 0x5555555555555555ull;
+constexpr std::uint64_t Mask3 = 0x1249249249249249ull;
+constexpr int Bits2 = 32;
+constexpr int Bits3 = 21;
+constexpr std::size_t MinPointsPerThread = std::size_t(1) << 15;
+
+#if defined(__BMI2__)
+
+inline std::uint64_t spread2(std::uint32_t v) { return _pdep_u64(v, Mask2); }
+inline std::uint64_t spread3(std::uint32_t v) { return _pdep_u64(v, Mask3); }
+inline std::uint32_t compact2(std::uint64_t v) { return std::uint32_t(_pext_u64(v, Mask2)); }
+inline std::uint32_t compact3(std::uint64_t v) { return std::uint32_t(_pext_u64(v, Mask3)); }
+
+#else
+
+inline std::uint64_t spread2(std::uint32_t v)
+{
+    std::uint64_t x = v;
+    x = (x | x << 16) & 0x0000FFFF0000FFFFull;
+    x = (x | x << 8) & 0x00FF00FF00FF00FFull;
+    x = (x | x << 4) & 0x0F0F0F0F0F0F0F0Full;
+    x = (x | x << 2) & 0x3333333333333333ull;
+    x = (x | x << 1) & 0x5555555555555555ull;
+    return x;
+}
+
+inline std::uint64_t spread3(std::uint32_t v)
+{
+    std::uint64_t x = v & 0x1FFFFFu;
+    x = (x | x << 32) & 0x001F00000000FFFFull;
+    x = (x | x << 16) & 0x001F0000FF0000FFull;
+    x = (x | x << 8) & 0x100F00F00F00F00Full;
+    x = (x | x << 4) & 0x10C30C30C30C30C3ull;
+    x = (x | x << 2) & 0x1249249249249249ull;
+    return x;
+}
+
+inline std::uint32_t compact2(std::uint64_t x)
+{
+    x &= 0x5555555555555555ull;
+    x = (x ^ (x >> 1)) & 0x3333333333333333ull;
+    x = (x ^ (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+    x = (x ^ (x >> 4)) & 0x00FF00FF00FF00FFull;
+    x = (x ^ (x >> 8)) & 0x0000FFFF0000FFFFull;
+    x = (x ^ (x >> 16)) & 0x00000000FFFFFFFFull;
+    return std::uint32_t(x);
+}
+
+inline std::uint32_t compact3(std::uint64_t x)
+{
+    x &= 0x1249249249249249ull;
+    x = (x ^ (x >> 2)) & 0x10C30C30C30C30C3ull;
+    x = (x ^ (x >> 4)) & 0x100F00F00F00F00Full;
+    x = (x ^ (x >> 8)) & 0x001F0000FF0000FFull;
+    x = (x ^ (x >> 16)) & 0x001F00000000FFFFull;
+    x = (x ^ (x >> 32)) & 0x00000000001FFFFFull;
+    return std::uint32_t(x);
+}
+
+#endif
+
+// Skilling's transform from axes to the transposed Hilbert index, in place
+template <int N>
+void axesToTranspose(std::uint32_t (&X)[N], int bits)
+{
+    std::uint32_t M = std::uint32_t(1) << (bits - 1);
+
+    // Inverse undo
+    for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+        std::uint32_t P = Q - 1;
+        for (int i = 0; i < N; ++i)
+        {
+            if (X[i] & Q)
+            {
+                X[0] ^= P;
+            }
+            else
+            {
+                std::uint32_t t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    for (int i = 1; i < N; ++i)
+        X[i] ^= X[i - 1];
+    std::uint32_t t = 0;
+    for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+        if (X[N - 1] & Q)
+            t ^= Q - 1;
+    }
+    for (int i = 0; i < N; ++i)
+        X[i] ^= t;
+}
+
+// Maps a coordinate onto [0, cells - 1]; NaN (including a NaN from non-finite bounds) maps to 0
+template <typename T>
+struct Quantizer
+{
+    double origin;
+    double scale;
+    double top;
+
+    Quantizer(T min, T max, int bits)
+        : origin(double(min)), top(double((std::uint64_t(1) << bits) - 1))
+    {
+        double extent = double(max) - double(min);
+        scale = extent > 0.0 ? top / extent : 0.0;
+    }
+
+    std::uint32_t operator()(T v) const
+    {
+        double q = (double(v) - origin) * scale;
+        return q == q ? std::uint32_t(std::clamp(q, 0.0, top)) : 0;
+    }
+};
+
+inline std::uint64_t encode3(std::uint32_t x, std::uint32_t y, std::uint32_t z, SpaceFillingCurve curve)
+{
+    return curve == SpaceFillingCurve::Morton ? mortonEncode3(x, y, z) : hilbertEncode3(x, y, z);
+}
+
+inline std::uint64_t encode2(std::uint32_t x, std::uint32_t y, SpaceFillingCurve curve)
+{
+    return curve == SpaceFillingCurve::Morton ? mortonEncode2(x, y) : hilbertEncode2(x, y);
+}
+
+template <typename T, typename Fetch>
+void codes3(std::size_t count, const Bounds3<T> &bounds, std::uint64_t *codes, SpaceFillingCurve curve,
+            unsigned threads, Fetch &&fetch)
+{
+    Quantizer<T> qx(bounds.min.x, bounds.max.x, Bits3);
+    Quantizer<T> qy(bounds.min.y, bounds.max.y, Bits3);
+    Quantizer<T> qz(bounds.min.z, bounds.max.z, Bits3);
+
+    unsigned chunks = parallel::chunkCount(count, threads, MinPointsPerThread);
+    parallel::forEachChunk(count, chunks, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            T x, y, z;
+            fetch(i, x, y, z);
+            codes[i] = encode3(qx(x), qy(y), qz(z), curve);
+        }
+    });
+}
+
+template <typename T, typename Points>
+void codes2(const Points &points, std::size_t count, const Vector2<T> &min, const Vector2<T> &max,
+            std::uint64_t *codes, SpaceFillingCurve curve, unsigned threads)
+{
+    Quantizer<T> qx(min.x, max.x, Bits2);
+    Quantizer<T> qy(min.y, max.y, Bits2);
+
+    unsigned chunks = parallel::chunkCount(count, threads, MinPointsPerThread);
+    parallel::forEachChunk(count, chunks, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            codes[i] = encode2(qx(points[i].x), qy(points[i].y), curve);
+    });
+}
+
+} // namespace
+
+// Scalar encoding
+std::uint64_t mortonEncode2(std::uint32_t x, std::uint32_t y)
+{
+    return spread2(x) | (spread2(y) << 1);
+}
+
+std::uint64_t mortonEncode3(std::uint32_t x, std::uint32_t y, std::uint32_t z)
+{
+    return spread3(x) | (spread3(y) << 1) | (spread3(z) << 2);
+}
+
+void mortonDecode2(std::uint64_t code, std::uint32_t &x, std::uint32_t &y)
+{
+    x = compact2(code);
+    y = compact2(code >> 1);
+}
+
+void mortonDecode3(std::uint64_t code, std::uint32_t &x, std::uint32_t &y, std::uint32_t &z)
+{
+    x = compact3(code);
+    y = compact3(code >> 1);
+    z = compact3(code >> 2);
+}
+
+// The transposed index interleaves with X[0] as the most significant bit of every level
+std::uint64_t hilbertEncode2(std::uint32_t x, std::uint32_t y)
+{
+    std::uint32_t X[2] = {x, y};
+    axesToTranspose(X, Bits2);
+    return mortonEncode2(X[1], X[0]);
+}
+
+std::uint64_t hilbertEncode3(std::uint32_t x, std::uint32_t y, std::uint32_t z)
+{
+    std::uint32_t X[3] = {x & 0x1FFFFFu, y & 0x1FFFFFu, z & 0x1FFFFFu};
+    axesToTranspose(X, Bits3);
+    return mortonEncode3(X[2], X[1], X[0]);
+}
+
+// Batch code generation
+template <typename T>
+void spaceFillingCodes(const Vector3<T> *points, std::size_t count, const Bounds3<T> &bounds,
+                       std::uint64_t *codes, SpaceFillingCurve curve, unsigned threads)
+{
+    codes3(count, bounds, codes, curve, threads, [points](std::size_t i, T &x, T &y, T &z)
+    {
+        x = points[i].x;
+        y = points[i].y;
+        z = points[i].z;
+    });
+}
+
+template <typename T>
+void spaceFillingCodes(const Vector3SoAView<T> &points, const Bounds3<T> &bounds,
+                       std::uint64_t *codes, SpaceFillingCurve curve, unsigned threads)
+{
+    codes3(points.count, bounds, codes, curve, threads, [&points](std::size_t i, T &x, T &y, T &z)
+    {
+        x = points.x[i];
+        y = points.y[i];
+        z = points.z[i];
+    });
+}
+
+template <typename T>
+void spaceFillingCodes(const Vector2<T> *points, std::size_t count, const Vector2<T> &min,
+                       const Vector2<T> &max, std::uint64_t *codes, SpaceFillingCurve curve, unsigned threads)
+{
+    codes2(points, count, min, max, codes, curve, threads);
+}
+
+template <typename T>
+void spaceFillingCodes(const StridedView<Vector3<T>> &points, const Bounds3<T> &bounds,
+                       std::uint64_t *codes, SpaceFillingCurve curve, unsigned threads)
+{
+    codes3(points.count, bounds, codes, curve, threads, [&points](std::size_t i, T &x, T &y, T &z)
+    {
+        const Vector3<T> &p = points[i];
+        x = p.x;
+        y = p.y;
+        z = p.z;
+    });
+}
+
+template <typename T>
+void spaceFillingCodes(const StridedView<Vector2<T>> &points, const Vector2<T> &min, const Vector2<T> &max,
+                       std::uint64_t *codes, SpaceFillingCurve curve, unsigned threads)
+{
+    codes2(points, points.count, min, max, codes, curve, threads);
+}
+
+// Spatial sorting
+template <typename T>
+std::vector<std::uint32_t> spatialSort(Vector3<T> *points, std::size_t count, SpaceFillingCurve curve,
+                                       unsigned threads)
+{
+    std::vector<std::uint64_t> codes(count);
+    std::vector<std::uint32_t> permutation(count);
+    spaceFillingCodes(points, count, bounds(points, count, threads), codes.data(), curve, threads);
+    radixSort(codes.data(), permutation.data(), count, threads, 3 * Bits3);
+
+    std::vector<Vector3<T>> sorted(count);
+    applyPermutation(permutation.data(), points, sorted.data(), count);
+    std::copy(sorted.begin(), sorted.end(), points);
+    return permutation;
+}
+
+template <typename T>
+std::vector<std::uint32_t> spatialSort(Vector3SoA<T> &points, SpaceFillingCurve curve, unsigned threads)
+{
+    std::size_t count = points.size();
+    std::vector<std::uint64_t> codes(count);
+    std::vector<std::uint32_t> permutation(count);
+    spaceFillingCodes(points.view(), bounds(points.view(), threads), codes.data(), curve, threads);
+    radixSort(codes.data(), permutation.data(), count, threads, 3 * Bits3);
+
+    std::vector<T> sorted(count);
+    for (std::vector<T> *axis : {&points.x, &points.y, &points.z})
+    {
+        applyPermutation(permutation.data(), axis->data(), sorted.data(), count);
+        axis->swap(sorted);
+    }
+    return permutation;
+}
+
+template <typename T>
+std::vector<std::uint32_t> spatialSort(Vector2<T> *points, std::size_t count, SpaceFillingCurve curve,
+                                       unsigned threads)
+{
+    Vector2<T> min = count > 0 ? points[0] : Vector2<T>::zero();
+    Vector2<T> max = min;
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        min = Vector2<T>::min(min, points[i]);
+        max = Vector2<T>::max(max, points[i]);
+    }
+
+    std::vector<std::uint64_t> codes(count);
+    std::vector<std::uint32_t> permutation(count);
+    spaceFillingCodes(points, count, min, max, codes.data(), curve, threads);
+    radixSort(codes.data(), permutation.data(), count, threads, 2 * Bits2);
+
+    std::vector<Vector2<T>> sorted(count);
+    applyPermutation(permutation.data(), points, sorted.data(), count);
+    std::copy(sorted.begin(), sorted.end(), points);
+    return permutation;
+}
+
+#define LUMINA_INSTANTIATE_SPACE_FILLING(T)                                                                      \
+    template void spaceFillingCodes<T>(const Vector3<T> *, std::size_t, const Bounds3<T> &, std::uint64_t *,    \
+                                       SpaceFillingCurve, unsigned);                                           \
+    template void spaceFillingCodes<T>(const Vector3SoAView<T> &, const Bounds3<T> &, std::uint64_t *,          \
+                                       SpaceFillingCurve, unsigned);                                           \
+    template void spaceFillingCodes<T>(const Vector2<T> *, std::size_t, const Vector2<T> &, const Vector2<T> &, \
+                                       std::uint64_t *, SpaceFillingCurve, unsigned);                          \
+    template void spaceFillingCodes<T>(const StridedView<Vector3<T>> &, const Bounds3<T> &, std::uint64_t *,    \
+                                       SpaceFillingCurve, unsigned);                                           \
+    template void spaceFillingCodes<T>(const StridedView<Vector2<T>> &, const Vector2<T> &, const Vector2<T> &, \
+                                       std::uint64_t *, SpaceFillingCurve, unsigned);                          \
+    template std::vector<std::uint32_t> spatialSort<T>(Vector3<T> *, std::size_t, SpaceFillingCurve, unsigned); \
+    template std::vector<std::uint32_t> spatialSort<T>(Vector3SoA<T> &, SpaceFillingCurve, unsigned);           \
+    template std::vector<std::uint32_t> spatialSort<T>(Vector2<T> *, std::size_t, SpaceFillingCurve, unsigned);
+
+LUMINA_INSTANTIATE_SPACE_FILLING(float)
+LUMINA_INSTANTIATE_SPACE_FILLING(double)
+
+#undef LUMINA_INSTANTIATE_SPACE_FILLING
+
+} // namespace lumina
@@ -0,0 +1,252 @@
+#include <lumina/spatial/sweep_and_prune.hpp>
+#include "../parallel/parallel_for.hpp"
+#include "../simd/simd.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace lumina
+{
+
+namespace
+{
+
+constexpr std::size_t MinBoxesPerThread = std::size_t(1) << 11;
+// Insertion sort gives up after this many element moves per box and the order is fully re-sorted
+constexpr std::size_t InsertionMovesPerBox = 8;
+
+// Axis with the largest variance of box centers; centers are taken relative to the first one
+// so the sums of squares do not cancel
+template <typename T>
+int widestAxis(const Vector3SoA<T> &minimums, const Vector3SoA<T> &maximums)
+{
+    std::size_t count = minimums.size();
+    const std::vector<T> *mins[3] = {&minimums.x, &minimums.y, &minimums.z};
+    const std::vector<T> *maxs[3] = {&maximums.x, &maximums.y, &maximums.z};
+    int best = 0;
+    double bestVariance = -1.0;
+    for (int a = 0; a < 3; ++a)
+    {
+        const T *lo = mins[a]->data();
+        const T *hi = maxs[a]->data();
+        double origin = double(lo[0]) + double(hi[0]);
+        double sum = 0.0, squares = 0.0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            double c = double(lo[i]) + double(hi[i]) - origin;
+            sum += c;
+            squares += c * c;
+        }
+        double variance = squares - sum * sum / double(count);
+        if (variance > bestVariance)
+        {
+            bestVariance = variance;
+            best = a;
+        }
+    }
+    return best;
+}
+
+// Sorts (keys, order) by key in place with insertion sort; returns false, leaving a permutation of
+// the input, once more than `budget` moves were needed
+template <typename T>
+bool insertionSort(std::vector<T> &keys, std::vector<std::uint32_t> &order, std::size_t budget)
+{
+    std::size_t count = keys.size();
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        T key = keys[i];
+        std::uint32_t index = order[i];
+        std::size_t j = i;
+        while (j > 0 && key < keys[j - 1])
+        {
+            keys[j] = keys[j - 1];
+            order[j] = order[j - 1];
+            --j;
+        }
+        keys[j] = key;
+        order[j] = index;
+        std::size_t moves = i - j;
+        if (moves > budget)
+            return false;
+        budget -= moves;
+    }
+    return true;
+}
+
+template <typename T>
+void fullSort(std::vector<T> &keys, std::vector<std::uint32_t> &order, const T *axisMinimums)
+{
+    std::sort(order.begin(), order.end(), [axisMinimums](std::uint32_t a, std::uint32_t b)
+    {
+        return axisMinimums[a] < axisMinimums[b] || (axisMinimums[a] == axisMinimums[b] && a < b);
+    });
+    for (std::size_t k = 0; k < order.size(); ++k)
+        keys[k] = axisMinimums[order[k]];
+}
+
+// Tests sorted box i against the boxes after it until the sweep axis separates them.
+// Sorting makes the sweep test monotonic, so the first pack with a failing lane is the last one;
+// the NaN padding fails every compare, which ends the sweep at the array end.
+template <typename T>
+void sweepBox(const T *const (&lo)[3], const T *const (&hi)[3], const std::uint32_t *order, std::size_t i,
+              std::vector<OverlapPair> &pairs)
+{
+    using P = simd::Pack<T>;
+    P sweepMax = P::broadcast(hi[0][i]);
+    P loB = P::broadcast(lo[1][i]), hiB = P::broadcast(hi[1][i]);
+    P loC = P::broadcast(lo[2][i]), hiC = P::broadcast(hi[2][i]);
+    std::uint32_t self = order[i];
+    std::uint32_t hits[P::width];
+    for (std::size_t j = i + 1;; j += P::width)
+    {
+        auto sweep = P::load(lo[0] + j) <= sweepMax;
+        auto overlap = sweep & (P::load(lo[1] + j) <= hiB) & (P::load(hi[1] + j) >= loB) &
+                       (P::load(lo[2] + j) <= hiC) & (P::load(hi[2] + j) >= loC);
+        std::size_t found = simd::compressIndices<P>(overlap.bits(), j, hits);
+        for (std::size_t h = 0; h < found; ++h)
+        {
+            std::uint32_t other = order[hits[h]];
+            pairs.push_back(self < other ? OverlapPair{self, other} : OverlapPair{other, self});
+        }
+        if (!sweep.all())
+            break;
+    }
+}
+
+} // namespace
+
+template <typename T>
+SweepAndPrune<T>::SweepAndPrune() : axis(0) {}
+
+// Box management
+template <typename T>
+std::size_t SweepAndPrune<T>::size() const
+{
+    return minimums.size();
+}
+
+template <typename T>
+std::uint32_t SweepAndPrune<T>::add(const Bounds3<T> &box)
+{
+    std::size_t index = size();
+    if (index >= std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error("SweepAndPrune holds at most 2^32 - 1 boxes");
+    minimums.push_back(box.min);
+    maximums.push_back(box.max);
+    order.push_back(std::uint32_t(index));
+    return std::uint32_t(index);
+}
+
+template <typename T>
+void SweepAndPrune<T>::set(std::uint32_t index, const Bounds3<T> &box)
+{
+    if (index >= size())
+        throw std::out_of_range("SweepAndPrune box index out of range");
+    minimums.set(index, box.min);
+    maximums.set(index, box.max);
+}
+
+template <typename T>
+Bounds3<T> SweepAndPrune<T>::get(std::uint32_t index) const
+{
+    if (index >= size())
+        throw std::out_of_range("SweepAndPrune box index out of range");
+    return Bounds3<T>(minimums.get(index), maximums.get(index));
+}
+
+template <typename T>
+void SweepAndPrune<T>::clear()
+{
+    minimums.clear();
+    maximums.clear();
+    order.clear();
+    sortedMinimums.clear();
+    sortedMaximums.clear();
+}
+
+template <typename T>
+void SweepAndPrune<T>::findPairs(std::vector<OverlapPair> &pairs, unsigned threads)
+{
+    pairs.clear();
+    std::size_t count = size();
+    if (maximums.size() != count)
+        throw std::invalid_argument("SweepAndPrune minimums and maximums differ in size");
+    if (count < 2)
+        return;
+
+    // Repair the previous order along the new sweep axis, or rebuild it
+    const std::vector<T> *minAxes[3] = {&minimums.x, &minimums.y, &minimums.z};
+    const std::vector<T> *maxAxes[3] = {&maximums.x, &maximums.y, &maximums.z};
+    int sweepAxis = widestAxis(minimums, maximums);
+    const T *axisMinimums = minAxes[sweepAxis]->data();
+    std::vector<T> keys(count);
+    bool reuse = sweepAxis == axis && order.size() == count;
+    if (reuse)
+    {
+        for (std::size_t k = 0; k < count; ++k)
+            keys[k] = axisMinimums[order[k]];
+        reuse = insertionSort(keys, order, count * InsertionMovesPerBox);
+    }
+    if (!reuse)
+    {
+        order.resize(count);
+        std::iota(order.begin(), order.end(), 0u);
+        fullSort(keys, order, axisMinimums);
+    }
+    axis = sweepAxis;
+
+    // Gather the corners in sweep order with the sweep axis first, padded with NaN boxes
+    constexpr std::size_t Padding = simd::Pack<T>::width;
+    constexpr T NaN = std::numeric_limits<T>::quiet_NaN();
+    sortedMinimums.resize(count + Padding);
+    sortedMaximums.resize(count + Padding);
+    std::vector<T> *sortedLo[3] = {&sortedMinimums.x, &sortedMinimums.y, &sortedMinimums.z};
+    std::vector<T> *sortedHi[3] = {&sortedMaximums.x, &sortedMaximums.y, &sortedMaximums.z};
+    const T *lo[3], *hi[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        int a = (sweepAxis + k) % 3;
+        const T *srcLo = minAxes[a]->data();
+        const T *srcHi = maxAxes[a]->data();
+        T *dstLo = sortedLo[k]->data();
+        T *dstHi = sortedHi[k]->data();
+        for (std::size_t s = 0; s < count; ++s)
+        {
+            dstLo[s] = srcLo[order[s]];
+            dstHi[s] = srcHi[order[s]];
+        }
+        std::fill(dstLo + count, dstLo + count + Padding, NaN);
+        std::fill(dstHi + count, dstHi + count + Padding, NaN);
+        lo[k] = dstLo;
+        hi[k] = dstHi;
+    }
+
+    // Each chunk sweeps a contiguous run of boxes into its own list; concatenating in chunk order
+    // gives the same output for any thread count
+    unsigned chunks = parallel::chunkCount(count, threads, MinBoxesPerThread);
+    if (chunks <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            sweepBox(lo, hi, order.data(), i, pairs);
+        return;
+    }
+    std::vector<std::vector<OverlapPair>> partial(chunks);
+    parallel::forEachChunk(count, chunks, [&](unsigned chunk, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            sweepBox(lo, hi, order.data(), i, partial[chunk]);
+    });
+    std::size_t total = 0;
+    for (const std::vector<OverlapPair> &part : partial)
+        total += part.size();
+    pairs.reserve(total);
+    for (const std::vector<OverlapPair> &part : partial)
+        pairs.insert(pairs.end(), part.begin(), part.end());
+}
+
+template class SweepAndPrune<float>;
+template class SweepAndPrune<double>;
+
+} // namespace lumina
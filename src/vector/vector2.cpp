@@ -1,4 +1,5 @@
 #include <lumina/vector/vector2.hpp>
+#include <lumina/numeric/scalar_traits.hpp>
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
@@ -19,50 +20,50 @@ Vector2<T>::Vector2(const T x, const T y) : x(x), y(y) {}
 template <typename T>
 Vector2<T> Vector2<T>::operator+(const Vector2 &other) const
 {
-    return Vector2(x + other.x, y + other.y);
+    return Vector2(ScalarTraits<T>::add(x, other.x), ScalarTraits<T>::add(y, other.y));
 }
 
 template <typename T>
 Vector2<T> Vector2<T>::operator-(const Vector2 &other) const
 {
-    return Vector2(x - other.x, y - other.y);
+    return Vector2(ScalarTraits<T>::sub(x, other.x), ScalarTraits<T>::sub(y, other.y));
 }
 
 template <typename T>
 Vector2<T> Vector2<T>::operator*(const Vector2 &other) const
 {
-    return Vector2(x * other.x, y * other.y);
+    return Vector2(ScalarTraits<T>::mul(x, other.x), ScalarTraits<T>::mul(y, other.y));
 }
 
 template <typename T>
 Vector2<T> Vector2<T>::operator/(const Vector2 &other) const
 {
-    return Vector2(x / other.x, y / other.y);
+    return Vector2(ScalarTraits<T>::div(x, other.x), ScalarTraits<T>::div(y, other.y));
 }
 
 // Arithmetic operators with scalar
 template <typename T>
 Vector2<T> Vector2<T>::operator+(T scalar) const
 {
-    return Vector2(x + scalar, y + scalar);
+    return Vector2(ScalarTraits<T>::add(x, scalar), ScalarTraits<T>::add(y, scalar));
 }
 
 template <typename T>
 Vector2<T> Vector2<T>::operator-(T scalar) const
 {
-    return Vector2(x - scalar, y - scalar);
+    return Vector2(ScalarTraits<T>::sub(x, scalar), ScalarTraits<T>::sub(y, scalar));
 }
 
 template <typename T>
 Vector2<T> Vector2<T>::operator*(T scalar) const
 {
-    return Vector2(x * scalar, y * scalar);
+    return Vector2(ScalarTraits<T>::mul(x, scalar), ScalarTraits<T>::mul(y, scalar));
 }
 
 template <typename T>
 Vector2<T> Vector2<T>::operator/(T scalar) const
 {
-    return Vector2(x / scalar, y / scalar);
+    return Vector2(ScalarTraits<T>::div(x, scalar), ScalarTraits<T>::div(y, scalar));
 }
 
 // Unary operators
@@ -75,39 +76,39 @@ Vector2<T> Vector2<T>::operator+() const
 template <typename T>
 Vector2<T> Vector2<T>::operator-() const
 {
-    return Vector2(-x, -y);
+    return Vector2(ScalarTraits<T>::negate(x), ScalarTraits<T>::negate(y));
 }
 
 // Compound assignment operators
 template <typename T>
 Vector2<T> &Vector2<T>::operator+=(const Vector2 &other)
 {
-    x += other.x;
-    y += other.y;
+    x = ScalarTraits<T>::add(x, other.x);
+    y = ScalarTraits<T>::add(y, other.y);
     return *this;
 }
 
 template <typename T>
 Vector2<T> &Vector2<T>::operator-=(const Vector2 &other)
 {
-    x -= other.x;
-    y -= other.y;
+    x = ScalarTraits<T>::sub(x, other.x);
+    y = ScalarTraits<T>::sub(y, other.y);
     return *this;
 }
 
 template <typename T>
 Vector2<T> &Vector2<T>::operator*=(const Vector2 &other)
 {
-    x *= other.x;
-    y *= other.y;
+    x = ScalarTraits<T>::mul(x, other.x);
+    y = ScalarTraits<T>::mul(y, other.y);
     return *this;
 }
 
 template <typename T>
 Vector2<T> &Vector2<T>::operator/=(const Vector2 &other)
 {
-    x /= other.x;
-    y /= other.y;
+    x = ScalarTraits<T>::div(x, other.x);
+    y = ScalarTraits<T>::div(y, other.y);
     return *this;
 }
 
@@ -162,7 +163,7 @@ const T *Vector2<T>::data() const
 
 // Vector properties
 template <typename T>
-Vector2<T> Vector2<T>::normalized() const
+Vector2<T> Vector2<T>::normalized() const requires(!std::integral<T>)
 {
     T mag = magnitude();
     if (mag == T(0))
@@ -173,13 +174,14 @@ Vector2<T> Vector2<T>::normalized() const
 template <typename T>
 T Vector2<T>::magnitude() const
 {
-    return std::sqrt(x * x + y * y);
+    return ScalarTraits<T>::length(x, y);
 }
 
 template <typename T>
 T Vector2<T>::sqrMagnitude() const
 {
-    return x * x + y * y;
+    using S = ScalarTraits<T>;
+    return S::add(S::mul(x, x), S::mul(y, y));
 }
 
 // Static predefined vectors
@@ -221,11 +223,11 @@ Vector2<T> Vector2<T>::right()
 
 // Static vector operations
 template <typename T>
-T Vector2<T>::angle(const Vector2 &a, const Vector2 &b)
+T Vector2<T>::angle(const Vector2 &a, const Vector2 &b) requires(!std::integral<T>)
 {
     T dotProduct = dot(a.normalized(), b.normalized());
     dotProduct = std::clamp(dotProduct, T(-1), T(1));
-    return std::acos(dotProduct); // Radianes
+    return ScalarTraits<T>::acos(dotProduct); // Radianes
 }
 
 template <typename T>
@@ -237,7 +239,15 @@ T Vector2<T>::distance(const Vector2 &a, const Vector2 &b)
 template <typename T>
 T Vector2<T>::dot(const Vector2 &a, const Vector2 &b)
 {
-    return a.x * b.x + a.y * b.y;
+    using S = ScalarTraits<T>;
+    return S::add(S::mul(a.x, b.x), S::mul(a.y, b.y));
+}
+
+template <typename T>
+T Vector2<T>::cross(const Vector2 &a, const Vector2 &b)
+{
+    using S = ScalarTraits<T>;
+    return S::sub(S::mul(a.x, b.y), S::mul(a.y, b.x));
 }
 
 template <typename T>
@@ -250,7 +260,7 @@ template <typename T>
 Vector2<T> Vector2<T>::reflect(const Vector2 &vector, const Vector2 &normal)
 {
     T dotProduct = dot(vector, normal);
-    return vector - normal * (T(2) * dotProduct);
+    return vector - normal * ScalarTraits<T>::mul(T(2), dotProduct);
 }
 
 template <typename T>
@@ -274,7 +284,7 @@ Vector2<T> Vector2<T>::clamp(const Vector2 &vector, const Vector2 &minVec, const
 }
 
 template <typename T>
-Vector2<T> Vector2<T>::normalize(const Vector2 &vector)
+Vector2<T> Vector2<T>::normalize(const Vector2 &vector) requires(!std::integral<T>)
 {
     return vector.normalized();
 }
@@ -282,7 +292,21 @@ Vector2<T> Vector2<T>::normalize(const Vector2 &vector)
 template <typename T>
 Vector2<T> Vector2<T>::abs(const Vector2 &vector)
 {
-    return Vector2(std::abs(vector.x), std::abs(vector.y));
+    return Vector2(ScalarTraits<T>::abs(vector.x), ScalarTraits<T>::abs(vector.y));
 }
 
+template <typename T>
+bool Vector2<T>::approxEqual(const Vector2 &a, const Vector2 &b, T epsilon)
+{
+    return ScalarTraits<T>::approxEqual(a.x, b.x, epsilon) &&
+           ScalarTraits<T>::approxEqual(a.y, b.y, epsilon);
+}
+
+template class Vector2<float>;
+template class Vector2<double>;
+template class Vector2<int>;
+template class Vector2<std::int64_t>;
+template class Vector2<Fixed16>;
+template class Vector2<Fixed32>;
+
 } // namespace lumina
@@ -1,5 +1,6 @@
 
 #include <lumina/vector/vector3.hpp>
+#include <lumina/numeric/scalar_traits.hpp>
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
@@ -21,50 +22,62 @@ Vector3<T>::Vector3(const T x, const T y, const T z) : x(x), y(y), z(z) {}
 template <typename T>
 Vector3<T> Vector3<T>::operator+(const Vector3 &other) const
 {
-    return Vector3(x + other.x, y + other.y, z + other.z);
+    return Vector3(
+        ScalarTraits<T>::add(x, other.x),
+        ScalarTraits<T>::add(y, other.y),
+        ScalarTraits<T>::add(z, other.z));
 }
 
 template <typename T>
 Vector3<T> Vector3<T>::operator-(const Vector3 &other) const
 {
-    return Vector3(x - other.x, y - other.y, z - other.z);
+    return Vector3(
+        ScalarTraits<T>::sub(x, other.x),
+        ScalarTraits<T>::sub(y, other.y),
+        ScalarTraits<T>::sub(z, other.z));
 }
 
 template <typename T>
 Vector3<T> Vector3<T>::operator*(const Vector3 &other) const
 {
-    return Vector3(x * other.x, y * other.y, z * other.z);
+    return Vector3(
+        ScalarTraits<T>::mul(x, other.x),
+        ScalarTraits<T>::mul(y, other.y),
+        ScalarTraits<T>::mul(z, other.z));
 }
 
 template <typename T>
 Vector3<T> Vector3<T>::operator/(const Vector3 &other) const
 {
-    return Vector3(x / other.x, y / other.y, z / other.z);
+    return Vector3(
+        ScalarTraits<T>::div(x, other.x),
+        ScalarTraits<T>::div(y, other.y),
+        ScalarTraits<T>::div(z, other.z));
 }
 
 // Arithmetic operators with scalar
 template <typename T>
 Vector3<T> Vector3<T>::operator+(T scalar) const
 {
-    return Vector3(x + scalar, y + scalar, z + scalar);
+    return Vector3(ScalarTraits<T>::add(x, scalar), ScalarTraits<T>::add(y, scalar), ScalarTraits<T>::add(z, scalar));
 }
 
 template <typename T>
 Vector3<T> Vector3<T>::operator-(T scalar) const
 {
-    return Vector3(x - scalar, y - scalar, z - scalar);
+    return Vector3(ScalarTraits<T>::sub(x, scalar), ScalarTraits<T>::sub(y, scalar), ScalarTraits<T>::sub(z, scalar));
 }
 
 template <typename T>
 Vector3<T> Vector3<T>::operator*(T scalar) const
 {
-    return Vector3(x * scalar, y * scalar, z * scalar);
+    return Vector3(ScalarTraits<T>::mul(x, scalar), ScalarTraits<T>::mul(y, scalar), ScalarTraits<T>::mul(z, scalar));
 }
 
 template <typename T>
 Vector3<T> Vector3<T>::operator/(T scalar) const
 {
-    return Vector3(x / scalar, y / scalar, z / scalar);
+    return Vector3(ScalarTraits<T>::div(x, scalar), ScalarTraits<T>::div(y, scalar), ScalarTraits<T>::div(z, scalar));
 }
 
 // Unary operators
@@ -77,43 +90,43 @@ Vector3<T> Vector3<T>::operator+() const
 template <typename T>
 Vector3<T> Vector3<T>::operator-() const
 {
-    return Vector3(-x, -y, -z);
+    return Vector3(ScalarTraits<T>::negate(x), ScalarTraits<T>::negate(y), ScalarTraits<T>::negate(z));
 }
 
 // Compound assignment operators
 template <typename T>
 Vector3<T> &Vector3<T>::operator+=(const Vector3 &other)
 {
-    x += other.x;
-    y += other.y;
-    z += other.z;
+    x = ScalarTraits<T>::add(x, other.x);
+    y = ScalarTraits<T>::add(y, other.y);
+    z = ScalarTraits<T>::add(z, other.z);
     return *this;
 }
 
 template <typename T>
 Vector3<T> &Vector3<T>::operator-=(const Vector3 &other)
 {
-    x -= other.x;
-    y -= other.y;
-    z -= other.z;
+    x = ScalarTraits<T>::sub(x, other.x);
+    y = ScalarTraits<T>::sub(y, other.y);
+    z = ScalarTraits<T>::sub(z, other.z);
     return *this;
 }
 
 template <typename T>
 Vector3<T> &Vector3<T>::operator*=(const Vector3 &other)
 {
-    x *= other.x;
-    y *= other.y;
-    z *= other.z;
+    x = ScalarTraits<T>::mul(x, other.x);
+    y = ScalarTraits<T>::mul(y, other.y);
+    z = ScalarTraits<T>::mul(z, other.z);
     return *this;
 }
 
 template <typename T>
 Vector3<T> &Vector3<T>::operator/=(const Vector3 &other)
 {
-    x /= other.x;
-    y /= other.y;
-    z /= other.z;
+    x = ScalarTraits<T>::div(x, other.x);
+    y = ScalarTraits<T>::div(y, other.y);
+    z = ScalarTraits<T>::div(z, other.z);
     return *this;
 }
 
@@ -172,7 +185,7 @@ const T *Vector3<T>::data() const
 
 // Vector properties
 template <typename T>
-Vector3<T> Vector3<T>::normalized() const
+Vector3<T> Vector3<T>::normalized() const requires(!std::integral<T>)
 {
     T mag = magnitude();
     if (mag == T(0))
@@ -183,13 +196,14 @@ Vector3<T> Vector3<T>::normalized() const
 template <typename T>
 T Vector3<T>::magnitude() const
 {
-    return std::sqrt(x * x + y * y + z * z);
+    return ScalarTraits<T>::length(x, y, z);
 }
 
 template <typename T>
 T Vector3<T>::sqrMagnitude() const
 {
-    return x * x + y * y + z * z;
+    using S = ScalarTraits<T>;
+    return S::add(S::add(S::mul(x, x), S::mul(y, y)), S::mul(z, z));
 }
 
 // Static predefined vectors
@@ -243,11 +257,11 @@ Vector3<T> Vector3<T>::back()
 
 // Static vector operations
 template <typename T>
-T Vector3<T>::angle(const Vector3 &a, const Vector3 &b)
+T Vector3<T>::angle(const Vector3 &a, const Vector3 &b) requires(!std::integral<T>)
 {
     T dotProduct = dot(a.normalized(), b.normalized());
     dotProduct = std::clamp(dotProduct, T(-1), T(1)); // Clamp for safety
-    return std::acos(dotProduct); // Returns radians
+    return ScalarTraits<T>::acos(dotProduct); // Returns radians
 }
 
 template <typename T>
@@ -259,16 +273,18 @@ T Vector3<T>::distance(const Vector3 &a, const Vector3 &b)
 template <typename T>
 T Vector3<T>::dot(const Vector3 &a, const Vector3 &b)
 {
-    return a.x * b.x + a.y * b.y + a.z * b.z;
+    using S = ScalarTraits<T>;
+    return S::add(S::add(S::mul(a.x, b.x), S::mul(a.y, b.y)), S::mul(a.z, b.z));
 }
 
 template <typename T>
 Vector3<T> Vector3<T>::cross(const Vector3 &a, const Vector3 &b)
 {
+    using S = ScalarTraits<T>;
     return Vector3(
-        a.y * b.z - a.z * b.y,
-        a.z * b.x - a.x * b.z,
-        a.x * b.y - a.y * b.x);
+        S::sub(S::mul(a.y, b.z), S::mul(a.z, b.y)),
+        S::sub(S::mul(a.z, b.x), S::mul(a.x, b.z)),
+        S::sub(S::mul(a.x, b.y), S::mul(a.y, b.x)));
 }
 
 template <typename T>
@@ -282,7 +298,7 @@ Vector3<T> Vector3<T>::reflect(const Vector3 &vector, const Vector3 &normal)
 {
     // R = V - 2*(V·N)*N
     T dotProduct = dot(vector, normal);
-    return vector - normal * (T(2) * dotProduct);
+    return vector - normal * ScalarTraits<T>::mul(T(2), dotProduct);
 }
 
 template <typename T>
@@ -313,7 +329,7 @@ Vector3<T> Vector3<T>::clamp(const Vector3 &vector, const Vector3 &minVec, const
 }
 
 template <typename T>
-Vector3<T> Vector3<T>::normalize(const Vector3 &vector)
+Vector3<T> Vector3<T>::normalize(const Vector3 &vector) requires(!std::integral<T>)
 {
     return vector.normalized();
 }
@@ -322,9 +338,24 @@ template <typename T>
 Vector3<T> Vector3<T>::abs(const Vector3 &vector)
 {
     return Vector3(
-        std::abs(vector.x),
-        std::abs(vector.y),
-        std::abs(vector.z));
+        ScalarTraits<T>::abs(vector.x),
+        ScalarTraits<T>::abs(vector.y),
+        ScalarTraits<T>::abs(vector.z));
 }
 
+template <typename T>
+bool Vector3<T>::approxEqual(const Vector3 &a, const Vector3 &b, T epsilon)
+{
+    return ScalarTraits<T>::approxEqual(a.x, b.x, epsilon) &&
+           ScalarTraits<T>::approxEqual(a.y, b.y, epsilon) &&
+           ScalarTraits<T>::approxEqual(a.z, b.z, epsilon);
+}
+
+template class Vector3<float>;
+template class Vector3<double>;
+template class Vector3<int>;
+template class Vector3<std::int64_t>;
+template class Vector3<Fixed16>;
+template class Vector3<Fixed32>;
+
 } // namespace lumina
@@ -1,4 +1,5 @@
 #include <lumina/vector/vector4.hpp>
+#include <lumina/numeric/scalar_traits.hpp>
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
@@ -19,50 +20,82 @@ Vector4<T>::Vector4(const T x, const T y, const T z, const T w) : x(x), y(y), z(
 template <typename T>
 Vector4<T> Vector4<T>::operator+(const Vector4 &other) const
 {
-    return Vector4(x + other.x, y + other.y, z + other.z, w + other.w);
+    return Vector4(
+        ScalarTraits<T>::add(x, other.x),
+        ScalarTraits<T>::add(y, other.y),
+        ScalarTraits<T>::add(z, other.z),
+        ScalarTraits<T>::add(w, other.w));
 }
 
 template <typename T>
 Vector4<T> Vector4<T>::operator-(const Vector4 &other) const
 {
-    return Vector4(x - other.x, y - other.y, z - other.z, w - other.w);
+    return Vector4(
+        ScalarTraits<T>::sub(x, other.x),
+        ScalarTraits<T>::sub(y, other.y),
+        ScalarTraits<T>::sub(z, other.z),
+        ScalarTraits<T>::sub(w, other.w));
 }
 
 template <typename T>
 Vector4<T> Vector4<T>::operator*(const Vector4 &other) const
 {
-    return Vector4(x * other.x, y * other.y, z * other.z, w * other.w);
+    return Vector4(
+        ScalarTraits<T>::mul(x, other.x),
+        ScalarTraits<T>::mul(y, other.y),
+        ScalarTraits<T>::mul(z, other.z),
+        ScalarTraits<T>::mul(w, other.w));
 }
 
 template <typename T>
 Vector4<T> Vector4<T>::operator/(const Vector4 &other) const
 {
-    return Vector4(x / other.x, y / other.y, z / other.z, w / other.w);
+    return Vector4(
+        ScalarTraits<T>::div(x, other.x),
+        ScalarTraits<T>::div(y, other.y),
+        ScalarTraits<T>::div(z, other.z),
+        ScalarTraits<T>::div(w, other.w));
 }
 
 // Arithmetic operators with scalar
 template <typename T>
 Vector4<T> Vector4<T>::operator+(T scalar) const
 {
-    return Vector4(x + scalar, y + scalar, z + scalar, w + scalar);
+    return Vector4(
+        ScalarTraits<T>::add(x, scalar),
+        ScalarTraits<T>::add(y, scalar),
+        ScalarTraits<T>::add(z, scalar),
+        ScalarTraits<T>::add(w, scalar));
 }
 
 template <typename T>
 Vector4<T> Vector4<T>::operator-(T scalar) const
 {
-    return Vector4(x - scalar, y - scalar, z - scalar, w - scalar);
+    return Vector4(
+        ScalarTraits<T>::sub(x, scalar),
+        ScalarTraits<T>::sub(y, scalar),
+        ScalarTraits<T>::sub(z, scalar),
+        ScalarTraits<T>::sub(w, scalar));
 }
 
 template <typename T>
 Vector4<T> Vector4<T>::operator*(T scalar) const
 {
-    return Vector4(x * scalar, y * scalar, z * scalar, w * scalar);
+    return Vector4(
+        ScalarTraits<T>::mul(x, scalar),
+        ScalarTraits<T>::mul(y, scalar),
+        ScalarTraits<T>::mul(z, scalar),
+        ScalarTraits<T>::mul(w, scalar));
 }
 
 template <typename T>
 Vector4<T> Vector4<T>::operator/(T scalar) const
 {
-    return Vector4(x / scalar, y / scalar, z / scalar, w / scalar);
+    return Vector4(
+        ScalarTraits<T>::div(x, scalar),
+        ScalarTraits<T>::div(y, scalar),
+        ScalarTraits<T>::div(z, scalar),
+        ScalarTraits<T>::div(w, scalar));
 }
 
 // Unary operators
@@ -75,47 +108,51 @@ Vector4<T> Vector4<T>::operator+() const
 template <typename T>
 Vector4<T> Vector4<T>::operator-() const
 {
-    return Vector4(-x, -y, -z, -w);
+    return Vector4(
+        ScalarTraits<T>::negate(x),
+        ScalarTraits<T>::negate(y),
+        ScalarTraits<T>::negate(z),
+        ScalarTraits<T>::negate(w));
 }
 
 // Compound assignment
 template <typename T>
 Vector4<T> &Vector4<T>::operator+=(const Vector4 &other)
 {
-    x += other.x;
-    y += other.y;
-    z += other.z;
-    w += other.w;
+    x = ScalarTraits<T>::add(x, other.x);
+    y = ScalarTraits<T>::add(y, other.y);
+    z = ScalarTraits<T>::add(z, other.z);
+    w = ScalarTraits<T>::add(w, other.w);
     return *this;
 }
 
 template <typename T>
 Vector4<T> &Vector4<T>::operator-=(const Vector4 &other)
 {
-    x -= other.x;
-    y -= other.y;
-    z -= other.z;
-    w -= other.w;
+    x = ScalarTraits<T>::sub(x, other.x);
+    y = ScalarTraits<T>::sub(y, other.y);
+    z = ScalarTraits<T>::sub(z, other.z);
+    w = ScalarTraits<T>::sub(w, other.w);
     return *this;
 }
 
 template <typename T>
 Vector4<T> &Vector4<T>::operator*=(const Vector4 &other)
 {
-    x *= other.x;
-    y *= other.y;
-    z *= other.z;
-    w *= other.w;
+    x = ScalarTraits<T>::mul(x, other.x);
+    y = ScalarTraits<T>::mul(y, other.y);
+    z = ScalarTraits<T>::mul(z, other.z);
+    w = ScalarTraits<T>::mul(w, other.w);
     return *this;
 }
 
 template <typename T>
 Vector4<T> &Vector4<T>::operator/=(const Vector4 &other)
 {
-    x /= other.x;
-    y /= other.y;
-    z /= other.z;
-    w /= other.w;
+    x = ScalarTraits<T>::div(x, other.x);
+    y = ScalarTraits<T>::div(y, other.y);
+    z = ScalarTraits<T>::div(z, other.z);
+    w = ScalarTraits<T>::div(w, other.w);
     return *this;
 }
 
@@ -168,7 +205,7 @@ const T *Vector4<T>::data() const
 
 // Vector properties
 template <typename T>
-Vector4<T> Vector4<T>::normalized() const
+Vector4<T> Vector4<T>::normalized() const requires(!std::integral<T>)
 {
     T mag = magnitude();
     if (mag == T(0))
@@ -179,13 +216,14 @@ Vector4<T> Vector4<T>::normalized() const
 template <typename T>
 T Vector4<T>::magnitude() const
 {
-    return std::sqrt(x * x + y * y + z * z + w * w);
+    return ScalarTraits<T>::length(x, y, z, w);
 }
 
 template <typename T>
 T Vector4<T>::sqrMagnitude() const
 {
-    return x * x + y * y + z * z + w * w;
+    using S = ScalarTraits<T>;
+    return S::add(S::add(S::add(S::mul(x, x), S::mul(y, y)), S::mul(z, z)), S::mul(w, w));
 }
 
 // Predefined vectors
@@ -205,7 +243,8 @@ Vector4<T> Vector4<T>::one()
 template <typename T>
 T Vector4<T>::dot(const Vector4 &a, const Vector4 &b)
 {
-    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    using S = ScalarTraits<T>;
+    return S::add(S::add(S::add(S::mul(a.x, b.x), S::mul(a.y, b.y)), S::mul(a.z, b.z)), S::mul(a.w, b.w));
 }
 
 template <typename T>
@@ -215,11 +254,11 @@ T Vector4<T>::distance(const Vector4 &a, const Vector4 &b)
 }
 
 template <typename T>
-T Vector4<T>::angle(const Vector4 &a, const Vector4 &b)
+T Vector4<T>::angle(const Vector4 &a, const Vector4 &b) requires(!std::integral<T>)
 {
     T dotProduct = dot(a.normalized(), b.normalized());
     dotProduct = std::clamp(dotProduct, T(-1), T(1));
-    return std::acos(dotProduct); // Radianes
+    return ScalarTraits<T>::acos(dotProduct); // Radianes
 }
 
 template <typename T>
@@ -232,7 +271,7 @@ template <typename T>
 Vector4<T> Vector4<T>::reflect(const Vector4 &vector, const Vector4 &normal)
 {
     T dotProduct = dot(vector, normal);
-    return vector - normal * (T(2) * dotProduct);
+    return vector - normal * ScalarTraits<T>::mul(T(2), dotProduct);
 }
 
 template <typename T>
@@ -266,7 +305,7 @@ Vector4<T> Vector4<T>::clamp(const Vector4 &vector, const Vector4 &minVec, const
 }
 
 template <typename T>
-Vector4<T> Vector4<T>::normalize(const Vector4 &vector)
+Vector4<T> Vector4<T>::normalize(const Vector4 &vector) requires(!std::integral<T>)
 {
     return vector.normalized();
 }
@@ -275,10 +314,26 @@ template <typename T>
 Vector4<T> Vector4<T>::abs(const Vector4 &vector)
 {
     return Vector4(
-        std::abs(vector.x),
-        std::abs(vector.y),
-        std::abs(vector.z),
-        std::abs(vector.w));
+        ScalarTraits<T>::abs(vector.x),
+        ScalarTraits<T>::abs(vector.y),
+        ScalarTraits<T>::abs(vector.z),
+        ScalarTraits<T>::abs(vector.w));
 }
 
+template <typename T>
+bool Vector4<T>::approxEqual(const Vector4 &a, const Vector4 &b, T epsilon)
+{
+    return ScalarTraits<T>::approxEqual(a.x, b.x, epsilon) &&
+           ScalarTraits<T>::approxEqual(a.y, b.y, epsilon) &&
+           ScalarTraits<T>::approxEqual(a.z, b.z, epsilon) &&
+           ScalarTraits<T>::approxEqual(a.w, b.w, epsilon);
+}
+
+template class Vector4<float>;
+template class Vector4<double>;
+template class Vector4<int>;
+template class Vector4<std::int64_t>;
+template class Vector4<Fixed16>;
+template class Vector4<Fixed32>;
+
 } // namespace lumina
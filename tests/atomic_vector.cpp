@@ -0,0 +1,180 @@
+// Lock-free atomicAdd from racing threads against serial sums, and BufferedScatterAdd against a serial
+// slot-order, insertion-order reference that it must match bit for bit for any merge thread count.
+
+#include "check.hpp"
+#include <lumina/concurrent/atomic_vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+template <typename V>
+bool sameBits(const std::vector<V> &a, const std::vector<V> &b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(V)) == 0;
+}
+
+// Small integers keep every partial sum exact, so the racing result must equal the serial one
+// whatever order the additions land in
+template <typename T>
+void testAtomicAdd()
+{
+    constexpr unsigned threadCount = 8;
+    constexpr int addsPerThread = 20000;
+    constexpr std::size_t targetCount = 5;
+
+    T scalar = T(0);
+    std::vector<Vector2<T>> targets2(targetCount, Vector2<T>(T(0)));
+    std::vector<Vector3<T>> targets3(targetCount, Vector3<T>(T(0)));
+    std::vector<Vector4<T>> targets4(targetCount, Vector4<T>(T(0)));
+
+    auto value = [](unsigned thread, int i) { return T(int(thread * 7 + unsigned(i)) % 13 - 6); };
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (int i = 0; i < addsPerThread; ++i)
+            {
+                T v = value(t, i);
+                std::size_t target = std::size_t(i) % targetCount;
+                atomicAdd(scalar, v);
+                atomicAdd(targets2[target], Vector2<T>(v, -v));
+                atomicAdd(targets3[target], Vector3<T>(v, T(1), T(2) * v));
+                atomicAdd(targets4[target], Vector4<T>(v, T(1), -v, T(3)));
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+
+    T expectedScalar = T(0);
+    std::vector<T> expected(targetCount, T(0));
+    std::vector<int> hits(targetCount, 0);
+    for (unsigned t = 0; t < threadCount; ++t)
+    {
+        for (int i = 0; i < addsPerThread; ++i)
+        {
+            expectedScalar += value(t, i);
+            expected[std::size_t(i) % targetCount] += value(t, i);
+            ++hits[std::size_t(i) % targetCount];
+        }
+    }
+    LUMINA_CHECK(scalar == expectedScalar);
+    bool matches = true;
+    for (std::size_t k = 0; k < targetCount; ++k)
+    {
+        T s = expected[k], n = T(hits[k]);
+        matches &= targets2[k] == Vector2<T>(s, -s);
+        matches &= targets3[k] == Vector3<T>(s, n, T(2) * s);
+        matches &= targets4[k] == Vector4<T>(s, n, -s, T(3) * n);
+    }
+    LUMINA_CHECK(matches);
+
+    int count = 0;
+    std::vector<std::thread> counters;
+    for (unsigned t = 0; t < threadCount; ++t)
+        counters.emplace_back([&]
+        {
+            for (int i = 0; i < addsPerThread; ++i)
+                atomicAdd(count, 1);
+        });
+    for (std::thread &thread : counters)
+        thread.join();
+    LUMINA_CHECK(count == int(threadCount) * addsPerThread);
+}
+
+template <typename T>
+struct Contribution
+{
+    std::uint32_t index;
+    Vector3<T> value;
+};
+
+template <typename T>
+void testBufferedScatterAdd()
+{
+    constexpr unsigned slotCount = 6;
+    std::mt19937_64 engine(38);
+    std::uniform_real_distribution<T> component(T(-1), T(1));
+
+    // Fewer targets than buckets, about one per bucket, and many per bucket
+    for (std::size_t targetCount : {std::size_t(7), std::size_t(64), std::size_t(5000)})
+    {
+        std::uniform_int_distribution<std::uint32_t> index(0, std::uint32_t(targetCount - 1));
+        std::vector<std::vector<Contribution<T>>> perSlot(slotCount);
+        for (unsigned slot = 0; slot < slotCount; ++slot)
+            for (std::size_t i = 0; i < 3000 * (slot + 1); ++i)
+                perSlot[slot].push_back({index(engine), Vector3<T>(component(engine), component(engine),
+                                                                   component(engine))});
+
+        std::vector<Vector3<T>> initial(targetCount);
+        for (Vector3<T> &v : initial)
+            v = Vector3<T>(component(engine), T(0), T(-0.0));
+
+        // Slot order, then insertion order within a slot
+        std::vector<Vector3<T>> expected = initial;
+        for (const std::vector<Contribution<T>> &contributions : perSlot)
+        {
+            for (const Contribution<T> &c : contributions)
+            {
+                expected[c.index].x += c.value.x;
+                expected[c.index].y += c.value.y;
+                expected[c.index].z += c.value.z;
+            }
+        }
+
+        BufferedScatterAdd<T> scatter(targetCount, slotCount);
+        for (unsigned mergeThreads : {1u, 3u, 0u})
+        {
+            // Producers fill their own slots concurrently
+            std::vector<std::thread> producers;
+            for (unsigned slot = 0; slot < slotCount; ++slot)
+                producers.emplace_back([&, slot]
+                {
+                    for (const Contribution<T> &c : perSlot[slot])
+                        scatter.add(slot, c.index, c.value);
+                });
+            for (std::thread &producer : producers)
+                producer.join();
+
+            std::size_t total = 0;
+            for (const std::vector<Contribution<T>> &contributions : perSlot)
+                total += contributions.size();
+            LUMINA_CHECK(scatter.size() == total && !scatter.empty());
+
+            std::vector<Vector3<T>> targets = initial;
+            scatter.merge(targets.data(), mergeThreads);
+            LUMINA_CHECK(sameBits(targets, expected));
+            LUMINA_CHECK(scatter.empty());
+        }
+    }
+
+    BufferedScatterAdd<T> scatter(10, 2);
+    scatter.add(1, 9, Vector3<T>(T(1)));
+    scatter.clear();
+    LUMINA_CHECK(scatter.empty() && scatter.size() == 0);
+    LUMINA_CHECK_THROWS(std::out_of_range, scatter.add(2, 0, Vector3<T>(T(1))));
+    LUMINA_CHECK_THROWS(std::out_of_range, scatter.add(0, 10, Vector3<T>(T(1))));
+    LUMINA_CHECK_THROWS(std::invalid_argument, BufferedScatterAdd<T>(10, 0));
+    LUMINA_CHECK_THROWS(std::length_error, BufferedScatterAdd<T>(std::size_t(UINT32_MAX) + 2, 1));
+}
+
+} // namespace
+
+int main()
+{
+    testAtomicAdd<float>();
+    testAtomicAdd<double>();
+    testBufferedScatterAdd<float>();
+    testBufferedScatterAdd<double>();
+    return test::finish();
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdio>
+
+// Assertions shared by the test executables. A failed check prints its location and expression and
+// keeps going, so one run reports every failure; main returns finish(), non-zero when any check failed.
+
+namespace lumina::test
+{
+
+    inline int &failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline bool check(bool passed, const char *expression, const char *file, int line)
+    {
+        if (!passed)
+        {
+            ++failures();
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+        }
+        return passed;
+    }
+
+    inline int finish()
+    {
+        if (failures() != 0)
+            std::fprintf(stderr, "%d check(s) failed\n", failures());
+        return failures() == 0 ? 0 : 1;
+    }
+
+} // namespace lumina::test
+
+#define LUMINA_CHECK(...) ::lumina::test::check(bool(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
+
+// Passes when the expression throws Exception (or a type derived from it)
+#define LUMINA_CHECK_THROWS(Exception, ...)                                                     \
+    do                                                                                          \
+    {                                                                                           \
+        bool thrown = false;                                                                    \
+        try                                                                                     \
+        {                                                                                       \
+            (void)(__VA_ARGS__);                                                                \
+        }                                                                                       \
+        catch (const Exception &)                                                               \
+        {                                                                                       \
+            thrown = true;                                                                      \
+        }                                                                                       \
+        ::lumina::test::check(thrown, #__VA_ARGS__ " throws " #Exception, __FILE__, __LINE__);  \
+    } while (false)
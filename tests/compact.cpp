@@ -0,0 +1,293 @@
+// Batch predicate masks and stream compaction against scalar loops: compare, withinDistance and
+// insideBounds per element, and compact / maskToIndices / countMask for every element type and
+// layout over empty, full, sparse and random masks.
+
+#include "check.hpp"
+#include <lumina/batch/compact.hpp>
+#include <lumina/batch/predicates.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+bool maskBit(const std::vector<std::uint64_t> &masks, std::size_t i)
+{
+    return masks[i / 64] >> (i % 64) & 1;
+}
+
+// Every bit agrees with `expected`, and bits past the count are cleared
+template <typename Expected>
+bool matchesMask(const std::vector<std::uint64_t> &masks, std::size_t count, Expected &&expected)
+{
+    bool matches = true;
+    for (std::size_t i = 0; i < count; ++i)
+        matches &= maskBit(masks, i) == expected(i);
+    if (count % 64 != 0)
+        matches &= masks.back() >> (count % 64) == 0;
+    return matches;
+}
+
+bool holds(Comparison comparison, double a, double b)
+{
+    switch (comparison)
+    {
+    case Comparison::Less:
+        return a < b;
+    case Comparison::LessEqual:
+        return a <= b;
+    case Comparison::Greater:
+        return a > b;
+    case Comparison::GreaterEqual:
+        return a >= b;
+    case Comparison::Equal:
+        return a == b;
+    case Comparison::NotEqual:
+        break;
+    }
+    return a != b;
+}
+
+template <typename T>
+void testCompare(std::mt19937_64 &engine)
+{
+    const T nan = std::numeric_limits<T>::quiet_NaN(), inf = std::numeric_limits<T>::infinity();
+    std::uniform_int_distribution<int> small(-4, 4);
+    for (std::size_t count : {std::size_t(1), std::size_t(64), std::size_t(77), std::size_t(1000)})
+    {
+        std::vector<T> values(count);
+        for (T &v : values)
+            v = T(small(engine)) * T(0.5);
+        values[0] = nan;
+        if (count > 3)
+        {
+            values[1] = inf;
+            values[2] = -inf;
+            values[3] = T(-0.0);
+        }
+        for (Comparison comparison : {Comparison::Less, Comparison::LessEqual, Comparison::Greater,
+                                      Comparison::GreaterEqual, Comparison::Equal, Comparison::NotEqual})
+        {
+            for (T threshold : {T(0), T(1), T(-1.5)})
+            {
+                std::vector<std::uint64_t> masks(maskWordCount(count), ~std::uint64_t(0));
+                compare(values.data(), count, comparison, threshold, masks.data());
+                LUMINA_CHECK(matchesMask(masks, count,
+                                         [&](std::size_t i) { return holds(comparison, values[i], threshold); }));
+            }
+        }
+    }
+}
+
+// Points on a half-integer grid, so squared distances to the integer center are exact and the
+// boundary cases compare the same with and without fused multiply-adds
+template <typename T>
+void testSpatialPredicates(std::mt19937_64 &engine)
+{
+    std::uniform_int_distribution<int> grid(-8, 8);
+    const Vector3<T> center(T(1), T(-2), T(0));
+    const T radius = T(2.5);
+    const Bounds3<T> box(Vector3<T>(T(-1), T(-2), T(-0.5)), Vector3<T>(T(2), T(1), T(3)));
+    for (std::size_t count : {std::size_t(3), std::size_t(64), std::size_t(1001)})
+    {
+        std::vector<Vector3<T>> points(count);
+        std::vector<Vector2<T>> flat(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            points[i] = Vector3<T>(T(grid(engine)) * T(0.5), T(grid(engine)) * T(0.5), T(grid(engine)) * T(0.5));
+            flat[i] = Vector2<T>(points[i].x, points[i].y);
+        }
+        points[0] = Vector3<T>(std::numeric_limits<T>::quiet_NaN(), T(0), T(0));
+        Vector3SoA<T> soa(points.data(), count);
+        StridedView<Vector3<T>> strided(points.data(), count);
+        std::vector<std::uint64_t> masks(maskWordCount(count));
+
+        auto within = [&](std::size_t i) { return (points[i] - center).sqrMagnitude() <= radius * radius; };
+        withinDistance(points.data(), count, center, radius, masks.data());
+        LUMINA_CHECK(matchesMask(masks, count, within));
+        withinDistance(strided, center, radius, masks.data());
+        LUMINA_CHECK(matchesMask(masks, count, within));
+        withinDistance(soa.view(), center, radius, masks.data());
+        LUMINA_CHECK(matchesMask(masks, count, within));
+
+        const Vector2<T> center2(center.x, center.y);
+        withinDistance(flat.data(), count, center2, radius, masks.data());
+        LUMINA_CHECK(matchesMask(masks, count, [&](std::size_t i)
+        {
+            return (flat[i] - center2).sqrMagnitude() <= radius * radius;
+        }));
+
+        auto inside = [&](std::size_t i) { return box.contains(points[i]); };
+        insideBounds(points.data(), count, box, masks.data());
+        LUMINA_CHECK(matchesMask(masks, count, inside));
+        insideBounds(strided, box, masks.data());
+        LUMINA_CHECK(matchesMask(masks, count, inside));
+        insideBounds(soa.view(), box, masks.data());
+        LUMINA_CHECK(matchesMask(masks, count, inside));
+    }
+}
+
+// Selected values in order, with their source indices
+template <typename V>
+std::size_t referenceCompact(const std::vector<V> &values, const std::vector<std::uint64_t> &masks, std::vector<V> &out,
+                             std::vector<std::uint32_t> &indices)
+{
+    out.clear();
+    indices.clear();
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        if (maskBit(masks, i))
+        {
+            out.push_back(values[i]);
+            indices.push_back(std::uint32_t(i));
+        }
+    }
+    return out.size();
+}
+
+template <typename V>
+bool samePrefix(const std::vector<V> &actual, const std::vector<V> &expected)
+{
+    return actual.size() >= expected.size() &&
+           std::memcmp(actual.data(), expected.data(), expected.size() * sizeof(V)) == 0;
+}
+
+template <typename V>
+void checkCompact(const std::vector<V> &values, const std::vector<std::uint64_t> &masks)
+{
+    std::size_t count = values.size();
+    std::vector<V> expected;
+    std::vector<std::uint32_t> expectedIndices;
+    std::size_t selected = referenceCompact(values, masks, expected, expectedIndices);
+
+    std::vector<V> out(count);
+    std::vector<std::uint32_t> indices(count);
+    LUMINA_CHECK(compact(values.data(), count, masks.data(), out.data(), indices.data()) == selected);
+    LUMINA_CHECK(samePrefix(out, expected) && samePrefix(indices, expectedIndices));
+
+    std::vector<V> valuesOnly(count);
+    LUMINA_CHECK(compact(values.data(), count, masks.data(), valuesOnly.data()) == selected);
+    LUMINA_CHECK(samePrefix(valuesOnly, expected));
+}
+
+template <typename T>
+void checkCompactLayouts(const std::vector<Vector3<T>> &values, const std::vector<std::uint64_t> &masks)
+{
+    std::size_t count = values.size();
+    std::vector<Vector3<T>> expected;
+    std::vector<std::uint32_t> expectedIndices;
+    std::size_t selected = referenceCompact(values, masks, expected, expectedIndices);
+
+    std::vector<Vector3<T>> out(count);
+    std::vector<std::uint32_t> indices(count);
+    LUMINA_CHECK(compact(StridedView<Vector3<T>>(values.data(), count), masks.data(), out.data(), indices.data()) ==
+                 selected);
+    LUMINA_CHECK(samePrefix(out, expected) && samePrefix(indices, expectedIndices));
+
+    Vector3SoA<T> soa(values.data(), count), soaOut(count);
+    LUMINA_CHECK(compact(soa.view(), masks.data(), soaOut.ref(), indices.data()) == selected);
+    bool matches = true;
+    for (std::size_t i = 0; i < selected; ++i)
+    {
+        Vector3<T> v = soaOut.get(i);
+        matches &= std::memcmp(&v, &expected[i], sizeof(v)) == 0;
+    }
+    LUMINA_CHECK(matches && samePrefix(indices, expectedIndices));
+
+    LUMINA_CHECK(maskToIndices(masks.data(), count, indices.data()) == selected);
+    LUMINA_CHECK(samePrefix(indices, expectedIndices));
+    LUMINA_CHECK(countMask(masks.data(), count) == selected);
+
+    Vector3SoA<T> shortOut(count + 1);
+    LUMINA_CHECK_THROWS(std::invalid_argument, compact(soa.view(), masks.data(), shortOut.ref()));
+}
+
+template <typename T>
+void testCompact(std::mt19937_64 &engine)
+{
+    std::uniform_real_distribution<T> coordinate(T(-10), T(10));
+    for (std::size_t count : {std::size_t(0), std::size_t(1), std::size_t(63), std::size_t(64), std::size_t(65),
+                              std::size_t(1003)})
+    {
+        std::vector<T> scalars(count);
+        std::vector<Vector2<T>> vectors2(count);
+        std::vector<Vector3<T>> vectors3(count);
+        std::vector<Vector4<T>> vectors4(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            scalars[i] = coordinate(engine);
+            vectors2[i] = Vector2<T>(coordinate(engine), coordinate(engine));
+            vectors3[i] = Vector3<T>(coordinate(engine), coordinate(engine), coordinate(engine));
+            vectors4[i] = Vector4<T>(coordinate(engine), coordinate(engine), coordinate(engine), coordinate(engine));
+        }
+
+        // None, all, every third element and random words; the random ones also carry garbage past
+        // the count, which every entry point must ignore
+        std::size_t words = maskWordCount(count);
+        std::vector<std::vector<std::uint64_t>> maskSets;
+        maskSets.emplace_back(words, 0);
+        maskSets.emplace_back(words, ~std::uint64_t(0));
+        if (count % 64 != 0)
+            maskSets.back().back() >>= 64 - count % 64;
+        maskSets.emplace_back(words, 0);
+        for (std::size_t i = 0; i < count; i += 3)
+            maskSets.back()[i / 64] |= std::uint64_t(1) << (i % 64);
+        maskSets.emplace_back(words);
+        for (std::uint64_t &word : maskSets.back())
+            word = engine();
+
+        for (std::vector<std::uint64_t> &masks : maskSets)
+        {
+            std::vector<std::uint64_t> clean = masks;
+            if (count % 64 != 0)
+                clean.back() &= (std::uint64_t(1) << (count % 64)) - 1;
+
+            // The references read clean masks; the library sees the originals
+            std::vector<std::uint32_t> expectedIndices, indices(count);
+            std::vector<T> expected, out(count);
+            std::size_t selected = referenceCompact(scalars, clean, expected, expectedIndices);
+            LUMINA_CHECK(compact(scalars.data(), count, masks.data(), out.data(), indices.data()) == selected);
+            LUMINA_CHECK(samePrefix(out, expected) && samePrefix(indices, expectedIndices));
+            LUMINA_CHECK(countMask(masks.data(), count) == selected);
+            LUMINA_CHECK(maskToIndices(masks.data(), count, indices.data()) == selected);
+            LUMINA_CHECK(samePrefix(indices, expectedIndices));
+
+            checkCompact(vectors2, clean);
+            checkCompact(vectors3, clean);
+            checkCompact(vectors4, clean);
+            checkCompactLayouts(vectors3, clean);
+        }
+    }
+
+    // Indices are 32-bit, so larger counts are refused before anything is read
+    const std::size_t tooMany = std::size_t(UINT32_MAX) + 2;
+    T value;
+    std::uint32_t index;
+    LUMINA_CHECK_THROWS(std::length_error, compact(&value, tooMany, nullptr, &value));
+    LUMINA_CHECK_THROWS(std::length_error, maskToIndices(nullptr, tooMany, &index));
+}
+
+template <typename T>
+void testPredicatesAndCompaction()
+{
+    std::mt19937_64 engine(35);
+    testCompare<T>(engine);
+    testSpatialPredicates<T>(engine);
+    testCompact<T>(engine);
+}
+
+} // namespace
+
+int main()
+{
+    testPredicatesAndCompaction<float>();
+    testPredicatesAndCompaction<double>();
+    return test::finish();
+}
@@ -0,0 +1,137 @@
+// Batch frustum culling against Frustum::containsPoint / intersectsSphere, through the SoA and
+// strided entry points, with counts that leave a partial pack at the end.
+
+#include "check.hpp"
+#include <lumina/batch/culling.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+// Interleaved vertex record for the strided overloads
+template <typename T>
+struct Record
+{
+    Vector3<T> center;
+    T radius;
+    T pad[3];
+};
+
+// A frustum whose planes are not axis aligned, so the kernels' plane distances round differently from
+// Plane::signedDistance; inputs within `margin` of a plane are redrawn
+template <typename T>
+Frustum<T> tiltedFrustum()
+{
+    return Frustum<T>(Plane<T>(T(2), T(0.5), T(0), T(2)), Plane<T>(T(-1), T(0), T(0.25), T(1)),
+                      Plane<T>(T(0), T(1), T(-0.5), T(1)), Plane<T>(T(0.25), T(-1), T(0), T(1)),
+                      Plane<T>(T(0), T(0), T(1), T(1)), Plane<T>(T(0), T(0.5), T(-1), T(1.5)));
+}
+
+template <typename T>
+bool nearPlane(const Frustum<T> &frustum, const Vector3<T> &point, T radius, T margin)
+{
+    for (const Plane<T> &plane : frustum.planes)
+    {
+        if (std::abs(plane.signedDistance(point) + radius) < margin)
+            return true;
+    }
+    return false;
+}
+
+template <typename T>
+void testFrustum(const Frustum<T> &frustum, std::size_t count)
+{
+    std::mt19937_64 engine(count);
+    std::uniform_real_distribution<T> coordinate(T(-3), T(3)), radius(T(0), T(1));
+
+    std::vector<Record<T>> records;
+    Vector3SoA<T> centers;
+    std::vector<T> radii;
+    while (records.size() < count)
+    {
+        Record<T> record{{coordinate(engine), coordinate(engine), coordinate(engine)}, radius(engine), {}};
+        T margin = T(1e-3);
+        if (nearPlane(frustum, record.center, T(0), margin) || nearPlane(frustum, record.center, record.radius, margin))
+            continue;
+        records.push_back(record);
+        centers.push_back(record.center);
+        radii.push_back(record.radius);
+    }
+
+    std::vector<std::uint32_t> expectedPoints, expectedSpheres;
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        if (frustum.containsPoint(records[i].center))
+            expectedPoints.push_back(i);
+        if (frustum.intersectsSphere(records[i].center, records[i].radius))
+            expectedSpheres.push_back(i);
+    }
+
+    StridedView<Vector3<T>> centerView(records.data(), count, sizeof(Record<T>), offsetof(Record<T>, center));
+    StridedView<T> radiusView(records.data(), count, sizeof(Record<T>), offsetof(Record<T>, radius));
+    std::vector<std::uint32_t> survivors(count);
+
+    survivors.resize(cullPoints(frustum, centers.view(), survivors.data()));
+    LUMINA_CHECK(survivors == expectedPoints);
+    survivors.assign(count, 0);
+    survivors.resize(cullPoints(frustum, centerView, survivors.data()));
+    LUMINA_CHECK(survivors == expectedPoints);
+
+    survivors.assign(count, 0);
+    survivors.resize(cullSpheres(frustum, centers.view(), radii.data(), survivors.data()));
+    LUMINA_CHECK(survivors == expectedSpheres);
+    survivors.assign(count, 0);
+    survivors.resize(cullSpheres(frustum, centerView, radiusView, survivors.data()));
+    LUMINA_CHECK(survivors == expectedSpheres);
+}
+
+template <typename T>
+void testCulling()
+{
+    for (std::size_t count : {0, 1, 7, 1003})
+    {
+        testFrustum(Frustum<T>(), count);
+        testFrustum(tiltedFrustum<T>(), count);
+    }
+
+    // Points exactly on the default cube's faces are inside
+    Vector3SoA<T> faces;
+    faces.push_back(Vector3<T>(T(1), T(0), T(0)));
+    faces.push_back(Vector3<T>(T(-1), T(1), T(-1)));
+    faces.push_back(Vector3<T>(T(0), T(0), T(1.5)));
+    std::uint32_t survivors[3];
+    LUMINA_CHECK(cullPoints(Frustum<T>(), faces.view(), survivors) == 2);
+    LUMINA_CHECK(survivors[0] == 0 && survivors[1] == 1);
+
+    // Strided centers and radii must agree in length
+    Record<T> records[2] = {};
+    StridedView<Vector3<T>> centers(records, 2, sizeof(Record<T>), offsetof(Record<T>, center));
+    StridedView<T> radii(records, 1, sizeof(Record<T>), offsetof(Record<T>, radius));
+    LUMINA_CHECK_THROWS(std::invalid_argument, cullSpheres(Frustum<T>(), centers, radii, survivors));
+
+    // More elements than 32-bit indices can name are rejected before anything is read
+    const std::size_t tooMany = std::size_t(UINT32_MAX) + 2;
+    Vector3SoAView<T> huge{nullptr, nullptr, nullptr, tooMany};
+    LUMINA_CHECK_THROWS(std::length_error, cullPoints(Frustum<T>(), huge, survivors));
+    LUMINA_CHECK_THROWS(std::length_error, cullSpheres(Frustum<T>(), huge, static_cast<const T *>(nullptr), survivors));
+    StridedView<Vector3<T>> hugeCenters(records, tooMany, sizeof(Record<T>), offsetof(Record<T>, center));
+    StridedView<T> hugeRadii(records, tooMany, sizeof(Record<T>), offsetof(Record<T>, radius));
+    LUMINA_CHECK_THROWS(std::length_error, cullPoints(Frustum<T>(), hugeCenters, survivors));
+    LUMINA_CHECK_THROWS(std::length_error, cullSpheres(Frustum<T>(), hugeCenters, hugeRadii, survivors));
+}
+
+} // namespace
+
+int main()
+{
+    testCulling<float>();
+    testCulling<double>();
+    return test::finish();
+}
@@ -0,0 +1,193 @@
+// Cubic segments, splines and arc-length tables over Vector2/3/4: control-point interpolation,
+// batch against scalar evaluation, parameter clamping and NaN rejection.
+
+#include "check.hpp"
+#include <lumina/curve/arc_length_table.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+template <typename V>
+using ScalarOf = typename CubicCurve<V>::Scalar;
+
+template <typename V>
+V point(ScalarOf<V> base)
+{
+    V v;
+    for (std::size_t k = 0; k < CubicCurve<V>::Dimension; ++k)
+        v[k] = base + ScalarOf<V>(k) * ScalarOf<V>(0.5);
+    return v;
+}
+
+template <typename V>
+bool near(const V &a, const V &b, ScalarOf<V> tolerance)
+{
+    for (std::size_t k = 0; k < CubicCurve<V>::Dimension; ++k)
+    {
+        if (!(std::abs(a[k] - b[k]) <= tolerance * (ScalarOf<V>(1) + std::abs(b[k]))))
+            return false;
+    }
+    return true;
+}
+
+template <typename V>
+void testSegments()
+{
+    using S = ScalarOf<V>;
+    const S eps = std::numeric_limits<S>::epsilon() * 16;
+    V p0 = point<V>(S(1)), p1 = point<V>(S(-2)), p2 = point<V>(S(4)), p3 = point<V>(S(0.25));
+
+    CubicCurve<V> bezier = CubicCurve<V>::bezier(p0, p1, p2, p3);
+    LUMINA_CHECK(near(bezier.evaluate(S(0)), p0, eps));
+    LUMINA_CHECK(near(bezier.evaluate(S(1)), p3, eps));
+    LUMINA_CHECK(near(bezier.evaluate(S(0.5)), (p0 + p1 * S(3) + p2 * S(3) + p3) / S(8), eps));
+    LUMINA_CHECK(near(bezier.derivative(S(0)), (p1 - p0) * S(3), eps));
+    LUMINA_CHECK(near(bezier.derivative(S(1)), (p3 - p2) * S(3), eps));
+    LUMINA_CHECK(near(bezier.secondDerivative(S(0)), (p0 - p1 * S(2) + p2) * S(6), eps));
+
+    CubicCurve<V> hermite = CubicCurve<V>::hermite(p0, p1, p2, p3);
+    LUMINA_CHECK(near(hermite.evaluate(S(0)), p0, eps) && near(hermite.evaluate(S(1)), p2, eps));
+    LUMINA_CHECK(near(hermite.derivative(S(0)), p1, eps) && near(hermite.derivative(S(1)), p3, eps));
+
+    CubicCurve<V> catmullRom = CubicCurve<V>::catmullRom(p0, p1, p2, p3, S(0.5));
+    LUMINA_CHECK(near(catmullRom.evaluate(S(0)), p1, eps) && near(catmullRom.evaluate(S(1)), p2, eps));
+    LUMINA_CHECK(near(catmullRom.derivative(S(0)), (p2 - p0) * S(0.5), eps));
+
+    // Batch evaluation, with a partial pack at the end
+    std::vector<S> t(37);
+    for (std::size_t i = 0; i < t.size(); ++i)
+        t[i] = S(i) / S(t.size() - 1);
+    std::vector<V> values(t.size()), slopes(t.size());
+    bezier.evaluate(t.data(), t.size(), values.data());
+    bezier.derivative(t.data(), t.size(), slopes.data());
+    for (std::size_t i = 0; i < t.size(); ++i)
+    {
+        LUMINA_CHECK(near(values[i], bezier.evaluate(t[i]), eps));
+        LUMINA_CHECK(near(slopes[i], bezier.derivative(t[i]), eps));
+    }
+}
+
+template <typename V>
+void testSplines()
+{
+    using S = ScalarOf<V>;
+    const S eps = std::numeric_limits<S>::epsilon() * 16;
+    std::vector<V> points = {point<V>(S(0)), point<V>(S(2)), point<V>(S(-1)), point<V>(S(3)), point<V>(S(1))};
+
+    CubicSpline<V> spline = CubicSpline<V>::catmullRom(points.data(), points.size());
+    LUMINA_CHECK(spline.segmentCount() == points.size() - 1);
+    for (std::size_t i = 0; i < points.size(); ++i)
+        LUMINA_CHECK(near(spline.evaluate(S(i)), points[i], eps));
+
+    // Out-of-range parameters clamp to the ends
+    LUMINA_CHECK(near(spline.evaluate(S(-3)), points.front(), eps));
+    LUMINA_CHECK(near(spline.evaluate(S(100)), points.back(), eps));
+    LUMINA_CHECK(near(spline.evaluate(std::numeric_limits<S>::infinity()), points.back(), eps));
+
+    // Unsorted batch parameters, crossing segments and both ends
+    std::mt19937_64 engine(29);
+    std::uniform_real_distribution<S> parameter(S(-0.5), S(4.5));
+    std::vector<S> u(301);
+    for (S &value : u)
+        value = parameter(engine);
+    std::vector<V> values(u.size()), slopes(u.size());
+    spline.evaluate(u.data(), u.size(), values.data());
+    spline.derivative(u.data(), u.size(), slopes.data());
+    for (std::size_t i = 0; i < u.size(); ++i)
+    {
+        LUMINA_CHECK(near(values[i], spline.evaluate(u[i]), eps));
+        LUMINA_CHECK(near(slopes[i], spline.derivative(u[i]), eps));
+    }
+
+    // Bezier splines share end points between segments
+    std::vector<V> controls = {point<V>(S(0)), point<V>(S(1)), point<V>(S(2)), point<V>(S(3)),
+                               point<V>(S(5)), point<V>(S(4)), point<V>(S(6))};
+    CubicSpline<V> bezier = CubicSpline<V>::bezier(controls.data(), controls.size());
+    LUMINA_CHECK(bezier.segmentCount() == 2);
+    LUMINA_CHECK(near(bezier.evaluate(S(1)), controls[3], eps) && near(bezier.evaluate(S(2)), controls[6], eps));
+
+    std::vector<V> tangents = {point<V>(S(1)), point<V>(S(-1)), point<V>(S(2))};
+    CubicSpline<V> hermite = CubicSpline<V>::hermite(points.data(), tangents.data(), tangents.size());
+    LUMINA_CHECK(hermite.segmentCount() == 2);
+    LUMINA_CHECK(near(hermite.derivative(S(1)), tangents[1], eps));
+
+    // Construction and evaluation errors
+    const S nan = std::numeric_limits<S>::quiet_NaN();
+    LUMINA_CHECK_THROWS(std::invalid_argument, CubicSpline<V>::catmullRom(points.data(), 1));
+    LUMINA_CHECK_THROWS(std::invalid_argument, CubicSpline<V>::bezier(controls.data(), 6));
+    LUMINA_CHECK_THROWS(std::invalid_argument, spline.evaluate(nan));
+    LUMINA_CHECK_THROWS(std::invalid_argument, spline.derivative(nan));
+    u[200] = nan;
+    LUMINA_CHECK_THROWS(std::invalid_argument, spline.evaluate(u.data(), u.size(), values.data()));
+    LUMINA_CHECK_THROWS(std::out_of_range, CubicSpline<V>().evaluate(S(0)));
+}
+
+// A Hermite segment with zero end tangents runs along a straight line with smoothstep speed, so the
+// arc length is known exactly: 5 * (3u^2 - 2u^3) for a segment of length 5
+template <typename V>
+void testArcLength()
+{
+    using S = ScalarOf<V>;
+    V start = V(), end = V();
+    end[0] = S(3);
+    end[1] = S(4);
+    CubicSpline<V> spline({CubicCurve<V>::hermite(start, V(), end, V())});
+    ArcLengthTable<V> table(spline, 16);
+
+    const S tolerance = S(1e-5);
+    LUMINA_CHECK(std::abs(table.totalLength() - S(5)) <= tolerance);
+    for (int s = 0; s <= 16; ++s)
+    {
+        S u = S(s) / S(16);
+        S exact = S(5) * (S(3) * u * u - S(2) * u * u * u);
+        LUMINA_CHECK(std::abs(table.lengthAt(u) - exact) <= tolerance);
+        LUMINA_CHECK(std::abs(table.parameterAt(exact) - u) <= S(1e-4));
+    }
+    LUMINA_CHECK(table.lengthAt(S(-1)) == S(0) && table.lengthAt(S(2)) == table.totalLength());
+    LUMINA_CHECK(table.parameterAt(S(-1)) == S(0) && table.parameterAt(S(6)) == S(1));
+
+    std::vector<S> distances = {S(0), S(0.5), S(2.5), S(2.5), S(4.9), S(7)}, parameters(distances.size());
+    table.parametersAt(distances.data(), distances.size(), parameters.data());
+    for (std::size_t i = 0; i < distances.size(); ++i)
+        LUMINA_CHECK(parameters[i] == table.parameterAt(distances[i]));
+    LUMINA_CHECK(std::abs(parameters[2] - S(0.5)) <= S(1e-4));
+
+    const S nan = std::numeric_limits<S>::quiet_NaN();
+    LUMINA_CHECK_THROWS(std::invalid_argument, table.lengthAt(nan));
+    LUMINA_CHECK_THROWS(std::invalid_argument, table.parameterAt(nan));
+    distances[3] = nan;
+    LUMINA_CHECK_THROWS(std::invalid_argument, table.parametersAt(distances.data(), distances.size(),
+                                                                  parameters.data()));
+}
+
+template <typename V>
+void testCurves()
+{
+    testSegments<V>();
+    testSplines<V>();
+    testArcLength<V>();
+}
+
+} // namespace
+
+int main()
+{
+    testCurves<Vector2<float>>();
+    testCurves<Vector2<double>>();
+    testCurves<Vector3<float>>();
+    testCurves<Vector3<double>>();
+    testCurves<Vector4<float>>();
+    testCurves<Vector4<double>>();
+    return test::finish();
+}
@@ -0,0 +1,267 @@
+// The 2D queries against brute-force references in exact integer arithmetic: convex hulls against
+// a gift-wrapping walk, nonzero winding against a per-edge count, and segment tests against
+// orientation and on-segment checks. Coordinates are small integers, so every cross product the
+// library forms is exact and the answers must agree everywhere except where the contract leaves
+// a choice (points on a polygon edge).
+
+#include "check.hpp"
+#include <lumina/geometry/geometry2d.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+using Wide = long double;
+
+template <typename T>
+std::int64_t cross(const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c)
+{
+    return (std::int64_t(b.x) - std::int64_t(a.x)) * (std::int64_t(c.y) - std::int64_t(a.y)) -
+           (std::int64_t(b.y) - std::int64_t(a.y)) * (std::int64_t(c.x) - std::int64_t(a.x));
+}
+
+template <typename T>
+std::int64_t squaredDistance(const Vector2<T> &a, const Vector2<T> &b)
+{
+    std::int64_t dx = std::int64_t(b.x) - std::int64_t(a.x), dy = std::int64_t(b.y) - std::int64_t(a.y);
+    return dx * dx + dy * dy;
+}
+
+template <typename T>
+bool lexicographicLess(const Vector2<T> &a, const Vector2<T> &b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+template <typename T>
+std::vector<Vector2<T>> integerPoints(std::mt19937_64 &engine, std::size_t count, int range)
+{
+    std::uniform_int_distribution<int> coordinate(-range, range);
+    std::vector<Vector2<T>> points(count);
+    for (Vector2<T> &p : points)
+        p = Vector2<T>(T(coordinate(engine)), T(coordinate(engine)));
+    return points;
+}
+
+// Jarvis march from the lowest (x, y) point: the next vertex has no point strictly to its right,
+// the farthest one when several are collinear, so collinear points never become vertices
+template <typename T>
+std::vector<Vector2<T>> giftWrap(const std::vector<Vector2<T>> &points)
+{
+    if (points.empty())
+        return {};
+    Vector2<T> start = *std::min_element(points.begin(), points.end(), lexicographicLess<T>);
+    std::vector<Vector2<T>> hull{start};
+    Vector2<T> current = start;
+    while (true)
+    {
+        Vector2<T> next = current;
+        for (const Vector2<T> &p : points)
+        {
+            if (p == current)
+                continue;
+            std::int64_t turn = next == current ? -1 : cross(current, next, p);
+            if (turn < 0 || (turn == 0 && squaredDistance(current, p) > squaredDistance(current, next)))
+                next = p;
+        }
+        if (next == start || next == current)
+            return hull;
+        hull.push_back(next);
+        current = next;
+    }
+}
+
+template <typename T>
+void testConvexHull(std::mt19937_64 &engine)
+{
+    // A wide range gives few collinear hull points, a narrow one many, and the square crowds onto its edges
+    for (int range : {3, 20, 1000})
+    {
+        for (std::size_t count : {std::size_t(0), std::size_t(1), std::size_t(2), std::size_t(3), std::size_t(10),
+                                  std::size_t(500), std::size_t(100000)})
+        {
+            std::vector<Vector2<T>> points = integerPoints<T>(engine, count, range);
+            std::vector<Vector2<T>> hull = convexHull(points.data(), count, 1);
+            LUMINA_CHECK(hull == giftWrap(points));
+            LUMINA_CHECK(convexHull(points.data(), count, 4) == hull);
+        }
+    }
+
+    // Duplicates collapse to one point and collinear runs to their ends
+    std::vector<Vector2<T>> same(50, Vector2<T>(T(2), T(-1)));
+    LUMINA_CHECK(convexHull(same.data(), same.size()) == std::vector<Vector2<T>>{Vector2<T>(T(2), T(-1))});
+    std::vector<Vector2<T>> line;
+    for (int i = 10; i >= -10; --i)
+        line.emplace_back(T(i), T(2 * i));
+    line.push_back(line[3]);
+    LUMINA_CHECK(convexHull(line.data(), line.size()) ==
+                 (std::vector<Vector2<T>>{Vector2<T>(T(-10), T(-20)), Vector2<T>(T(10), T(20))}));
+    std::vector<Vector2<T>> square;
+    for (int i = 0; i <= 4; ++i)
+        for (int j = 0; j <= 4; ++j)
+            square.emplace_back(T(i), T(j));
+    LUMINA_CHECK(convexHull(square.data(), square.size()) ==
+                 (std::vector<Vector2<T>>{Vector2<T>(T(0), T(0)), Vector2<T>(T(4), T(0)), Vector2<T>(T(4), T(4)),
+                                          Vector2<T>(T(0), T(4))}));
+}
+
+// Point on the closed segment [a, b]
+template <typename T>
+bool onSegment(const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &p)
+{
+    return cross(a, b, p) == 0 && std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) &&
+           std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+}
+
+// Signed crossings of the edges with the ray from p towards +x: upward edges passing left of p
+// count one, downward edges passing right of it minus one
+template <typename T>
+int windingNumber(const std::vector<Vector2<T>> &polygon, const Vector2<T> &p)
+{
+    int winding = 0;
+    for (std::size_t e = 0; e < polygon.size(); ++e)
+    {
+        const Vector2<T> &a = polygon[e], &b = polygon[(e + 1) % polygon.size()];
+        if (a.y <= p.y && b.y > p.y && cross(a, b, p) > 0)
+            ++winding;
+        else if (a.y > p.y && b.y <= p.y && cross(a, b, p) < 0)
+            --winding;
+    }
+    return winding;
+}
+
+template <typename T>
+void testInsidePolygon(std::mt19937_64 &engine)
+{
+    // A convex hexagon, a pentagram whose core winds twice, a random self-intersecting polygon, and
+    // each of them reversed
+    std::vector<std::vector<Vector2<T>>> polygons{
+        {{T(-8), T(-4)}, {T(0), T(-9)}, {T(8), T(-4)}, {T(8), T(4)}, {T(0), T(9)}, {T(-8), T(4)}},
+        {{T(0), T(10)}, {T(6), T(-8)}, {T(-10), T(3)}, {T(10), T(3)}, {T(-6), T(-8)}},
+        integerPoints<T>(engine, 17, 10)};
+    for (std::size_t k = 0, n = polygons.size(); k < n; ++k)
+        polygons.emplace_back(polygons[k].rbegin(), polygons[k].rend());
+
+    for (const std::vector<Vector2<T>> &polygon : polygons)
+    {
+        for (std::size_t count : {std::size_t(1), std::size_t(63), std::size_t(64), std::size_t(65),
+                                  std::size_t(5000)})
+        {
+            std::vector<Vector2<T>> points = integerPoints<T>(engine, count, 12);
+            std::vector<std::uint64_t> masks(maskWordCount(count), ~std::uint64_t(0)), threaded(masks.size());
+            insidePolygon(points.data(), count, polygon.data(), polygon.size(), masks.data(), 1);
+            insidePolygon(points.data(), count, polygon.data(), polygon.size(), threaded.data(), 4);
+            LUMINA_CHECK(masks == threaded);
+
+            bool matches = true;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                bool boundary = false;
+                for (std::size_t e = 0; e < polygon.size(); ++e)
+                    boundary |= onSegment(polygon[e], polygon[(e + 1) % polygon.size()], points[i]);
+                if (!boundary)
+                    matches &= bool(masks[i / 64] >> (i % 64) & 1) == (windingNumber(polygon, points[i]) != 0);
+            }
+            if (count % 64 != 0)
+                matches &= masks.back() >> (count % 64) == 0;
+            LUMINA_CHECK(matches);
+        }
+    }
+
+    // The pentagram's core is inside under the nonzero rule, unlike even-odd
+    std::uint64_t mask = 0;
+    Vector2<T> center(T(0), T(0));
+    insidePolygon(&center, 1, polygons[1].data(), polygons[1].size(), &mask);
+    LUMINA_CHECK(mask == 1 && std::abs(windingNumber(polygons[1], center)) == 2);
+    LUMINA_CHECK_THROWS(std::invalid_argument, insidePolygon(&center, 1, polygons[0].data(), 2, &mask));
+}
+
+template <typename T>
+bool intersectsExactly(const Vector2<T> &p0, const Vector2<T> &p1, const Vector2<T> &q0, const Vector2<T> &q1)
+{
+    std::int64_t d1 = cross(q0, q1, p0), d2 = cross(q0, q1, p1), d3 = cross(p0, p1, q0), d4 = cross(p0, p1, q1);
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0)))
+        return true;
+    return onSegment(q0, q1, p0) || onSegment(q0, q1, p1) || onSegment(p0, p1, q0) || onSegment(p0, p1, q1);
+}
+
+template <typename T>
+void testSegments(std::mt19937_64 &engine)
+{
+    // A small grid makes touching, collinear and degenerate (point) segments common
+    for (int range : {2, 6, 500})
+    {
+        for (std::size_t count : {std::size_t(1), std::size_t(7), std::size_t(64), std::size_t(3001)})
+        {
+            std::vector<Vector2<T>> p0 = integerPoints<T>(engine, count, range);
+            std::vector<Vector2<T>> p1 = integerPoints<T>(engine, count, range);
+            std::vector<Vector2<T>> q0 = integerPoints<T>(engine, count, range);
+            std::vector<Vector2<T>> q1 = integerPoints<T>(engine, count, range);
+            std::vector<std::uint64_t> masks(maskWordCount(count), ~std::uint64_t(0));
+            segmentsIntersect(p0.data(), p1.data(), q0.data(), q1.data(), count, masks.data());
+
+            bool batchMatches = true, scalarMatches = true, crossingMatches = true;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                bool expected = intersectsExactly(p0[i], p1[i], q0[i], q1[i]);
+                batchMatches &= bool(masks[i / 64] >> (i % 64) & 1) == expected;
+                scalarMatches &= segmentsIntersect(p0[i], p1[i], q0[i], q1[i]) == expected;
+                scalarMatches &= segmentsIntersect(q1[i], q0[i], p0[i], p1[i]) == expected;
+
+                // The crossing point of non-parallel segments, against the exact rational solution
+                Vector2<T> r = p1[i] - p0[i], s = q1[i] - q0[i];
+                std::int64_t denominator =
+                    std::int64_t(r.x) * std::int64_t(s.y) - std::int64_t(r.y) * std::int64_t(s.x);
+                Vector2<T> point(T(0));
+                bool found = segmentIntersection(p0[i], p1[i], q0[i], q1[i], point);
+                crossingMatches &= found == (expected && denominator != 0);
+                if (found && denominator != 0)
+                {
+                    Vector2<T> offset = q0[i] - p0[i];
+                    Wide t = (Wide(offset.x) * s.y - Wide(offset.y) * s.x) / Wide(denominator);
+                    Wide x = p0[i].x + t * r.x, y = p0[i].y + t * r.y;
+                    Wide tolerance = 8 * Wide(std::numeric_limits<T>::epsilon()) * Wide(range);
+                    crossingMatches &= std::abs(point.x - x) <= tolerance && std::abs(point.y - y) <= tolerance;
+                }
+            }
+            if (count % 64 != 0)
+                batchMatches &= masks.back() >> (count % 64) == 0;
+            LUMINA_CHECK(batchMatches && scalarMatches && crossingMatches);
+        }
+    }
+
+    // Collinear segments meet when they overlap or touch end to end, not across a gap
+    const Vector2<T> a(T(0), T(0)), b(T(2), T(2)), c(T(3), T(3)), d(T(4), T(4));
+    Vector2<T> point;
+    LUMINA_CHECK(segmentsIntersect(a, c, b, d) && segmentsIntersect(a, b, b, d) && !segmentsIntersect(a, b, c, d));
+    LUMINA_CHECK(!segmentIntersection(a, c, b, d, point));
+    LUMINA_CHECK(segmentIntersection(a, d, Vector2<T>(T(0), T(4)), Vector2<T>(T(4), T(0)), point) &&
+                 point == b);
+}
+
+template <typename T>
+void testGeometry2d()
+{
+    std::mt19937_64 engine(43);
+    testConvexHull<T>(engine);
+    testInsidePolygon<T>(engine);
+    testSegments<T>(engine);
+}
+
+} // namespace
+
+int main()
+{
+    testGeometry2d<float>();
+    testGeometry2d<double>();
+    return test::finish();
+}
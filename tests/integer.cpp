@@ -0,0 +1,355 @@
+// Fixed16 / Fixed32 against 128-bit integer references (saturation at both ends, rounding of
+// products, quotients and conversions, sqrt and acos), the wrapping and saturating rules of the
+// integer ScalarTraits, and the integer batch kernels against the scalar Vector code bit for bit.
+
+#include "check.hpp"
+#include <lumina/batch/integer.hpp>
+#include <lumina/numeric/fixed.hpp>
+#include <lumina/numeric/scalar_traits.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+__extension__ typedef __int128 Int128;
+__extension__ typedef unsigned __int128 UInt128;
+
+template <typename Raw>
+Raw clampTo(Int128 value)
+{
+    return Raw(std::clamp(value, Int128(std::numeric_limits<Raw>::min()), Int128(std::numeric_limits<Raw>::max())));
+}
+
+// Quotient rounded toward negative infinity
+Int128 floorDivide(Int128 a, Int128 b)
+{
+    Int128 q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+// Both extremes, their neighbours, +-1 in raw units and in whole units, then random values over the
+// full range and over a small range where products do not saturate
+template <typename Raw>
+std::vector<Raw> raws(std::mt19937_64 &engine, int fractionBits)
+{
+    const Raw max = std::numeric_limits<Raw>::max(), min = std::numeric_limits<Raw>::min();
+    const Raw one = Raw(1) << fractionBits;
+    std::vector<Raw> values{min, Raw(min + 1), Raw(-one), -1, 0, 1, one, Raw(max - 1), max};
+    std::uniform_int_distribution<Raw> full(min, max), small(Raw(-16) * one, Raw(16) * one);
+    for (int i = 0; i < 150; ++i)
+        values.push_back(i % 2 ? full(engine) : small(engine));
+    return values;
+}
+
+template <typename F>
+void testFixedArithmetic(std::mt19937_64 &engine)
+{
+    using Raw = typename F::RawType;
+    constexpr int bits = F::fractionBits;
+    std::vector<Raw> values = raws<Raw>(engine, bits);
+    bool matches = true;
+    for (Raw a : values)
+    {
+        F fa = F::fromRaw(a);
+        matches &= (-fa).raw == clampTo<Raw>(-Int128(a)) && abs(fa).raw == clampTo<Raw>(a < 0 ? -Int128(a) : a);
+        for (Raw b : values)
+        {
+            F fb = F::fromRaw(b);
+            matches &= (fa + fb).raw == clampTo<Raw>(Int128(a) + b);
+            matches &= (fa - fb).raw == clampTo<Raw>(Int128(a) - b);
+            matches &= (fa * fb).raw == clampTo<Raw>(floorDivide(Int128(a) * b, Int128(1) << bits));
+            Raw quotient = b != 0 ? clampTo<Raw>((Int128(a) << bits) / b) : (a > 0 ? F::max().raw : F::min().raw);
+            matches &= (fa / fb).raw == (a == 0 && b == 0 ? 0 : quotient);
+            matches &= (fa < fb) == (a < b) && (fa == fb) == (a == b);
+
+            F compound = fa;
+            compound *= fb;
+            compound -= fa;
+            matches &= compound == fa * fb - fa;
+        }
+    }
+    LUMINA_CHECK(matches);
+}
+
+template <typename F>
+void testFixedConversions()
+{
+    using Raw = typename F::RawType;
+    constexpr int bits = F::fractionBits;
+    constexpr Raw max = std::numeric_limits<Raw>::max(), min = std::numeric_limits<Raw>::min();
+    const double unit = std::ldexp(1.0, -bits);
+
+    // Floating point rounds to nearest with ties away from zero, saturates, and maps NaN to 0
+    LUMINA_CHECK(F(0.5 * unit).raw == 1 && F(-0.5 * unit).raw == -1 && F(0.49 * unit).raw == 0);
+    LUMINA_CHECK(F(1.5 * unit).raw == 2 && F(-2.5 * unit).raw == -3 && F(-0.0).raw == 0);
+    LUMINA_CHECK(F(1.25f).raw == Raw(5) << (bits - 2) && F(-3.0).raw == Raw(-3) * (Raw(1) << bits));
+    LUMINA_CHECK(F(1e30).raw == max && F(-1e30).raw == min);
+    LUMINA_CHECK(F(std::numeric_limits<double>::infinity()).raw == max);
+    LUMINA_CHECK(F(-std::numeric_limits<float>::infinity()).raw == min);
+    LUMINA_CHECK(F(std::numeric_limits<double>::quiet_NaN()).raw == 0);
+
+    // Integers saturate at the whole-number range
+    constexpr Raw limit = max >> bits;
+    LUMINA_CHECK(F(limit).raw == Raw(limit) * (Raw(1) << bits) && F(limit + 1).raw == max);
+    LUMINA_CHECK(F(-limit - 1).raw == min && F(Raw(-limit - 2)).raw == min);
+    LUMINA_CHECK(F(std::numeric_limits<std::uint64_t>::max()).raw == max &&
+                 F(std::int8_t(-7)).raw == Raw(-7) * (Raw(1) << bits));
+
+    // toInt rounds down, and the conversion to double is exact for 32-bit raws
+    LUMINA_CHECK(F::fromRaw(-1).toInt() == -1 && F::fromRaw(1).toInt() == 0 && F(-2.5).toInt() == -3);
+    for (Raw raw : {min, Raw(-12345), Raw(0), Raw(1), Raw(987654321), max})
+    {
+        double value = double(F::fromRaw(raw));
+        LUMINA_CHECK(value == double(std::ldexp((long double)raw, -bits)));
+        if (sizeof(Raw) == 4)
+            LUMINA_CHECK(F(value).raw == raw);
+    }
+    LUMINA_CHECK(F::epsilon().raw == 1 && F::max().raw == max && F::min().raw == min);
+}
+
+template <typename F>
+void testFixedFunctions(std::mt19937_64 &engine)
+{
+    using Raw = typename F::RawType;
+    constexpr int bits = F::fractionBits;
+    bool sqrtMatches = true, acosMatches = true;
+
+    // sqrt rounds down: r^2 <= v 2^bits < (r + 1)^2 in raw units
+    for (Raw v : raws<Raw>(engine, bits))
+    {
+        Raw r = sqrt(F::fromRaw(v)).raw;
+        if (v <= 0)
+        {
+            sqrtMatches &= r == 0;
+            continue;
+        }
+        UInt128 scaled = UInt128(v) << bits, root = UInt128(r);
+        sqrtMatches &= root * root <= scaled && (root + 1) * (root + 1) > scaled;
+    }
+
+    // acos is accurate to about 2^-30, then rounded to the raw unit; outside [-1, 1] it clamps
+    const long double tolerance = std::ldexp(1.0L, -29) + std::ldexp(1.0L, -bits - 1);
+    std::uniform_int_distribution<Raw> cosine(-(Raw(1) << bits), Raw(1) << bits);
+    for (int i = 0; i < 2000; ++i)
+    {
+        Raw c = i < 3 ? Raw(i - 1) << bits : cosine(engine);
+        long double expected = std::acos(std::ldexp((long double)c, -bits));
+        acosMatches &= std::abs(std::ldexp((long double)acos(F::fromRaw(c)).raw, -bits) - expected) <= tolerance;
+    }
+    LUMINA_CHECK(sqrtMatches && acosMatches);
+    LUMINA_CHECK(acos(F(2)) == acos(F(1)) && acos(F::min()) == acos(F(-1)));
+
+    bool isqrtMatches = true;
+    std::uniform_int_distribution<std::uint64_t> full;
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::uint64_t v = i == 0 ? ~std::uint64_t(0) : (i < 100 ? std::uint64_t(i) : full(engine) >> (i % 64));
+        UInt128 r = isqrt(v);
+        isqrtMatches &= r * r <= v && (r + 1) * (r + 1) > v;
+    }
+    LUMINA_CHECK(isqrtMatches);
+}
+
+// Integer vectors wrap like the batch kernels, abs and magnitudes saturate, and fixed-point
+// magnitudes keep the fraction bits of the squares
+void testIntegerTraits()
+{
+    constexpr int max = std::numeric_limits<int>::max(), min = std::numeric_limits<int>::min();
+    using Traits = ScalarTraits<int>;
+    LUMINA_CHECK(Traits::add(max, 1) == min && Traits::sub(min, 1) == max && Traits::mul(max, 2) == -2);
+    LUMINA_CHECK(Traits::negate(min) == min && Traits::div(min, -1) == min && Traits::div(-7, 2) == -3);
+    LUMINA_CHECK(Traits::abs(min) == max && Traits::abs(-5) == 5 && Traits::sqrt(-4) == 0 && Traits::sqrt(99) == 9);
+    LUMINA_CHECK(Traits::approxEqual(min, max, max) == false && Traits::approxEqual(-3, 4, 7));
+    LUMINA_CHECK(!Traits::approxEqual(1, 1, -1));
+
+    LUMINA_CHECK((Vector3<int>(max, 1, min) + Vector3<int>(1, 1, -1)) == Vector3<int>(min, 2, max));
+    LUMINA_CHECK(Vector3<int>(min, min, min).magnitude() == max && Vector2<int>(3, -4).magnitude() == 5);
+    LUMINA_CHECK(Vector4<int>(1, 2, 3, 4).sqrMagnitude() == 30 && Vector3<int>(2, 3, 6).magnitude() == 7);
+
+    constexpr std::int64_t max64 = std::numeric_limits<std::int64_t>::max();
+    LUMINA_CHECK(Vector3<std::int64_t>(max64, max64, 0).magnitude() == max64);
+    LUMINA_CHECK(Vector2<std::int64_t>(3000000000, 4000000000).magnitude() == 5000000000);
+
+    // (3/65536, 4/65536) squares to less than the raw unit, but its length is still 5/65536
+    LUMINA_CHECK(Vector2<Fixed16>(Fixed16::fromRaw(3), Fixed16::fromRaw(4)).magnitude().raw == 5);
+    LUMINA_CHECK(Vector3<Fixed16>(Fixed16::max()).magnitude() == Fixed16::max());
+    LUMINA_CHECK(Vector3<Fixed32>(Fixed32(2), Fixed32(3), Fixed32(6)).magnitude() == Fixed32(7));
+}
+
+template <typename V>
+bool sameBits(const std::vector<V> &a, const std::vector<V> &b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(V)) == 0;
+}
+
+template <typename T>
+T component(std::mt19937_64 &engine, std::size_t i)
+{
+    std::uniform_int_distribution<std::int32_t> full(std::numeric_limits<std::int32_t>::min(),
+                                                     std::numeric_limits<std::int32_t>::max()),
+        small(-1000000, 1000000);
+    std::int32_t raw = i % 5 == 0 ? full(engine) : small(engine);
+    if constexpr (std::is_same_v<T, int>)
+        return raw;
+    else
+        return T::fromRaw(raw);
+}
+
+template <typename V, typename T>
+std::vector<V> integerVectors(std::mt19937_64 &engine, std::size_t count)
+{
+    std::vector<V> vectors(count);
+    for (std::size_t i = 0; i < count; ++i)
+        for (std::size_t k = 0; k < sizeof(V) / sizeof(T); ++k)
+            vectors[i][int(k)] = component<T>(engine, i + k);
+    return vectors;
+}
+
+template <typename V, typename T>
+void testComponentKernels(std::mt19937_64 &engine)
+{
+    for (std::size_t count : {std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(8), std::size_t(9),
+                              std::size_t(33), std::size_t(1001)})
+    {
+        std::vector<V> a = integerVectors<V, T>(engine, count), b = integerVectors<V, T>(engine, count);
+        std::vector<V> out(count), sum(count), difference(count), product(count), low(count), high(count);
+        std::vector<T> dots(count), expectedDots(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sum[i] = a[i] + b[i];
+            difference[i] = a[i] - b[i];
+            product[i] = a[i] * b[i];
+            low[i] = V::min(a[i], b[i]);
+            high[i] = V::max(a[i], b[i]);
+            expectedDots[i] = V::dot(a[i], b[i]);
+        }
+
+        addBatch(a.data(), b.data(), out.data(), count);
+        LUMINA_CHECK(sameBits(out, sum));
+        subBatch(a.data(), b.data(), out.data(), count);
+        LUMINA_CHECK(sameBits(out, difference));
+        mulBatch(a.data(), b.data(), out.data(), count);
+        LUMINA_CHECK(sameBits(out, product));
+        minBatch(a.data(), b.data(), out.data(), count);
+        LUMINA_CHECK(sameBits(out, low));
+        maxBatch(a.data(), b.data(), out.data(), count);
+        LUMINA_CHECK(sameBits(out, high));
+        dotBatch(a.data(), b.data(), dots.data(), count);
+        LUMINA_CHECK(sameBits(dots, expectedDots));
+
+        // Outputs may alias either input
+        std::vector<V> inPlace = a;
+        subBatch(inPlace.data(), b.data(), inPlace.data(), count);
+        LUMINA_CHECK(sameBits(inPlace, difference));
+        inPlace = b;
+        mulBatch(a.data(), inPlace.data(), inPlace.data(), count);
+        LUMINA_CHECK(sameBits(inPlace, product));
+    }
+}
+
+// The documented estimate evaluated in 64-bit arithmetic and saturated once at the end
+std::int32_t referenceEstimate(std::int32_t *components, int dimension)
+{
+    std::int64_t m[3] = {0, 0, 0};
+    for (int k = 0; k < dimension; ++k)
+        m[k] = std::min<std::int64_t>(std::abs(std::int64_t(components[k])), std::numeric_limits<std::int32_t>::max());
+    std::sort(m, m + dimension, std::greater<>());
+    std::int64_t hi = m[0], mid = m[1], lo = dimension == 3 ? m[2] : 0;
+    std::int64_t estimate = dimension == 2 ? hi - (hi >> 3) + (mid >> 1) + (mid >> 5)
+                                           : hi - (hi >> 3) - (hi >> 5) + (mid >> 1) + (mid >> 5) + (lo >> 2) +
+                                                 (lo >> 5);
+    return std::int32_t(std::min<std::int64_t>(std::max(hi, estimate), std::numeric_limits<std::int32_t>::max()));
+}
+
+template <typename T>
+std::int32_t rawOf(T value)
+{
+    if constexpr (std::is_same_v<T, int>)
+        return value;
+    else
+        return value.raw;
+}
+
+template <typename T>
+void testApproxMagnitude(std::mt19937_64 &engine)
+{
+    constexpr std::size_t count = 1003;
+    std::vector<Vector2<T>> flat = integerVectors<Vector2<T>, T>(engine, count);
+    std::vector<Vector3<T>> vectors = integerVectors<Vector3<T>, T>(engine, count);
+    const std::int32_t min = std::numeric_limits<std::int32_t>::min();
+    if constexpr (std::is_same_v<T, int>)
+        vectors[0] = Vector3<T>(min, min, min);
+    else
+        vectors[0] = Vector3<T>(T::min());
+    std::vector<T> out(count);
+
+    approxMagnitudeBatch(flat.data(), out.data(), count);
+    bool matches = true, bounded = true;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::int32_t c[2] = {rawOf(flat[i].x), rawOf(flat[i].y)};
+        matches &= rawOf(out[i]) == referenceEstimate(c, 2);
+        long double exact = std::hypot((long double)c[0], (long double)c[1]);
+        if (std::max(std::abs((long double)c[0]), std::abs((long double)c[1])) >= 256 && exact < 2e9L)
+            bounded &= std::abs(rawOf(out[i]) - exact) <= 0.03L * exact;
+    }
+    LUMINA_CHECK(matches && bounded);
+
+    approxMagnitudeBatch(vectors.data(), out.data(), count);
+    matches = bounded = true;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::int32_t c[3] = {rawOf(vectors[i].x), rawOf(vectors[i].y), rawOf(vectors[i].z)};
+        matches &= rawOf(out[i]) == referenceEstimate(c, 3);
+        long double exact = std::sqrt((long double)c[0] * c[0] + (long double)c[1] * c[1] + (long double)c[2] * c[2]);
+        if (std::max({std::abs((long double)c[0]), std::abs((long double)c[1]), std::abs((long double)c[2])}) >= 256 &&
+            exact < 2e9L)
+            bounded &= std::abs(rawOf(out[i]) - exact) <= 0.05L * exact;
+    }
+    LUMINA_CHECK(matches && bounded);
+    LUMINA_CHECK(rawOf(out[0]) == std::numeric_limits<std::int32_t>::max());
+}
+
+template <typename T>
+void testBatchKernels()
+{
+    std::mt19937_64 engine(40);
+    testComponentKernels<Vector2<T>, T>(engine);
+    testComponentKernels<Vector3<T>, T>(engine);
+    testComponentKernels<Vector4<T>, T>(engine);
+    testApproxMagnitude<T>(engine);
+}
+
+template <typename F>
+void testFixed()
+{
+    std::mt19937_64 engine(40);
+    testFixedArithmetic<F>(engine);
+    testFixedConversions<F>();
+    testFixedFunctions<F>(engine);
+}
+
+} // namespace
+
+int main()
+{
+    testFixed<Fixed16>();
+    testFixed<Fixed32>();
+    testIntegerTraits();
+    testBatchKernels<int>();
+    testBatchKernels<Fixed16>();
+    return test::finish();
+}
@@ -0,0 +1,476 @@
+// The text, OBJ and PLY readers against the values they were written from: formatVectors output
+// parsed back bit for bit, OBJ attributes in file order, PLY vertices in every format and scalar
+// type with lists around them, the same results for any thread count, and malformed input refused.
+
+#include "check.hpp"
+#include <lumina/io/obj.hpp>
+#include <lumina/io/ply.hpp>
+#include <lumina/io/text.hpp>
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+template <typename V>
+bool sameBits(const std::vector<V> &a, const std::vector<V> &b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(V)) == 0;
+}
+
+template <typename T>
+bool sameBits(const Vector3SoA<T> &a, const std::vector<Vector3<T>> &b)
+{
+    bool matches = a.size() == b.size();
+    for (std::size_t i = 0; matches && i < b.size(); ++i)
+    {
+        Vector3<T> v = a.get(i);
+        matches = std::memcmp(&v, &b[i], sizeof(v)) == 0;
+    }
+    return matches;
+}
+
+// The what() of the std::invalid_argument thrown by fn, or "" when nothing is thrown
+template <typename Fn>
+std::string failure(Fn &&fn)
+{
+    try
+    {
+        fn();
+    }
+    catch (const std::invalid_argument &error)
+    {
+        return error.what();
+    }
+    return "";
+}
+
+template <typename S>
+void appendNumber(std::string &out, S value)
+{
+    char buffer[32];
+    out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+}
+
+template <typename T>
+std::vector<Vector3<T>> randomVectors(std::mt19937_64 &engine, std::size_t count)
+{
+    std::uniform_real_distribution<T> coordinate(T(-1000), T(1000));
+    std::uniform_int_distribution<int> exponent(-40, 40);
+    std::vector<Vector3<T>> vectors(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vectors[i] = Vector3<T>(coordinate(engine), coordinate(engine), coordinate(engine));
+        if (i % 4 == 0)
+            vectors[i] = vectors[i] * std::ldexp(T(1), exponent(engine));
+    }
+    return vectors;
+}
+
+template <typename T>
+void testText(std::mt19937_64 &engine)
+{
+    // Shortest round-trip output reads back exactly, including the extremes
+    const T inf = std::numeric_limits<T>::infinity();
+    std::vector<Vector3<T>> vectors{{T(0), T(-0.0), T(1)},
+                                    {std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::min(), T(-1)},
+                                    {std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(), T(0.1)},
+                                    {inf, -inf, T(1e-7)}};
+    for (const Vector3<T> &v : randomVectors<T>(engine, 500))
+        vectors.push_back(v);
+    std::vector<Vector2<T>> flat(vectors.size());
+    for (std::size_t i = 0; i < vectors.size(); ++i)
+        flat[i] = Vector2<T>(vectors[i].x, vectors[i].y);
+
+    for (char separator : {' ', ',', '\t'})
+    {
+        std::string text;
+        formatVectors(vectors.data(), vectors.size(), text, separator);
+        std::vector<Vector3<T>> parsed;
+        parseVectors(text, parsed);
+        LUMINA_CHECK(sameBits(parsed, vectors));
+        Vector3SoA<T> soa;
+        parseVectors(text, soa);
+        LUMINA_CHECK(sameBits(soa, vectors));
+
+        std::string text2;
+        formatVectors(flat.data(), flat.size(), text2, separator);
+        std::vector<Vector2<T>> parsed2;
+        parseVectors(text2, parsed2);
+        LUMINA_CHECK(sameBits(parsed2, flat));
+    }
+
+    // Blank and comment lines, mixed separators, a leading '+', CRLF endings and extra fields
+    std::vector<Vector3<T>> parsed;
+    parseVectors("# header\n\n1 2 3\r\n  \t\n+4,\t-5 ,6 extra fields\n# 7 8 9\n-0 0.5 1e3", parsed);
+    LUMINA_CHECK(sameBits(parsed, std::vector<Vector3<T>>{{T(1), T(2), T(3)}, {T(4), T(-5), T(6)},
+                                                          {T(-0.0), T(0.5), T(1000)}}));
+    parseVectors("", parsed);
+    LUMINA_CHECK(parsed.empty());
+
+    // Malformed lines are reported by their number, counting blank and comment lines
+    LUMINA_CHECK(failure([] {
+        std::vector<Vector3<T>> out;
+        parseVectors("1 2 3\n# note\n4 5\n", out);
+    }) == "parseVectors: malformed line 3");
+    for (const char *bad : {"1 2 x\n", "+-1 2 3\n", "1 2 3x\n", "1 2 --3\n"})
+        LUMINA_CHECK_THROWS(std::invalid_argument, parseVectors(bad, parsed));
+    std::vector<Vector2<T>> parsed2;
+    LUMINA_CHECK_THROWS(std::invalid_argument, parseVectors("1\n", parsed2));
+
+    // Inputs past a few megabytes are split into parallel chunks; the result does not depend on it
+    std::vector<Vector3<T>> large = randomVectors<T>(engine, 200000);
+    std::string text = "# large\n";
+    formatVectors(large.data(), large.size(), text);
+    std::vector<Vector3<T>> serial, threaded;
+    parseVectors(text, serial, 1);
+    parseVectors(text, threaded, 4);
+    LUMINA_CHECK(sameBits(serial, large) && sameBits(threaded, large));
+
+    // The line number of an error is counted from the start of the text whichever chunk finds it
+    text += "1 2\n";
+    std::string expected = "parseVectors: malformed line " + std::to_string(large.size() + 2);
+    LUMINA_CHECK(failure([&] { parseVectors(text, threaded, 4); }) == expected);
+}
+
+template <typename T>
+void testObj(std::mt19937_64 &engine)
+{
+    const char *text = "# cube\n"
+                       "o cube\n"
+                       "v 1 2 3\n"
+                       "  v -1.5 0 2 1\n"
+                       "v 0 0 1 0.5 0.5 0.5\n"
+                       "vn 0 0 -1\n"
+                       "vt 0.25\n"
+                       "vt 0.5 0.75 0\n"
+                       "vp 0.1 0.2\n"
+                       "usemtl red\n"
+                       "f 1/1/1 2/2/1 3/1/1\n"
+                       "# v 9 9 9\n"
+                       "vn 1e-3 -0 1\r\n";
+    ObjVertices<T> obj = readObj<T>(text);
+    LUMINA_CHECK(sameBits(obj.positions, std::vector<Vector3<T>>{{T(1), T(2), T(3)}, {T(-1.5), T(0), T(2)},
+                                                                 {T(0), T(0), T(1)}}));
+    LUMINA_CHECK(sameBits(obj.normals, std::vector<Vector3<T>>{{T(0), T(0), T(-1)}, {T(1e-3), T(-0.0), T(1)}}));
+    LUMINA_CHECK(sameBits(obj.texcoords, std::vector<Vector2<T>>{{T(0.25), T(0)}, {T(0.5), T(0.75)}}));
+
+    Vector3SoA<T> positions;
+    readObjPositions(text, positions);
+    LUMINA_CHECK(sameBits(positions, obj.positions));
+
+    LUMINA_CHECK(failure([] { readObj<T>("v 1 2 3\nv 1 2\n"); }) == "readObj: malformed line 2");
+    LUMINA_CHECK_THROWS(std::invalid_argument, readObj<T>("vn 1 x 3\n"));
+    // Bare keywords are statements with every number missing, not unknown lines to skip
+    LUMINA_CHECK(failure([] { readObj<T>("v\nv 1 2 3\n"); }) == "readObj: malformed line 1");
+    LUMINA_CHECK(failure([] { readObj<T>("v 1 2 3\nv"); }) == "readObj: malformed line 2");
+    LUMINA_CHECK_THROWS(std::invalid_argument, readObj<T>("vn\n"));
+    LUMINA_CHECK_THROWS(std::invalid_argument, readObj<T>("vt\n"));
+    LUMINA_CHECK_THROWS(std::invalid_argument, readObj<T>("vt\r\n"));
+    LUMINA_CHECK_THROWS(std::invalid_argument, readObj<T>("vt \n"));
+    LUMINA_CHECK_THROWS(std::invalid_argument, readObj<T>("vt 1 y\n"));
+    // Only positions are read here, so attribute lines are not even parsed
+    readObjPositions("v 1 2 3\nvt 1 y\nvn\n", positions);
+    LUMINA_CHECK(positions.size() == 1);
+    LUMINA_CHECK_THROWS(std::invalid_argument, readObjPositions("v\n", positions));
+    LUMINA_CHECK_THROWS(std::runtime_error, readObjFile<T>("/nonexistent/lumina.obj"));
+
+    // Large files give the same attributes for any thread count, also when read from disk
+    std::vector<Vector3<T>> vectors = randomVectors<T>(engine, 120000);
+    std::string large;
+    for (std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        const Vector3<T> &v = vectors[i];
+        large += i % 3 == 0 ? "vn " : "v ";
+        appendNumber(large, v.x);
+        large += ' ';
+        appendNumber(large, v.y);
+        large += ' ';
+        appendNumber(large, v.z);
+        large += "\nvt ";
+        appendNumber(large, v.z);
+        large += i % 5 == 0 ? "\nf 1 2 3\n" : "\n";
+    }
+    ObjVertices<T> expected;
+    for (std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        (i % 3 == 0 ? expected.normals : expected.positions).push_back(vectors[i]);
+        expected.texcoords.emplace_back(vectors[i].z, T(0));
+    }
+    for (unsigned threads : {1u, 4u})
+    {
+        ObjVertices<T> read = readObj<T>(large, threads);
+        LUMINA_CHECK(sameBits(read.positions, expected.positions) && sameBits(read.normals, expected.normals) &&
+                     sameBits(read.texcoords, expected.texcoords));
+        readObjPositions(large, positions, threads);
+        LUMINA_CHECK(sameBits(positions, expected.positions));
+    }
+
+    std::string path = (std::filesystem::temp_directory_path() / "lumina_io_test.obj").string();
+    if (std::FILE *file = std::fopen(path.c_str(), "wb"))
+    {
+        std::fwrite(large.data(), 1, large.size(), file);
+        std::fclose(file);
+        ObjVertices<T> read = readObjFile<T>(path, 4);
+        LUMINA_CHECK(sameBits(read.positions, expected.positions) && sameBits(read.normals, expected.normals));
+        std::filesystem::remove(path);
+    }
+}
+
+// Appends the bytes of value in the given byte order
+template <typename S>
+void put(std::string &out, S value, bool bigEndian)
+{
+    char bytes[sizeof(S)];
+    std::memcpy(bytes, &value, sizeof(S));
+    if (bigEndian != (std::endian::native == std::endian::big))
+        std::reverse(bytes, bytes + sizeof(S));
+    out.append(bytes, sizeof(S));
+}
+
+// A vertex as it is stored in the test files: x as double, y as float, z as int16, a list of
+// float weights between y and z, and an unsigned char tag after z
+struct PlyVertex
+{
+    double x;
+    float y;
+    std::int16_t z;
+    std::vector<float> weights;
+    unsigned char tag;
+};
+
+std::vector<PlyVertex> plyVertices(std::mt19937_64 &engine, std::size_t count, bool lists)
+{
+    std::uniform_real_distribution<double> coordinate(-100, 100);
+    std::uniform_int_distribution<int> integer(-30000, 30000), length(0, 3);
+    std::vector<PlyVertex> vertices(count);
+    for (PlyVertex &v : vertices)
+    {
+        v = {coordinate(engine), float(coordinate(engine)), std::int16_t(integer(engine)), {},
+             (unsigned char)(integer(engine) & 0xff)};
+        if (lists)
+            v.weights.assign(std::size_t(length(engine)), float(coordinate(engine)));
+    }
+    return vertices;
+}
+
+enum class PlyFormat
+{
+    Ascii,
+    Little,
+    Big
+};
+
+// A face element before the vertices and an edge element after them, both to be skipped
+std::string plyFile(const std::vector<PlyVertex> &vertices, bool lists, PlyFormat format)
+{
+    const char *formats[] = {"ascii", "binary_little_endian", "binary_big_endian"};
+    std::string out = std::string("ply\nformat ") + formats[int(format)] + " 1.0\ncomment written by tests/io.cpp\n";
+    out += "element face 2\nproperty list uchar int vertex_indices\nproperty float area\n";
+    out += "element vertex " + std::to_string(vertices.size()) + "\n";
+    out += "property double x\nproperty float y\n";
+    if (lists)
+        out += "property list uchar float weights\n";
+    out += "property short z\nproperty uchar tag\n";
+    out += "element edge 1\nproperty int vertex1\nproperty int vertex2\nend_header\n";
+
+    bool big = format == PlyFormat::Big;
+    if (format == PlyFormat::Ascii)
+    {
+        out += "3 0 1 2 0.5\n4 0 1 2 3 1.5\n";
+        for (const PlyVertex &v : vertices)
+        {
+            appendNumber(out, v.x);
+            // y goes out as the double it widens to, so a double reader gets that and not the
+            // shortest decimal of the float
+            out += ' ';
+            appendNumber(out, double(v.y));
+            if (lists)
+            {
+                out += ' ' + std::to_string(v.weights.size());
+                for (float w : v.weights)
+                {
+                    out += ' ';
+                    appendNumber(out, w);
+                }
+            }
+            out += ' ' + std::to_string(v.z) + ' ' + std::to_string(int(v.tag)) + '\n';
+        }
+        out += "0 1\n";
+        return out;
+    }
+
+    for (int face = 0; face < 2; ++face)
+    {
+        put(out, std::uint8_t(3 + face), big);
+        for (int i = 0; i < 3 + face; ++i)
+            put(out, std::int32_t(i), big);
+        put(out, 0.5f, big);
+    }
+    for (const PlyVertex &v : vertices)
+    {
+        put(out, v.x, big);
+        put(out, v.y, big);
+        if (lists)
+        {
+            put(out, std::uint8_t(v.weights.size()), big);
+            for (float w : v.weights)
+                put(out, w, big);
+        }
+        put(out, v.z, big);
+        put(out, v.tag, big);
+    }
+    put(out, std::int32_t(0), big);
+    put(out, std::int32_t(1), big);
+    return out;
+}
+
+template <typename T>
+void testPlyFormats(std::mt19937_64 &engine)
+{
+    for (std::size_t count : {std::size_t(0), std::size_t(1), std::size_t(500), std::size_t(150000)})
+    {
+        for (bool lists : {false, true})
+        {
+            std::vector<PlyVertex> vertices = plyVertices(engine, count, lists);
+            std::vector<Vector3<T>> expected(count);
+            for (std::size_t i = 0; i < count; ++i)
+                expected[i] = Vector3<T>(T(vertices[i].x), T(vertices[i].y), T(vertices[i].z));
+
+            for (PlyFormat format : {PlyFormat::Ascii, PlyFormat::Little, PlyFormat::Big})
+            {
+                std::string file = plyFile(vertices, lists, format);
+                for (unsigned threads : {1u, 4u})
+                {
+                    std::vector<Vector3<T>> positions;
+                    readPly(file, positions, threads);
+                    LUMINA_CHECK(sameBits(positions, expected));
+                    Vector3SoA<T> soa;
+                    readPly(file, soa, threads);
+                    LUMINA_CHECK(sameBits(soa, expected));
+                }
+            }
+        }
+    }
+
+    std::vector<PlyVertex> vertices = plyVertices(engine, 50, true);
+    std::string file = plyFile(vertices, true, PlyFormat::Little);
+    std::string path = (std::filesystem::temp_directory_path() / "lumina_io_test.ply").string();
+    if (std::FILE *out = std::fopen(path.c_str(), "wb"))
+    {
+        std::fwrite(file.data(), 1, file.size(), out);
+        std::fclose(out);
+        std::vector<Vector3<T>> fromFile, fromMemory;
+        readPlyFile(path, fromFile);
+        readPly(file, fromMemory);
+        LUMINA_CHECK(fromFile.size() == 50 && sameBits(fromFile, fromMemory));
+        std::filesystem::remove(path);
+    }
+    std::vector<Vector3<T>> positions;
+    LUMINA_CHECK_THROWS(std::runtime_error, readPlyFile("/nonexistent/lumina.ply", positions));
+}
+
+// A little endian file of one vertex whose list length is stored as the given count type
+template <typename Count>
+std::string plyListLength(const char *countType, Count length, std::size_t items)
+{
+    std::string out = std::string("ply\nformat binary_little_endian 1.0\nelement vertex 1\n") +
+                      "property float x\nproperty float y\nproperty float z\nproperty list " + countType +
+                      " uchar values\nend_header\n";
+    for (int k = 0; k < 3; ++k)
+        put(out, float(k), false);
+    put(out, length, false);
+    out.append(items, '\x07');
+    return out;
+}
+
+template <typename T>
+void testPlyErrors()
+{
+    std::vector<Vector3<T>> positions;
+    auto read = [&](const std::string &data) { return failure([&] { readPly(data, positions); }); };
+    const std::string vertex = "element vertex 1\nproperty float x\nproperty float y\nproperty float z\n";
+
+    LUMINA_CHECK(read("plx\nformat ascii 1.0\nend_header\n") == "readPly: missing 'ply' signature");
+    LUMINA_CHECK(read("ply\n" + vertex + "end_header\n0 0 0\n") == "readPly: missing format line");
+    LUMINA_CHECK(read("ply\nformat middle_endian 1.0\nend_header\n") == "readPly: unknown format 'middle_endian'");
+    LUMINA_CHECK(read("ply\nformat ascii 1.0\nelement vertex -1\nend_header\n") ==
+                 "readPly: bad element count '-1'");
+    LUMINA_CHECK(read("ply\nformat ascii 1.0\nelement vertex 1\nproperty half x\nend_header\n") ==
+                 "readPly: unknown property type 'half'");
+    LUMINA_CHECK(read("ply\nformat ascii 1.0\nelement vertex 1\nproperty float\nend_header\n") ==
+                 "readPly: bad property line");
+    LUMINA_CHECK(read("ply\nformat ascii 1.0\nproperty float x\nend_header\n") ==
+                 "readPly: unexpected header line 'property'");
+    LUMINA_CHECK(read("ply\nformat ascii 1.0\n" + vertex) == "readPly: missing end_header");
+    LUMINA_CHECK(read("ply\nformat ascii 1.0\nelement face 0\nend_header\n") == "readPly: no vertex element");
+    LUMINA_CHECK(read("ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\nproperty float y\n"
+                      "property list uchar float z\nend_header\n1 2 1 3\n") ==
+                 "readPly: vertex element has no scalar 'z' property");
+
+    const std::string ascii = "ply\nformat ascii 1.0\n" + vertex + "end_header\n";
+    LUMINA_CHECK(read(ascii + "1 2 3\n") == "");
+    LUMINA_CHECK(read(ascii) == "readPly: expected 1 vertices, found 0");
+    LUMINA_CHECK(read(ascii + "1 2\n") == "readPly: malformed line 8");
+    LUMINA_CHECK(read("ply\nformat binary_little_endian 1.0\n" + vertex + "end_header\n" + std::string(11, '\0')) ==
+                 "readPly: truncated vertex data");
+    // Counts far beyond the body fail before anything is allocated, with and without a list property
+    for (const char *count : {"500000000", "1099511627776", "18446744073709551615"})
+    {
+        std::string huge = std::string("ply\nformat binary_little_endian 1.0\nelement vertex ") + count +
+                           "\nproperty float x\nproperty float y\nproperty float z\n";
+        LUMINA_CHECK(read(huge + "end_header\n" + std::string(24, '\0')) == "readPly: truncated vertex data");
+        LUMINA_CHECK(read(huge + "property list uchar float w\nend_header\n" + std::string(26, '\0')) ==
+                     "readPly: truncated vertex data");
+    }
+    LUMINA_CHECK(read("ply\nformat ascii 1.0\nelement face 3\nproperty uchar n\n" + vertex + "end_header\n1\n2") ==
+                 "readPly: truncated face data");
+
+    // List lengths must be whole, non-negative and fit in the data that is left
+    LUMINA_CHECK(read(plyListLength("uchar", std::uint8_t(2), 2)) == "");
+    LUMINA_CHECK(read(plyListLength("uchar", std::uint8_t(3), 2)) == "readPly: truncated vertex data");
+    LUMINA_CHECK(read(plyListLength("int", std::int32_t(-1), 2)) == "readPly: bad list length in vertex data");
+    LUMINA_CHECK(read(plyListLength("float", 2.0f, 2)) == "");
+    for (double length : {2.5, -1.0, std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN()})
+        LUMINA_CHECK(read(plyListLength("double", length, 2)) == "readPly: bad list length in vertex data");
+    LUMINA_CHECK(read(plyListLength("double", 1e30, 2)) == "readPly: truncated vertex data");
+    LUMINA_CHECK(read(plyListLength("uint", std::uint32_t(0xffffffff), 2)) == "readPly: truncated vertex data");
+
+    const std::string asciiList = "ply\nformat ascii 1.0\n" + vertex + "property list uchar float w\nend_header\n";
+    LUMINA_CHECK(read(asciiList + "1 2 3 2 0.5 0.5\n") == "");
+    for (const char *line : {"1 2 3 2.5 0.5 0.5\n", "1 2 3 -1\n", "1 2 3 3 0.5 0.5\n"})
+        LUMINA_CHECK(read(asciiList + line) == "readPly: malformed line 9");
+}
+
+template <typename T>
+void testIo()
+{
+    std::mt19937_64 engine(39);
+    testText<T>(engine);
+    testObj<T>(engine);
+    testPlyFormats<T>(engine);
+    testPlyErrors<T>();
+}
+
+} // namespace
+
+int main()
+{
+    testIo<float>();
+    testIo<double>();
+    return test::finish();
+}
@@ -0,0 +1,290 @@
+// Vectorized elementary functions against long double references at both accuracy tiers, special
+// values (clamping, overflow, NaN in a SIMD lane and in the scalar tail), aliasing, and the batch
+// angle, rotation and polar kernels built on them.
+
+#include "check.hpp"
+#include <lumina/batch/angles.hpp>
+#include <lumina/batch/math.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+using Wide = long double;
+
+// ULP of T at the magnitude of x
+template <typename T>
+Wide ulp(Wide x)
+{
+    T r = std::min(T(std::fabs(x)), std::numeric_limits<T>::max());
+    return Wide(std::nextafter(r, std::numeric_limits<T>::infinity())) - Wide(r);
+}
+
+template <typename T>
+struct Case
+{
+    const char *name;
+    T lo, hi;
+    std::function<Wide(Wide, Wide)> exact;
+    std::function<void(const T *, const T *, T *, std::size_t, MathAccuracy)> run;
+};
+
+template <typename T>
+std::vector<Case<T>> cases()
+{
+    return {
+        {"sin", T(-100), T(100), [](Wide x, Wide) { return std::sin(x); },
+         [](const T *x, const T *, T *out, std::size_t n, MathAccuracy a) { sinBatch(x, out, n, a); }},
+        {"cos", T(-100), T(100), [](Wide x, Wide) { return std::cos(x); },
+         [](const T *x, const T *, T *out, std::size_t n, MathAccuracy a) { cosBatch(x, out, n, a); }},
+        {"acos", T(-1), T(1), [](Wide x, Wide) { return std::acos(x); },
+         [](const T *x, const T *, T *out, std::size_t n, MathAccuracy a) { acosBatch(x, out, n, a); }},
+        {"atan2", T(-10), T(10), [](Wide x, Wide y) { return std::atan2(y, x); },
+         [](const T *x, const T *y, T *out, std::size_t n, MathAccuracy a) { atan2Batch(y, x, out, n, a); }},
+        {"rsqrt", T(1e-3), T(1e3), [](Wide x, Wide) { return 1 / std::sqrt(x); },
+         [](const T *x, const T *, T *out, std::size_t n, MathAccuracy a) { rsqrtBatch(x, out, n, a); }},
+        {"exp", T(-80), T(80), [](Wide x, Wide) { return std::exp(x); },
+         [](const T *x, const T *, T *out, std::size_t n, MathAccuracy a) { expBatch(x, out, n, a); }},
+    };
+}
+
+// Precise stays within 4 ulp of T. Fast stays within 4 ulp of float, except float sin and cos whose
+// shorter polynomials are bounded in absolute error.
+template <typename T>
+void testAccuracy()
+{
+    constexpr std::size_t count = 100003;
+    std::mt19937_64 engine(30);
+    std::vector<T> x(count), y(count), out(count);
+    for (const Case<T> &c : cases<T>())
+    {
+        std::uniform_real_distribution<T> input(c.lo, c.hi);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            x[i] = input(engine);
+            y[i] = input(engine);
+        }
+        for (MathAccuracy accuracy : {MathAccuracy::Fast, MathAccuracy::Precise})
+        {
+            c.run(x.data(), y.data(), out.data(), count, accuracy);
+            bool absolute = accuracy == MathAccuracy::Fast && sizeof(T) == sizeof(float) &&
+                            (c.name[0] == 's' || c.name[0] == 'c');
+            Wide worst = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Wide exact = c.exact(x[i], y[i]);
+                Wide error = std::fabs(out[i] - exact);
+                if (!absolute)
+                    error /= accuracy == MathAccuracy::Precise ? ulp<T>(exact) : ulp<float>(exact);
+                worst = std::max(worst, std::isnan(error) ? std::numeric_limits<Wide>::infinity() : error);
+            }
+            if (!LUMINA_CHECK(worst <= (absolute ? Wide(5e-5) : Wide(4))))
+                std::fprintf(stderr, "  %s error %Lg\n", c.name, worst);
+        }
+    }
+}
+
+// NaN goes in the first lane of the first pack and in the last element, which every pack width leaves
+// to the scalar tail; both must come out NaN
+template <typename T>
+void testSpecialValues()
+{
+    const T nan = std::numeric_limits<T>::quiet_NaN(), inf = std::numeric_limits<T>::infinity();
+    constexpr std::size_t count = 19;
+    for (MathAccuracy accuracy : {MathAccuracy::Fast, MathAccuracy::Precise})
+    {
+        for (const Case<T> &c : cases<T>())
+        {
+            std::vector<T> x(count, T(0.5)), y(count, T(0.5)), out(count);
+            x.front() = nan;
+            x.back() = nan;
+            c.run(x.data(), y.data(), out.data(), count, accuracy);
+            if (!LUMINA_CHECK(std::isnan(out.front()) && std::isnan(out.back())))
+                std::fprintf(stderr, "  %s(NaN) gave %g, %g\n", c.name, double(out.front()), double(out.back()));
+            LUMINA_CHECK(!std::isnan(out[1]) && !std::isnan(out[count - 2]));
+        }
+
+        std::vector<T> in = {T(1.5), T(-2), T(1), T(-1), inf, -inf, T(1000), T(-1000), T(0)}, out(in.size());
+        acosBatch(in.data(), out.data(), 4, accuracy);
+        LUMINA_CHECK(out[0] == T(0) && out[2] == T(0));
+        LUMINA_CHECK(std::abs(out[1] - std::numbers::pi_v<T>) <= ulp<T>(std::numbers::pi_v<T>) * 4);
+        LUMINA_CHECK(out[1] == out[3]);
+        expBatch(in.data() + 4, out.data(), 5, accuracy);
+        LUMINA_CHECK(out[0] == inf && out[1] == T(0) && out[2] == inf && out[3] == T(0) && out[4] == T(1));
+
+        // In-place evaluation
+        std::vector<T> values(count), expected(count);
+        for (std::size_t i = 0; i < count; ++i)
+            values[i] = T(i) * T(0.37) - T(3);
+        sinBatch(values.data(), expected.data(), count, accuracy);
+        sinBatch(values.data(), values.data(), count, accuracy);
+        LUMINA_CHECK(values == expected);
+
+        std::vector<T> sines(count), cosines(count), cosinesOnly(count);
+        for (std::size_t i = 0; i < count; ++i)
+            values[i] = T(i) * T(0.37) - T(3);
+        sincosBatch(values.data(), sines.data(), cosines.data(), count, accuracy);
+        cosBatch(values.data(), cosinesOnly.data(), count, accuracy);
+        LUMINA_CHECK(sines == expected && cosines == cosinesOnly);
+    }
+}
+
+// a * b - c * d in long double from its exact products: long double holds a float product exactly and
+// fmal recovers the rounding error of a double one
+Wide differenceOfProducts(Wide a, Wide b, Wide c, Wide d)
+{
+    Wide ab = a * b, cd = c * d;
+    return (ab - cd) + (std::fma(a, b, -ab) - std::fma(c, d, -cd));
+}
+
+// atan2(|a ^ b|, a . b) with the wedge terms from exact products, so near-parallel pairs are resolved
+// to full precision
+template <typename V>
+Wide angleReference(const V &a, const V &b, std::size_t dim)
+{
+    Wide dot = 0, aa = 0, bb = 0, wedge = 0;
+    for (std::size_t j = 0; j < dim; ++j)
+    {
+        dot += Wide(a[j]) * b[j];
+        aa += Wide(a[j]) * a[j];
+        bb += Wide(b[j]) * b[j];
+        for (std::size_t k = j + 1; k < dim; ++k)
+        {
+            Wide w = differenceOfProducts(a[j], b[k], a[k], b[j]);
+            wedge += w * w;
+        }
+    }
+    if (aa == 0 || bb == 0)
+        return std::numbers::pi_v<Wide> / 2;
+    return std::atan2(std::sqrt(wedge), dot);
+}
+
+// Precise angles stay within 8 ulp of T against the reference, on random pairs and on pairs parallel or
+// antiparallel to within a relative 2^-4 .. 2^-digits, where the angle is far below one ulp of pi.
+// Fast is bounded the same way in ulp of float.
+template <typename T, typename V>
+void testAngles(std::mt19937_64 &engine)
+{
+    constexpr std::size_t count = 20001, dim = sizeof(V) / sizeof(T);
+    std::uniform_real_distribution<T> component(T(-4), T(4)), unit(T(-1), T(1));
+    std::vector<V> a(count), b(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        for (std::size_t k = 0; k < dim; ++k)
+            a[i][k] = component(engine);
+        if (i % 2 == 0)
+        {
+            for (std::size_t k = 0; k < dim; ++k)
+                b[i][k] = component(engine);
+            continue;
+        }
+        T scale = (i % 4 == 1 ? T(1) : T(-1)) * (T(1.25) + unit(engine) / 2);
+        T eps = std::ldexp(T(1), -int(4 + engine() % (std::numeric_limits<T>::digits - 4)));
+        for (std::size_t k = 0; k < dim; ++k)
+            b[i][k] = a[i][k] * scale * (T(1) + eps * unit(engine));
+    }
+    // Zero-length, exactly parallel and antiparallel pairs
+    a[0] = V();
+    b[2] = V();
+    b[4] = a[4] * T(2);
+    b[6] = a[6] * T(-0.5);
+
+    std::vector<T> out(count);
+    for (MathAccuracy accuracy : {MathAccuracy::Fast, MathAccuracy::Precise})
+    {
+        angles(a.data(), b.data(), out.data(), count, accuracy);
+        Wide worst[2] = {0, 0};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Wide exact = angleReference(a[i], b[i], dim);
+            Wide unit = accuracy == MathAccuracy::Precise ? ulp<T>(exact) : ulp<float>(exact);
+            Wide error = std::fabs(out[i] - exact) / unit;
+            worst[i % 2] = std::max(worst[i % 2], std::isnan(error) ? std::numeric_limits<Wide>::infinity() : error);
+        }
+        if (!LUMINA_CHECK(worst[0] <= 8 && worst[1] <= 8))
+            std::fprintf(stderr, "  %zu-component angles: %Lg ulp random, %Lg ulp near-parallel\n", dim, worst[0],
+                         worst[1]);
+
+        T halfPi = std::numbers::pi_v<T> / 2;
+        LUMINA_CHECK(out[0] == halfPi && out[2] == halfPi);
+        LUMINA_CHECK(out[4] == T(0) && out[6] == std::numbers::pi_v<T>);
+    }
+}
+
+template <typename T>
+void testRotations()
+{
+    std::mt19937_64 engine(300);
+    testAngles<T, Vector2<T>>(engine);
+    testAngles<T, Vector3<T>>(engine);
+    testAngles<T, Vector4<T>>(engine);
+
+    constexpr std::size_t count = 257;
+    const T tolerance = sizeof(T) == sizeof(float) ? T(1e-5) : T(1e-12);
+    std::uniform_real_distribution<T> angle(T(-6), T(6)), component(T(-2), T(2));
+    std::vector<T> theta(count);
+    std::vector<Vector2<T>> flat(count), flatOut(count), back(count);
+    std::vector<Vector3<T>> points(count), axes(count), rotated(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        theta[i] = angle(engine);
+        flat[i] = Vector2<T>(component(engine), component(engine));
+        points[i] = Vector3<T>(component(engine), component(engine), component(engine));
+        axes[i] = Vector3<T>(component(engine), component(engine), component(engine)).normalized();
+    }
+
+    rotate(flat.data(), theta.data(), flatOut.data(), count);
+    rotate(points.data(), axes.data(), theta.data(), rotated.data(), count);
+    std::vector<T> radius(count), polarAngle(count);
+    toPolar(flat.data(), radius.data(), polarAngle.data(), count);
+    fromPolar(radius.data(), polarAngle.data(), back.data(), count);
+
+    bool close = true;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Wide c = std::cos(Wide(theta[i])), s = std::sin(Wide(theta[i]));
+        close &= std::fabs(flatOut[i].x - (c * flat[i].x - s * flat[i].y)) <= tolerance;
+        close &= std::fabs(flatOut[i].y - (s * flat[i].x + c * flat[i].y)) <= tolerance;
+
+        // Rodrigues: v cos + (k x v) sin + k (k . v)(1 - cos)
+        const Vector3<T> &v = points[i], &k = axes[i];
+        Wide kv = Wide(k.x) * v.x + Wide(k.y) * v.y + Wide(k.z) * v.z;
+        Wide cross[3] = {Wide(k.y) * v.z - Wide(k.z) * v.y, Wide(k.z) * v.x - Wide(k.x) * v.z,
+                         Wide(k.x) * v.y - Wide(k.y) * v.x};
+        for (int j = 0; j < 3; ++j)
+            close &= std::fabs(rotated[i][j] - (v[j] * c + cross[j] * s + k[j] * kv * (1 - c))) <= tolerance * 4;
+
+        close &= std::fabs(radius[i] - std::hypot(Wide(flat[i].x), Wide(flat[i].y))) <= tolerance;
+        close &= std::fabs(polarAngle[i] - std::atan2(Wide(flat[i].y), Wide(flat[i].x))) <= tolerance;
+        close &= std::fabs(back[i].x - flat[i].x) <= tolerance * 4 && std::fabs(back[i].y - flat[i].y) <= tolerance * 4;
+    }
+    LUMINA_CHECK(close);
+
+    // Polar angles lie in (-pi, pi]
+    Vector2<T> negativeX(T(-1), T(0));
+    T r, phi;
+    toPolar(&negativeX, &r, &phi, 1);
+    LUMINA_CHECK(r == T(1) && phi == std::numbers::pi_v<T>);
+}
+
+} // namespace
+
+int main()
+{
+    testAccuracy<float>();
+    testAccuracy<double>();
+    testSpecialValues<float>();
+    testSpecialValues<double>();
+    testRotations<float>();
+    testRotations<double>();
+    return test::finish();
+}
@@ -0,0 +1,445 @@
+// Mesh normals and tangent frames against brute-force long double references: the vertex-face
+// adjacency, face and vertex normals under both weightings, the orthonormal basis and the vertex
+// tangents, plus the strided overloads and thread counts against the contiguous single-thread results.
+
+#include "check.hpp"
+#include <lumina/mesh/normals.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+using Wide = long double;
+
+struct WideVector
+{
+    Wide x = 0, y = 0, z = 0;
+};
+
+template <typename T>
+WideVector widen(const Vector3<T> &v)
+{
+    return {Wide(v.x), Wide(v.y), Wide(v.z)};
+}
+
+WideVector operator-(const WideVector &a, const WideVector &b)
+{
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+WideVector cross(const WideVector &a, const WideVector &b)
+{
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+Wide dot(const WideVector &a, const WideVector &b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+Wide length(const WideVector &v)
+{
+    return std::sqrt(dot(v, v));
+}
+
+WideVector normalized(const WideVector &v)
+{
+    Wide l = length(v);
+    return l > 0 ? WideVector{v.x / l, v.y / l, v.z / l} : WideVector{};
+}
+
+template <typename T>
+Wide distance(const Vector3<T> &a, const WideVector &b)
+{
+    return length(widen(a) - b);
+}
+
+template <typename T>
+bool sameBits(const std::vector<T> &a, const std::vector<T> &b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+template <typename T>
+struct Mesh
+{
+    std::vector<Vector3<T>> positions;
+    std::vector<Vector2<T>> uvs;
+    std::vector<std::uint32_t> indices;
+
+    std::size_t triangleCount() const { return indices.size() / 3; }
+};
+
+// Gently curved grid of `side` x `side` vertices, triangulated into quads, followed by three collinear
+// vertices forming one degenerate triangle and a vertex no triangle uses
+template <typename T>
+Mesh<T> gridMesh(std::size_t side, std::mt19937_64 &engine)
+{
+    std::uniform_real_distribution<T> jitter(T(-0.01), T(0.01));
+    Mesh<T> mesh;
+    for (std::size_t j = 0; j < side; ++j)
+    {
+        for (std::size_t i = 0; i < side; ++i)
+        {
+            T x = T(i) * T(0.05) + jitter(engine), y = T(j) * T(0.05) + jitter(engine);
+            T z = T(0.1) * std::sin(T(0.3) * T(i)) * std::cos(T(0.2) * T(j));
+            mesh.positions.emplace_back(x, y, z);
+            mesh.uvs.emplace_back(T(2) * x, T(3) * y);
+        }
+    }
+    for (std::size_t j = 0; j + 1 < side; ++j)
+    {
+        for (std::size_t i = 0; i + 1 < side; ++i)
+        {
+            auto v = std::uint32_t(j * side + i), s = std::uint32_t(side);
+            mesh.indices.insert(mesh.indices.end(), {v, v + 1, v + s + 1, v, v + s + 1, v + s});
+        }
+    }
+    auto first = std::uint32_t(mesh.positions.size());
+    for (int k = 0; k < 4; ++k)
+    {
+        mesh.positions.emplace_back(T(k), T(2 * k), T(-1));
+        mesh.uvs.emplace_back(T(0), T(0));
+    }
+    mesh.indices.insert(mesh.indices.end(), {first, first + 1, first + 2});
+    return mesh;
+}
+
+template <typename T>
+void testAdjacency(const Mesh<T> &mesh)
+{
+    VertexFaceAdjacency adjacency(mesh.indices.data(), mesh.triangleCount(), mesh.positions.size());
+    LUMINA_CHECK(adjacency.vertexCount() == mesh.positions.size());
+
+    std::vector<std::uint32_t> offsets{0}, corners;
+    for (std::size_t v = 0; v < mesh.positions.size(); ++v)
+    {
+        for (std::size_t c = 0; c < mesh.indices.size(); ++c)
+            if (mesh.indices[c] == v)
+                corners.push_back(std::uint32_t(c));
+        offsets.push_back(std::uint32_t(corners.size()));
+    }
+    LUMINA_CHECK(adjacency.offsets == offsets);
+    LUMINA_CHECK(adjacency.corners == corners);
+
+    std::uint32_t bad[3] = {0, 1, 7};
+    LUMINA_CHECK_THROWS(std::out_of_range, VertexFaceAdjacency(bad, 1, 7));
+    LUMINA_CHECK(VertexFaceAdjacency(bad, 0, 3).corners.empty());
+}
+
+template <typename T>
+void testFaceNormals(const Mesh<T> &mesh)
+{
+    const Wide eps = std::numeric_limits<T>::epsilon();
+    std::size_t count = mesh.triangleCount();
+    std::vector<Vector3<T>> raw(count), unit(count), raw4(count);
+    faceNormals(mesh.positions.data(), mesh.indices.data(), count, raw.data(), false, StoreMode::Regular, 1);
+    faceNormals(mesh.positions.data(), mesh.indices.data(), count, unit.data(), true, StoreMode::Regular, 1);
+    faceNormals(mesh.positions.data(), mesh.indices.data(), count, raw4.data(), false, StoreMode::Regular, 4);
+    LUMINA_CHECK(sameBits(raw, raw4));
+
+    // Edges are rounded to T before the cross product, so the bound scales with the coordinates too
+    Wide worstRaw = 0, worstUnit = 0;
+    for (std::size_t t = 0; t < count; ++t)
+    {
+        WideVector p0 = widen(mesh.positions[mesh.indices[3 * t]]);
+        WideVector e1 = widen(mesh.positions[mesh.indices[3 * t + 1]]) - p0;
+        WideVector e2 = widen(mesh.positions[mesh.indices[3 * t + 2]]) - p0;
+        WideVector expected = cross(e1, e2);
+        Wide scale = (length(e1) + length(p0)) * (length(e2) + length(p0));
+        worstRaw = std::max(worstRaw, distance(raw[t], expected) / scale);
+        if (length(expected) > 0)
+            worstUnit = std::max(worstUnit, distance(unit[t], normalized(expected)) * length(expected) / scale);
+        else
+            LUMINA_CHECK(unit[t].x == T(0) && unit[t].y == T(0) && unit[t].z == T(0));
+    }
+    LUMINA_CHECK(worstRaw <= 16 * eps);
+    LUMINA_CHECK(worstUnit <= 16 * eps);
+}
+
+// Sum of the corner-weighted face normals around each vertex, normalized
+template <typename T>
+std::vector<WideVector> referenceVertexNormals(const Mesh<T> &mesh, NormalWeighting weighting)
+{
+    std::vector<WideVector> sums(mesh.positions.size());
+    for (std::size_t c = 0; c < mesh.indices.size(); ++c)
+    {
+        std::size_t t = c / 3, k = c % 3;
+        WideVector corner = widen(mesh.positions[mesh.indices[c]]);
+        WideVector e1 = widen(mesh.positions[mesh.indices[3 * t + (k + 1) % 3]]) - corner;
+        WideVector e2 = widen(mesh.positions[mesh.indices[3 * t + (k + 2) % 3]]) - corner;
+        WideVector face = cross(e1, e2);
+        Wide weight = 1;
+        if (weighting == NormalWeighting::Angle)
+        {
+            weight = std::atan2(length(face), dot(e1, e2));
+            face = normalized(face);
+        }
+        WideVector &sum = sums[mesh.indices[c]];
+        sum = {sum.x + face.x * weight, sum.y + face.y * weight, sum.z + face.z * weight};
+    }
+    for (WideVector &sum : sums)
+        sum = normalized(sum);
+    return sums;
+}
+
+template <typename T>
+void testVertexNormals(const Mesh<T> &mesh)
+{
+    const Wide eps = std::numeric_limits<T>::epsilon();
+    std::size_t vertexCount = mesh.positions.size();
+    VertexFaceAdjacency adjacency(mesh.indices.data(), mesh.triangleCount(), vertexCount);
+
+    for (NormalWeighting weighting : {NormalWeighting::Area, NormalWeighting::Angle})
+    {
+        std::vector<WideVector> expected = referenceVertexNormals(mesh, weighting);
+        std::vector<Vector3<T>> normals(vertexCount), normals4(vertexCount);
+        vertexNormals(mesh.positions.data(), mesh.indices.data(), mesh.triangleCount(), adjacency, normals.data(),
+                      weighting, StoreMode::Regular, 1);
+        vertexNormals(mesh.positions.data(), mesh.indices.data(), mesh.triangleCount(), adjacency, normals4.data(),
+                      weighting, StoreMode::Regular, 4);
+        LUMINA_CHECK(sameBits(normals, normals4));
+
+        Wide worst = 0;
+        for (std::size_t v = 0; v < vertexCount; ++v)
+            worst = std::max(worst, distance(normals[v], expected[v]));
+        LUMINA_CHECK(worst <= 256 * eps);
+
+        // The degenerate triangle and the unused vertex give zero normals
+        for (std::size_t v = vertexCount - 4; v < vertexCount; ++v)
+            LUMINA_CHECK(normals[v].x == T(0) && normals[v].y == T(0) && normals[v].z == T(0));
+    }
+
+    std::vector<Vector3<T>> normals(vertexCount);
+    LUMINA_CHECK_THROWS(std::invalid_argument,
+                        vertexNormals(mesh.positions.data(), mesh.indices.data(), mesh.triangleCount() - 1,
+                                      adjacency, normals.data()));
+}
+
+template <typename T>
+void testOrthonormalBasis(std::mt19937_64 &engine)
+{
+    const Wide eps = std::numeric_limits<T>::epsilon();
+    std::normal_distribution<T> gaussian;
+    std::vector<Vector3<T>> normals(1001);
+    for (Vector3<T> &n : normals)
+    {
+        Vector3<T> v(gaussian(engine), gaussian(engine), gaussian(engine));
+        n = v / v.magnitude();
+    }
+    normals[0] = Vector3<T>(T(0), T(0), T(1));
+    normals[1] = Vector3<T>(T(0), T(0), T(-1));
+    normals[2] = Vector3<T>(T(1), T(0), T(0));
+    normals[3] = Vector3<T>(std::sqrt(T(1) - T(1e-6)), T(0), T(-1e-3));
+
+    std::vector<Vector3<T>> tangents(normals.size()), bitangents(normals.size());
+    orthonormalBasis(normals.data(), normals.size(), tangents.data(), bitangents.data());
+
+    // An orthonormal, right-handed frame: n x t = b
+    Wide worst = 0;
+    for (std::size_t i = 0; i < normals.size(); ++i)
+    {
+        WideVector n = widen(normals[i]), t = widen(tangents[i]), b = widen(bitangents[i]);
+        worst = std::max({worst, std::abs(dot(n, t)), std::abs(dot(n, b)), std::abs(dot(t, b)),
+                          std::abs(length(t) - 1), std::abs(length(b) - 1), length(cross(n, t) - b)});
+    }
+    LUMINA_CHECK(worst <= 16 * eps);
+}
+
+// Lengyel's per-triangle directions accumulated per vertex, Gram-Schmidt orthogonalized
+template <typename T>
+void referenceTangents(const Mesh<T> &mesh, const std::vector<Vector3<T>> &normals,
+                       std::vector<WideVector> &tangents, std::vector<Wide> &handedness)
+{
+    std::vector<WideVector> t(mesh.positions.size()), b(mesh.positions.size());
+    for (std::size_t f = 0; f < mesh.triangleCount(); ++f)
+    {
+        const std::uint32_t *v = mesh.indices.data() + 3 * f;
+        WideVector p0 = widen(mesh.positions[v[0]]);
+        WideVector e1 = widen(mesh.positions[v[1]]) - p0, e2 = widen(mesh.positions[v[2]]) - p0;
+        Wide du1 = Wide(mesh.uvs[v[1]].x) - mesh.uvs[v[0]].x, dv1 = Wide(mesh.uvs[v[1]].y) - mesh.uvs[v[0]].y;
+        Wide du2 = Wide(mesh.uvs[v[2]].x) - mesh.uvs[v[0]].x, dv2 = Wide(mesh.uvs[v[2]].y) - mesh.uvs[v[0]].y;
+        Wide det = du1 * dv2 - du2 * dv1;
+        if (det == 0)
+            continue;
+        WideVector ft{(e1.x * dv2 - e2.x * dv1) / det, (e1.y * dv2 - e2.y * dv1) / det,
+                      (e1.z * dv2 - e2.z * dv1) / det};
+        WideVector fb{(e2.x * du1 - e1.x * du2) / det, (e2.y * du1 - e1.y * du2) / det,
+                      (e2.z * du1 - e1.z * du2) / det};
+        for (int k = 0; k < 3; ++k)
+        {
+            t[v[k]] = {t[v[k]].x + ft.x, t[v[k]].y + ft.y, t[v[k]].z + ft.z};
+            b[v[k]] = {b[v[k]].x + fb.x, b[v[k]].y + fb.y, b[v[k]].z + fb.z};
+        }
+    }
+    tangents.resize(t.size());
+    handedness.resize(t.size());
+    for (std::size_t v = 0; v < t.size(); ++v)
+    {
+        WideVector n = widen(normals[v]);
+        Wide projection = dot(n, t[v]);
+        tangents[v] = normalized({t[v].x - n.x * projection, t[v].y - n.y * projection, t[v].z - n.z * projection});
+        handedness[v] = dot(cross(n, tangents[v]), b[v]) < 0 ? -1 : 1;
+    }
+}
+
+template <typename T>
+void testVertexTangents(const Mesh<T> &mesh)
+{
+    const Wide eps = std::numeric_limits<T>::epsilon();
+    std::size_t vertexCount = mesh.positions.size();
+    std::size_t gridCount = vertexCount - 4;
+    VertexFaceAdjacency adjacency(mesh.indices.data(), mesh.triangleCount(), vertexCount);
+    std::vector<Vector3<T>> normals(vertexCount);
+    vertexNormals(mesh.positions.data(), mesh.indices.data(), mesh.triangleCount(), adjacency, normals.data());
+
+    std::vector<Vector4<T>> tangents(vertexCount), tangents4(vertexCount);
+    vertexTangents(mesh.positions.data(), normals.data(), mesh.uvs.data(), mesh.indices.data(), mesh.triangleCount(),
+                   adjacency, tangents.data(), 1);
+    vertexTangents(mesh.positions.data(), normals.data(), mesh.uvs.data(), mesh.indices.data(), mesh.triangleCount(),
+                   adjacency, tangents4.data(), 4);
+    LUMINA_CHECK(sameBits(tangents, tangents4));
+
+    std::vector<WideVector> expected;
+    std::vector<Wide> handedness;
+    referenceTangents(mesh, normals, expected, handedness);
+    Wide worst = 0;
+    bool signs = true;
+    for (std::size_t v = 0; v < gridCount; ++v)
+    {
+        worst = std::max(worst, distance(Vector3<T>(tangents[v].x, tangents[v].y, tangents[v].z), expected[v]));
+        signs &= Wide(tangents[v].w) == handedness[v];
+    }
+    LUMINA_CHECK(worst <= 4096 * eps);
+    LUMINA_CHECK(signs);
+
+    // Vertices with only degenerate UVs (and the zero normal of the unused one) still get a unit frame
+    for (std::size_t v = gridCount; v < vertexCount; ++v)
+        LUMINA_CHECK(std::isfinite(tangents[v].x) && tangents[v].w == T(1));
+}
+
+// A flat quad facing +z: u along +x gives tangent +x, mirrored u gives -x with negative handedness,
+// and a collapsed UV mapping falls back to the orthonormalBasis tangent
+template <typename T>
+void testTangentCases()
+{
+    std::vector<Vector3<T>> positions{{T(0), T(0), T(0)}, {T(1), T(0), T(0)}, {T(1), T(1), T(0)}, {T(0), T(1), T(0)}};
+    std::vector<Vector3<T>> normals(4, Vector3<T>(T(0), T(0), T(1)));
+    std::vector<std::uint32_t> indices{0, 1, 2, 0, 2, 3};
+    VertexFaceAdjacency adjacency(indices.data(), 2, 4);
+
+    struct Case
+    {
+        T uScale;
+        T expectedX;
+        T expectedW;
+    };
+    for (Case c : {Case{T(1), T(1), T(1)}, Case{T(-1), T(-1), T(-1)}, Case{T(0), T(1), T(1)}})
+    {
+        std::vector<Vector2<T>> uvs;
+        for (const Vector3<T> &p : positions)
+            uvs.emplace_back(p.x * c.uScale, c.uScale == T(0) ? T(0) : p.y);
+        std::vector<Vector4<T>> tangents(4);
+        vertexTangents(positions.data(), normals.data(), uvs.data(), indices.data(), 2, adjacency, tangents.data());
+        bool matches = true;
+        for (const Vector4<T> &t : tangents)
+            matches &= t.x == c.expectedX && t.y == T(0) && t.z == T(0) && t.w == c.expectedW;
+        LUMINA_CHECK(matches);
+    }
+}
+
+// Interleaved vertices read and written through strided views match the contiguous overloads bit for bit
+template <typename T>
+struct Vertex
+{
+    Vector3<T> position;
+    Vector3<T> normal;
+    Vector2<T> uv;
+    Vector4<T> tangent;
+    Vector3<T> bitangent;
+};
+
+template <typename T>
+void testStrided(const Mesh<T> &mesh)
+{
+    std::size_t vertexCount = mesh.positions.size(), triangleCount = mesh.triangleCount();
+    VertexFaceAdjacency adjacency(mesh.indices.data(), triangleCount, vertexCount);
+    std::vector<Vertex<T>> vertices(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; ++v)
+    {
+        vertices[v].position = mesh.positions[v];
+        vertices[v].uv = mesh.uvs[v];
+    }
+    const std::size_t stride = sizeof(Vertex<T>);
+    StridedView<Vector3<T>> positions(vertices.data(), vertexCount, stride, offsetof(Vertex<T>, position));
+    StridedRef<Vector3<T>> normals(vertices.data(), vertexCount, stride, offsetof(Vertex<T>, normal));
+    StridedView<Vector2<T>> uvs(vertices.data(), vertexCount, stride, offsetof(Vertex<T>, uv));
+    StridedRef<Vector4<T>> tangents(vertices.data(), vertexCount, stride, offsetof(Vertex<T>, tangent));
+    StridedRef<Vector3<T>> bitangents(vertices.data(), vertexCount, stride, offsetof(Vertex<T>, bitangent));
+
+    std::vector<Vector3<T>> faces(triangleCount), stridedFaces(triangleCount);
+    faceNormals(mesh.positions.data(), mesh.indices.data(), triangleCount, faces.data());
+    faceNormals(positions, mesh.indices.data(), triangleCount, stridedFaces.data());
+    LUMINA_CHECK(sameBits(faces, stridedFaces));
+
+    std::vector<Vector3<T>> expectedNormals(vertexCount), expectedBitangents(vertexCount),
+        expectedBasis(vertexCount);
+    std::vector<Vector4<T>> expectedTangents(vertexCount);
+    vertexNormals(mesh.positions.data(), mesh.indices.data(), triangleCount, adjacency, expectedNormals.data(),
+                  NormalWeighting::Angle);
+    vertexNormals(positions, mesh.indices.data(), triangleCount, adjacency, normals, NormalWeighting::Angle);
+    vertexTangents(mesh.positions.data(), expectedNormals.data(), mesh.uvs.data(), mesh.indices.data(),
+                   triangleCount, adjacency, expectedTangents.data());
+    vertexTangents(positions, normals.view(), uvs, mesh.indices.data(), triangleCount, adjacency, tangents);
+    orthonormalBasis(expectedNormals.data(), vertexCount, expectedBasis.data(), expectedBitangents.data());
+    StridedRef<Vector3<T>> basis(expectedBasis.data(), vertexCount);
+    orthonormalBasis(normals.view(), basis, bitangents);
+
+    bool matches = true;
+    for (std::size_t v = 0; v < vertexCount; ++v)
+    {
+        matches &= std::memcmp(&vertices[v].normal, &expectedNormals[v], sizeof(Vector3<T>)) == 0;
+        matches &= std::memcmp(&vertices[v].tangent, &expectedTangents[v], sizeof(Vector4<T>)) == 0;
+        matches &= std::memcmp(&vertices[v].bitangent, &expectedBitangents[v], sizeof(Vector3<T>)) == 0;
+    }
+    LUMINA_CHECK(matches);
+
+    LUMINA_CHECK_THROWS(std::invalid_argument, vertexNormals(positions.subview(0, vertexCount - 1),
+                                                             mesh.indices.data(), triangleCount, adjacency, normals));
+    LUMINA_CHECK_THROWS(std::invalid_argument,
+                        orthonormalBasis(normals.view(), basis.subview(0, vertexCount - 1), bitangents));
+}
+
+template <typename T>
+void testNormals()
+{
+    std::mt19937_64 engine(33);
+    // 80 x 80 vertices give more triangles than one thread takes, so the 4-thread runs really split
+    Mesh<T> mesh = gridMesh<T>(80, engine);
+    testAdjacency(mesh);
+    testFaceNormals(mesh);
+    testVertexNormals(mesh);
+    testOrthonormalBasis<T>(engine);
+    testVertexTangents(mesh);
+    testTangentCases<T>();
+    testStrided(mesh);
+}
+
+} // namespace
+
+int main()
+{
+    testNormals<float>();
+    testNormals<double>();
+    return test::finish();
+}
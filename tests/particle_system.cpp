@@ -0,0 +1,209 @@
+// Particle integration against closed-form trajectories, the boundary rules, per-particle
+// accelerations, thread-count independence and the argument checks.
+
+#include "check.hpp"
+#include <lumina/physics/particle_system.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+template <typename T>
+bool near(T value, T exact, T tolerance)
+{
+    return std::abs(value - exact) <= tolerance * (T(1) + std::abs(exact));
+}
+
+template <typename T>
+bool near(const Vector3<T> &value, const Vector3<T> &exact, T tolerance)
+{
+    return near(value.x, exact.x, tolerance) && near(value.y, exact.y, tolerance) &&
+           near(value.z, exact.z, tolerance);
+}
+
+// Under constant acceleration Verlet and RK4 are exact; semi-implicit Euler gains a dt^2 n(n+1)/2 term
+// in place of the (n dt)^2 / 2 of the exact parabola
+template <typename T>
+void testConstantAcceleration()
+{
+    const T tolerance = sizeof(T) == sizeof(float) ? T(1e-5) : T(1e-12);
+    const T dt = T(1) / T(64);
+    const int steps = 64;
+    const Vector3<T> a(T(0.5), T(-9.81), T(2)), x0(T(1), T(2), T(3)), v0(T(-1), T(4), T(0.25));
+
+    for (Integrator integrator : {Integrator::SemiImplicitEuler, Integrator::Verlet, Integrator::RungeKutta4})
+    {
+        // Enough particles for full packs and a tail
+        ParticleSystem<T> system;
+        for (int i = 0; i < 19; ++i)
+            system.add(x0, v0);
+        system.acceleration = a;
+        for (int s = 0; s < steps; ++s)
+            system.step(dt, integrator, 1);
+
+        T t = dt * steps;
+        T n = T(steps);
+        T quadratic = integrator == Integrator::SemiImplicitEuler ? dt * dt * n * (n + T(1)) / T(2) : t * t / T(2);
+        Vector3<T> x = x0 + v0 * t + a * quadratic;
+        Vector3<T> v = v0 + a * t;
+        bool exact = true;
+        for (std::size_t i = 0; i < system.size(); ++i)
+            exact &= near(system.positions.get(i), x, tolerance) && near(system.velocities.get(i), v, tolerance);
+        LUMINA_CHECK(exact);
+    }
+}
+
+// Pure drag: v' = -drag v, so v(t) = v0 e^(-drag t) and x(t) = x0 + v0 (1 - e^(-drag t)) / drag.
+// RK4 is fourth order; the others are checked at first order.
+template <typename T>
+void testDrag()
+{
+    const T dt = T(1) / T(100);
+    const T drag = T(0.8);
+    const int steps = 100;
+    for (Integrator integrator : {Integrator::SemiImplicitEuler, Integrator::Verlet, Integrator::RungeKutta4})
+    {
+        ParticleSystem<T> system;
+        system.add(Vector3<T>(), Vector3<T>(T(3), T(-2), T(1)));
+        system.drag = drag;
+        for (int s = 0; s < steps; ++s)
+            system.step(dt, integrator);
+
+        T decay = std::exp(-drag * dt * steps);
+        Vector3<T> v = Vector3<T>(T(3), T(-2), T(1)) * decay;
+        Vector3<T> x = Vector3<T>(T(3), T(-2), T(1)) * ((T(1) - decay) / drag);
+        T tolerance = integrator == Integrator::RungeKutta4 ? (sizeof(T) == sizeof(float) ? T(1e-5) : T(1e-9))
+                                                            : T(1e-2);
+        LUMINA_CHECK(near(system.velocities.get(0), v, tolerance));
+        LUMINA_CHECK(near(system.positions.get(0), x, tolerance));
+    }
+}
+
+template <typename T>
+void testBoundaries()
+{
+    ParticleSystem<T> system;
+    system.bounds = Bounds3<T>(Vector3<T>(T(-1), T(-1), T(-1)), Vector3<T>(T(1), T(1), T(1)));
+    // Leaving through +x, -y and +z by 0.5 in one unit step; staying inside
+    system.add(Vector3<T>(T(0.5), T(0), T(0)), Vector3<T>(T(1), T(0), T(0)));
+    system.add(Vector3<T>(T(0), T(-0.5), T(0)), Vector3<T>(T(0), T(-1), T(0)));
+    system.add(Vector3<T>(T(0), T(0), T(0.75)), Vector3<T>(T(0.25), T(0), T(0.75)));
+    system.add(Vector3<T>(T(0), T(0), T(0)), Vector3<T>(T(0.5), T(0.5), T(0.5)));
+
+    ParticleSystem<T> clamped = system;
+    clamped.boundaryMode = BoundaryMode::Clamp;
+    clamped.step(T(1));
+    LUMINA_CHECK(clamped.positions.get(0) == Vector3<T>(T(1), T(0), T(0)));
+    LUMINA_CHECK(clamped.velocities.get(0) == Vector3<T>(T(0), T(0), T(0)));
+    LUMINA_CHECK(clamped.positions.get(1) == Vector3<T>(T(0), T(-1), T(0)));
+    LUMINA_CHECK(clamped.velocities.get(1) == Vector3<T>(T(0), T(0), T(0)));
+    LUMINA_CHECK(clamped.positions.get(2) == Vector3<T>(T(0.25), T(0), T(1)));
+    LUMINA_CHECK(clamped.velocities.get(2) == Vector3<T>(T(0.25), T(0), T(0)));
+    LUMINA_CHECK(clamped.positions.get(3) == Vector3<T>(T(0.5), T(0.5), T(0.5)));
+
+    ParticleSystem<T> reflected = system;
+    reflected.boundaryMode = BoundaryMode::Reflect;
+    reflected.restitution = T(0.5);
+    reflected.step(T(1));
+    LUMINA_CHECK(reflected.positions.get(0) == Vector3<T>(T(0.5), T(0), T(0)));
+    LUMINA_CHECK(reflected.velocities.get(0) == Vector3<T>(T(-0.5), T(0), T(0)));
+    LUMINA_CHECK(reflected.positions.get(1) == Vector3<T>(T(0), T(-0.5), T(0)));
+    LUMINA_CHECK(reflected.velocities.get(1) == Vector3<T>(T(0), T(0.5), T(0)));
+    LUMINA_CHECK(reflected.positions.get(2) == Vector3<T>(T(0.25), T(0), T(0.5)));
+    LUMINA_CHECK(reflected.velocities.get(2) == Vector3<T>(T(0.25), T(0), T(-0.375)));
+    LUMINA_CHECK(reflected.velocities.get(3) == Vector3<T>(T(0.5), T(0.5), T(0.5)));
+
+    // An overshoot larger than the box still ends inside it
+    ParticleSystem<T> fast = reflected;
+    fast.velocities.set(0, Vector3<T>(T(100), T(0), T(0)));
+    fast.step(T(1));
+    LUMINA_CHECK(system.bounds.contains(fast.positions.get(0)));
+}
+
+template <typename T>
+void testFieldAndThreads()
+{
+    const std::size_t count = 100003;
+    ParticleSystem<T> system(count);
+    system.accelerations.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        T f = T(i % 97) / T(97);
+        system.positions.set(i, Vector3<T>(f, -f, T(2) * f));
+        system.velocities.set(i, Vector3<T>(T(1) - f, f, T(0)));
+        system.accelerations.set(i, Vector3<T>(T(0), T(0), f));
+    }
+    system.acceleration = Vector3<T>(T(0), T(-1), T(0));
+    system.drag = T(0.1);
+
+    for (Integrator integrator : {Integrator::SemiImplicitEuler, Integrator::Verlet, Integrator::RungeKutta4})
+    {
+        ParticleSystem<T> single = system, multi = system;
+        single.step(T(0.01), integrator, 1);
+        multi.step(T(0.01), integrator, 4);
+        LUMINA_CHECK(single.positions.x == multi.positions.x && single.positions.y == multi.positions.y &&
+                     single.positions.z == multi.positions.z);
+        LUMINA_CHECK(single.velocities.z == multi.velocities.z);
+
+        // The per-particle term adds to the uniform acceleration
+        ParticleSystem<T> uniformOnly = system;
+        uniformOnly.accelerations.clear();
+        uniformOnly.step(T(0.01), integrator, 1);
+        LUMINA_CHECK(single.velocities.z[0] == uniformOnly.velocities.z[0]);
+        LUMINA_CHECK(single.velocities.z[50] > uniformOnly.velocities.z[50]);
+        LUMINA_CHECK(single.velocities.y[50] == uniformOnly.velocities.y[50]);
+    }
+}
+
+template <typename T>
+void testErrors()
+{
+    ParticleSystem<T> system(4);
+    system.velocities.resize(3);
+    LUMINA_CHECK_THROWS(std::logic_error, system.step(T(0.1)));
+
+    system = ParticleSystem<T>(4);
+    system.accelerations.resize(2);
+    LUMINA_CHECK_THROWS(std::logic_error, system.step(T(0.1)));
+
+    system = ParticleSystem<T>(4);
+    system.boundaryMode = BoundaryMode::Clamp;
+    system.bounds = Bounds3<T>::empty();
+    LUMINA_CHECK_THROWS(std::logic_error, system.step(T(0.1)));
+
+    std::vector<Vector3<T>> positions(4), velocities(3);
+    system.boundaryMode = BoundaryMode::None;
+    LUMINA_CHECK_THROWS(std::invalid_argument, system.step(T(0.1), StridedRef<Vector3<T>>(positions.data(), 4),
+                                                           StridedRef<Vector3<T>>(velocities.data(), 3)));
+
+    // add() and resize() keep an attached acceleration buffer in step
+    system = ParticleSystem<T>(2);
+    system.accelerations.resize(2);
+    system.add(Vector3<T>(), Vector3<T>());
+    LUMINA_CHECK(system.accelerations.size() == 3);
+    system.resize(5);
+    LUMINA_CHECK(system.size() == 5 && system.velocities.size() == 5 && system.accelerations.size() == 5);
+}
+
+} // namespace
+
+int main()
+{
+    testConstantAcceleration<float>();
+    testConstantAcceleration<double>();
+    testDrag<float>();
+    testDrag<double>();
+    testBoundaries<float>();
+    testBoundaries<double>();
+    testFieldAndThreads<float>();
+    testFieldAndThreads<double>();
+    testErrors<float>();
+    testErrors<double>();
+    return test::finish();
+}
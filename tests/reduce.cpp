@@ -0,0 +1,149 @@
+// Point set reductions against a long double two-pass reference, on inputs far from the origin where
+// naive float sums and one-pass covariance lose most of their digits.
+
+#include "check.hpp"
+#include <lumina/batch/reduce.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+struct Reference
+{
+    long double sum[3] = {};
+    long double mean[3] = {};
+    long double covariance[3][3] = {};
+    long double lo[3], hi[3];
+};
+
+template <typename T>
+Reference reference(const std::vector<Vector3<T>> &points)
+{
+    Reference r;
+    for (int k = 0; k < 3; ++k)
+    {
+        r.lo[k] = std::numeric_limits<long double>::infinity();
+        r.hi[k] = -r.lo[k];
+    }
+    for (const Vector3<T> &p : points)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            r.sum[k] += p[k];
+            r.lo[k] = std::min<long double>(r.lo[k], p[k]);
+            r.hi[k] = std::max<long double>(r.hi[k], p[k]);
+        }
+    }
+    for (int k = 0; k < 3; ++k)
+        r.mean[k] = points.empty() ? 0 : r.sum[k] / points.size();
+    for (const Vector3<T> &p : points)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+                r.covariance[i][j] += (p[i] - r.mean[i]) * (p[j] - r.mean[j]) / points.size();
+        }
+    }
+    return r;
+}
+
+// Within `ulps` units in the last place of T at the magnitude of the exact value. x87 excess precision
+// (FLT_EVAL_METHOD 2) rounds the compensated sums' error terms inconsistently, costing a few more.
+template <typename T>
+bool close(T value, long double exact, long double ulps)
+{
+    if (FLT_EVAL_METHOD == 2)
+        ulps *= 4;
+    long double ulp = std::numeric_limits<T>::epsilon() * std::fabs(exact);
+    return std::fabs(value - exact) <= ulps * ulp + std::numeric_limits<T>::denorm_min();
+}
+
+template <typename T>
+void checkStats(const PointStats<T> &stats, const Reference &r, std::size_t count)
+{
+    LUMINA_CHECK(stats.count == count);
+    for (int k = 0; k < 3; ++k)
+    {
+        LUMINA_CHECK(close(stats.sum[k], r.sum[k], 2));
+        LUMINA_CHECK(close(stats.mean[k], r.mean[k], 2));
+        LUMINA_CHECK(stats.bounds.min[k] == r.lo[k]);
+        LUMINA_CHECK(stats.bounds.max[k] == r.hi[k]);
+        for (int j = 0; j < 3; ++j)
+        {
+            // Relative to the spread, since off-diagonal terms can be near zero
+            long double scale = std::sqrt(r.covariance[k][k] * r.covariance[j][j]);
+            LUMINA_CHECK(std::fabs(stats.covariance[k][j] - r.covariance[k][j]) <= 1e-4L * scale);
+            LUMINA_CHECK(stats.covariance[k][j] == stats.covariance[j][k]);
+        }
+    }
+}
+
+template <typename T>
+void testReduce(std::size_t count)
+{
+    std::mt19937_64 engine(count);
+    std::normal_distribution<T> noise(T(0), T(1));
+    std::vector<Vector3<T>> points(count);
+    for (Vector3<T> &p : points)
+    {
+        T x = noise(engine);
+        p = Vector3<T>(T(1000) + x, T(-5) + T(2) * noise(engine), T(-250) + T(3) * noise(engine) + T(0.5) * x);
+    }
+    Reference r = reference(points);
+    Vector3SoA<T> soa(points.data(), count);
+    StridedView<Vector3<T>> strided(points.data(), count);
+
+    for (unsigned threads : {1u, 4u})
+    {
+        checkStats(pointStats(points.data(), count, threads), r, count);
+        checkStats(pointStats(soa.view(), threads), r, count);
+        checkStats(pointStats(strided, threads), r, count);
+
+        Vector3<T> sums[3] = {sum(points.data(), count, threads), sum(soa.view(), threads), sum(strided, threads)};
+        Vector3<T> centroids[3] = {centroid(points.data(), count, threads), centroid(soa.view(), threads),
+                                   centroid(strided, threads)};
+        Bounds3<T> boxes[3] = {bounds(points.data(), count, threads), bounds(soa.view(), threads),
+                               bounds(strided, threads)};
+        for (int s = 0; s < 3; ++s)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                LUMINA_CHECK(close(sums[s][k], r.sum[k], 2));
+                LUMINA_CHECK(close(centroids[s][k], r.mean[k], 2));
+                LUMINA_CHECK(boxes[s].min[k] == r.lo[k] && boxes[s].max[k] == r.hi[k]);
+            }
+        }
+    }
+}
+
+template <typename T>
+void testEmpty()
+{
+    Vector3SoA<T> none;
+    LUMINA_CHECK(pointStats(none.view()).count == 0);
+    LUMINA_CHECK(sum(none.view()) == Vector3<T>());
+    LUMINA_CHECK(centroid(none.view()) == Vector3<T>());
+    LUMINA_CHECK(bounds(none.view()) == Bounds3<T>::empty());
+}
+
+} // namespace
+
+int main()
+{
+    for (std::size_t count : {1, 13, 1000, 100003, 1000003})
+    {
+        testReduce<float>(count);
+        testReduce<double>(count);
+    }
+    testEmpty<float>();
+    testEmpty<double>();
+    return test::finish();
+}
@@ -0,0 +1,255 @@
+// Philox4x32-10 against the Random123 known-answer vectors, and the batch samplers against scalar
+// long double mappings of the same uniforms: placement on the target domain, independence from the
+// thread count and the call split, stream separation, and the first moments of each distribution.
+
+#include "check.hpp"
+#include <lumina/random/philox.hpp>
+#include <lumina/random/sampling.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+using Wide = long double;
+
+const Wide pi = 3.141592653589793238462643383279502884L;
+
+template <typename T>
+bool sameBits(const std::vector<T> &a, const std::vector<T> &b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+void testPhilox()
+{
+    struct Known
+    {
+        std::uint32_t counter[4];
+        std::uint64_t key;
+        Philox4x32::Block expected;
+    };
+    // Random123 kat_vectors, philox4x32 with 10 rounds; the key is (low word, high word)
+    const Known known[] = {
+        {{0, 0, 0, 0}, 0, {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+        {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+         0xffffffffffffffff,
+         {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+        {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+         0x299f31d0a4093822,
+         {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}},
+    };
+    for (const Known &k : known)
+    {
+        Philox4x32 rng(k.key, k.counter[2]);
+        std::uint64_t counter = std::uint64_t(k.counter[1]) << 32 | k.counter[0];
+        LUMINA_CHECK(rng.generate(counter, k.counter[3]) == k.expected);
+    }
+    LUMINA_CHECK(Philox4x32().generate(0) == known[0].expected);
+}
+
+// The d-th uniform of sample `counter`, as the samplers derive it from the Philox blocks
+template <typename T>
+T uniform(const Philox4x32 &rng, std::uint64_t counter, std::size_t d)
+{
+    auto word = [&](std::size_t w) { return rng.generate(counter, std::uint32_t(w / 4))[w % 4]; };
+    if constexpr (sizeof(T) == 4)
+        return T(word(d) >> 8) * T(0x1p-24);
+    else
+        return T((std::uint64_t(word(2 * d)) << 21) | (word(2 * d + 1) >> 11)) * T(0x1p-53);
+}
+
+template <typename T>
+void testUniform(const Philox4x32 &rng)
+{
+    const std::uint64_t offset = 1000;
+    std::vector<T> values(10007);
+    sampleUniform(rng, offset, values.data(), values.size());
+    bool matches = true, inRange = true;
+    Wide mean = 0;
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        matches &= values[i] == uniform<T>(rng, offset + i, 0);
+        inRange &= values[i] >= T(0) && values[i] < T(1);
+        mean += values[i];
+    }
+    LUMINA_CHECK(matches && inRange);
+    // Standard error of the mean is 1 / sqrt(12 n), about 0.003
+    LUMINA_CHECK(std::abs(mean / Wide(values.size()) - Wide(0.5)) < Wide(0.015));
+
+    // Any split of the counter range and any thread count give the same samples
+    std::vector<T> split(values.size()), threaded(values.size());
+    sampleUniform(rng, offset, split.data(), 13, 1);
+    sampleUniform(rng, offset + 13, split.data() + 13, split.size() - 13, 1);
+    LUMINA_CHECK(sameBits(split, values));
+    sampleUniform(rng, offset, threaded.data(), threaded.size(), 4);
+    LUMINA_CHECK(sameBits(threaded, values));
+
+    // Another stream or seed gives other samples
+    std::vector<T> other(values.size());
+    sampleUniform(Philox4x32(rng.seed, rng.stream + 1), offset, other.data(), other.size());
+    LUMINA_CHECK(!sameBits(other, values));
+    sampleUniform(Philox4x32(rng.seed + 1, rng.stream), offset, other.data(), other.size());
+    LUMINA_CHECK(!sameBits(other, values));
+
+    // Counter ranges that would wrap around are refused; the last counter itself is usable
+    T value;
+    LUMINA_CHECK_THROWS(std::length_error, sampleUniform(rng, ~std::uint64_t(0), &value, 2));
+    sampleUniform(rng, ~std::uint64_t(0), &value, 1);
+    LUMINA_CHECK(value == uniform<T>(rng, ~std::uint64_t(0), 0));
+}
+
+// `slack` widens the error bound of one sample beyond the common tolerance
+struct WideVector
+{
+    Wide x = 0, y = 0, z = 0;
+    Wide slack = 0;
+};
+
+// Direction at height z and azimuth 2 pi v - pi. The samplers round z * z before taking
+// sqrt(1 - z * z), which costs about eps / radius near the poles.
+template <typename T>
+WideVector ring(Wide z, Wide v)
+{
+    Wide radius = std::sqrt(std::max(Wide(0), 1 - z * z)), azimuth = 2 * pi * v - pi;
+    Wide slack = radius > 0 ? Wide(std::numeric_limits<T>::epsilon()) / radius : 0;
+    return {radius * std::cos(azimuth), radius * std::sin(azimuth), z, slack};
+}
+
+// Largest distance of out[i] from reference(i) past its slack, and the mean of the outputs
+template <typename T, typename V, typename Reference>
+Wide worstError(const std::vector<V> &out, Reference &&reference, WideVector &mean)
+{
+    Wide worst = 0;
+    mean = {};
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        WideVector expected = reference(i);
+        Wide x = out[i].x, y = out[i].y, z = 0;
+        if constexpr (sizeof(V) == 3 * sizeof(T))
+            z = out[i].z;
+        Wide error = std::max({std::abs(x - expected.x), std::abs(y - expected.y), std::abs(z - expected.z)});
+        worst = std::max(worst, error - expected.slack);
+        mean = {mean.x + x, mean.y + y, mean.z + z};
+    }
+    Wide n = Wide(out.size());
+    mean = {mean.x / n, mean.y / n, mean.z / n};
+    return worst;
+}
+
+bool near(const WideVector &mean, Wide x, Wide y, Wide z, Wide tolerance)
+{
+    return std::abs(mean.x - x) < tolerance && std::abs(mean.y - y) < tolerance && std::abs(mean.z - z) < tolerance;
+}
+
+template <typename T>
+void testShapes(const Philox4x32 &rng)
+{
+    const std::uint64_t offset = 77;
+    const std::size_t count = 20011;
+    // The azimuth's sin and cos bound the error, with the same budgets as in tests/math.cpp: a few ulp of T
+    // when Precise; when Fast, 5e-5 absolute for float and a few ulp of float for double
+    for (MathAccuracy accuracy : {MathAccuracy::Fast, MathAccuracy::Precise})
+    {
+        const Wide eps = std::numeric_limits<T>::epsilon(), floatEps = std::numeric_limits<float>::epsilon();
+        const Wide tolerance = accuracy == MathAccuracy::Precise ? 16 * eps
+                               : sizeof(T) == sizeof(float)      ? Wide(5e-5)
+                                                                 : 16 * floatEps;
+        auto u = [&](std::size_t i, std::size_t d) { return Wide(uniform<T>(rng, offset + i, d)); };
+        WideVector mean;
+
+        std::vector<Vector3<T>> sphere(count), sphere4(count);
+        sampleSphere(rng, offset, sphere.data(), count, accuracy, 1);
+        LUMINA_CHECK(worstError<T>(sphere, [&](std::size_t i) { return ring<T>(1 - 2 * u(i, 0), u(i, 1)); }, mean) <=
+                     tolerance);
+        LUMINA_CHECK(near(mean, 0, 0, 0, 0.03));
+        sampleSphere(rng, offset, sphere4.data(), count, accuracy, 4);
+        LUMINA_CHECK(sameBits(sphere, sphere4));
+
+        // Radius distributed as r^3, so the mean radius is 3/4
+        std::vector<Vector3<T>> ball(count);
+        sampleBall(rng, offset, ball.data(), count, accuracy);
+        LUMINA_CHECK(worstError<T>(ball, [&](std::size_t i)
+        {
+            WideVector d = ring<T>(1 - 2 * u(i, 0), u(i, 1));
+            Wide radius = std::max({u(i, 2), u(i, 3), u(i, 4)});
+            return WideVector{d.x * radius, d.y * radius, d.z * radius, d.slack};
+        }, mean) <= tolerance);
+        LUMINA_CHECK(near(mean, 0, 0, 0, 0.03));
+        Wide radius = 0;
+        for (const Vector3<T> &p : ball)
+            radius += std::sqrt(Wide(p.x) * p.x + Wide(p.y) * p.y + Wide(p.z) * p.z);
+        LUMINA_CHECK(std::abs(radius / Wide(count) - Wide(0.75)) < Wide(0.01));
+
+        // Mean height 1/2 for the uniform hemisphere, 2/3 for the cosine-weighted one
+        for (HemisphereDistribution distribution : {HemisphereDistribution::Uniform, HemisphereDistribution::Cosine})
+        {
+            bool cosine = distribution == HemisphereDistribution::Cosine;
+            std::vector<Vector3<T>> hemisphere(count);
+            sampleHemisphere(rng, offset, hemisphere.data(), count, distribution, accuracy);
+            LUMINA_CHECK(worstError<T>(hemisphere, [&](std::size_t i)
+            {
+                if (!cosine)
+                    return ring<T>(1 - u(i, 0), u(i, 1));
+                Wide r = std::sqrt(u(i, 0)), azimuth = 2 * pi * u(i, 1) - pi;
+                return WideVector{r * std::cos(azimuth), r * std::sin(azimuth), std::sqrt(1 - u(i, 0))};
+            }, mean) <= tolerance);
+            LUMINA_CHECK(near(mean, 0, 0, cosine ? Wide(2) / 3 : Wide(0.5), 0.02));
+            LUMINA_CHECK(std::all_of(hemisphere.begin(), hemisphere.end(), [](const Vector3<T> &p) {
+                return p.z > T(0);
+            }));
+        }
+
+        std::vector<Vector2<T>> disk(count);
+        sampleDisk(rng, offset, disk.data(), count, accuracy);
+        LUMINA_CHECK(worstError<T>(disk, [&](std::size_t i)
+        {
+            Wide r = std::sqrt(u(i, 0)), azimuth = 2 * pi * u(i, 1) - pi;
+            return WideVector{r * std::cos(azimuth), r * std::sin(azimuth)};
+        }, mean) <= tolerance);
+        LUMINA_CHECK(near(mean, 0, 0, 0, 0.02));
+    }
+
+    // min + u * size per axis, inside the box
+    const Bounds3<T> box(Vector3<T>(T(-1), T(2), T(0.5)), Vector3<T>(T(3), T(2.5), T(10)));
+    std::vector<Vector3<T>> points(count);
+    sampleBox(rng, offset, box, points.data(), count);
+    bool inside = true;
+    WideVector mean;
+    Wide worst = worstError<T>(points, [&](std::size_t i)
+    {
+        return WideVector{-1 + 4 * Wide(uniform<T>(rng, offset + i, 0)), 2 + Wide(0.5) * uniform<T>(rng, offset + i, 1),
+                          Wide(0.5) + Wide(9.5) * uniform<T>(rng, offset + i, 2)};
+    }, mean);
+    for (const Vector3<T> &p : points)
+        inside &= box.contains(p);
+    LUMINA_CHECK(inside && worst <= 16 * Wide(std::numeric_limits<T>::epsilon()));
+    LUMINA_CHECK(near(mean, 1, 2.25, 5.25, 0.1));
+    LUMINA_CHECK_THROWS(std::invalid_argument, sampleBox(rng, offset, Bounds3<T>::empty(), points.data(), count));
+}
+
+template <typename T>
+void testSampling()
+{
+    Philox4x32 rng(0x5eed0000cafe, 36);
+    testUniform<T>(rng);
+    testShapes<T>(rng);
+}
+
+} // namespace
+
+int main()
+{
+    testPhilox();
+    testSampling<float>();
+    testSampling<double>();
+    return test::finish();
+}
@@ -0,0 +1,202 @@
+// Morton and Hilbert encodings, quantization onto the grid (including clamped and NaN coordinates),
+// radix sorting and spatial sorting.
+
+#include "check.hpp"
+#include <lumina/batch/reduce.hpp>
+#include <lumina/spatial/radix_sort.hpp>
+#include <lumina/spatial/space_filling.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+void testMorton()
+{
+    LUMINA_CHECK(mortonEncode2(1, 0) == 1 && mortonEncode2(0, 1) == 2);
+    LUMINA_CHECK(mortonEncode2(0xFFFFFFFFu, 0xFFFFFFFFu) == ~std::uint64_t(0));
+    LUMINA_CHECK(mortonEncode3(1, 2, 4) == (1u | 1u << 4 | 1u << 8));
+    LUMINA_CHECK(mortonEncode3(0x1FFFFFu, 0x1FFFFFu, 0x1FFFFFu) == (std::uint64_t(1) << 63) - 1);
+
+    std::mt19937_64 engine(28);
+    for (int i = 0; i < 10000; ++i)
+    {
+        std::uint32_t x = std::uint32_t(engine()), y = std::uint32_t(engine()), z = std::uint32_t(engine());
+        std::uint32_t dx, dy, dz;
+        mortonDecode2(mortonEncode2(x, y), dx, dy);
+        LUMINA_CHECK(dx == x && dy == y);
+        mortonDecode3(mortonEncode3(x, y, z), dx, dy, dz);
+        LUMINA_CHECK(dx == (x & 0x1FFFFFu) && dy == (y & 0x1FFFFFu) && dz == (z & 0x1FFFFFu));
+    }
+}
+
+// The first (2^bits)^D Hilbert indices fill the cube at the origin, and consecutive indices are
+// face neighbours
+void testHilbert()
+{
+    constexpr std::uint32_t side2 = 16;
+    std::vector<std::uint64_t> cells2(side2 * side2, ~std::uint64_t(0));
+    for (std::uint32_t x = 0; x < side2; ++x)
+    {
+        for (std::uint32_t y = 0; y < side2; ++y)
+        {
+            std::uint64_t code = hilbertEncode2(x, y);
+            if (LUMINA_CHECK(code < cells2.size()))
+                cells2[code] = std::uint64_t(x) << 32 | y;
+        }
+    }
+    for (std::size_t i = 1; i < cells2.size(); ++i)
+    {
+        long dx = long(cells2[i] >> 32) - long(cells2[i - 1] >> 32);
+        long dy = long(cells2[i] & 0xFFFFFFFFu) - long(cells2[i - 1] & 0xFFFFFFFFu);
+        LUMINA_CHECK(std::labs(dx) + std::labs(dy) == 1);
+    }
+
+    constexpr std::uint32_t side3 = 8;
+    std::vector<std::uint32_t> cells3(side3 * side3 * side3, ~0u);
+    for (std::uint32_t x = 0; x < side3; ++x)
+    {
+        for (std::uint32_t y = 0; y < side3; ++y)
+        {
+            for (std::uint32_t z = 0; z < side3; ++z)
+            {
+                std::uint64_t code = hilbertEncode3(x, y, z);
+                if (LUMINA_CHECK(code < cells3.size()))
+                    cells3[code] = x << 16 | y << 8 | z;
+            }
+        }
+    }
+    for (std::size_t i = 1; i < cells3.size(); ++i)
+    {
+        long distance = 0;
+        for (int shift : {16, 8, 0})
+            distance += std::labs(long(cells3[i] >> shift & 0xFF) - long(cells3[i - 1] >> shift & 0xFF));
+        LUMINA_CHECK(distance == 1);
+    }
+}
+
+template <typename T>
+void testQuantization()
+{
+    constexpr std::uint32_t top3 = (1u << 21) - 1;
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    Bounds3<T> box(Vector3<T>(T(-1), T(0), T(2)), Vector3<T>(T(1), T(4), T(2)));
+    std::vector<Vector3<T>> points = {
+        box.min, box.max, Vector3<T>(T(0), T(2), T(2)),
+        // Outside the bounds on every side
+        Vector3<T>(T(-5), T(9), T(-3)),
+        Vector3<T>(nan, T(4), T(2)), Vector3<T>(T(1), nan, nan)};
+    // The z extent is empty, so every z lands in cell 0
+    std::vector<std::uint64_t> expected = {
+        mortonEncode3(0, 0, 0), mortonEncode3(top3, top3, 0), mortonEncode3(top3 / 2, top3 / 2, 0),
+        mortonEncode3(0, top3, 0), mortonEncode3(0, top3, 0), mortonEncode3(top3, 0, 0)};
+
+    std::vector<std::uint64_t> codes(points.size());
+    spaceFillingCodes(points.data(), points.size(), box, codes.data());
+    LUMINA_CHECK(codes == expected);
+
+    Vector3SoA<T> soa(points.data(), points.size());
+    codes.assign(points.size(), 0);
+    spaceFillingCodes(soa.view(), box, codes.data());
+    LUMINA_CHECK(codes == expected);
+
+    codes.assign(points.size(), 0);
+    spaceFillingCodes(StridedView<Vector3<T>>(points.data(), points.size()), box, codes.data());
+    LUMINA_CHECK(codes == expected);
+
+    // 2D codes use 32 bits per axis
+    std::vector<Vector2<T>> flat = {Vector2<T>(T(-1), T(0)), Vector2<T>(T(1), T(4)), Vector2<T>(nan, T(8))};
+    codes.resize(flat.size());
+    spaceFillingCodes(flat.data(), flat.size(), Vector2<T>(T(-1), T(0)), Vector2<T>(T(1), T(4)), codes.data());
+    LUMINA_CHECK(codes[0] == 0 && codes[1] == ~std::uint64_t(0) && codes[2] == mortonEncode2(0, 0xFFFFFFFFu));
+}
+
+void testRadixSort()
+{
+    std::mt19937_64 engine(280);
+    for (int keyBits : {12, 40, 64})
+    {
+        for (std::size_t count : {0, 1, 1000, 300000})
+        {
+            std::vector<std::uint64_t> keys(count);
+            // Few distinct low bits, so equal keys exercise stability
+            for (std::uint64_t &key : keys)
+                key = engine() & ~std::uint64_t(0xFF0);
+            std::vector<std::uint64_t> sorted = keys;
+            std::vector<std::uint32_t> permutation(count);
+            radixSort(sorted.data(), permutation.data(), count, 4, keyBits);
+
+            std::uint64_t mask = keyBits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << keyBits) - 1;
+            std::vector<std::uint32_t> expected(count);
+            std::iota(expected.begin(), expected.end(), 0u);
+            std::stable_sort(expected.begin(), expected.end(), [&](std::uint32_t a, std::uint32_t b)
+            {
+                return (keys[a] & mask) < (keys[b] & mask);
+            });
+            LUMINA_CHECK(permutation == expected);
+            bool keysFollow = true;
+            for (std::size_t i = 0; i < count; ++i)
+                keysFollow &= (sorted[i] & mask) == (keys[permutation[i]] & mask);
+            LUMINA_CHECK(keysFollow);
+        }
+    }
+}
+
+template <typename T>
+void testSpatialSort()
+{
+    std::mt19937_64 engine(2800);
+    std::uniform_real_distribution<T> coordinate(T(-10), T(10));
+    for (SpaceFillingCurve curve : {SpaceFillingCurve::Morton, SpaceFillingCurve::Hilbert})
+    {
+        std::vector<Vector3<T>> original(50000);
+        for (Vector3<T> &p : original)
+            p = Vector3<T>(coordinate(engine), coordinate(engine), coordinate(engine));
+
+        std::vector<Vector3<T>> points = original;
+        Vector3SoA<T> soa(original.data(), original.size());
+        std::vector<std::uint32_t> permutation = spatialSort(points.data(), points.size(), curve, 4);
+        LUMINA_CHECK(spatialSort(soa, curve, 4) == permutation);
+
+        bool follows = true;
+        for (std::size_t i = 0; i < points.size(); ++i)
+            follows &= points[i] == original[permutation[i]] && soa.get(i) == points[i];
+        LUMINA_CHECK(follows);
+
+        Bounds3<T> box = bounds(original.data(), original.size());
+        std::vector<std::uint64_t> codes(points.size());
+        spaceFillingCodes(points.data(), points.size(), box, codes.data(), curve);
+        LUMINA_CHECK(std::is_sorted(codes.begin(), codes.end()));
+
+        std::vector<Vector2<T>> flat(original.size());
+        for (std::size_t i = 0; i < flat.size(); ++i)
+            flat[i] = Vector2<T>(original[i].x, original[i].y);
+        std::vector<Vector2<T>> flatOriginal = flat;
+        permutation = spatialSort(flat.data(), flat.size(), curve, 4);
+        follows = true;
+        for (std::size_t i = 0; i < flat.size(); ++i)
+            follows &= flat[i] == flatOriginal[permutation[i]];
+        LUMINA_CHECK(follows);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    testMorton();
+    testHilbert();
+    testQuantization<float>();
+    testQuantization<double>();
+    testRadixSort();
+    testSpatialSort<float>();
+    testSpatialSort<double>();
+    return test::finish();
+}
@@ -0,0 +1,268 @@
+// StoreMode against itself: Streaming and Auto write the same bits as Regular for every batch math
+// function, transformBatch, normalizeBatch and the face and vertex normals, over counts around the
+// streamed block size, outputs off the 16-byte boundary, outputs of mismatched alignment, in-place calls
+// and any thread count. transformBatch is also checked against Matrix4 * Vector4 element by element.
+
+#include "check.hpp"
+#include <lumina/batch/math.hpp>
+#include <lumina/batch/transform.hpp>
+#include <lumina/mesh/normals.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+constexpr StoreMode modes[] = {StoreMode::Regular, StoreMode::Streaming, StoreMode::Auto};
+constexpr MathAccuracy accuracies[] = {MathAccuracy::Fast, MathAccuracy::Precise};
+constexpr std::size_t counts[] = {0, 1, 15, 64, 1000, 100003};
+
+template <typename V>
+bool sameBits(const V *a, const V *b, std::size_t count)
+{
+    return count == 0 || std::memcmp(a, b, count * sizeof(V)) == 0;
+}
+
+template <typename T>
+std::vector<T> uniform(std::mt19937_64 &engine, std::size_t count, T low, T high)
+{
+    std::uniform_real_distribution<T> distribution(low, high);
+    std::vector<T> values(count);
+    for (T &value : values)
+        value = distribution(engine);
+    return values;
+}
+
+template <typename T>
+using UnaryBatch = void (*)(const T *, T *, std::size_t, MathAccuracy, StoreMode);
+
+// Every mode writes the Regular bits, to an output at element offset 0 and 1 and in place
+template <typename T>
+void testUnary(UnaryBatch<T> batch, const std::vector<T> &in)
+{
+    std::size_t count = in.size();
+    for (MathAccuracy accuracy : accuracies)
+    {
+        std::vector<T> expected(count);
+        batch(in.data(), expected.data(), count, accuracy, StoreMode::Regular);
+        for (StoreMode mode : modes)
+        {
+            for (std::size_t offset : {std::size_t(0), std::size_t(1)})
+            {
+                std::vector<T> out(count + 1, T(-7));
+                batch(in.data(), out.data() + offset, count, accuracy, mode);
+                LUMINA_CHECK(sameBits(out.data() + offset, expected.data(), count));
+                LUMINA_CHECK(out[offset == 0 ? count : 0] == T(-7));
+            }
+            std::vector<T> inPlace(count + 1);
+            std::copy(in.begin(), in.end(), inPlace.begin() + 1);
+            batch(inPlace.data() + 1, inPlace.data() + 1, count, accuracy, mode);
+            LUMINA_CHECK(sameBits(inPlace.data() + 1, expected.data(), count));
+        }
+    }
+}
+
+template <typename T>
+void testMath(std::mt19937_64 &engine)
+{
+    for (std::size_t count : counts)
+    {
+        testUnary<T>(sinBatch<T>, uniform<T>(engine, count, T(-10), T(10)));
+        testUnary<T>(cosBatch<T>, uniform<T>(engine, count, T(-10), T(10)));
+        testUnary<T>(acosBatch<T>, uniform<T>(engine, count, T(-1.1), T(1.1)));
+        testUnary<T>(rsqrtBatch<T>, uniform<T>(engine, count, T(0.001), T(1000)));
+        testUnary<T>(expBatch<T>, uniform<T>(engine, count, T(-20), T(20)));
+
+        // sincos with both outputs sharing an alignment, and with sin and cos one element apart,
+        // which cannot stream and must still match
+        std::vector<T> angles = uniform<T>(engine, count, T(-10), T(10));
+        std::vector<T> y = uniform<T>(engine, count, T(-5), T(5)), x = uniform<T>(engine, count, T(-5), T(5));
+        for (MathAccuracy accuracy : accuracies)
+        {
+            std::vector<T> sinExpected(count), cosExpected(count), atanExpected(count);
+            sincosBatch(angles.data(), sinExpected.data(), cosExpected.data(), count, accuracy, StoreMode::Regular);
+            atan2Batch(y.data(), x.data(), atanExpected.data(), count, accuracy, StoreMode::Regular);
+            for (StoreMode mode : modes)
+            {
+                for (std::size_t cosOffset : {std::size_t(0), std::size_t(1)})
+                {
+                    std::vector<T> sinOut(count + 1), cosOut(count + 1);
+                    sincosBatch(angles.data(), sinOut.data(), cosOut.data() + cosOffset, count, accuracy, mode);
+                    LUMINA_CHECK(sameBits(sinOut.data(), sinExpected.data(), count));
+                    LUMINA_CHECK(sameBits(cosOut.data() + cosOffset, cosExpected.data(), count));
+                }
+                std::vector<T> atanOut(count + 1);
+                atan2Batch(y.data(), x.data(), atanOut.data() + 1, count, accuracy, mode);
+                LUMINA_CHECK(sameBits(atanOut.data() + 1, atanExpected.data(), count));
+            }
+        }
+    }
+
+    // Auto must stream past the threshold; kept to thresholds a test can allocate cheaply
+    std::size_t threshold = streamingThreshold();
+    LUMINA_CHECK(threshold > 0);
+    if (threshold <= (std::size_t(32) << 20))
+    {
+        std::vector<T> in = uniform<T>(engine, threshold / sizeof(T) + 1001, T(-10), T(10));
+        std::vector<T> regular(in.size()), automatic(in.size());
+        sinBatch(in.data(), regular.data(), in.size(), MathAccuracy::Fast, StoreMode::Regular);
+        sinBatch(in.data(), automatic.data(), in.size(), MathAccuracy::Fast, StoreMode::Auto);
+        LUMINA_CHECK(sameBits(automatic.data(), regular.data(), in.size()));
+    }
+}
+
+template <typename T>
+void testTransform(std::mt19937_64 &engine)
+{
+    Matrix4<T> matrix;
+    std::vector<T> entries = uniform<T>(engine, 16, T(-2), T(2));
+    for (int row = 0; row < 4; ++row)
+        for (int column = 0; column < 4; ++column)
+            matrix(row, column) = entries[std::size_t(row * 4 + column)];
+
+    for (std::size_t count : {std::size_t(0), std::size_t(1), std::size_t(15), std::size_t(64), std::size_t(1000),
+                              std::size_t(40009)})
+    {
+        std::vector<T> values = uniform<T>(engine, count * 4, T(-100), T(100));
+        std::vector<Vector4<T>> in(count);
+        std::vector<Vector3<T>> directions(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            in[i] = Vector4<T>(values[4 * i], values[4 * i + 1], values[4 * i + 2], values[4 * i + 3]);
+            directions[i] = i % 97 == 0 ? Vector3<T>(T(0)) : Vector3<T>(in[i].x, in[i].y, in[i].z);
+        }
+
+        std::vector<Vector4<T>> transformed(count);
+        for (std::size_t i = 0; i < count; ++i)
+            transformed[i] = matrix * in[i];
+        std::vector<Vector3<T>> fastExpected(count), preciseExpected(count);
+        normalizeBatch(directions.data(), fastExpected.data(), count, MathAccuracy::Fast, StoreMode::Regular, 1);
+        normalizeBatch(directions.data(), preciseExpected.data(), count, MathAccuracy::Precise, StoreMode::Regular,
+                       1);
+
+        for (StoreMode mode : modes)
+        {
+            for (unsigned threads : {1u, 4u})
+            {
+                for (std::size_t offset : {std::size_t(0), std::size_t(1)})
+                {
+                    std::vector<Vector4<T>> out(count + 1);
+                    transformBatch(matrix, in.data(), out.data() + offset, count, mode, threads);
+                    LUMINA_CHECK(sameBits(out.data() + offset, transformed.data(), count));
+
+                    std::vector<Vector3<T>> fast(count + 1), precise(count + 1);
+                    normalizeBatch(directions.data(), fast.data() + offset, count, MathAccuracy::Fast, mode,
+                                   threads);
+                    normalizeBatch(directions.data(), precise.data() + offset, count, MathAccuracy::Precise, mode,
+                                   threads);
+                    LUMINA_CHECK(sameBits(fast.data() + offset, fastExpected.data(), count));
+                    LUMINA_CHECK(sameBits(precise.data() + offset, preciseExpected.data(), count));
+                }
+            }
+        }
+    }
+}
+
+// A jittered height-field grid; 150 x 150 gives enough triangles and vertices for four threads
+template <typename T>
+void gridMesh(std::size_t side, std::mt19937_64 &engine, std::vector<Vector3<T>> &positions,
+              std::vector<std::uint32_t> &indices)
+{
+    std::uniform_real_distribution<T> jitter(T(-0.01), T(0.01));
+    positions.clear();
+    indices.clear();
+    for (std::size_t j = 0; j < side; ++j)
+    {
+        for (std::size_t i = 0; i < side; ++i)
+        {
+            T z = T(0.1) * std::sin(T(0.3) * T(i)) * std::cos(T(0.2) * T(j));
+            positions.emplace_back(T(i) * T(0.05) + jitter(engine), T(j) * T(0.05) + jitter(engine), z);
+        }
+    }
+    for (std::size_t j = 0; j + 1 < side; ++j)
+    {
+        for (std::size_t i = 0; i + 1 < side; ++i)
+        {
+            auto v = std::uint32_t(j * side + i), s = std::uint32_t(side);
+            indices.insert(indices.end(), {v, v + 1, v + s + 1, v, v + s + 1, v + s});
+        }
+    }
+}
+
+template <typename T>
+void testNormals(std::mt19937_64 &engine)
+{
+    std::vector<Vector3<T>> positions;
+    std::vector<std::uint32_t> indices;
+    for (std::size_t side : {std::size_t(2), std::size_t(9), std::size_t(150)})
+    {
+        gridMesh(side, engine, positions, indices);
+        std::size_t triangles = indices.size() / 3, vertices = positions.size();
+        VertexFaceAdjacency adjacency(indices.data(), triangles, vertices);
+
+        for (bool normalize : {false, true})
+        {
+            std::vector<Vector3<T>> expected(triangles);
+            faceNormals(positions.data(), indices.data(), triangles, expected.data(), normalize, StoreMode::Regular,
+                        1);
+            for (StoreMode mode : modes)
+            {
+                for (unsigned threads : {1u, 4u})
+                {
+                    for (std::size_t offset : {std::size_t(0), std::size_t(1)})
+                    {
+                        std::vector<Vector3<T>> out(triangles + 1);
+                        faceNormals(positions.data(), indices.data(), triangles, out.data() + offset, normalize, mode,
+                                    threads);
+                        LUMINA_CHECK(sameBits(out.data() + offset, expected.data(), triangles));
+                    }
+                }
+            }
+        }
+
+        for (NormalWeighting weighting : {NormalWeighting::Area, NormalWeighting::Angle})
+        {
+            std::vector<Vector3<T>> expected(vertices);
+            vertexNormals(positions.data(), indices.data(), triangles, adjacency, expected.data(), weighting,
+                          StoreMode::Regular, 1);
+            for (StoreMode mode : modes)
+            {
+                for (unsigned threads : {1u, 4u})
+                {
+                    for (std::size_t offset : {std::size_t(0), std::size_t(1)})
+                    {
+                        std::vector<Vector3<T>> out(vertices + 1);
+                        vertexNormals(positions.data(), indices.data(), triangles, adjacency, out.data() + offset,
+                                      weighting, mode, threads);
+                        LUMINA_CHECK(sameBits(out.data() + offset, expected.data(), vertices));
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void testStoreMode()
+{
+    std::mt19937_64 engine(44);
+    testMath<T>(engine);
+    testTransform<T>(engine);
+    testNormals<T>(engine);
+}
+
+} // namespace
+
+int main()
+{
+    testStoreMode<float>();
+    testStoreMode<double>();
+    return test::finish();
+}
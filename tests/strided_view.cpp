@@ -0,0 +1,316 @@
+// Strided views over interleaved vertex buffers: the view and iterator mechanics, and every strided
+// kernel overload against its contiguous (or SoA) counterpart run on copies of the same attributes.
+
+#include "check.hpp"
+#include <lumina/batch/angles.hpp>
+#include <lumina/batch/culling.hpp>
+#include <lumina/batch/predicates.hpp>
+#include <lumina/batch/reduce.hpp>
+#include <lumina/batch/strided_view.hpp>
+#include <lumina/spatial/space_filling.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+// Attributes interleaved the way a vertex buffer holds them, so no view is contiguous
+template <typename T>
+struct Vertex
+{
+    Vector3<T> position;
+    T weight;
+    Vector2<T> uv;
+    Vector3<T> normal;
+    Vector4<T> color;
+    Vector2<T> uvOut;
+    Vector3<T> normalOut;
+};
+
+template <typename T>
+bool sameBits(const std::vector<T> &a, const std::vector<T> &b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+template <typename V>
+bool sameBits(const V &a, const V &b)
+{
+    return std::memcmp(&a, &b, sizeof(V)) == 0;
+}
+
+template <typename T>
+struct Buffer
+{
+    std::vector<Vertex<T>> vertices;
+    std::vector<Vector3<T>> positions, normals;
+    std::vector<Vector2<T>> uvs;
+    std::vector<Vector4<T>> colors;
+
+    static constexpr std::size_t stride = sizeof(Vertex<T>);
+
+    StridedView<Vector3<T>> positionView() const
+    {
+        return {vertices.data(), vertices.size(), stride, offsetof(Vertex<T>, position)};
+    }
+    StridedView<Vector2<T>> uvView() const
+    {
+        return {vertices.data(), vertices.size(), stride, offsetof(Vertex<T>, uv)};
+    }
+    StridedView<Vector3<T>> normalView() const
+    {
+        return {vertices.data(), vertices.size(), stride, offsetof(Vertex<T>, normal)};
+    }
+    StridedView<Vector4<T>> colorView() const
+    {
+        return {vertices.data(), vertices.size(), stride, offsetof(Vertex<T>, color)};
+    }
+    StridedRef<Vector2<T>> uvOutRef()
+    {
+        return {vertices.data(), vertices.size(), stride, offsetof(Vertex<T>, uvOut)};
+    }
+    StridedRef<Vector3<T>> normalOutRef()
+    {
+        return {vertices.data(), vertices.size(), stride, offsetof(Vertex<T>, normalOut)};
+    }
+};
+
+// Random attributes, kept both interleaved and as separate contiguous arrays
+template <typename T>
+Buffer<T> makeBuffer(std::size_t count, std::mt19937_64 &engine)
+{
+    std::uniform_real_distribution<T> coordinate(T(-4), T(4));
+    Buffer<T> buffer;
+    buffer.vertices.resize(count);
+    for (Vertex<T> &v : buffer.vertices)
+    {
+        v.position = Vector3<T>(coordinate(engine), coordinate(engine), coordinate(engine));
+        v.weight = coordinate(engine);
+        v.uv = Vector2<T>(coordinate(engine), coordinate(engine));
+        Vector3<T> normal(coordinate(engine), coordinate(engine), coordinate(engine) + T(9));
+        v.normal = normal / normal.magnitude();
+        v.color = Vector4<T>(coordinate(engine), coordinate(engine), coordinate(engine), coordinate(engine));
+        buffer.positions.push_back(v.position);
+        buffer.uvs.push_back(v.uv);
+        buffer.normals.push_back(v.normal);
+        buffer.colors.push_back(v.color);
+    }
+    return buffer;
+}
+
+template <typename T>
+void testMechanics()
+{
+    std::vector<Vertex<T>> vertices(5);
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+        vertices[i].uv = Vector2<T>(T(i), T(-1) * T(i));
+
+    StridedRef<Vector2<T>> uvs(vertices.data(), vertices.size(), sizeof(Vertex<T>), offsetof(Vertex<T>, uv));
+    LUMINA_CHECK(uvs.size() == 5 && !uvs.empty() && !uvs.isContiguous());
+    LUMINA_CHECK(&uvs[3] == &vertices[3].uv);
+
+    // Random access iteration walks the attribute, and writes land in the interleaved buffer
+    LUMINA_CHECK(std::distance(uvs.begin(), uvs.end()) == 5);
+    LUMINA_CHECK(uvs.end() - 2 == uvs.begin() + 3 && uvs.begin() < uvs.end());
+    LUMINA_CHECK(uvs.begin()[4].x == T(4) && (uvs.end() - 1)->y == T(-4));
+    std::reverse(uvs.begin(), uvs.end());
+    LUMINA_CHECK(vertices[0].uv.x == T(4) && vertices[4].uv.x == T(0));
+    LUMINA_CHECK(std::count_if(uvs.begin(), uvs.end(), [](const Vector2<T> &uv) { return uv.x > T(1); }) == 3);
+
+    StridedView<Vector2<T>> tail = uvs.subview(2, 3);
+    LUMINA_CHECK(tail.size() == 3 && &tail[0] == &vertices[2].uv);
+    LUMINA_CHECK(uvs.subview(5, 0).empty() && uvs.view().subview(0, 5).size() == 5);
+    LUMINA_CHECK_THROWS(std::out_of_range, uvs.subview(2, 4));
+    LUMINA_CHECK_THROWS(std::out_of_range, uvs.subview(6, 0));
+    LUMINA_CHECK_THROWS(std::out_of_range, tail.subview(1, ~std::size_t(0)));
+    LUMINA_CHECK_THROWS(std::out_of_range, uvs.view().subview(~std::size_t(0), 2));
+    StridedView<Vector2<T>> view = uvs;
+    LUMINA_CHECK(view.base == uvs.base && view.stride == uvs.stride && view.count == uvs.count);
+
+    std::vector<Vector2<T>> packed(3);
+    LUMINA_CHECK(StridedView<Vector2<T>>(packed.data(), packed.size()).isContiguous());
+    LUMINA_CHECK(StridedView<Vector2<T>>().empty());
+
+    // Strides shorter than the element or off its alignment, and misaligned offsets, are rejected
+    LUMINA_CHECK_THROWS(std::invalid_argument, StridedView<Vector2<T>>(vertices.data(), 5, sizeof(T)));
+    LUMINA_CHECK_THROWS(std::invalid_argument, StridedView<Vector2<T>>(vertices.data(), 5, sizeof(Vertex<T>) + 1));
+    LUMINA_CHECK_THROWS(std::invalid_argument, StridedRef<Vector2<T>>(vertices.data(), 5, sizeof(Vertex<T>), 1));
+}
+
+template <typename T>
+void testAngles(Buffer<T> &buffer)
+{
+    std::size_t count = buffer.vertices.size();
+    for (MathAccuracy accuracy : {MathAccuracy::Fast, MathAccuracy::Precise})
+    {
+        std::vector<T> expected(count), actual(count);
+        angles(buffer.uvs.data(), buffer.uvs.data() + 1, expected.data(), count - 1, accuracy);
+        angles(buffer.uvView().subview(0, count - 1), buffer.uvView().subview(1, count - 1), actual.data(), accuracy);
+        LUMINA_CHECK(sameBits(expected, actual));
+
+        angles(buffer.positions.data(), buffer.normals.data(), expected.data(), count, accuracy);
+        angles(buffer.positionView(), buffer.normalView(), actual.data(), accuracy);
+        LUMINA_CHECK(sameBits(expected, actual));
+
+        angles(buffer.colors.data(), buffer.colors.data() + 1, expected.data(), count - 1, accuracy);
+        angles(buffer.colorView().subview(0, count - 1), buffer.colorView().subview(1, count - 1), actual.data(),
+               accuracy);
+        LUMINA_CHECK(sameBits(expected, actual));
+
+        std::vector<T> radius(count), angle(count), stridedRadius(count), stridedAngle(count);
+        toPolar(buffer.uvs.data(), radius.data(), angle.data(), count, accuracy);
+        toPolar(buffer.uvView(), stridedRadius.data(), stridedAngle.data(), accuracy);
+        LUMINA_CHECK(sameBits(radius, stridedRadius) && sameBits(angle, stridedAngle));
+
+        std::vector<Vector2<T>> cartesian(count), stridedCartesian(count);
+        fromPolar(radius.data(), angle.data(), cartesian.data(), count, accuracy);
+        fromPolar(radius.data(), angle.data(), buffer.uvOutRef(), accuracy);
+        for (std::size_t i = 0; i < count; ++i)
+            stridedCartesian[i] = buffer.vertices[i].uvOut;
+        LUMINA_CHECK(sameBits(cartesian, stridedCartesian));
+    }
+}
+
+template <typename T>
+void testRotate(Buffer<T> &buffer)
+{
+    std::size_t count = buffer.vertices.size();
+    std::vector<T> turns(count);
+    for (std::size_t i = 0; i < count; ++i)
+        turns[i] = buffer.vertices[i].weight;
+
+    std::vector<Vector2<T>> rotated2(count), strided2(count);
+    rotate(buffer.uvs.data(), turns.data(), rotated2.data(), count);
+    rotate(buffer.uvView(), turns.data(), buffer.uvOutRef());
+    for (std::size_t i = 0; i < count; ++i)
+        strided2[i] = buffer.vertices[i].uvOut;
+    LUMINA_CHECK(sameBits(rotated2, strided2));
+
+    std::vector<Vector3<T>> rotated3(count), strided3(count);
+    rotate(buffer.positions.data(), buffer.normals.data(), turns.data(), rotated3.data(), count);
+    rotate(buffer.positionView(), buffer.normalView(), turns.data(), buffer.normalOutRef());
+    for (std::size_t i = 0; i < count; ++i)
+        strided3[i] = buffer.vertices[i].normalOut;
+    LUMINA_CHECK(sameBits(rotated3, strided3));
+
+    // In place: `in` and `out` over the same elements
+    StridedRef<Vector2<T>> uvOut = buffer.uvOutRef();
+    for (std::size_t i = 0; i < count; ++i)
+        buffer.vertices[i].uvOut = buffer.uvs[i];
+    rotate(uvOut.view(), turns.data(), uvOut);
+    for (std::size_t i = 0; i < count; ++i)
+        strided2[i] = buffer.vertices[i].uvOut;
+    LUMINA_CHECK(sameBits(rotated2, strided2));
+
+    LUMINA_CHECK_THROWS(std::invalid_argument, rotate(buffer.uvView().subview(0, count - 1), turns.data(), uvOut));
+}
+
+template <typename T>
+void testReductions(const Buffer<T> &buffer)
+{
+    std::size_t count = buffer.positions.size();
+    for (unsigned threads : {1u, 4u})
+    {
+        PointStats<T> expected = pointStats(buffer.positions.data(), count, threads);
+        PointStats<T> actual = pointStats(buffer.positionView(), threads);
+        LUMINA_CHECK(actual.count == expected.count);
+        LUMINA_CHECK(sameBits(actual.sum, expected.sum) && sameBits(actual.mean, expected.mean));
+        LUMINA_CHECK(actual.bounds == expected.bounds);
+        LUMINA_CHECK(std::memcmp(actual.covariance, expected.covariance, sizeof(actual.covariance)) == 0);
+
+        LUMINA_CHECK(sameBits(sum(buffer.positionView(), threads), sum(buffer.positions.data(), count, threads)));
+        LUMINA_CHECK(sameBits(centroid(buffer.positionView(), threads),
+                              centroid(buffer.positions.data(), count, threads)));
+        LUMINA_CHECK(bounds(buffer.positionView(), threads) == bounds(buffer.positions.data(), count, threads));
+    }
+}
+
+template <typename T>
+void testCulling(const Buffer<T> &buffer)
+{
+    std::size_t count = buffer.positions.size();
+    Frustum<T> frustum(Plane<T>(T(2), T(0.5), T(0), T(2)), Plane<T>(T(-1), T(0), T(0.25), T(1)),
+                       Plane<T>(T(0), T(1), T(0), T(1.5)), Plane<T>(T(0), T(-1), T(0.5), T(1)),
+                       Plane<T>(T(0), T(0), T(1), T(3)), Plane<T>(T(0.25), T(0), T(-1), T(2)));
+    Vector3SoA<T> soa(buffer.positions.data(), count);
+    std::vector<std::uint32_t> expected(count), actual(count);
+    expected.resize(cullPoints(frustum, soa.view(), expected.data()));
+    actual.resize(cullPoints(frustum, buffer.positionView(), actual.data()));
+    LUMINA_CHECK(!expected.empty() && expected.size() < count);
+    LUMINA_CHECK(actual == expected);
+}
+
+template <typename T>
+void testPredicates(const Buffer<T> &buffer)
+{
+    std::size_t count = buffer.vertices.size() - 1;
+    std::vector<std::uint64_t> expected(maskWordCount(count)), actual(maskWordCount(count));
+    const T epsilon = T(2);
+
+    approxEqual(buffer.uvs.data(), buffer.uvs.data() + 1, count, epsilon, expected.data());
+    approxEqual(buffer.uvView().subview(0, count), buffer.uvView().subview(1, count), epsilon, actual.data());
+    LUMINA_CHECK(actual == expected);
+
+    approxEqual(buffer.positions.data(), buffer.positions.data() + 1, count, epsilon, expected.data());
+    approxEqual(buffer.positionView().subview(0, count), buffer.positionView().subview(1, count), epsilon,
+                actual.data());
+    LUMINA_CHECK(actual == expected);
+
+    approxEqual(buffer.colors.data(), buffer.colors.data() + 1, count, epsilon, expected.data());
+    approxEqual(buffer.colorView().subview(0, count), buffer.colorView().subview(1, count), epsilon, actual.data());
+    LUMINA_CHECK(actual == expected);
+}
+
+template <typename T>
+void testSpaceFilling(const Buffer<T> &buffer)
+{
+    std::size_t count = buffer.vertices.size();
+    Bounds3<T> box(Vector3<T>(T(-3)), Vector3<T>(T(3)));
+    for (SpaceFillingCurve curve : {SpaceFillingCurve::Morton, SpaceFillingCurve::Hilbert})
+    {
+        std::vector<std::uint64_t> expected(count), actual(count);
+        spaceFillingCodes(buffer.positions.data(), count, box, expected.data(), curve);
+        spaceFillingCodes(buffer.positionView(), box, actual.data(), curve);
+        LUMINA_CHECK(actual == expected);
+
+        spaceFillingCodes(buffer.uvs.data(), count, Vector2<T>(T(-3)), Vector2<T>(T(3)), expected.data(), curve);
+        spaceFillingCodes(buffer.uvView(), Vector2<T>(T(-3)), Vector2<T>(T(3)), actual.data(), curve);
+        LUMINA_CHECK(actual == expected);
+    }
+}
+
+template <typename T>
+void testStrided()
+{
+    testMechanics<T>();
+    std::mt19937_64 engine(34);
+    // Odd counts leave a scalar tail after the SIMD packs
+    for (std::size_t count : {std::size_t(2), std::size_t(37), std::size_t(70001)})
+    {
+        Buffer<T> buffer = makeBuffer<T>(count, engine);
+        testAngles(buffer);
+        testRotate(buffer);
+        testReductions(buffer);
+        testPredicates(buffer);
+        testSpaceFilling(buffer);
+        if (count > 2)
+            testCulling(buffer);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    testStrided<float>();
+    testStrided<double>();
+    return test::finish();
+}
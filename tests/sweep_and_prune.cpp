@@ -0,0 +1,213 @@
+// SweepAndPrune against an all-pairs Bounds3::overlaps scan: the same pair set, each pair once with
+// first < second, over touching, nested and degenerate boxes, across frames of coherent motion,
+// reshuffles and sweep-axis changes, and in the same order for any thread count.
+
+#include "check.hpp"
+#include <lumina/spatial/sweep_and_prune.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+using Pair = std::pair<std::uint32_t, std::uint32_t>;
+
+template <typename T>
+std::vector<Pair> bruteForce(const std::vector<Bounds3<T>> &boxes)
+{
+    std::vector<Pair> pairs;
+    for (std::size_t a = 0; a < boxes.size(); ++a)
+        for (std::size_t b = a + 1; b < boxes.size(); ++b)
+            if (boxes[a].overlaps(boxes[b]))
+                pairs.emplace_back(std::uint32_t(a), std::uint32_t(b));
+    return pairs;
+}
+
+// The pairs as a sorted set, or a sentinel entry when any pair is not ordered first < second
+std::vector<Pair> normalized(const std::vector<OverlapPair> &pairs)
+{
+    std::vector<Pair> result;
+    for (const OverlapPair &pair : pairs)
+    {
+        if (pair.first >= pair.second)
+            return {Pair(~0u, ~0u)};
+        result.emplace_back(pair.first, pair.second);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+bool sameSequence(const std::vector<OverlapPair> &a, const std::vector<OverlapPair> &b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const OverlapPair &x, const OverlapPair &y) {
+        return x.first == y.first && x.second == y.second;
+    });
+}
+
+// Corners on a quarter-unit grid, so many boxes touch exactly; some are points or flat slabs
+template <typename T>
+Bounds3<T> randomBox(std::mt19937_64 &engine, const Vector3<T> &spread)
+{
+    std::uniform_int_distribution<int> grid(0, 400), extent(0, 12);
+    Vector3<T> min(T(grid(engine)) * T(0.25) * spread.x, T(grid(engine)) * T(0.25) * spread.y,
+                   T(grid(engine)) * T(0.25) * spread.z);
+    Vector3<T> size(T(extent(engine)) * T(0.25), T(extent(engine)) * T(0.25), T(extent(engine)) * T(0.25));
+    return Bounds3<T>(min, min + size);
+}
+
+// The sweep order is a permutation sorted by minimum along the current axis
+template <typename T>
+bool validOrder(const SweepAndPrune<T> &sap)
+{
+    std::vector<std::uint32_t> sorted = sap.order;
+    std::sort(sorted.begin(), sorted.end());
+    bool permutation = sorted.size() == sap.size();
+    for (std::size_t i = 0; permutation && i < sorted.size(); ++i)
+        permutation = sorted[i] == i;
+    const std::vector<T> &minimums = sap.axis == 0 ? sap.minimums.x : (sap.axis == 1 ? sap.minimums.y : sap.minimums.z);
+    bool ordered = true;
+    for (std::size_t i = 1; i < sap.order.size(); ++i)
+        ordered &= minimums[sap.order[i - 1]] <= minimums[sap.order[i]];
+    return permutation && ordered;
+}
+
+// Finds the pairs with one thread and with four, which must agree in order, and checks the set
+template <typename T>
+bool matchesBruteForce(SweepAndPrune<T> &serial, SweepAndPrune<T> &threaded, const std::vector<Bounds3<T>> &boxes)
+{
+    std::vector<OverlapPair> serialPairs, threadedPairs;
+    serial.findPairs(serialPairs, 1);
+    threaded.findPairs(threadedPairs, 4);
+    return normalized(serialPairs) == bruteForce(boxes) && sameSequence(serialPairs, threadedPairs) &&
+           validOrder(serial) && validOrder(threaded);
+}
+
+template <typename T>
+void testFrames(std::mt19937_64 &engine)
+{
+    for (std::size_t count : {std::size_t(0), std::size_t(1), std::size_t(2), std::size_t(37), std::size_t(6000)})
+    {
+        // Spread widest along x first
+        std::vector<Bounds3<T>> boxes(count);
+        SweepAndPrune<T> serial, threaded;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            boxes[i] = randomBox(engine, Vector3<T>(T(4), T(1), T(1)));
+            LUMINA_CHECK(serial.add(boxes[i]) == i && threaded.add(boxes[i]) == i);
+        }
+        LUMINA_CHECK(serial.size() == count);
+        LUMINA_CHECK(matchesBruteForce(serial, threaded, boxes));
+        if (count > 2)
+            LUMINA_CHECK(serial.axis == 0);
+
+        std::uniform_int_distribution<int> step(-2, 2);
+        std::uniform_int_distribution<std::size_t> pick(0, count == 0 ? 0 : count - 1);
+        for (int frame = 0; frame < 6 && count > 0; ++frame)
+        {
+            if (frame < 3)
+            {
+                // Coherent motion: small grid steps, repaired by insertion sort
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    Vector3<T> offset(T(step(engine)) * T(0.25), T(step(engine)) * T(0.25), T(step(engine)) * T(0.25));
+                    boxes[i] = Bounds3<T>(boxes[i].min + offset, boxes[i].max + offset);
+                }
+            }
+            else if (frame == 3)
+            {
+                // A full reshuffle along x
+                for (Bounds3<T> &box : boxes)
+                    box = randomBox(engine, Vector3<T>(T(4), T(1), T(1)));
+            }
+            else
+            {
+                // Spread along z so the sweep axis changes; a few boxes are copied so some coincide
+                for (Bounds3<T> &box : boxes)
+                    box = randomBox(engine, Vector3<T>(T(1), T(1), T(4)));
+                for (std::size_t k = 0; k < count / 10; ++k)
+                    boxes[pick(engine)] = boxes[pick(engine)];
+            }
+
+            // set() for even indices, direct writes to the corner arrays for odd ones
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                for (SweepAndPrune<T> *sap : {&serial, &threaded})
+                {
+                    if (i % 2 == 0)
+                    {
+                        sap->set(std::uint32_t(i), boxes[i]);
+                    }
+                    else
+                    {
+                        sap->minimums.set(i, boxes[i].min);
+                        sap->maximums.set(i, boxes[i].max);
+                    }
+                }
+            }
+            LUMINA_CHECK(matchesBruteForce(serial, threaded, boxes));
+            if (frame >= 4 && count > 2)
+                LUMINA_CHECK(serial.axis == 2);
+        }
+    }
+}
+
+template <typename T>
+void testEdgeCases()
+{
+    // Boxes touching on a face, an edge and a corner overlap; a gap of one ulp does not
+    SweepAndPrune<T> sap;
+    const Vector3<T> one(T(1));
+    sap.add(Bounds3<T>(Vector3<T>(T(0)), one));
+    sap.add(Bounds3<T>(Vector3<T>(T(1), T(0), T(0)), Vector3<T>(T(2), T(1), T(1))));
+    sap.add(Bounds3<T>(Vector3<T>(T(1), T(1), T(0)), Vector3<T>(T(2), T(2), T(1))));
+    sap.add(Bounds3<T>(one, Vector3<T>(T(2))));
+    sap.add(Bounds3<T>(Vector3<T>(std::nextafter(T(2), T(3)), T(0), T(0)), Vector3<T>(T(3), T(1), T(1))));
+    sap.add(Bounds3<T>(Vector3<T>(T(0.5)), Vector3<T>(T(0.5))));
+    std::vector<OverlapPair> pairs;
+    sap.findPairs(pairs);
+    std::vector<Bounds3<T>> boxes;
+    for (std::uint32_t i = 0; i < sap.size(); ++i)
+        boxes.push_back(sap.get(i));
+    LUMINA_CHECK(normalized(pairs) == bruteForce(boxes));
+    LUMINA_CHECK(std::none_of(pairs.begin(), pairs.end(), [](const OverlapPair &p) {
+        return p.first == 4 || p.second == 4;
+    }));
+    LUMINA_CHECK(std::count_if(pairs.begin(), pairs.end(), [](const OverlapPair &p) { return p.first == 0; }) == 4);
+
+    LUMINA_CHECK_THROWS(std::out_of_range, sap.set(6, boxes[0]));
+    LUMINA_CHECK_THROWS(std::out_of_range, sap.get(6));
+    sap.maximums.push_back(one);
+    LUMINA_CHECK_THROWS(std::invalid_argument, sap.findPairs(pairs));
+
+    // Stale pairs are replaced, and an emptied broadphase finds none
+    sap.clear();
+    LUMINA_CHECK(sap.size() == 0 && sap.order.empty());
+    pairs.assign(3, OverlapPair{0, 1});
+    sap.findPairs(pairs);
+    LUMINA_CHECK(pairs.empty());
+}
+
+template <typename T>
+void testSweepAndPrune()
+{
+    std::mt19937_64 engine(42);
+    testFrames<T>(engine);
+    testEdgeCases<T>();
+}
+
+} // namespace
+
+int main()
+{
+    testSweepAndPrune<float>();
+    testSweepAndPrune<double>();
+    return test::finish();
+}
@@ -0,0 +1,343 @@
+// Matrix4 against scalar loops that sum in the documented column order, bit for bit, and against
+// long double for the factories; TransformHierarchy against a full recompute from scratch after
+// every round of dirty edits, for one thread and several.
+// Built with -ffp-contract=off like the library's matrix sources (exact_tests in meson.build).
+
+#include "check.hpp"
+#include <lumina/matrix/matrix4.hpp>
+#include <lumina/scene/transform_hierarchy.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+using Wide = long double;
+
+template <typename T>
+bool sameBits(const Matrix4<T> &a, const Matrix4<T> &b)
+{
+    return std::memcmp(a.data(), b.data(), sizeof(T) * 16) == 0;
+}
+
+template <typename T>
+bool sameBits(const Vector4<T> &a, const Vector4<T> &b)
+{
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+template <typename T>
+Matrix4<T> randomMatrix(std::mt19937_64 &engine)
+{
+    std::uniform_real_distribution<T> element(T(-4), T(4));
+    Matrix4<T> m;
+    for (T *p = m.data(); p != m.data() + 16; ++p)
+        *p = element(engine);
+    return m;
+}
+
+template <typename T>
+Vector4<T> randomQuaternion(std::mt19937_64 &engine)
+{
+    std::normal_distribution<T> component(T(0), T(1));
+    Vector4<T> q(component(engine), component(engine), component(engine), component(engine));
+    return q / q.magnitude();
+}
+
+// Row i of a times column j of b, summed over k in order
+template <typename T>
+T productElement(const Matrix4<T> &a, const Matrix4<T> &b, int i, int j)
+{
+    return a(i, 0) * b(0, j) + a(i, 1) * b(1, j) + a(i, 2) * b(2, j) + a(i, 3) * b(3, j);
+}
+
+template <typename T>
+void testMatrix(std::mt19937_64 &engine)
+{
+    bool matches = true;
+    for (int trial = 0; trial < 500; ++trial)
+    {
+        Matrix4<T> a = randomMatrix<T>(engine), b = randomMatrix<T>(engine);
+        Matrix4<T> product = a * b, expected;
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                expected(i, j) = productElement(a, b, i, j);
+        matches &= sameBits(product, expected);
+        Matrix4<T> compound = a;
+        compound *= b;
+        matches &= sameBits(compound, expected);
+        matches &= sameBits(Matrix4<T>() * a, a) && sameBits(a * Matrix4<T>::identity(), a);
+
+        const Vector4<T> &v = b.columns[1];
+        Vector4<T> image = a * v;
+        for (int i = 0; i < 4; ++i)
+            matches &= image[i] == a(i, 0) * v.x + a(i, 1) * v.y + a(i, 2) * v.z + a(i, 3) * v.w;
+        Vector3<T> point = a.transformPoint(Vector3<T>(v.x, v.y, v.z));
+        Vector3<T> direction = a.transformVector(Vector3<T>(v.x, v.y, v.z));
+        for (int i = 0; i < 3; ++i)
+        {
+            matches &= point[i] == a(i, 0) * v.x + a(i, 1) * v.y + a(i, 2) * v.z + a(i, 3);
+            matches &= direction[i] == a(i, 0) * v.x + a(i, 1) * v.y + a(i, 2) * v.z;
+        }
+
+        Matrix4<T> transposed = a.transposed();
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                matches &= transposed(i, j) == a(j, i) && a.data()[4 * j + i] == a(i, j) && a[j][i] == a(i, j);
+        matches &= a.transposed().transposed() == a && (a != b) && !(a == b);
+    }
+    LUMINA_CHECK(matches);
+    Matrix4<T> m;
+    LUMINA_CHECK_THROWS(std::out_of_range, m[4]);
+    LUMINA_CHECK_THROWS(std::out_of_range, m(0, -1));
+
+    LUMINA_CHECK(Matrix4<T>::approxEqual(m, Matrix4<T>::scale(Vector3<T>(T(1.25))), T(0.25)));
+    LUMINA_CHECK(!Matrix4<T>::approxEqual(m, Matrix4<T>::scale(Vector3<T>(T(1.25))), T(0.2)));
+}
+
+// The factories against long double: rotations are orthonormal with determinant 1 and turn
+// vectors like q v q*, and trs composes translation, rotation and scale in that order
+template <typename T>
+void testFactories(std::mt19937_64 &engine)
+{
+    const Wide tolerance = 16 * Wide(std::numeric_limits<T>::epsilon());
+    std::uniform_real_distribution<T> coordinate(T(-5), T(5)), factor(T(0.25), T(4));
+    bool orthonormal = true, rotates = true, composes = true;
+    for (int trial = 0; trial < 500; ++trial)
+    {
+        Vector4<T> q = randomQuaternion<T>(engine);
+        Matrix4<T> r = Matrix4<T>::rotation(q);
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+            {
+                Wide dot = 0;
+                for (int k = 0; k < 4; ++k)
+                    dot += Wide(r(k, i)) * r(k, j);
+                orthonormal &= std::abs(dot - Wide(i == j)) <= tolerance;
+            }
+        Wide determinant = Wide(r(0, 0)) * (Wide(r(1, 1)) * r(2, 2) - Wide(r(1, 2)) * r(2, 1)) -
+                           Wide(r(0, 1)) * (Wide(r(1, 0)) * r(2, 2) - Wide(r(1, 2)) * r(2, 0)) +
+                           Wide(r(0, 2)) * (Wide(r(1, 0)) * r(2, 1) - Wide(r(1, 1)) * r(2, 0));
+        orthonormal &= std::abs(determinant - 1) <= tolerance;
+
+        // v' = v + 2 w (u x v) + 2 u x (u x v) for q = (u, w)
+        Vector3<T> v(coordinate(engine), coordinate(engine), coordinate(engine));
+        Wide u[3] = {q.x, q.y, q.z}, w = q.w, p[3] = {v.x, v.y, v.z};
+        Wide t[3] = {u[1] * p[2] - u[2] * p[1], u[2] * p[0] - u[0] * p[2], u[0] * p[1] - u[1] * p[0]};
+        Wide s[3] = {u[1] * t[2] - u[2] * t[1], u[2] * t[0] - u[0] * t[2], u[0] * t[1] - u[1] * t[0]};
+        Vector3<T> turned = r.transformVector(v);
+        for (int k = 0; k < 3; ++k)
+            rotates &= std::abs(turned[k] - (p[k] + 2 * w * t[k] + 2 * s[k])) <= 8 * tolerance;
+
+        Vector3<T> offset(coordinate(engine), coordinate(engine), coordinate(engine));
+        Vector3<T> factors(factor(engine), factor(engine), factor(engine));
+        Matrix4<T> trs = Matrix4<T>::trs(offset, q, factors);
+        Matrix4<T> composed = Matrix4<T>::translation(offset) * r * Matrix4<T>::scale(factors);
+        composes &= Matrix4<T>::approxEqual(trs, composed, T(4) * T(tolerance));
+        composes &= sameBits(trs.columns[3], Vector4<T>(offset.x, offset.y, offset.z, T(1)));
+    }
+    LUMINA_CHECK(orthonormal && rotates && composes);
+
+    Matrix4<T> scale = Matrix4<T>::scale(Vector3<T>(T(2), T(3), T(4)));
+    Matrix4<T> translation = Matrix4<T>::translation(Vector3<T>(T(1), T(-2), T(0.5)));
+    LUMINA_CHECK(scale.transformPoint(Vector3<T>(T(1))) == Vector3<T>(T(2), T(3), T(4)));
+    LUMINA_CHECK(translation.transformPoint(Vector3<T>(T(1))) == Vector3<T>(T(2), T(-1), T(1.5)));
+    LUMINA_CHECK(translation.transformVector(Vector3<T>(T(1))) == Vector3<T>(T(1)));
+    LUMINA_CHECK(Matrix4<T>::rotation(Vector4<T>(T(0), T(0), T(0), T(1))) == Matrix4<T>::identity());
+}
+
+// Random hierarchy built depth-first: each node's parent is a random node on the current path,
+// or none. Depth is capped so world matrices stay well scaled.
+template <typename T>
+TransformHierarchy<T> randomHierarchy(std::mt19937_64 &engine, std::size_t count)
+{
+    constexpr std::size_t maxDepth = 12;
+    std::uniform_real_distribution<T> coordinate(T(-2), T(2)), factor(T(0.8), T(1.25));
+    TransformHierarchy<T> hierarchy;
+    hierarchy.reserve(count);
+    std::vector<std::size_t> path;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::uniform_int_distribution<std::size_t> pick(0, std::min(path.size(), maxDepth - 1));
+        std::size_t depth = i % 500 == 0 ? 0 : pick(engine);
+        path.resize(std::min(path.size(), depth));
+        std::size_t parent = path.empty() ? TransformHierarchy<T>::NoParent : path.back();
+        path.push_back(hierarchy.add(parent, Vector3<T>(coordinate(engine), coordinate(engine), coordinate(engine)),
+                                     randomQuaternion<T>(engine),
+                                     Vector3<T>(factor(engine), factor(engine), factor(engine))));
+    }
+    return hierarchy;
+}
+
+// Every world matrix recomposed from the locals, as Matrix4 products and in long double
+template <typename T>
+std::vector<Matrix4<T>> recompose(const TransformHierarchy<T> &h, std::vector<std::vector<Wide>> &wide)
+{
+    std::vector<Matrix4<T>> worlds(h.size());
+    wide.assign(h.size(), std::vector<Wide>(16));
+    for (std::size_t i = 0; i < h.size(); ++i)
+    {
+        Matrix4<T> local = Matrix4<T>::trs(h.translations[i], h.rotations[i], h.scales[i]);
+        std::size_t parent = h.parents[i];
+        worlds[i] = parent == TransformHierarchy<T>::NoParent ? local : worlds[parent] * local;
+        for (int r = 0; r < 4; ++r)
+            for (int c = 0; c < 4; ++c)
+            {
+                if (parent == TransformHierarchy<T>::NoParent)
+                {
+                    wide[i][std::size_t(4 * c + r)] = local(r, c);
+                    continue;
+                }
+                Wide sum = 0;
+                for (int k = 0; k < 4; ++k)
+                    sum += wide[parent][std::size_t(4 * k + r)] * Wide(local(k, c));
+                wide[i][std::size_t(4 * c + r)] = sum;
+            }
+    }
+    return worlds;
+}
+
+template <typename T>
+bool matchesRecompute(const TransformHierarchy<T> &h)
+{
+    std::vector<std::vector<Wide>> wide;
+    std::vector<Matrix4<T>> expected = recompose(h, wide);
+    bool matches = true;
+    const Wide tolerance = 256 * Wide(std::numeric_limits<T>::epsilon());
+    for (std::size_t i = 0; i < h.size(); ++i)
+    {
+        matches &= sameBits(h.world(i), expected[i]);
+        for (std::size_t k = 0; k < 16; ++k)
+            matches &= std::abs(h.world(i).data()[k] - wide[i][k]) <= tolerance * (1 + std::abs(wide[i][k]));
+        Vector3<T> position = h.worldPosition(i);
+        matches &= sameBits(Vector4<T>(position.x, position.y, position.z, T(1)), h.world(i).columns[3]);
+    }
+    return matches;
+}
+
+// Nodes in the union of the dirty nodes' subtrees, found by walking parents
+template <typename T>
+std::size_t affectedCount(const TransformHierarchy<T> &h, const std::vector<std::size_t> &dirty)
+{
+    std::vector<bool> isDirty(h.size(), false);
+    for (std::size_t node : dirty)
+        isDirty[node] = true;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < h.size(); ++i)
+    {
+        bool affected = false;
+        for (std::size_t a = i; a != TransformHierarchy<T>::NoParent && !affected; a = h.parents[a])
+            affected = isDirty[a];
+        count += affected;
+    }
+    return count;
+}
+
+template <typename T>
+void testHierarchy(std::mt19937_64 &engine)
+{
+    for (std::size_t count : {std::size_t(1), std::size_t(300), std::size_t(30000)})
+    {
+        TransformHierarchy<T> serial = randomHierarchy<T>(engine, count);
+        LUMINA_CHECK(serial.update(1) == count);
+        LUMINA_CHECK(matchesRecompute(serial) && serial.update(1) == 0);
+
+        // Subtree sizes agree with the parent links
+        std::vector<std::size_t> sizes(count, 1);
+        for (std::size_t i = count; i-- > 0;)
+            if (serial.parents[i] != TransformHierarchy<T>::NoParent)
+                sizes[serial.parents[i]] += sizes[i];
+        LUMINA_CHECK(sizes == serial.subtreeSizes);
+
+        TransformHierarchy<T> threaded = serial;
+        std::uniform_int_distribution<std::size_t> node(0, count - 1);
+        std::uniform_real_distribution<T> coordinate(T(-2), T(2)), factor(T(0.8), T(1.25));
+        for (int round = 0; round < 4; ++round)
+        {
+            // Every kind of edit, some repeated on the same node, and arrays written directly
+            std::vector<std::size_t> dirty;
+            for (std::size_t e = 0; e < count / 50 + 1; ++e)
+            {
+                std::size_t n = node(engine);
+                dirty.push_back(n);
+                Vector3<T> t(coordinate(engine), coordinate(engine), coordinate(engine));
+                Vector4<T> q = randomQuaternion<T>(engine);
+                Vector3<T> s(factor(engine), factor(engine), factor(engine));
+                for (TransformHierarchy<T> *h : {&serial, &threaded})
+                {
+                    switch (e % 5)
+                    {
+                    case 0:
+                        h->setTranslation(n, t);
+                        break;
+                    case 1:
+                        h->setRotation(n, q);
+                        break;
+                    case 2:
+                        h->setScale(n, s);
+                        break;
+                    case 3:
+                        h->setLocal(n, t, q, s);
+                        break;
+                    default:
+                        h->translations[n] = t;
+                        h->markDirty(n);
+                        h->markDirty(n);
+                    }
+                }
+            }
+            std::size_t expected = affectedCount(serial, dirty);
+            LUMINA_CHECK(serial.update(1) == expected && threaded.update(4) == expected);
+            LUMINA_CHECK(matchesRecompute(serial));
+            LUMINA_CHECK(std::memcmp(serial.worlds.data(), threaded.worlds.data(),
+                                     count * sizeof(Matrix4<T>)) == 0);
+            LUMINA_CHECK(serial.dirtyNodes.empty() &&
+                         std::all_of(serial.dirtyFlags.begin(), serial.dirtyFlags.end(),
+                                     [](std::uint8_t flag) { return flag == 0; }));
+        }
+
+        // Dirtying a root recomputes its whole subtree, nothing else
+        serial.markDirty(0);
+        LUMINA_CHECK(serial.update(4) == serial.subtreeSizes[0] && matchesRecompute(serial));
+    }
+
+    // Nodes must be added depth-first, under an existing node
+    TransformHierarchy<T> h;
+    std::size_t root = h.add(TransformHierarchy<T>::NoParent);
+    std::size_t a = h.add(root), b = h.add(a);
+    LUMINA_CHECK(h.add(root) == 3 && h.size() == 4 && h.subtreeSizes[root] == 4 && h.subtreeSizes[a] == 2);
+    LUMINA_CHECK_THROWS(std::invalid_argument, h.add(a));
+    LUMINA_CHECK_THROWS(std::invalid_argument, h.add(b));
+    LUMINA_CHECK_THROWS(std::out_of_range, h.add(7));
+    LUMINA_CHECK_THROWS(std::out_of_range, h.setTranslation(4, Vector3<T>(T(0))));
+    LUMINA_CHECK_THROWS(std::out_of_range, h.markDirty(4));
+    LUMINA_CHECK_THROWS(std::out_of_range, h.world(4));
+    LUMINA_CHECK(h.update() == 4 && h.world(b) == Matrix4<T>::identity());
+}
+
+template <typename T>
+void testTransforms()
+{
+    std::mt19937_64 engine(41);
+    testMatrix<T>(engine);
+    testFactories<T>(engine);
+    testHierarchy<T>(engine);
+}
+
+} // namespace
+
+int main()
+{
+    testTransforms<float>();
+    testTransforms<double>();
+    return test::finish();
+}
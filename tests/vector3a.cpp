@@ -0,0 +1,163 @@
+// Vector3A against Vector3: every operation on random, signed-zero, non-finite, tiny and huge
+// components must give the same bits (NaN matching any NaN), along with the layout guarantees.
+// Built with -ffp-contract=off like the library's vector sources (exact_tests in meson.build).
+
+#include "check.hpp"
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector3a.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+template <typename T>
+bool same(T a, T b)
+{
+    return std::memcmp(&a, &b, sizeof(T)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+template <typename T>
+bool same(const Vector3A<T> &a, const Vector3<T> &b)
+{
+    return same(a.x, b.x) && same(a.y, b.y) && same(a.z, b.z);
+}
+
+template <typename T>
+Vector3A<T> aligned(const Vector3<T> &v)
+{
+    return Vector3A<T>(v);
+}
+
+template <typename T>
+std::vector<Vector3<T>> inputs(std::mt19937_64 &engine)
+{
+    const T nan = std::numeric_limits<T>::quiet_NaN(), inf = std::numeric_limits<T>::infinity();
+    const T tiny = std::numeric_limits<T>::denorm_min(), huge = std::numeric_limits<T>::max() / T(4);
+    std::vector<Vector3<T>> values{{T(0), T(0), T(0)},   {T(-0.0), T(0), T(-0.0)}, {T(1), T(0), T(0)},
+                                   {T(0), T(0), T(1)},   {nan, T(1), T(2)},        {inf, T(-1), T(0)},
+                                   {T(1), -inf, inf},    {tiny, -tiny, tiny},      {huge, huge, -huge},
+                                   {T(3), T(-4), T(12)}, {T(1e-20), T(1), T(-1)}};
+    std::uniform_real_distribution<T> coordinate(T(-10), T(10));
+    std::uniform_int_distribution<int> exponent(-30, 30);
+    for (int i = 0; i < 300; ++i)
+    {
+        Vector3<T> v(coordinate(engine), coordinate(engine), coordinate(engine));
+        if (i % 3 == 0)
+            v = v * std::ldexp(T(1), exponent(engine));
+        values.push_back(v);
+    }
+    return values;
+}
+
+template <typename T>
+void testLayout()
+{
+    static_assert(sizeof(Vector3A<T>) == 4 * sizeof(T) && alignof(Vector3A<T>) == 4 * sizeof(T));
+    std::vector<Vector3A<T>> array(3);
+    for (const Vector3A<T> &a : array)
+        LUMINA_CHECK(reinterpret_cast<std::uintptr_t>(&a) % (4 * sizeof(T)) == 0);
+
+    // The padding lane is zero after construction, and conversion round-trips
+    Vector3<T> v(T(1.5), T(-2), T(3));
+    for (const Vector3A<T> &a : {Vector3A<T>(), Vector3A<T>(T(7)), Vector3A<T>(T(1), T(2), T(3)), Vector3A<T>(v)})
+        LUMINA_CHECK(a.pad == T(0));
+    LUMINA_CHECK(same(Vector3A<T>(v), Vector3<T>(Vector3A<T>(v))));
+    LUMINA_CHECK(same(Vector3A<T>(T(7)), Vector3<T>(T(7))));
+}
+
+template <typename T>
+void testElementwise(const std::vector<Vector3<T>> &values)
+{
+    bool matches = true;
+    const T scalars[] = {T(0), T(-0.0), T(2.5), T(-3), std::numeric_limits<T>::infinity()};
+    for (const Vector3<T> &a : values)
+    {
+        Vector3A<T> va = aligned(a);
+        matches &= same(+va, +a) && same(-va, -a);
+        matches &= same(va.normalized(), a.normalized()) && same(Vector3A<T>::normalize(va), Vector3<T>::normalize(a));
+        matches &= same(va.magnitude(), a.magnitude()) && same(va.sqrMagnitude(), a.sqrMagnitude());
+        matches &= same(Vector3A<T>::abs(va), Vector3<T>::abs(a));
+        for (int k = 0; k < 3; ++k)
+            matches &= same(va[k], a[k]) && same(va.data()[k], a.data()[k]);
+        for (T s : scalars)
+        {
+            matches &= same(va + s, a + s) && same(va - s, a - s) && same(va * s, a * s) && same(va / s, a / s);
+            matches &= same(Vector3A<T>::lerp(va, aligned(a * T(0.5)), s), Vector3<T>::lerp(a, a * T(0.5), s));
+        }
+    }
+    LUMINA_CHECK(matches);
+}
+
+template <typename T>
+void testPairs(const std::vector<Vector3<T>> &values)
+{
+    bool matches = true;
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        // Every special value meets every other, and the random ones meet a neighbour
+        for (std::size_t j = i < 11 ? 0 : i - 1; j < (i < 11 ? values.size() : i + 1); ++j)
+        {
+            const Vector3<T> &a = values[i], &b = values[j];
+            Vector3A<T> va = aligned(a), vb = aligned(b);
+            matches &= same(va + vb, a + b) && same(va - vb, a - b) && same(va * vb, a * b) && same(va / vb, a / b);
+
+            Vector3A<T> sum = va, difference = va, product = va, quotient = va;
+            sum += vb;
+            difference -= vb;
+            product *= vb;
+            quotient /= vb;
+            matches &= same(sum, a + b) && same(difference, a - b) && same(product, a * b) && same(quotient, a / b);
+
+            matches &= (va == vb) == (a == b) && (va != vb) == (a != b);
+            matches &= same(Vector3A<T>::dot(va, vb), Vector3<T>::dot(a, b));
+            matches &= same(Vector3A<T>::cross(va, vb), Vector3<T>::cross(a, b));
+            matches &= same(Vector3A<T>::distance(va, vb), Vector3<T>::distance(a, b));
+            matches &= same(Vector3A<T>::angle(va, vb), Vector3<T>::angle(a, b));
+            matches &= same(Vector3A<T>::reflect(va, vb), Vector3<T>::reflect(a, b));
+            matches &= same(Vector3A<T>::min(va, vb), Vector3<T>::min(a, b));
+            matches &= same(Vector3A<T>::max(va, vb), Vector3<T>::max(a, b));
+            matches &= same(Vector3A<T>::clamp(va, vb, vb * T(2)), Vector3<T>::clamp(a, b, b * T(2)));
+            for (T epsilon : {T(0), T(0.5), T(100)})
+                matches &= Vector3A<T>::approxEqual(va, vb, epsilon) == Vector3<T>::approxEqual(a, b, epsilon);
+        }
+    }
+    LUMINA_CHECK(matches);
+}
+
+template <typename T>
+void testConstants()
+{
+    LUMINA_CHECK(same(Vector3A<T>::zero(), Vector3<T>::zero()) && same(Vector3A<T>::one(), Vector3<T>::one()));
+    LUMINA_CHECK(same(Vector3A<T>::up(), Vector3<T>::up()) && same(Vector3A<T>::down(), Vector3<T>::down()));
+    LUMINA_CHECK(same(Vector3A<T>::left(), Vector3<T>::left()) && same(Vector3A<T>::right(), Vector3<T>::right()));
+    LUMINA_CHECK(same(Vector3A<T>::forward(), Vector3<T>::forward()) &&
+                 same(Vector3A<T>::back(), Vector3<T>::back()));
+}
+
+template <typename T>
+void testVector3A()
+{
+    std::mt19937_64 engine(37);
+    std::vector<Vector3<T>> values = inputs<T>(engine);
+    testLayout<T>();
+    testElementwise(values);
+    testPairs(values);
+    testConstants<T>();
+}
+
+} // namespace
+
+int main()
+{
+    testVector3A<float>();
+    testVector3A<double>();
+    return test::finish();
+}
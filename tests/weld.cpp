@@ -0,0 +1,184 @@
+// Vertex welding against a brute-force first-match reference, and the batch approxEqual predicates
+// against Vector::approxEqual.
+
+#include "check.hpp"
+#include <lumina/batch/predicates.hpp>
+#include <lumina/spatial/weld.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+// Each vertex joins the first kept vertex it matches, in input order
+template <typename T>
+WeldResult<T> bruteForceWeld(const std::vector<Vector3<T>> &vertices, T epsilon)
+{
+    WeldResult<T> result;
+    for (const Vector3<T> &v : vertices)
+    {
+        std::size_t match = 0;
+        while (match < result.vertices.size() && !Vector3<T>::approxEqual(result.vertices[match], v, epsilon))
+            ++match;
+        if (match == result.vertices.size())
+            result.vertices.push_back(v);
+        result.remap.push_back(std::uint32_t(match));
+    }
+    return result;
+}
+
+template <typename T>
+bool same(const WeldResult<T> &a, const WeldResult<T> &b)
+{
+    if (a.remap != b.remap || a.vertices.size() != b.vertices.size())
+        return false;
+    for (std::size_t i = 0; i < a.vertices.size(); ++i)
+    {
+        // Bitwise, so NaN vertices compare by position
+        if (std::memcmp(&a.vertices[i], &b.vertices[i], sizeof(Vector3<T>)) != 0)
+            return false;
+    }
+    return true;
+}
+
+// Clusters jittered within epsilon / 2 of a few grid points, so members sit on both sides of the weld's
+// cell boundaries, plus singletons, signed zeros and non-finite coordinates that never merge
+template <typename T>
+std::vector<Vector3<T>> meshLike(std::size_t count, T epsilon, std::mt19937_64 &engine)
+{
+    std::uniform_int_distribution<int> cell(-20, 20);
+    std::uniform_real_distribution<T> jitter(-epsilon / 2, epsilon / 2), anywhere(T(-100), T(100));
+    std::vector<Vector3<T>> vertices(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (i % 5 == 4)
+        {
+            vertices[i] = Vector3<T>(anywhere(engine), anywhere(engine), anywhere(engine));
+            continue;
+        }
+        Vector3<T> center(T(cell(engine)) * T(0.25), T(cell(engine) % 3) * T(0.25), T(0.125));
+        vertices[i] = center + Vector3<T>(jitter(engine), jitter(engine), jitter(engine));
+    }
+    const T nan = std::numeric_limits<T>::quiet_NaN(), inf = std::numeric_limits<T>::infinity();
+    vertices[1] = Vector3<T>(T(0), T(0), T(0));
+    vertices[2] = Vector3<T>(T(-0.0), T(0), T(-0.0));
+    vertices[3] = Vector3<T>(nan, T(1), T(1));
+    vertices[6] = Vector3<T>(nan, T(1), T(1));
+    vertices[7] = Vector3<T>(inf, T(0), T(0));
+    vertices[8] = Vector3<T>(inf, T(0), T(0));
+    return vertices;
+}
+
+template <typename T>
+void testWeld()
+{
+    std::mt19937_64 engine(32);
+    for (T epsilon : {T(0), T(1e-3), T(0.1)})
+    {
+        for (std::size_t count : {std::size_t(9), std::size_t(5000)})
+        {
+            std::vector<Vector3<T>> vertices = meshLike(count, epsilon == T(0) ? T(1e-3) : epsilon, engine);
+            // Exact duplicates for the epsilon = 0 case
+            for (std::size_t i = 10; i < count; i += 7)
+                vertices[i] = vertices[i / 2];
+            WeldResult<T> expected = bruteForceWeld(vertices, epsilon);
+
+            for (unsigned threads : {1u, 4u})
+            {
+                WeldResult<T> welded = weldVertices(vertices.data(), count, epsilon, threads);
+                LUMINA_CHECK(same(welded, expected));
+                LUMINA_CHECK(same(weldVertices(StridedView<Vector3<T>>(vertices.data(), count), epsilon, threads),
+                                  expected));
+            }
+        }
+    }
+
+    // Signed zeros weld at epsilon 0; NaN and infinite vertices stay apart
+    std::vector<Vector3<T>> vertices = meshLike(9, T(1e-3), engine);
+    WeldResult<T> welded = weldVertices(vertices.data(), vertices.size(), T(0));
+    LUMINA_CHECK(welded.remap[2] == welded.remap[1]);
+    LUMINA_CHECK(welded.remap[6] != welded.remap[3] && welded.remap[8] != welded.remap[7]);
+
+    LUMINA_CHECK(weldVertices(vertices.data(), 0, T(1)).vertices.empty());
+    LUMINA_CHECK_THROWS(std::invalid_argument, weldVertices(vertices.data(), vertices.size(), T(-1)));
+}
+
+template <typename V, typename T>
+void checkMasks(const std::vector<V> &a, const std::vector<V> &b, T epsilon, const std::vector<std::uint64_t> &masks)
+{
+    bool matches = true;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        matches &= bool(masks[i / 64] >> (i % 64) & 1) == V::approxEqual(a[i], b[i], epsilon);
+    LUMINA_CHECK(matches);
+    // Bits past the count are cleared
+    if (a.size() % 64 != 0)
+        LUMINA_CHECK(masks.back() >> (a.size() % 64) == 0);
+}
+
+template <typename V, typename T>
+void testPredicate(std::mt19937_64 &engine)
+{
+    constexpr std::size_t dim = sizeof(V) / sizeof(T);
+    const T epsilon = T(0.01);
+    std::uniform_real_distribution<T> offset(-2 * epsilon, 2 * epsilon);
+    for (std::size_t count : {std::size_t(1), std::size_t(63), std::size_t(64), std::size_t(1001)})
+    {
+        std::vector<V> a(count), b(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t k = 0; k < dim; ++k)
+            {
+                a[i][k] = T(i % 17) - T(k);
+                b[i][k] = a[i][k] + offset(engine);
+            }
+        }
+        b[0][0] = std::numeric_limits<T>::quiet_NaN();
+
+        std::vector<std::uint64_t> masks(maskWordCount(count), ~std::uint64_t(0));
+        approxEqual(a.data(), b.data(), count, epsilon, masks.data());
+        checkMasks(a, b, epsilon, masks);
+
+        masks.assign(masks.size(), ~std::uint64_t(0));
+        approxEqual(StridedView<V>(a.data(), count), StridedView<V>(b.data(), count), epsilon, masks.data());
+        checkMasks(a, b, epsilon, masks);
+
+        if constexpr (dim == 3)
+        {
+            Vector3SoA<T> soaA(a.data(), count), soaB(b.data(), count);
+            masks.assign(masks.size(), ~std::uint64_t(0));
+            approxEqual(soaA.view(), soaB.view(), epsilon, masks.data());
+            checkMasks(a, b, epsilon, masks);
+        }
+    }
+    std::vector<V> a(4), b(3);
+    std::uint64_t mask;
+    LUMINA_CHECK_THROWS(std::invalid_argument, approxEqual(StridedView<V>(a.data(), 4), StridedView<V>(b.data(), 3),
+                                                           epsilon, &mask));
+}
+
+template <typename T>
+void testPredicates()
+{
+    std::mt19937_64 engine(320);
+    testPredicate<Vector2<T>, T>(engine);
+    testPredicate<Vector3<T>, T>(engine);
+    testPredicate<Vector4<T>, T>(engine);
+}
+
+} // namespace
+
+int main()
+{
+    testWeld<float>();
+    testWeld<double>();
+    testPredicates<float>();
+    testPredicates<double>();
+    return test::finish();
+}
@@ -0,0 +1,554 @@
+// Differential accuracy and throughput report for the Vector2/3/4 backends.
+// Every operation runs on the scalar reference classes and on each optimized path that implements it
+// (Vector3A and the batch kernels at both accuracy tiers) over four input sets: random components
+// across a wide exponent range, denormals, zero-length vectors and nearly parallel or antiparallel
+// pairs. Results are compared with the exact value evaluated in long double under the same contract
+// (a zero-length vector normalizes to zero and is at pi/2 to everything). The maximum error is
+// reported in ULPs of the exact result, or of the largest term summed into it when cancellation
+// leaves the result smaller; "inf" marks a NaN or infinity where the exact value has none.
+// Throughput is measured on the random set. Errors past the declared budget (see budget below) are
+// marked '!', and the exit status is then non-zero, so the report doubles as an accuracy gate.
+// Usage: vector_accuracy [elements per set]
+
+#include <lumina/batch/angles.hpp>
+#include <lumina/batch/transform.hpp>
+#include <lumina/vector/vector2.hpp>
+#include <lumina/vector/vector3.hpp>
+#include <lumina/vector/vector3a.hpp>
+#include <lumina/vector/vector4.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using namespace lumina;
+
+namespace
+{
+
+using Wide = long double;
+
+template <typename T, int D>
+using Vec = std::conditional_t<D == 2, Vector2<T>, std::conditional_t<D == 3, Vector3<T>, Vector4<T>>>;
+
+enum InputSet
+{
+    Random,
+    Denormal,
+    Zero,
+    Parallel,
+    SetCount
+};
+
+const char *const SetNames[SetCount] = {"random", "denormal", "zero", "parallel"};
+
+template <typename T, int D>
+struct Inputs
+{
+    std::vector<Vec<T, D>> a, b;
+    std::vector<T> t;
+    // Copies of a and b for the Vector3A backend, filled for D == 3
+    std::vector<Vector3A<T>> alignedA, alignedB;
+};
+
+template <typename T>
+struct Generator
+{
+    std::mt19937_64 engine{0x5eed};
+
+    T uniform(T lo, T hi) { return std::uniform_real_distribution<T>(lo, hi)(engine); }
+    T sign() { return engine() & 1 ? T(1) : T(-1); }
+
+    // Magnitudes spread over 2^-8 .. 2^9
+    T wide() { return sign() * std::ldexp(uniform(T(1), T(2)), int(engine() % 17) - 8); }
+
+    // Mostly subnormal, with a quarter of the smallest normals mixed in
+    T denormal()
+    {
+        if (engine() % 4 == 0)
+            return sign() * std::numeric_limits<T>::min() * uniform(T(1), T(4));
+        int shift = 1 + int(engine() % (std::numeric_limits<T>::digits - 2));
+        return sign() * std::ldexp(uniform(T(1), T(2)), std::numeric_limits<T>::min_exponent - 1 - shift);
+    }
+};
+
+template <typename T, int D>
+Inputs<T, D> makeInputs(InputSet set, std::size_t count, Generator<T> &g)
+{
+    Inputs<T, D> in;
+    in.a.resize(count);
+    in.b.resize(count);
+    in.t.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Vec<T, D> &a = in.a[i], &b = in.b[i];
+        for (int k = 0; k < D; ++k)
+        {
+            a[k] = set == Denormal ? g.denormal() : g.wide();
+            b[k] = set == Denormal ? g.denormal() : g.wide();
+        }
+        if (set == Zero)
+        {
+            // Alternate which side is zero, and the sign of the zeros
+            T zero = i % 4 < 2 ? T(0) : -T(0);
+            (i % 2 == 0 ? a : b) = Vec<T, D>(zero);
+        }
+        else if (set == Parallel)
+        {
+            T scale = g.sign() * g.uniform(T(0.5), T(2));
+            T eps = std::ldexp(T(1), -int(4 + g.engine() % (std::numeric_limits<T>::digits - 4)));
+            for (int k = 0; k < D; ++k)
+                b[k] = a[k] * scale * (T(1) + eps * g.uniform(T(-1), T(1)));
+        }
+        in.t[i] = g.uniform(T(-0.5), T(1.5));
+    }
+    if constexpr (D == 3)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            in.alignedA.emplace_back(in.a[i]);
+            in.alignedB.emplace_back(in.b[i]);
+        }
+    }
+    return in;
+}
+
+template <typename T, int D>
+struct Backend
+{
+    const char *name;
+    // Writes the operation's `width` results per element to out
+    std::function<void(const Inputs<T, D> &, T *)> run;
+};
+
+template <typename T, int D>
+struct Operation
+{
+    const char *name;
+    int width;
+    // Exact results for one element from its wide components, and the term scale for cancellation
+    std::function<void(const Wide *, const Wide *, Wide, Wide *, Wide &)> exact;
+    std::vector<Backend<T, D>> backends;
+};
+
+template <typename T, typename R>
+void store(const R &result, T *out, std::size_t i)
+{
+    if constexpr (std::is_arithmetic_v<R>)
+    {
+        out[i] = result;
+    }
+    else
+    {
+        static_assert(sizeof(R) % sizeof(T) == 0, "Results are packed vectors");
+        std::memcpy(out + i * (sizeof(R) / sizeof(T)), &result, sizeof(R));
+    }
+}
+
+// Backend applying fn(a[i], b[i], t[i]) to every element of the Vector2/3/4 inputs
+template <typename T, int D, typename Fn>
+Backend<T, D> scalarBackend(Fn fn)
+{
+    return {"scalar", [fn](const Inputs<T, D> &in, T *out)
+    {
+        for (std::size_t i = 0; i < in.a.size(); ++i)
+            store(fn(in.a[i], in.b[i], in.t[i]), out, i);
+    }};
+}
+
+// The same over the Vector3A copies, vector results converted back to Vector3
+template <typename T, typename Fn>
+Backend<T, 3> alignedBackend(Fn fn)
+{
+    return {"vector3a", [fn](const Inputs<T, 3> &in, T *out)
+    {
+        for (std::size_t i = 0; i < in.alignedA.size(); ++i)
+        {
+            auto result = fn(in.alignedA[i], in.alignedB[i], in.t[i]);
+            if constexpr (std::is_arithmetic_v<decltype(result)>)
+                store(result, out, i);
+            else
+                store(Vector3<T>(result), out, i);
+        }
+    }};
+}
+
+Wide dotWide(const Wide *a, const Wide *b, int dim, Wide &scale)
+{
+    Wide sum = 0;
+    scale = 0;
+    for (int k = 0; k < dim; ++k)
+    {
+        sum += a[k] * b[k];
+        scale += std::fabs(a[k] * b[k]);
+    }
+    return sum;
+}
+
+Wide lengthWide(const Wide *a, int dim)
+{
+    Wide scale;
+    return std::sqrt(dotWide(a, a, dim, scale));
+}
+
+// a * b - c * d from exact products: long double holds a float product exactly and fmal recovers the
+// rounding error of a double one, so the difference stays exact to long double even when it cancels
+Wide differenceOfProducts(Wide a, Wide b, Wide c, Wide d)
+{
+    Wide ab = a * b, cd = c * d;
+    return (ab - cd) + (std::fma(a, b, -ab) - std::fma(c, d, -cd));
+}
+
+// atan2(|a ^ b|, a . b) with the wedge norm from Lagrange's identity, exact for near-parallel inputs
+Wide angleWide(const Wide *a, const Wide *b, int dim)
+{
+    if (lengthWide(a, dim) == 0 || lengthWide(b, dim) == 0)
+        return std::numbers::pi_v<Wide> / 2;
+    Wide wedge = 0, scale;
+    for (int i = 0; i < dim; ++i)
+    {
+        for (int j = i + 1; j < dim; ++j)
+        {
+            Wide w = differenceOfProducts(a[i], b[j], a[j], b[i]);
+            wedge += w * w;
+        }
+    }
+    return std::atan2(std::sqrt(wedge), dotWide(a, b, dim, scale));
+}
+
+template <typename T, int D>
+std::vector<Operation<T, D>> operations()
+{
+    using V = Vec<T, D>;
+    using A = Vector3A<T>;
+    std::vector<Operation<T, D>> ops;
+    auto componentwise = [&](const char *name, auto exact, auto scalar, auto aligned)
+    {
+        Operation<T, D> op{name, D, [exact](const Wide *a, const Wide *b, Wide t, Wide *out, Wide &scale)
+        {
+            scale = 0;
+            for (int k = 0; k < D; ++k)
+                out[k] = exact(a[k], b[k], t);
+        }, {scalarBackend<T, D>(scalar)}};
+        if constexpr (D == 3)
+            op.backends.push_back(alignedBackend<T>(aligned));
+        ops.push_back(op);
+    };
+
+    componentwise("add", [](Wide a, Wide b, Wide) { return a + b; },
+                  [](const V &a, const V &b, T) { return a + b; }, [](const A &a, const A &b, T) { return a + b; });
+    componentwise("sub", [](Wide a, Wide b, Wide) { return a - b; },
+                  [](const V &a, const V &b, T) { return a - b; }, [](const A &a, const A &b, T) { return a - b; });
+    componentwise("mul", [](Wide a, Wide b, Wide) { return a * b; },
+                  [](const V &a, const V &b, T) { return a * b; }, [](const A &a, const A &b, T) { return a * b; });
+    componentwise("div", [](Wide a, Wide b, Wide) { return a / b; },
+                  [](const V &a, const V &b, T) { return a / b; }, [](const A &a, const A &b, T) { return a / b; });
+    componentwise("min", [](Wide a, Wide b, Wide) { return std::min(a, b); },
+                  [](const V &a, const V &b, T) { return V::min(a, b); },
+                  [](const A &a, const A &b, T) { return A::min(a, b); });
+    componentwise("max", [](Wide a, Wide b, Wide) { return std::max(a, b); },
+                  [](const V &a, const V &b, T) { return V::max(a, b); },
+                  [](const A &a, const A &b, T) { return A::max(a, b); });
+    componentwise("abs", [](Wide a, Wide, Wide) { return std::fabs(a); },
+                  [](const V &a, const V &, T) { return V::abs(a); },
+                  [](const A &a, const A &, T) { return A::abs(a); });
+    // Clamped into [-|b|, |b|], so the bounds are exact and every input set lands both inside and outside
+    componentwise("clamp", [](Wide a, Wide b, Wide) { return std::clamp(a, -std::fabs(b), std::fabs(b)); },
+                  [](const V &a, const V &b, T) { return V::clamp(a, -V::abs(b), V::abs(b)); },
+                  [](const A &a, const A &b, T) { return A::clamp(a, -A::abs(b), A::abs(b)); });
+
+    // Scalar operands, with t as the scalar
+    componentwise("add scalar", [](Wide a, Wide, Wide t) { return a + t; },
+                  [](const V &a, const V &, T t) { return a + t; }, [](const A &a, const A &, T t) { return a + t; });
+    componentwise("sub scalar", [](Wide a, Wide, Wide t) { return a - t; },
+                  [](const V &a, const V &, T t) { return a - t; }, [](const A &a, const A &, T t) { return a - t; });
+    componentwise("mul scalar", [](Wide a, Wide, Wide t) { return a * t; },
+                  [](const V &a, const V &, T t) { return a * t; }, [](const A &a, const A &, T t) { return a * t; });
+    componentwise("div scalar", [](Wide a, Wide, Wide t) { return a / t; },
+                  [](const V &a, const V &, T t) { return a / t; }, [](const A &a, const A &, T t) { return a / t; });
+
+    // Scalar-valued operations; `aligned` is only used for D == 3
+    auto scalarValued = [&](const char *name, auto exact, auto scalar, auto aligned)
+    {
+        Operation<T, D> op{name, 1, exact, {scalarBackend<T, D>(scalar)}};
+        if constexpr (D == 3)
+            op.backends.push_back(alignedBackend<T>(aligned));
+        ops.push_back(op);
+    };
+
+    scalarValued("dot", [](const Wide *a, const Wide *b, Wide, Wide *out, Wide &scale)
+    {
+        out[0] = dotWide(a, b, D, scale);
+    }, [](const V &a, const V &b, T) { return V::dot(a, b); },
+       [](const A &a, const A &b, T) { return A::dot(a, b); });
+    scalarValued("sqrMagnitude", [](const Wide *a, const Wide *, Wide, Wide *out, Wide &scale)
+    {
+        out[0] = dotWide(a, a, D, scale);
+    }, [](const V &a, const V &, T) { return a.sqrMagnitude(); },
+       [](const A &a, const A &, T) { return a.sqrMagnitude(); });
+    scalarValued("magnitude", [](const Wide *a, const Wide *, Wide, Wide *out, Wide &scale)
+    {
+        scale = 0;
+        out[0] = lengthWide(a, D);
+    }, [](const V &a, const V &, T) { return a.magnitude(); },
+       [](const A &a, const A &, T) { return a.magnitude(); });
+    scalarValued("distance", [](const Wide *a, const Wide *b, Wide, Wide *out, Wide &scale)
+    {
+        Wide d[D];
+        for (int k = 0; k < D; ++k)
+            d[k] = a[k] - b[k];
+        scale = 0;
+        out[0] = lengthWide(d, D);
+    }, [](const V &a, const V &b, T) { return V::distance(a, b); },
+       [](const A &a, const A &b, T) { return A::distance(a, b); });
+
+    // Angle, with the batch kernels at both tiers
+    {
+        Operation<T, D> op{"angle", 1, [](const Wide *a, const Wide *b, Wide, Wide *out, Wide &scale)
+        {
+            scale = 0;
+            out[0] = angleWide(a, b, D);
+        }, {scalarBackend<T, D>([](const V &a, const V &b, T) { return V::angle(a, b); })}};
+        if constexpr (D == 3)
+            op.backends.push_back(alignedBackend<T>([](const A &a, const A &b, T) { return A::angle(a, b); }));
+        op.backends.push_back({"batch-precise", [](const Inputs<T, D> &in, T *out)
+        {
+            angles(in.a.data(), in.b.data(), out, in.a.size(), MathAccuracy::Precise);
+        }});
+        op.backends.push_back({"batch-fast", [](const Inputs<T, D> &in, T *out)
+        {
+            angles(in.a.data(), in.b.data(), out, in.a.size(), MathAccuracy::Fast);
+        }});
+        ops.push_back(op);
+    }
+
+    // normalized, with normalizeBatch for 3 components
+    {
+        Operation<T, D> op{"normalized", D, [](const Wide *a, const Wide *, Wide, Wide *out, Wide &scale)
+        {
+            Wide length = lengthWide(a, D);
+            scale = 0;
+            for (int k = 0; k < D; ++k)
+                out[k] = length == 0 ? Wide(0) : a[k] / length;
+        }, {scalarBackend<T, D>([](const V &a, const V &, T) { return a.normalized(); })}};
+        if constexpr (D == 3)
+        {
+            op.backends.push_back(alignedBackend<T>([](const A &a, const A &, T) { return a.normalized(); }));
+            op.backends.push_back({"batch-precise", [](const Inputs<T, D> &in, T *out)
+            {
+                normalizeBatch(in.a.data(), reinterpret_cast<Vector3<T> *>(out), in.a.size(), MathAccuracy::Precise);
+            }});
+            op.backends.push_back({"batch-fast", [](const Inputs<T, D> &in, T *out)
+            {
+                normalizeBatch(in.a.data(), reinterpret_cast<Vector3<T> *>(out), in.a.size(), MathAccuracy::Fast);
+            }});
+        }
+        ops.push_back(op);
+    }
+
+    // lerp and reflect can cancel down to zero, so errors are scaled by the largest term
+    {
+        Operation<T, D> op{"lerp", D, [](const Wide *a, const Wide *b, Wide t, Wide *out, Wide &scale)
+        {
+            scale = 0;
+            for (int k = 0; k < D; ++k)
+            {
+                out[k] = a[k] + (b[k] - a[k]) * t;
+                scale = std::max({scale, std::fabs(a[k]), std::fabs((b[k] - a[k]) * t)});
+            }
+        }, {scalarBackend<T, D>([](const V &a, const V &b, T t) { return V::lerp(a, b, t); })}};
+        if constexpr (D == 3)
+            op.backends.push_back(alignedBackend<T>([](const A &a, const A &b, T t) { return A::lerp(a, b, t); }));
+        ops.push_back(op);
+    }
+    {
+        Operation<T, D> op{"reflect", D, [](const Wide *a, const Wide *b, Wide, Wide *out, Wide &scale)
+        {
+            Wide dotScale;
+            Wide twice = 2 * dotWide(a, b, D, dotScale);
+            scale = 0;
+            for (int k = 0; k < D; ++k)
+            {
+                out[k] = a[k] - b[k] * twice;
+                scale = std::max({scale, std::fabs(a[k]), 2 * dotScale * std::fabs(b[k])});
+            }
+        }, {scalarBackend<T, D>([](const V &a, const V &b, T) { return V::reflect(a, b); })}};
+        if constexpr (D == 3)
+            op.backends.push_back(alignedBackend<T>([](const A &a, const A &b, T) { return A::reflect(a, b); }));
+        ops.push_back(op);
+    }
+
+    // cross: the perp-dot product in 2D, the cross product in 3D
+    if constexpr (D == 2 || D == 3)
+    {
+        auto exact = [](const Wide *a, const Wide *b, Wide, Wide *out, Wide &scale)
+        {
+            scale = 0;
+            for (int k = 0; k < (D == 2 ? 1 : 3); ++k)
+            {
+                int i = D == 2 ? 0 : (k + 1) % 3, j = D == 2 ? 1 : (k + 2) % 3;
+                out[k] = a[i] * b[j] - a[j] * b[i];
+                scale = std::max(scale, std::fabs(a[i] * b[j]) + std::fabs(a[j] * b[i]));
+            }
+        };
+        Operation<T, D> op{"cross", D == 2 ? 1 : 3, exact,
+                           {scalarBackend<T, D>([](const V &a, const V &b, T) { return V::cross(a, b); })}};
+        if constexpr (D == 3)
+            op.backends.push_back(alignedBackend<T>([](const A &a, const A &b, T) { return A::cross(a, b); }));
+        ops.push_back(op);
+    }
+    return ops;
+}
+
+// ULP of |x| rounded to T; the smallest denormal for zero
+template <typename T>
+Wide ulp(Wide x)
+{
+    T r = std::min(T(std::fabs(x)), std::numeric_limits<T>::max());
+    T next = std::nextafter(r, std::numeric_limits<T>::infinity());
+    if (std::isinf(next))
+        return Wide(r) - Wide(std::nextafter(r, T(0)));
+    return Wide(next) - Wide(r);
+}
+
+template <typename T>
+Wide elementError(const T *result, const Wide *exact, int width, Wide scale)
+{
+    for (int k = 0; k < width; ++k)
+        scale = std::max(scale, std::fabs(exact[k]));
+    Wide unit = ulp<T>(scale), worst = 0;
+    for (int k = 0; k < width; ++k)
+    {
+        Wide r = Wide(result[k]);
+        if (std::isnan(r) || std::isnan(exact[k]))
+        {
+            if (std::isnan(r) != std::isnan(exact[k]))
+                return std::numeric_limits<Wide>::infinity();
+            continue;
+        }
+        if (r != exact[k])
+            worst = std::max(worst, std::fabs(r - exact[k]) / unit);
+    }
+    return worst;
+}
+
+// Maximum error of one backend's results over an input set
+template <typename T, int D>
+Wide maxError(const Operation<T, D> &op, const Inputs<T, D> &in, const std::vector<T> &results)
+{
+    Wide worst = 0;
+    Wide a[D], b[D], exact[D];
+    for (std::size_t i = 0; i < in.a.size(); ++i)
+    {
+        for (int k = 0; k < D; ++k)
+        {
+            a[k] = Wide(in.a[i][k]);
+            b[k] = Wide(in.b[i][k]);
+        }
+        Wide scale;
+        op.exact(a, b, Wide(in.t[i]), exact, scale);
+        worst = std::max(worst, elementError(results.data() + i * op.width, exact, op.width, scale));
+    }
+    return worst;
+}
+
+// Best of several timed runs, in nanoseconds per element
+template <typename T, int D>
+double timePerElement(const Backend<T, D> &backend, const Inputs<T, D> &in, std::vector<T> &results)
+{
+    double best = 0;
+    for (int run = 0; run < 5; ++run)
+    {
+        auto start = std::chrono::steady_clock::now();
+        backend.run(in, results.data());
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = run == 0 ? ns : std::min(best, ns);
+    }
+    return best / double(in.a.size());
+}
+
+// Declared ULP budget of a backend on an input set; infinity where none is declared.
+// Every set but the denormal one is budgeted: there squared sums underflow, so magnitude, normalized and
+// angle lose precision by design. The scalar and Vector3A angle() take acos of the normalized dot and
+// are reported only. Fast kernels are budgeted in ulp of float.
+template <typename T>
+Wide budget(const char *operation, const char *backend, InputSet set)
+{
+    const Wide none = std::numeric_limits<Wide>::infinity();
+    bool isAngle = std::strcmp(operation, "angle") == 0;
+    if (set == Denormal || (isAngle && std::strncmp(backend, "batch", 5) != 0))
+        return none;
+    Wide ulps = isAngle ? 8 : 4;
+    if (std::strcmp(backend, "batch-fast") == 0)
+        ulps = std::ldexp(Wide(8), std::numeric_limits<T>::digits - std::numeric_limits<float>::digits);
+    return ulps;
+}
+
+// Prints one row per backend, marking errors past their budget with '!'; returns the number marked
+template <typename T, int D>
+int report(std::size_t count, Generator<T> &g)
+{
+    Inputs<T, D> sets[SetCount];
+    for (int s = 0; s < SetCount; ++s)
+        sets[s] = makeInputs<T, D>(InputSet(s), count, g);
+
+    std::vector<T> results(count * D);
+    int exceeded = 0;
+    for (const Operation<T, D> &op : operations<T, D>())
+    {
+        for (const Backend<T, D> &backend : op.backends)
+        {
+            std::printf("%-13s %3d %-14s", op.name, D, backend.name);
+            for (int s = 0; s < SetCount; ++s)
+            {
+                backend.run(sets[s], results.data());
+                Wide error = maxError(op, sets[s], results);
+                bool over = !(error <= budget<T>(op.name, backend.name, InputSet(s)));
+                exceeded += over;
+                std::printf(" %9.3Lg%c", error, over ? '!' : ' ');
+            }
+            std::printf(" %10.1f\n", 1e3 / timePerElement(backend, sets[Random], results));
+        }
+    }
+    return exceeded;
+}
+
+template <typename T>
+int reportType(const char *name, std::size_t count)
+{
+    Generator<T> g;
+    std::printf("\n%s (max ULP error against long double, throughput in Mops/s)\n", name);
+    std::printf("%-13s %3s %-14s", "operation", "dim", "backend");
+    for (const char *set : SetNames)
+        std::printf(" %10s", set);
+    std::printf(" %10s\n", "Mops/s");
+    return report<T, 2>(count, g) + report<T, 3>(count, g) + report<T, 4>(count, g);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::size_t count = argc > 1 ? std::size_t(std::atoll(argv[1])) : std::size_t(1) << 16;
+    if (count == 0)
+    {
+        std::fprintf(stderr, "usage: vector_accuracy [elements per set]\n");
+        return 1;
+    }
+    int exceeded = reportType<float>("float", count) + reportType<double>("double", count);
+    if (exceeded != 0)
+    {
+        std::fprintf(stderr, "%d result(s) over their ULP budget, marked '!'\n", exceeded);
+        return 1;
+    }
+    return 0;
+}